@@ -16,6 +16,7 @@
 //////////////////////////////////////////////////////////////////////////////
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
@@ -27,7 +28,9 @@
 #define SOL_F_SIZE_DEFAULT 64 // Set the size of the sol_f float value.
 #define SOL_INLINE_DEFAULT true // Enables function inlining.
 #define SOL_FAM_DEFAULT true // Enables C99 "Flexible Array Members" (FAM).
-#define SOL_SIMD_DEFAULT true // Enables automatic selection of OMP/AVX/NEON.
+#define SOL_SIMD_DEFAULT true // Enables automatic selection of SSE/AVX/NEON.
+#define SOL_AVX_DEFAULT true // Allows the AVX tier on x86; otherwise SSE is used.
+#define SOL_THREADS_DEFAULT true // Enables automatic selection of OMP/pthreads.
 
   //////////////////////////////////////////////////////////////////////////////
  // Config Processing /////////////////////////////////////////////////////////
@@ -73,11 +76,33 @@
       #endif
 #endif
 
+// SOL_AVX
+
+#if !defined(SOL_NO_AVX)
+      #if SOL_AVX_DEFAULT == false
+            #define SOL_NO_AVX
+      #endif
+#endif
+
+// SOL_THREADS
+
+#if !defined(SOL_THREADS) && !defined(SOL_NO_THREADS)
+      #if SOL_THREADS_DEFAULT == true
+            #define SOL_THREADS
+      #endif
+#else
+      #ifdef SOL_NO_THREADS
+            #ifdef SOL_THREADS
+                  #undef SOL_THREADS
+            #endif
+      #endif
+#endif
+
 // SOL_SIMD
 
 #if !defined(SOL_SIMD) && !defined(SOL_NO_SIMD)
       #if SOL_SIMD_DEFAULT == true
-            #if defined(__AVX__) || defined(__AVX2__) || defined(__ARM_NEON__)
+            #if defined(__SSE2__) || defined(__ARM_NEON__)
                   #define SOL_SIMD
             #endif
       #endif
@@ -100,26 +125,46 @@
            #undef SOL_F_SIZE
            #define SOL_F_SIZE 64
       #endif
-      #if !defined(__ARM__) && !defined(__AVX__)
-            #pragma message ("[sol] SOL_SIMD cannot be enabled on x86 without AVX.")
+      #if !defined(__ARM_NEON__) && !defined(__SSE2__)
+            #pragma message ("[sol] SOL_SIMD cannot be enabled on x86 without SSE2.")
             #undef SOL_SIMD
       #endif
 #endif
 
 #ifdef SOL_SIMD
-      #if defined(__AVX__)
-            #if defined(__AVX2__)
-                  #define SOL_AVX2
+      #if defined(__SSE2__)
+            #if defined(__SSE4_1__)
+                  #define SOL_SSE41
             #endif
-            #if SOL_F_SIZE > 32
-                  #define SOL_AVX_64
+            #if defined(__AVX__) && !defined(SOL_NO_AVX)
+                  #if defined(__AVX2__)
+                        #define SOL_AVX2
+                  #endif
+                  #if defined(__F16C__)
+                        #define SOL_F16C
+                  #endif
+                  #if defined(__FMA__)
+                        #define SOL_FMA
+                  #endif
+                  #define SOL_AVX
             #endif
-            #define SOL_AVX
+            #define SOL_SSE
       #elif defined(__ARM_NEON__)
-            #if SOL_F_SIZE > 32
-                  #define SOL_NEON_64
-            #endif
             #define SOL_NEON
+            #if defined(__ARM_FEATURE_FMA)
+                  #define SOL_FMA
+            #endif
+      #endif
+#endif
+
+#ifdef SOL_THREADS
+      #if defined(_OPENMP)
+            #define SOL_OMP
+      #elif defined(__unix__) || defined(__APPLE__)
+            #define SOL_PTHREAD
+      #else
+            #pragma message ("[sol] SOL_THREADS needs OpenMP or pthreads; running single-threaded.")
+            #undef SOL_THREADS
       #endif
 #endif
 
@@ -127,7 +172,7 @@
  // Nonstandard Headers ///////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 
-#if defined(SOL_AVX)
+#if defined(SOL_SSE)
       #include <x86intrin.h>
 #elif defined(SOL_NEON)
       #include <arm_neon.h>
@@ -143,17 +188,18 @@
       #define sol_inline
 #endif
 
-  //////////////////////////////////////////////////////////////////////////////
- // Core Type Definitions /////////////////////////////////////////////////////
-//////////////////////////////////////////////////////////////////////////////
+// SOL_VECN_ALIGN is the byte alignment of VecN storage, enough for the widest
+// SIMD register and a whole cache line.
 
-#if SOL_F_SIZE > 64
-      typedef long double Float;
-#elif SOL_F_SIZE > 32
-      typedef double Float;
-#else
-      typedef float Float;
-#endif
+#define SOL_VECN_ALIGN 64
+
+// SOL_T and SOL_FN attach the current family suffix (f, d or l) to a type
+// or function name, e.g. SOL_FN(vec3, add) is vec3f_add in the float family.
+
+#define SOL_PASTE_(a, b) a##b
+#define SOL_PASTE(a, b) SOL_PASTE_(a, b)
+#define SOL_T(name) SOL_PASTE(name, SOL_SUFFIX)
+#define SOL_FN(pre, name) SOL_PASTE(SOL_PASTE(pre, SOL_SUFFIX), SOL_PASTE(_, name))
 
   //////////////////////////////////////////////////////////////////////////////
  // Math Macros ///////////////////////////////////////////////////////////////
@@ -192,283 +238,579 @@
       #define M_C ((Float) 299792000)
 #endif
 
+  //////////////////////////////////////////////////////////////////////////////
+ // Float Families ////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Both the float (f) and double (d) families are always declared, e.g.
+// Vec3f/vec3f_add and Vec3d/vec3d_add, each with its own SIMD layout. The
+// unsuffixed names (Float, Vec3, vec3_add, ...) are aliases for the family
+// picked by SOL_F_SIZE, which also gets an "l" family when it is 80.
+
+#if SOL_F_SIZE > 64
+      #define SOL_F_SIZE_CONFIG 80
+#elif SOL_F_SIZE > 32
+      #define SOL_F_SIZE_CONFIG 64
+#else
+      #define SOL_F_SIZE_CONFIG 32
+#endif
+
+#undef SOL_F_SIZE
+#define SOL_F_SIZE 32
+#include "sol_family.h"
+
+#undef SOL_F_SIZE
+#define SOL_F_SIZE 64
+#include "sol_family.h"
+
+#undef SOL_F_SIZE
+#define SOL_F_SIZE SOL_F_SIZE_CONFIG
+#include "sol_family.h"
+
   //////////////////////////////////////////////////////////////////////////////
  // Struct Type Definitions ///////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 
-/// Vec2 ///
+/// Vec3h, Vec4h ///
 // Description
-//   A type comprised of two floats to represent a 2D vector or position.
+//   Storage types holding a vector as IEEE 754 half-precision (binary16)
+//   bit patterns. Convert with vecNh_encode/vecNh_decode.
 // Fields
-//   x: dimension (Float)
-//   y: dimension (Float)
-//   dim: dimensions (Float[2])
+//   x, y, z, w: dimension (uint16_t)
+//   dim: dimensions (uint16_t[3] / uint16_t[4])
 
 typedef struct {
   union {
     struct {
-      Float x, y;
+      uint16_t x, y, z;
     };
-    Float dim[2];
-    #if defined(SOL_AVX_64)
-          __m128d vec;
-    #elif defined(SOL_AVX)
-          __m128 vec;
-    #elif defined(SOL_NEON_64)
-          f64x2_t vec;
-    #elif defined(SOL_NEON)
-          f32x2_t vec;
-    #endif
+    uint16_t dim[3];
   };
-} Vec2;
+} Vec3h;
 
-/// Vec3 ///
+typedef struct {
+  union {
+    struct {
+      uint16_t x, y, z, w;
+    };
+    uint16_t dim[4];
+  };
+} Vec4h;
+
+/// Vec3s, Vec4s ///
+// Description
+//   Storage types holding a vector as signed normalized 16-bit integers,
+//   mapping [-1, 1] onto [-32767, 32767].
+// Fields
+//   x, y, z, w: dimension (int16_t)
+//   dim: dimensions (int16_t[3] / int16_t[4])
+
+typedef struct {
+  union {
+    struct {
+      int16_t x, y, z;
+    };
+    int16_t dim[3];
+  };
+} Vec3s;
+
+typedef struct {
+  union {
+    struct {
+      int16_t x, y, z, w;
+    };
+    int16_t dim[4];
+  };
+} Vec4s;
+
+/// Vec3u, Vec4u ///
 // Description
-//   A type comprised of three floats to represent a 3D vector or position.
+//   Storage types holding a vector as unsigned normalized 16-bit integers,
+//   mapping [0, 1] onto [0, 65535].
 // Fields
-//   x: dimension (sol_f)
-//   y: dimension (sol_f)
-//   z: dimension (sol_F)
-//   dim: dimensions (Float[3])
+//   x, y, z, w: dimension (uint16_t)
+//   dim: dimensions (uint16_t[3] / uint16_t[4])
 
-typedef struct type_vec3 {
-  union { 
+typedef struct {
+  union {
+    struct {
+      uint16_t x, y, z;
+    };
+    uint16_t dim[3];
+  };
+} Vec3u;
+
+typedef struct {
+  union {
     struct {
-      Float x, y, z;
+      uint16_t x, y, z, w;
     };
-    Float dim[3];
-    #if defined(SOL_AVX_64)
-          __m256d vec;
-    #elif defined(SOL_AVX)
-          __m128 vec;
-    #elif defined(SOL_NEON_64)
-          f64x4_t vec;
-    #elif defined(SOL_NEON)
-          f32x4_t vec;
-    #endif
+    uint16_t dim[4];
   };
-} Vec3;
+} Vec4u;
 
-/// Vec4 ///
+/// Oct3 ///
 // Description
-//   A type comprised of four floats to represent a quaternion or axis/angle
-//   rotation.
+//   A storage type holding a 3D unit vector in octahedral encoding: the
+//   direction is projected onto an octahedron, unfolded onto the [-1, 1]
+//   square and stored as two signed normalized 16-bit integers (4 bytes).
 // Fields
-//   x: dimension (Float)
-//   y: dimension (Float)
-//   z: dimension (Float)
-//   w: dimension (Float)
-//   dim: dimensions (Float[4])
-// Declarations
-//   Vec4
-//   struct type_vec4
+//   x: dimension (int16_t)
+//   y: dimension (int16_t)
+//   dim: dimensions (int16_t[2])
 
 typedef struct {
   union {
     struct {
-      Float x, y, z, w;
+      int16_t x, y;
     };
-    Float dim[4];
-    #if defined(SOL_AVX_64)
-          __m256d vec;
-    #elif defined(SOL_AVX)
-          __m128 vec;
-    #elif defined(SOL_NEON_64)
-          f64x4_t vec;
-    #elif defined(SOL_NEON)
-          f32x4_t vec;
-    #endif
+    int16_t dim[2];
   };
-} Vec4;
+} Oct3;
+
+/// Soa2, Soa3, Soa4 ///
+// Description
+//   Structure-of-arrays views over caller-owned Float buffers, one array per
+//   dimension. Batch kernels read or write element i as (x[i], y[i], ...).
+// Fields
+//   x, y, z, w: dimension arrays (Float*)
+
+typedef struct {
+  Float *x, *y;
+} Soa2;
+
+typedef struct {
+  Float *x, *y, *z;
+} Soa3;
+
+typedef struct {
+  Float *x, *y, *z, *w;
+} Soa4;
+
+/// Sym3 ///
+// Description
+//   A type comprised of six floats to represent a symmetric 3x3 matrix, such
+//   as a covariance. Only the upper triangle is stored.
+// Fields
+//   xx, xy, xz: first row (Float)
+//   yy, yz: second row from the diagonal (Float)
+//   zz: third row from the diagonal (Float)
+
+typedef struct {
+  Float xx, xy, xz, yy, yz, zz;
+} Sym3;
 
-/// Seg2 ///
+/// SoaSym3 ///
 // Description
-//   A type comprised of two 2D positions that represent a line segment.
+//   A structure-of-arrays view of symmetric 3x3 matrices over caller-owned
+//   Float buffers, one array per entry of Sym3.
 // Fields
-//   orig: position (Vec2)
-//   dest: position (Vec2)
+//   xx, xy, xz, yy, yz, zz: entry arrays (Float*)
 
 typedef struct {
-  Vec2 orig, dest;
-} Seg2;
+  Float *xx, *xy, *xz, *yy, *yz, *zz;
+} SoaSym3;
 
-/// Seg3 ///
+/// SolRand ///
 // Description
-//   A type comprised of two 3D positions that represent a line segment.
+//   The state of a xoshiro256+ generator running SOL_RAND_LANES independent
+//   lanes side by side, one lane per SIMD slot. Seed with sol_rand_seed.
 // Fields
-//   orig: position (Vec3)
-//   dest: position (Vec3)
+//   s: state words, word-major (uint64_t[4][SOL_RAND_LANES])
+
+#define SOL_RAND_LANES 8
 
 typedef struct {
-  Vec3 orig, dest;
-} Seg3;
+  uint64_t s[4][SOL_RAND_LANES];
+} SolRand;
+
+/// SolAccel ///
+// Description
+//   An acceleration field for the integrators: writes the acceleration of
+//   each of the n particles at the given positions and velocities into acc.
+//   Gravity is added by the integrator and should be left out.
+
+typedef void (*SolAccel)(void *ctx, Soa3 acc, Soa3 pos, Soa3 vel, size_t n);
+
+/// SolMotion ///
+// Description
+//   Settings shared by the integrators. A zeroed SolMotion, or NULL, means no
+//   gravity, no damping, no walls and a constant acc buffer.
+// Fields
+//   gravity: uniform acceleration, e.g. (0, 0, -M_G) (Vec3)
+//   damping: velocity decay rate; speeds shrink by exp(-damping * dt) (Float)
+//   bounds: walls that particles reflect off when bounded is set (Box3)
+//   bounded: whether to reflect off bounds (bool)
+//   restitution: speed kept on a bounce, 1 for elastic (Float)
+//   accel: acceleration field, or NULL to use acc as given (SolAccel)
+//   ctx: passed through to accel (void*)
 
-/// Box2 ///
+typedef struct {
+  Vec3 gravity;
+  Float damping;
+  Box3 bounds;
+  bool bounded;
+  Float restitution;
+  SolAccel accel;
+  void *ctx;
+} SolMotion;
+
+/// SolGravity ///
 // Description
-//   A type comprised of two 2D positions that represent a bounding box.
+//   Settings for the N-body solvers.
 // Fields
-//   lower: position (Vec2)
-//   upper: position (Vec2)
+//   mass: body masses, or NULL for unit masses (Float*)
+//   g: gravitational constant (Float)
+//   softening: Plummer softening length, keeping close pairs finite (Float)
+//   theta: Barnes-Hut opening angle, 0 for direct summation (Float)
 
-typedef struct type_box2 {
-  Vec2 lower, upper;
-} Box2;
+typedef struct {
+  const Float *mass;
+  Float g;
+  Float softening;
+  Float theta;
+} SolGravity;
 
-/// Box3 ///
+/// SolPair ///
 // Description
-//   A type comprised of two 3D positions that represent a bounding box.
+//   A pair of indices into an array, such as two overlapping boxes.
 // Fields
-//   upper: position (Vec3)
-//   lower: position (Vec3)
+//   a: lower index (size_t)
+//   b: higher index (size_t)
+
+typedef struct {
+  size_t a, b;
+} SolPair;
+
+/// SolSupport ///
+// Description
+//   A support function: returns the point of a convex shape furthest along
+//   dir, which need not be unit length. shape is passed through untouched.
 
-typedef struct type_box3 {
-  Vec3 lower, upper;
-} Box3;
+typedef Vec3 (*SolSupport)(const void *shape, Vec3 dir);
 
-/// Sph2 ///
+/// SolHull ///
 // Description
-//   A type comprised of a 2D position and a radius that represent a bounding
-//   sphere.
+//   A convex hull given by its points, in any order; points inside the hull
+//   are allowed but slow the support search down.
 // Fields
-//   pos: position (Vec2)
-//   rad: radius (Float)
+//   v: points (Soa3)
+//   n: point count, at least one (size_t)
 
-typedef struct type_sph2 {
-  Vec2 pos;
-  Float rad;
-} Sph2;
+typedef struct {
+  Soa3 v;
+  size_t n;
+} SolHull;
 
-/// Sph3 ///
+/// SolShape ///
 // Description
-//   A type comprised of a 3D position and a radius that represent a bounding
-//   sphere.
+//   A convex shape for the collision functions: a core given by its support
+//   function, grown by a radius. Make one with sol_shape_hull, sol_shape_sph3,
+//   sol_shape_box3 or sol_shape_capsule, or from any support function.
 // Fields
-//   pos: position (Vec3)
-//   rad: radius (Float)
+//   support: support function of the core (SolSupport)
+//   data: passed to support (void*)
+//   radius: distance the core is grown by (Float)
 
-typedef struct type_sph3 {
-  Vec3 pos;
-  Float rad;
-} Sph3;
+typedef struct {
+  SolSupport support;
+  const void *data;
+  Float radius;
+} SolShape;
+
+/// SolSimplex ///
+// Description
+//   The simplex a collision query ended on, kept between frames to warm start
+//   the next query for the same pair. Zero it before first use.
+// Fields
+//   dir: search directions of the simplex points (Vec3[4])
+//   n: point count (size_t)
+
+typedef struct {
+  Vec3 dir[4];
+  size_t n;
+} SolSimplex;
+
+/// SolContact ///
+// Description
+//   The result of a distance or penetration query.
+// Fields
+//   normal: unit direction from the first shape to the second (Vec3)
+//   point_a: point on the first shape (Vec3)
+//   point_b: point on the second shape (Vec3)
+//   distance: distance between the shapes, negative when they overlap (Float)
+
+typedef struct {
+  Vec3 normal;
+  Vec3 point_a, point_b;
+  Float distance;
+} SolContact;
+
+/// SolHit ///
+// Description
+//   Where a ray meets a triangle mesh.
+// Fields
+//   t: distance along the ray as a fraction of its length (Float)
+//   u, v: barycentric coordinates; the point is a + u (b - a) + v (c - a)
+//         for the triangle's corners a, b and c (Float)
+//   tri: triangle index (size_t)
+
+typedef struct {
+  Float t, u, v;
+  size_t tri;
+} SolHit;
+
+/// SolVoxels ///
+// Description
+//   A grid of nx by ny by nz cubic voxels with its lowest corner at origin,
+//   one bit each. Every row of voxels along x starts a new word: voxel
+//   (x, y, z) is bit x % 64 of bits[(z ny + y) words + x / 64], and the bits
+//   past nx in a row's last word are always clear.
+// Fields
+//   bits: voxels (uint64_t*)
+//   words: words per row, (nx + 63) / 64 (size_t)
+//   nx, ny, nz: voxel counts along each axis (size_t)
+//   origin: lowest corner of the grid (Vec3)
+//   size: voxel edge length (Float)
+
+typedef struct {
+  uint64_t *bits;
+  size_t words;
+  size_t nx, ny, nz;
+  Vec3 origin;
+  Float size;
+} SolVoxels;
+
+/// SolField ///
+// Description
+//   A grid of nx by ny by nz samples of a scalar field, such as a signed
+//   distance. Sample (x, y, z) is d[(z ny + y) nx + x], taken at the centre
+//   of voxel (x, y, z) of a SolVoxels grid with the same origin and size.
+// Fields
+//   d: samples (Float*)
+//   nx, ny, nz: sample counts along each axis (size_t)
+//   origin: lowest corner of the grid (Vec3)
+//   size: sample spacing (Float)
+
+typedef struct {
+  Float *d;
+  size_t nx, ny, nz;
+  Vec3 origin;
+  Float size;
+} SolField;
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Parallel Function Declarations ////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// A task over the index range [lo, hi); ctx is passed through untouched.
+
+typedef void (*SolFor)(void *ctx, size_t lo, size_t hi);
+
+typedef struct type_graph SolGraph;
+
+void sol_parallel_for(size_t n, size_t size, SolFor fn, void *ctx);
+
+SolGraph *sol_graph_init(void);
+void sol_graph_free(SolGraph *g);
+size_t sol_graph_add(SolGraph *g, size_t n, size_t size, SolFor fn, void *ctx);
+bool sol_graph_after(SolGraph *g, size_t node, size_t dep);
+void sol_graph_run(SolGraph *g);
+
+void sol_set_threads(size_t n);
+size_t sol_get_threads(void);
+void sol_set_threshold(size_t bytes);
+size_t sol_get_threshold(void);
+void sol_set_chunk(size_t bytes);
+size_t sol_get_chunk(void);
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Packed Storage Function Declarations //////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+Vec3h vec3h_encode(Vec3 v);
+Vec3 vec3h_decode(Vec3h h);
+Vec4h vec4h_encode(Vec4 v);
+Vec4 vec4h_decode(Vec4h h);
+Vec3s vec3s_encode(Vec3 v);
+Vec3 vec3s_decode(Vec3s s);
+Vec4s vec4s_encode(Vec4 v);
+Vec4 vec4s_decode(Vec4s s);
+Vec3u vec3u_encode(Vec3 v);
+Vec3 vec3u_decode(Vec3u u);
+Vec4u vec4u_encode(Vec4 v);
+Vec4 vec4u_decode(Vec4u u);
+Oct3 oct3_encode(Vec3 n);
+Vec3 oct3_decode(Oct3 o);
+
+void vec3h_encode_array(Vec3h *out, Soa3 in, size_t n);
+void vec3h_decode_array(Soa3 out, const Vec3h *in, size_t n);
+void vec4h_encode_array(Vec4h *out, Soa4 in, size_t n);
+void vec4h_decode_array(Soa4 out, const Vec4h *in, size_t n);
+void vec3s_encode_array(Vec3s *out, Soa3 in, size_t n);
+void vec3s_decode_array(Soa3 out, const Vec3s *in, size_t n);
+void vec4s_encode_array(Vec4s *out, Soa4 in, size_t n);
+void vec4s_decode_array(Soa4 out, const Vec4s *in, size_t n);
+void vec3u_encode_array(Vec3u *out, Soa3 in, size_t n);
+void vec3u_decode_array(Soa3 out, const Vec3u *in, size_t n);
+void vec4u_encode_array(Vec4u *out, Soa4 in, size_t n);
+void vec4u_decode_array(Soa4 out, const Vec4u *in, size_t n);
+void oct3_encode_array(Oct3 *out, Soa3 in, size_t n);
+void oct3_decode_array(Soa3 out, const Oct3 *in, size_t n);
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Reduction Function Declarations ///////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+Float flt_sum_array(const Float *f, size_t n);
+Float flt_sum_exact_array(const Float *f, size_t n);
+Float flt_dot_array(const Float *a, const Float *b, size_t n);
+Float flt_dot_exact_array(const Float *a, const Float *b, size_t n);
+Float flt_min_array(const Float *f, size_t n);
+Float flt_max_array(const Float *f, size_t n);
+
+Vec3 vec3_sum_array(const Vec3p *v, size_t n);
+Vec3 vec3_sum_exact_array(const Vec3p *v, size_t n);
+Vec3 vec3_mean_array(const Vec3p *v, size_t n);
+Vec3 vec3_mean_exact_array(const Vec3p *v, size_t n);
+Float vec3_dot_sum_array(const Vec3p *a, const Vec3p *b, size_t n);
+Float vec3_dot_sum_exact_array(const Vec3p *a, const Vec3p *b, size_t n);
+Sym3 vec3_cov_array(const Vec3p *v, size_t n);
+Sym3 vec3_cov_exact_array(const Vec3p *v, size_t n);
+Vec3 vec3_min_array(const Vec3p *v, size_t n);
+Vec3 vec3_max_array(const Vec3p *v, size_t n);
+Box3 vec3_bounds_array(const Vec3p *v, size_t n);
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Random Sampling Function Declarations /////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+void sol_rand_seed(SolRand *r, uint64_t seed, uint64_t stream);
+
+void flt_rand_array(SolRand *r, Float *out, size_t n);
+void vec2_rand_disk_array(SolRand *r, Soa2 out, size_t n);
+void vec3_rand_box_array(SolRand *r, Soa3 out, Box3 box, size_t n);
+void vec3_rand_sphere_array(SolRand *r, Soa3 out, size_t n);
+void vec4_rand_quat_array(SolRand *r, Soa4 out, size_t n);
 
   //////////////////////////////////////////////////////////////////////////////
- // Float Function Declarations ///////////////////////////////////////////////
+ // Integration Function Declarations /////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 
-Float flt_clamp(Float f, Float lower, Float upper);
-Float flt_pow(Float a, Float b);
-Float flt_sqrt(Float f);
-Float flt_sin(Float f);
-Float flt_cos(Float f);
-Float flt_acos(Float f);
+void vec3_euler_array(Soa3 pos, Soa3 vel, Soa3 acc, size_t n, Float dt, const SolMotion *m);
+void vec3_verlet_array(Soa3 pos, Soa3 vel, Soa3 acc, size_t n, Float dt, const SolMotion *m);
+void vec3_rk4_array(Soa3 pos, Soa3 vel, Soa3 acc, Float *work, size_t n, Float dt, const SolMotion *m);
 
   //////////////////////////////////////////////////////////////////////////////
- // Conversion Function Declarations //////////////////////////////////////////
+ // N-Body Function Declarations //////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 
-Vec4 cv_axis_quat(Vec4 axis);
-Vec4 cv_quat_axis(Vec4 quat);
+void vec3_gravity_direct_array(Soa3 acc, Soa3 pos, size_t n, const SolGravity *grav);
+void vec3_gravity_tree_array(Soa3 acc, Soa3 pos, size_t n, const SolGravity *grav);
+void vec3_gravity_field(void *ctx, Soa3 acc, Soa3 pos, Soa3 vel, size_t n);
 
-Vec2 cv_vec3_vec2(Vec3 v);
-Vec2 cv_vec4_vec2(Vec4 v);
-Vec3 cv_vec2_vec3(Vec2 v, Float z);
-Vec3 cv_vec4_vec3(Vec4 v);
-Vec4 cv_vec2_vec4(Vec2 v, Float z, Float w);
-Vec4 cv_vec3_vec4(Vec3 v, Float w);
+  //////////////////////////////////////////////////////////////////////////////
+ // Noise Function Declarations ///////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
 
-Float cv_deg_rad(Float deg);
-Float cv_rad_deg(Float rad);
+Float noise2(Vec2 p);
+Float noise2_perlin(Vec2 p);
+Float noise2_fbm(Vec2 p, size_t octaves, Float lacunarity, Float gain);
+Float noise3(Vec3 p);
+Float noise3_perlin(Vec3 p);
+Float noise3_fbm(Vec3 p, size_t octaves, Float lacunarity, Float gain);
+
+void noise2_array(Float *out, const Vec2 *points, size_t n);
+void noise2_perlin_array(Float *out, const Vec2 *points, size_t n);
+void noise2_fbm_array(Float *out, const Vec2 *points, size_t n,
+                      size_t octaves, Float lacunarity, Float gain);
+void noise3_array(Float *out, const Vec3p *points, size_t n);
+void noise3_perlin_array(Float *out, const Vec3p *points, size_t n);
+void noise3_fbm_array(Float *out, const Vec3p *points, size_t n,
+                      size_t octaves, Float lacunarity, Float gain);
 
   //////////////////////////////////////////////////////////////////////////////
- // Vec2 Function Declarations ////////////////////////////////////////////////
+ // Broadphase Function Declarations //////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 
-Vec2 vec2_init(Float x, Float y);
-Vec2 vec2_initf(Float f);
-Vec2 vec2_zero(void);
+typedef struct type_sap SolSap;
 
-Vec2 vec2_norm(Vec2 v);
-Float vec2_mag(Vec2 v);
+SolSap *sol_sap_init(void);
+void sol_sap_free(SolSap *s);
+size_t sol_sap_update(SolSap *s, const Box3 *boxes, size_t n);
+const SolPair *sol_sap_pairs(const SolSap *s);
 
-Vec2 vec2_rot(Vec2 v, Float rad);
+  //////////////////////////////////////////////////////////////////////////////
+ // Collision Function Declarations ///////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
 
-Float vec2_cross(Vec2 a, Vec2 b);
-Float vec2_dot(Vec2 a, Vec2 b);
+size_t vec3_support_array(Soa3 v, size_t n, Vec3 dir);
 
-Float vec2_sum(Vec2 v);
-Vec2 vec2_add(Vec2 a, Vec2 b);
-Vec2 vec2_addf(Vec2 v, Float f);
-Vec2 vec2_sub(Vec2 a, Vec2 b);
-Vec2 vec2_subf(Vec2 v, Float f);
-Vec2 vec2_fsub(Float f, Vec2 v);
-Vec2 vec2_mul(Vec2 a, Vec2 b);
-Vec2 vec2_mulf(Vec2 v, Float f);
-Vec2 vec2_div(Vec2 a, Vec2 b);
-Vec2 vec2_divf(Vec2 v, Float f);
-Vec2 vec2_fdiv(Float f, Vec2 v);
-Vec2 vec2_avg(Vec2 a, Vec2 b);
-Vec2 vec2_avgf(Vec2 v, Float f);
+Vec3 sol_support_hull(const void *shape, Vec3 dir);
+Vec3 sol_support_sph3(const void *shape, Vec3 dir);
+Vec3 sol_support_box3(const void *shape, Vec3 dir);
+Vec3 sol_support_seg3(const void *shape, Vec3 dir);
 
-void vec2_print(Vec2 v);
+SolShape sol_shape_hull(const SolHull *h);
+SolShape sol_shape_sph3(const Sph3 *s);
+SolShape sol_shape_box3(const Box3 *b);
+SolShape sol_shape_capsule(const Seg3 *s, Float radius);
+
+bool sol_gjk_intersect(SolShape a, SolShape b, SolSimplex *cache);
+bool sol_gjk_distance(SolContact *c, SolShape a, SolShape b, SolSimplex *cache);
+bool sol_gjk_penetration(SolContact *c, SolShape a, SolShape b, SolSimplex *cache);
 
   //////////////////////////////////////////////////////////////////////////////
- // Vec3 Function Declarations ////////////////////////////////////////////////
+ // Convex Hull Function Declarations /////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 
-Vec3 vec3_init(Float x, Float y, Float z);
-Vec3 vec3_initf(Float f);
-Vec3 vec3_zero(void);
+size_t vec2_hull_array(size_t *idx, const Vec2 *v, size_t n);
+size_t vec3_hull_array(size_t *idx, const Vec3p *v, size_t n);
 
-Vec3 vec3_norm(Vec3 v);
-Float vec3_mag(Vec3 v);
+  //////////////////////////////////////////////////////////////////////////////
+ // Mesh Function Declarations ////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
 
-Vec3 vec3_rot(Vec3 v, Vec4 q);
+typedef struct type_mesh SolMesh;
 
-Vec3 vec3_cross(Vec3 a, Vec3 b);
-Float vec3_dot(Vec3 a, Vec3 b);
+SolMesh *sol_mesh_init(const Vec3p *v, const uint32_t *idx, size_t n);
+void sol_mesh_free(SolMesh *m);
+bool sol_mesh_raycast(SolHit *hit, const SolMesh *m, Seg3 ray);
+bool sol_mesh_occluded(const SolMesh *m, Seg3 ray);
+void sol_mesh_raycast_array(SolHit *hits, const SolMesh *m, const Seg3 *rays, size_t n);
+Float sol_mesh_distance(size_t *tri, const SolMesh *m, Vec3 p);
+void sol_mesh_distance_array(Float *dist, size_t *tri, const SolMesh *m, const Vec3p *p, size_t n);
 
-Float vec3_sum(Vec3 v);
-Vec3 vec3_add(Vec3 a, Vec3 b);
-Vec3 vec3_addf(Vec3 v, Float f);
-Vec3 vec3_sub(Vec3 a, Vec3 b);
-Vec3 vec3_subf(Vec3 v, Float f);
-Vec3 vec3_fsub(Float f, Vec3 v);
-Vec3 vec3_mul(Vec3 a, Vec3 b);
-Vec3 vec3_mulf(Vec3 v, Float f);
-Vec3 vec3_div(Vec3 a, Vec3 b);
-Vec3 vec3_divf(Vec3 v, Float f);
-Vec3 vec3_fdiv(Float f, Vec3 v);
-Vec3 vec3_avg(Vec3 a, Vec3 b);
-Vec3 vec3_avgf(Vec3 v, Float f);
+void vec3_closest_tri_array(Soa3 out, Soa3 p, Soa3 a, Soa3 b, Soa3 c, size_t n);
 
-void vec3_print(Vec3 v);
+  //////////////////////////////////////////////////////////////////////////////
+ // Voxel Function Declarations ///////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+SolVoxels *sol_voxels_init(Vec3 origin, Float size, size_t nx, size_t ny, size_t nz);
+void sol_voxels_free(SolVoxels *g);
+bool sol_voxels_get(const SolVoxels *g, size_t x, size_t y, size_t z);
+bool sol_voxelize(SolVoxels *g, const Vec3p *v, const uint32_t *idx, size_t n, bool solid);
+
+SolField *sol_field_init(Vec3 origin, Float size, size_t nx, size_t ny, size_t nz);
+void sol_field_free(SolField *f);
+bool sol_field_mesh(SolField *f, const Vec3p *v, const uint32_t *idx, size_t n, size_t band);
+bool sol_field_points(SolField *f, const Vec3p *p, size_t n);
+void sol_field_sample_array(Float *d, Vec3p *grad, const SolField *f, const Vec3p *p, size_t n);
+
+size_t vec3_voxel_mean_array(Vec3p *out, const Vec3p *v, size_t n, Float size);
+size_t vec3_voxel_first_array(size_t *idx, const Vec3p *v, size_t n, Float size);
+size_t vec3_voxel_nearest_array(size_t *idx, const Vec3p *v, size_t n, Float size);
 
   //////////////////////////////////////////////////////////////////////////////
- // Vec4 Function Declarations ////////////////////////////////////////////////
+ // Eigen Function Declarations ///////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 
-Vec4 vec4_init(Float x, Float y, Float z, Float w);
-Vec4 vec4_initf(Float f);
-Vec4 vec4_zero(void);
-
-Vec4 vec4_norm(Vec4 v);
-Float vec4_mag(Vec4 v);
-
-Float vec4_sum(Vec4 v);
-Vec4 vec4_add(Vec4 a, Vec4 b);
-Vec4 vec4_addf(Vec4 v, Float f);
-Vec4 vec4_sub(Vec4 a, Vec4 b);
-Vec4 vec4_subf(Vec4 v, Float f);
-Vec4 vec4_fsub(Float f, Vec4 v);
-Vec4 vec4_mul(Vec4 a, Vec4 b);
-Vec4 vec4_mulf(Vec4 v, Float f);
-Vec4 vec4_div(Vec4 a, Vec4 b);
-Vec4 vec4_divf(Vec4 v, Float f);
-Vec4 vec4_fdiv(Float f, Vec4 v);
-Vec4 vec4_avg(Vec4 a, Vec4 b);
-Vec4 vec4_avgf(Vec4 v, Float f);
-
-void vec4_print(Vec4 v);
+Vec3 sym3_eigen(Vec3 vec[3], Sym3 m);
+void sym3_eigen_array(Soa3 val, Soa3 vec0, Soa3 vec1, Soa3 vec2, SoaSym3 m, size_t n);
+
+void vec3_cov_knn_array(SoaSym3 cov, const Vec3p *v, const size_t *idx, size_t k, size_t n);
+void vec3_normal_array(Soa3 normal, Float *curv, const Vec3p *v, const size_t *idx, size_t k, size_t n, Vec3 view);
 
 #ifdef __cplusplus
       }
@@ -8,23 +8,37 @@
 # Compiler Configuration #######################################################
 ################################################################################
 
-{.emit:
-"""
-   #define SOL_F_SIZE 32
-   #define SOL_NO_FAM
-   #define SOL_INLINE
-   #define SOL_SIMD
-"""
-.}
+# Passed to every C unit (not just the generated one) so that the compiled
+# sources agree with these bindings: the unsuffixed names below are the float
+# family, and the double family is bound with a "d" suffix further down.
+
+{.passc:"-DSOL_F_SIZE=32 -DSOL_NO_FAM -DSOL_INLINE -DSOL_SIMD".}
 
 {.compile: "./src/sol_flt.c".}
 {.compile: "./src/sol_conv.c".}
 {.compile: "./src/sol_vec2.c".}
 {.compile: "./src/sol_vec3.c".}
 {.compile: "./src/sol_vec4.c".}
+{.compile: "./src/sol_vecn.c".}
+{.compile: "./src/sol_f32.c".}
+{.compile: "./src/sol_f64.c".}
+{.compile: "./src/sol_pack.c".}
+{.compile: "./src/sol_reduce.c".}
+{.compile: "./src/sol_rand.c".}
+{.compile: "./src/sol_noise.c".}
+{.compile: "./src/sol_motion.c".}
+{.compile: "./src/sol_nbody.c".}
+{.compile: "./src/sol_sap.c".}
+{.compile: "./src/sol_gjk.c".}
+{.compile: "./src/sol_hull.c".}
+{.compile: "./src/sol_mod3.c".}
+{.compile: "./src/sol_vox.c".}
+{.compile: "./src/sol_eig.c".}
+{.compile: "./src/sol_par.c".}
 
 {.passc:"-I.".}
 {.passl:"-lm".}
+{.passl:"-lpthread".}
 
 ################################################################################
 # Type Definitions #############################################################
@@ -32,15 +46,97 @@
 
 type Float* {.importc: "Float", header: "sol.h".} = cfloat
 
+type SolFor* = proc (ctx: pointer; lo, hi: csize) {.cdecl.}
+
+type SolGraph* {.importc: "SolGraph", header: "sol.h", incompleteStruct.} = object
+
+type SolSap* {.importc: "SolSap", header: "sol.h", incompleteStruct.} = object
+
+type SolMesh* {.importc: "SolMesh", header: "sol.h", incompleteStruct.} = object
+
+type SolPair* {.importc: "SolPair", header: "sol.h".} = object
+    a*, b*: csize
+
 type Vec2* {.importc: "Vec2", header: "sol.h".} = object
     x*, y*: Float
 
 type Vec3* {.importc: "Vec3", header: "sol.h".} = object
     x*, y*, z*: Float
 
+type Vec3p* {.importc: "Vec3p", header: "sol.h".} = object
+    x*, y*, z*: Float
+
+type Vec3x4* {.importc: "Vec3x4", header: "sol.h".} = object
+    x*, y*, z*: array[4, Float]
+
+type Vec3x8* {.importc: "Vec3x8", header: "sol.h".} = object
+    x*, y*, z*: array[8, Float]
+
 type Vec4* {.importc: "Vec4", header: "sol.h".} = object
     x*, y*, z*, w*: Float
 
+type VecN* {.importc: "VecN", header: "sol.h", incompleteStruct.} = object
+    len*: csize
+
+type Floatd* {.importc: "Floatd", header: "sol.h".} = cdouble
+
+type Vec2d* {.importc: "Vec2d", header: "sol.h".} = object
+    x*, y*: Floatd
+
+type Vec3d* {.importc: "Vec3d", header: "sol.h".} = object
+    x*, y*, z*: Floatd
+
+type Vec3pd* {.importc: "Vec3pd", header: "sol.h".} = object
+    x*, y*, z*: Floatd
+
+type Vec3x4d* {.importc: "Vec3x4d", header: "sol.h".} = object
+    x*, y*, z*: array[4, Floatd]
+
+type Vec3x8d* {.importc: "Vec3x8d", header: "sol.h".} = object
+    x*, y*, z*: array[8, Floatd]
+
+type Vec4d* {.importc: "Vec4d", header: "sol.h".} = object
+    x*, y*, z*, w*: Floatd
+
+type VecNd* {.importc: "VecNd", header: "sol.h", incompleteStruct.} = object
+    len*: csize
+
+type Vec3h* {.importc: "Vec3h", header: "sol.h".} = object
+    x*, y*, z*: uint16
+
+type Vec4h* {.importc: "Vec4h", header: "sol.h".} = object
+    x*, y*, z*, w*: uint16
+
+type Vec3s* {.importc: "Vec3s", header: "sol.h".} = object
+    x*, y*, z*: int16
+
+type Vec4s* {.importc: "Vec4s", header: "sol.h".} = object
+    x*, y*, z*, w*: int16
+
+type Vec3u* {.importc: "Vec3u", header: "sol.h".} = object
+    x*, y*, z*: uint16
+
+type Vec4u* {.importc: "Vec4u", header: "sol.h".} = object
+    x*, y*, z*, w*: uint16
+
+type Oct3* {.importc: "Oct3", header: "sol.h".} = object
+    x*, y*: int16
+
+type Soa2* {.importc: "Soa2", header: "sol.h".} = object
+    x*, y*: ptr Float
+
+type Soa3* {.importc: "Soa3", header: "sol.h".} = object
+    x*, y*, z*: ptr Float
+
+type Soa4* {.importc: "Soa4", header: "sol.h".} = object
+    x*, y*, z*, w*: ptr Float
+
+type Sym3* {.importc: "Sym3", header: "sol.h".} = object
+    xx*, xy*, xz*, yy*, yz*, zz*: Float
+
+type SoaSym3* {.importc: "SoaSym3", header: "sol.h".} = object
+    xx*, xy*, xz*, yy*, yz*, zz*: ptr Float
+
 type Seg2* {.importc: "Seg2", header: "sol.h".} = object
     orig*, dest*: Vec2
 
@@ -61,16 +157,77 @@ type Sph3* {.importc: "Sph3", header: "sol.h".} = object
     pos*: Vec3
     rad*: Float
 
+type SolRand* {.importc: "SolRand", header: "sol.h".} = object
+    s*: array[4, array[8, uint64]]
+
+type SolAccel* = proc (ctx: pointer; acc, pos, vel: Soa3; n: csize) {.cdecl.}
+
+type SolMotion* {.importc: "SolMotion", header: "sol.h".} = object
+    gravity*: Vec3
+    damping*: Float
+    bounds*: Box3
+    bounded*: bool
+    restitution*: Float
+    accel*: SolAccel
+    ctx*: pointer
+
+type SolGravity* {.importc: "SolGravity", header: "sol.h".} = object
+    mass*: ptr Float
+    g*, softening*, theta*: Float
+
+type SolSupport* = proc (shape: pointer; dir: Vec3): Vec3 {.cdecl.}
+
+type SolHull* {.importc: "SolHull", header: "sol.h".} = object
+    v*: Soa3
+    n*: csize
+
+type SolShape* {.importc: "SolShape", header: "sol.h".} = object
+    support*: SolSupport
+    data*: pointer
+    radius*: Float
+
+type SolSimplex* {.importc: "SolSimplex", header: "sol.h".} = object
+    dir*: array[4, Vec3]
+    n*: csize
+
+type SolContact* {.importc: "SolContact", header: "sol.h".} = object
+    normal*: Vec3
+    point_a*, point_b*: Vec3
+    distance*: Float
+
+type SolHit* {.importc: "SolHit", header: "sol.h".} = object
+    t*, u*, v*: Float
+    tri*: csize
+
+type SolVoxels* {.importc: "SolVoxels", header: "sol.h".} = object
+    bits*: ptr uint64
+    words*: csize
+    nx*, ny*, nz*: csize
+    origin*: Vec3
+    size*: Float
+
+type SolField* {.importc: "SolField", header: "sol.h".} = object
+    d*: ptr Float
+    nx*, ny*, nz*: csize
+    origin*: Vec3
+    size*: Float
+
 ################################################################################
 # Float Functions ##############################################################
 ################################################################################
 
 proc flt_clamp*(f, lower, upper: Float): Float {.importc: "flt_clamp", header: "sol.h".}
 proc flt_pow*(a, b: Float): Float {.importc: "flt_pow", header: "sol.h".}
+proc flt_exp*(f: Float): Float {.importc: "flt_exp", header: "sol.h".}
 proc flt_sqrt*(f: Float): Float {.importc: "flt_sqrt", header: "sol.h".}
 proc flt_sin*(f: Float): Float {.importc: "flt_sin", header: "sol.h".}
 proc flt_cos*(f: Float): Float {.importc: "flt_cos", header: "sol.h".}
 proc flt_acos*(f: Float): Float {.importc: "flt_acos", header: "sol.h".}
+proc flt_abs*(f: Float): Float {.importc: "flt_abs", header: "sol.h".}
+proc flt_floor*(f: Float): Float {.importc: "flt_floor", header: "sol.h".}
+proc flt_ceil*(f: Float): Float {.importc: "flt_ceil", header: "sol.h".}
+proc flt_round*(f: Float): Float {.importc: "flt_round", header: "sol.h".}
+proc flt_fma*(a, b, c: Float): Float {.importc: "flt_fma", header: "sol.h".}
 
 ################################################################################
 # Conversion Functions #########################################################
@@ -89,6 +246,9 @@ proc cv_vec3_vec4*(v: Vec3; w: Float): Vec4 {.importc: "cv_vec3_vec4", header: "
 proc cv_deg_rad*(deg: Float): Float {.importc: "cv_deg_rad", header: "sol.h".}
 proc cv_rad_deg*(rad: Float): Float {.importc: "cv_rad_deg", header: "sol.h".}
 
+proc cv_flt_half*(f: Float): uint16 {.importc: "cv_flt_half", header: "sol.h".}
+proc cv_half_flt*(h: uint16): Float {.importc: "cv_half_flt", header: "sol.h".}
+
 ################################################################################
 # Vec2 Functions ###############################################################
 ################################################################################
@@ -119,6 +279,15 @@ proc vec2_fdiv*(f: Float, v: Vec2): Vec2 {.importc: "vec2_fdiv", header: "sol.h"
 proc vec2_avg*(a, b: Vec2): Vec2 {.importc: "vec2_avg", header: "sol.h".}
 proc vec2_avgf*(v: Vec2, f: Float): Vec2 {.importc: "vec2_avgf", header: "sol.h".}
 
+proc vec2_fma*(a, b, c: Vec2): Vec2 {.importc: "vec2_fma", header: "sol.h".}
+proc vec2_fmaf*(a: Vec2, f: Float, b: Vec2): Vec2 {.importc: "vec2_fmaf", header: "sol.h".}
+proc vec2_madd*(a, b: Vec2, f: Float): Vec2 {.importc: "vec2_madd", header: "sol.h".}
+proc vec2_lerp*(a, b: Vec2, t: Float): Vec2 {.importc: "vec2_lerp", header: "sol.h".}
+
+proc vec2_floor*(v: Vec2): Vec2 {.importc: "vec2_floor", header: "sol.h".}
+proc vec2_ceil*(v: Vec2): Vec2 {.importc: "vec2_ceil", header: "sol.h".}
+proc vec2_round*(v: Vec2): Vec2 {.importc: "vec2_round", header: "sol.h".}
+
 proc vec2_print*(v: Vec2): void {.importc: "vec2_print", header: "sol.h".}
 
 ################################################################################
@@ -151,8 +320,36 @@ proc vec3_fdiv*(f: Float, v: Vec3): Vec3 {.importc: "vec3_fdiv", header: "sol.h"
 proc vec3_avg*(a, b: Vec3): Vec3 {.importc: "vec3_avg", header: "sol.h".}
 proc vec3_avgf*(v: Vec3, f: Float): Vec3 {.importc: "vec3_avgf", header: "sol.h".}
 
+proc vec3_fma*(a, b, c: Vec3): Vec3 {.importc: "vec3_fma", header: "sol.h".}
+proc vec3_fmaf*(a: Vec3, f: Float, b: Vec3): Vec3 {.importc: "vec3_fmaf", header: "sol.h".}
+proc vec3_madd*(a, b: Vec3, f: Float): Vec3 {.importc: "vec3_madd", header: "sol.h".}
+proc vec3_lerp*(a, b: Vec3, t: Float): Vec3 {.importc: "vec3_lerp", header: "sol.h".}
+
+proc vec3_floor*(v: Vec3): Vec3 {.importc: "vec3_floor", header: "sol.h".}
+proc vec3_ceil*(v: Vec3): Vec3 {.importc: "vec3_ceil", header: "sol.h".}
+proc vec3_round*(v: Vec3): Vec3 {.importc: "vec3_round", header: "sol.h".}
+
 proc vec3_print*(v: Vec3): void {.importc: "vec3_print", header: "sol.h".}
 
+proc vec3_load*(p: ptr Vec3p): Vec3 {.importc: "vec3_load", header: "sol.h".}
+proc vec3_store*(p: ptr Vec3p; v: Vec3): void {.importc: "vec3_store", header: "sol.h".}
+proc vec3_load_array*(output: ptr Vec3; input: ptr Vec3p; n: csize): void {.importc: "vec3_load_array", header: "sol.h".}
+proc vec3_store_array*(output: ptr Vec3p; input: ptr Vec3; n: csize): void {.importc: "vec3_store_array", header: "sol.h".}
+
+proc vec3_add_array*(output, a, b: ptr Vec3p; n: csize): void {.importc: "vec3_add_array", header: "sol.h".}
+proc vec3_sub_array*(output, a, b: ptr Vec3p; n: csize): void {.importc: "vec3_sub_array", header: "sol.h".}
+proc vec3_mul_array*(output, a, b: ptr Vec3p; n: csize): void {.importc: "vec3_mul_array", header: "sol.h".}
+proc vec3_div_array*(output, a, b: ptr Vec3p; n: csize): void {.importc: "vec3_div_array", header: "sol.h".}
+proc vec3_mulf_array*(output, v: ptr Vec3p; f: Float; n: csize): void {.importc: "vec3_mulf_array", header: "sol.h".}
+proc vec3_axpy_array*(output, x: ptr Vec3p; f: Float; y: ptr Vec3p; n: csize): void {.importc: "vec3_axpy_array", header: "sol.h".}
+
+proc vec3x4_load*(p: ptr Vec3p): Vec3x4 {.importc: "vec3x4_load", header: "sol.h".}
+proc vec3x8_load*(p: ptr Vec3p): Vec3x8 {.importc: "vec3x8_load", header: "sol.h".}
+proc vec3_dot4*(a: Vec3; b: ptr Vec3x4): Vec4 {.importc: "vec3_dot4", header: "sol.h".}
+proc vec3_dot8*(output: ptr Float; a: Vec3; b: ptr Vec3x8): void {.importc: "vec3_dot8", header: "sol.h".}
+proc vec3_dot_array*(output: ptr Float; a: Vec3; b: ptr Vec3p; n: csize): void {.importc: "vec3_dot_array", header: "sol.h".}
+proc vec3_dot_arrays*(output: ptr Float; a, b: ptr Vec3p; n: csize): void {.importc: "vec3_dot_arrays", header: "sol.h".}
+
 ################################################################################
 # Vec4 Functions ###############################################################
 ################################################################################
@@ -163,6 +360,7 @@ proc vec4_zero*(): Vec4 {.importc: "vec4_zero", header: "sol.h".}
 
 proc vec4_norm*(v: Vec4): Vec4 {.importc: "vec4_norm", header: "sol.h".}
 proc vec4_mag*(v: Vec4): Float {.importc: "vec4_mag", header: "sol.h".}
+proc vec4_dot*(a, b: Vec4): Float {.importc: "vec4_dot", header: "sol.h".}
 
 proc vec4_sum*(v: Vec4): Float {.importc: "vec4_sum", header: "sol.h".}
 proc vec4_add*(a, b: Vec4): Vec4 {.importc: "vec4_add", header: "sol.h".}
@@ -178,8 +376,415 @@ proc vec4_fdiv*(f: Float; v: Vec4): Vec4 {.importc: "vec4_fdiv", header: "sol.h"
 proc vec4_avg*(a, b: Vec4): Vec4 {.importc: "vec4_avg", header: "sol.h".}
 proc vec4_avgf*(v: Vec4, f: Float): Vec4 {.importc: "vec4_avgf", header: "sol.h".}
 
+proc vec4_fma*(a, b, c: Vec4): Vec4 {.importc: "vec4_fma", header: "sol.h".}
+proc vec4_fmaf*(a: Vec4, f: Float, b: Vec4): Vec4 {.importc: "vec4_fmaf", header: "sol.h".}
+proc vec4_madd*(a, b: Vec4, f: Float): Vec4 {.importc: "vec4_madd", header: "sol.h".}
+proc vec4_lerp*(a, b: Vec4, t: Float): Vec4 {.importc: "vec4_lerp", header: "sol.h".}
+
+proc vec4_floor*(v: Vec4): Vec4 {.importc: "vec4_floor", header: "sol.h".}
+proc vec4_ceil*(v: Vec4): Vec4 {.importc: "vec4_ceil", header: "sol.h".}
+proc vec4_round*(v: Vec4): Vec4 {.importc: "vec4_round", header: "sol.h".}
+
 proc vec4_print*(v: Vec4): void {.importc: "vec4_print", header: "sol.h".}
 
+################################################################################
+# VecN Functions ###############################################################
+################################################################################
+
+proc vecn_alloc*(len: csize): ptr VecN {.importc: "vecn_alloc", header: "sol.h".}
+proc vecn_init*(f: ptr Float; len: csize): ptr VecN {.importc: "vecn_init", header: "sol.h".}
+proc vecn_free*(v: ptr VecN): void {.importc: "vecn_free", header: "sol.h".}
+
+proc vecn_add*(output, a, b: ptr VecN): void {.importc: "vecn_add", header: "sol.h".}
+proc vecn_mulf*(output, v: ptr VecN; f: Float): void {.importc: "vecn_mulf", header: "sol.h".}
+proc vecn_axpy*(output, x: ptr VecN; f: Float; y: ptr VecN): void {.importc: "vecn_axpy", header: "sol.h".}
+proc vecn_dot*(a, b: ptr VecN): Float {.importc: "vecn_dot", header: "sol.h".}
+proc vecn_mag*(v: ptr VecN): Float {.importc: "vecn_mag", header: "sol.h".}
+proc vecn_norm*(output, v: ptr VecN): void {.importc: "vecn_norm", header: "sol.h".}
+proc vecn_dist*(a, b: ptr VecN): Float {.importc: "vecn_dist", header: "sol.h".}
+proc vecn_cos*(a, b: ptr VecN): Float {.importc: "vecn_cos", header: "sol.h".}
+
+proc vecn_dist_array*(output: ptr Float; q: ptr VecN; v: ptr ptr VecN; n: csize): void {.importc: "vecn_dist_array", header: "sol.h".}
+proc vecn_knn_l2*(idx: ptr csize; dist: ptr Float; k: csize; q: ptr ptr VecN; nq: csize; db: ptr ptr VecN; n: csize): bool {.importc: "vecn_knn_l2", header: "sol.h".}
+proc vecn_knn_ip*(idx: ptr csize; score: ptr Float; k: csize; q: ptr ptr VecN; nq: csize; db: ptr ptr VecN; n: csize): bool {.importc: "vecn_knn_ip", header: "sol.h".}
+
+################################################################################
+# Double Family Functions ######################################################
+################################################################################
+
+proc fltd_clamp*(f, lower, upper: Floatd): Floatd {.importc: "fltd_clamp", header: "sol.h".}
+proc fltd_pow*(a, b: Floatd): Floatd {.importc: "fltd_pow", header: "sol.h".}
+proc fltd_exp*(f: Floatd): Floatd {.importc: "fltd_exp", header: "sol.h".}
+proc fltd_sqrt*(f: Floatd): Floatd {.importc: "fltd_sqrt", header: "sol.h".}
+proc fltd_sin*(f: Floatd): Floatd {.importc: "fltd_sin", header: "sol.h".}
+proc fltd_cos*(f: Floatd): Floatd {.importc: "fltd_cos", header: "sol.h".}
+proc fltd_acos*(f: Floatd): Floatd {.importc: "fltd_acos", header: "sol.h".}
+proc fltd_abs*(f: Floatd): Floatd {.importc: "fltd_abs", header: "sol.h".}
+proc fltd_floor*(f: Floatd): Floatd {.importc: "fltd_floor", header: "sol.h".}
+proc fltd_ceil*(f: Floatd): Floatd {.importc: "fltd_ceil", header: "sol.h".}
+proc fltd_round*(f: Floatd): Floatd {.importc: "fltd_round", header: "sol.h".}
+proc fltd_fma*(a, b, c: Floatd): Floatd {.importc: "fltd_fma", header: "sol.h".}
+
+proc cvd_axis_quat*(axis: Vec4d): Vec4d {.importc: "cvd_axis_quat", header: "sol.h".}
+proc cvd_quat_axis*(quat: Vec4d): Vec4d {.importc: "cvd_quat_axis", header: "sol.h".}
+
+proc cvd_vec3_vec2*(v: Vec3d): Vec2d {.importc: "cvd_vec3_vec2", header: "sol.h".}
+proc cvd_vec4_vec2*(v: Vec4d): Vec2d {.importc: "cvd_vec4_vec2", header: "sol.h".}
+proc cvd_vec2_vec3*(v: Vec2d; z: Floatd): Vec3d {.importc: "cvd_vec2_vec3", header: "sol.h".}
+proc cvd_vec4_vec3*(v: Vec4d): Vec3d {.importc: "cvd_vec4_vec3", header: "sol.h".}
+proc cvd_vec2_vec4*(v: Vec2d; z, w: Floatd): Vec4d {.importc: "cvd_vec2_vec4", header: "sol.h".}
+proc cvd_vec3_vec4*(v: Vec3d; w: Floatd): Vec4d {.importc: "cvd_vec3_vec4", header: "sol.h".}
+
+proc cvd_deg_rad*(deg: Floatd): Floatd {.importc: "cvd_deg_rad", header: "sol.h".}
+proc cvd_rad_deg*(rad: Floatd): Floatd {.importc: "cvd_rad_deg", header: "sol.h".}
+
+proc cvd_flt_half*(f: Floatd): uint16 {.importc: "cvd_flt_half", header: "sol.h".}
+proc cvd_half_flt*(h: uint16): Floatd {.importc: "cvd_half_flt", header: "sol.h".}
+
+proc vec2d_init*(x, y: Floatd): Vec2d {.importc: "vec2d_init", header: "sol.h".}
+proc vec2d_initf*(f: Floatd): Vec2d {.importc: "vec2d_initf", header: "sol.h".}
+proc vec2d_zero*(): Vec2d {.importc: "vec2d_zero", header: "sol.h".}
+
+proc vec2d_norm*(v: Vec2d): Vec2d {.importc: "vec2d_norm", header: "sol.h".}
+proc vec2d_mag*(v: Vec2d): Floatd {.importc: "vec2d_mag", header: "sol.h".}
+
+proc vec2d_rot*(v: Vec2d, rad: Floatd): Vec2d {.importc: "vec2d_rot", header: "sol.h".}
+
+proc vec2d_cross*(a, b: Vec2d): Floatd {.importc: "vec2d_cross", header: "sol.h".}
+proc vec2d_dot*(a, b: Vec2d): Floatd {.importc: "vec2d_dot", header: "sol.h".}
+
+proc vec2d_sum*(v: Vec2d): Floatd {.importc: "vec2d_sum", header: "sol.h".}
+proc vec2d_add*(a, b: Vec2d): Vec2d {.importc: "vec2d_add", header: "sol.h".}
+proc vec2d_addf*(v: Vec2d, f: Floatd): Vec2d {.importc: "vec2d_addf", header: "sol.h".}
+proc vec2d_sub*(a, b: Vec2d): Vec2d {.importc: "vec2d_sub", header: "sol.h".}
+proc vec2d_subf*(v: Vec2d, f: Floatd): Vec2d {.importc: "vec2d_subf", header: "sol.h".}
+proc vec2d_fsub*(f: Floatd, v: Vec2d): Vec2d {.importc: "vec2d_fsub", header: "sol.h".}
+proc vec2d_mul*(a, b: Vec2d): Vec2d {.importc: "vec2d_mul", header: "sol.h".}
+proc vec2d_mulf*(v: Vec2d, f: Floatd): Vec2d {.importc: "vec2d_mulf", header: "sol.h".}
+proc vec2d_div*(a, b: Vec2d): Vec2d {.importc: "vec2d_div", header: "sol.h".}
+proc vec2d_divf*(v: Vec2d, f: Floatd): Vec2d {.importc: "vec2d_divf", header: "sol.h".}
+proc vec2d_fdiv*(f: Floatd, v: Vec2d): Vec2d {.importc: "vec2d_fdiv", header: "sol.h".}
+proc vec2d_avg*(a, b: Vec2d): Vec2d {.importc: "vec2d_avg", header: "sol.h".}
+proc vec2d_avgf*(v: Vec2d, f: Floatd): Vec2d {.importc: "vec2d_avgf", header: "sol.h".}
+
+proc vec2d_fma*(a, b, c: Vec2d): Vec2d {.importc: "vec2d_fma", header: "sol.h".}
+proc vec2d_fmaf*(a: Vec2d, f: Floatd, b: Vec2d): Vec2d {.importc: "vec2d_fmaf", header: "sol.h".}
+proc vec2d_madd*(a, b: Vec2d, f: Floatd): Vec2d {.importc: "vec2d_madd", header: "sol.h".}
+proc vec2d_lerp*(a, b: Vec2d, t: Floatd): Vec2d {.importc: "vec2d_lerp", header: "sol.h".}
+
+proc vec2d_floor*(v: Vec2d): Vec2d {.importc: "vec2d_floor", header: "sol.h".}
+proc vec2d_ceil*(v: Vec2d): Vec2d {.importc: "vec2d_ceil", header: "sol.h".}
+proc vec2d_round*(v: Vec2d): Vec2d {.importc: "vec2d_round", header: "sol.h".}
+
+proc vec2d_print*(v: Vec2d): void {.importc: "vec2d_print", header: "sol.h".}
+
+proc vec3d_init*(x, y, z: Floatd): Vec3d {.importc: "vec3d_init", header: "sol.h".}
+proc vec3d_initf*(f: Floatd): Vec3d {.importc: "vec3d_initf", header: "sol.h".}
+proc vec3d_zero*(): Vec3d {.importc: "vec3d_zero", header: "sol.h".}
+
+proc vec3d_norm*(v: Vec3d): Vec3d {.importc: "vec3d_norm", header: "sol.h".}
+proc vec3d_mag*(v: Vec3d): Floatd {.importc: "vec3d_mag", header: "sol.h".}
+
+proc vec3d_rot*(v: Vec3d, q: Vec4d): Vec3d {.importc: "vec3d_rot", header: "sol.h".}
+
+proc vec3d_cross*(a, b: Vec3d): Vec3d {.importc: "vec3d_cross", header: "sol.h".}
+proc vec3d_dot*(a, b: Vec3d): Floatd {.importc: "vec3d_dot", header: "sol.h".}
+
+proc vec3d_sum*(v: Vec3d): Floatd {.importc: "vec3d_sum", header: "sol.h".}
+proc vec3d_add*(a, b: Vec3d): Vec3d {.importc: "vec3d_add", header: "sol.h".}
+proc vec3d_addf*(v: Vec3d, f: Floatd): Vec3d {.importc: "vec3d_addf", header: "sol.h".}
+proc vec3d_sub*(a, b: Vec3d): Vec3d {.importc: "vec3d_sub", header: "sol.h".}
+proc vec3d_subf*(v: Vec3d, f: Floatd): Vec3d {.importc: "vec3d_subf", header: "sol.h".}
+proc vec3d_fsub*(f: Floatd, v: Vec3d): Vec3d {.importc: "vec3d_fsub", header: "sol.h".}
+proc vec3d_mul*(a, b: Vec3d): Vec3d {.importc: "vec3d_mul", header: "sol.h".}
+proc vec3d_mulf*(v: Vec3d, f: Floatd): Vec3d {.importc: "vec3d_mulf", header: "sol.h".}
+proc vec3d_div*(a, b: Vec3d): Vec3d {.importc: "vec3d_div", header: "sol.h".}
+proc vec3d_divf*(v: Vec3d, f: Floatd): Vec3d {.importc: "vec3d_divf", header: "sol.h".}
+proc vec3d_fdiv*(f: Floatd, v: Vec3d): Vec3d {.importc: "vec3d_fdiv", header: "sol.h".}
+proc vec3d_avg*(a, b: Vec3d): Vec3d {.importc: "vec3d_avg", header: "sol.h".}
+proc vec3d_avgf*(v: Vec3d, f: Floatd): Vec3d {.importc: "vec3d_avgf", header: "sol.h".}
+
+proc vec3d_fma*(a, b, c: Vec3d): Vec3d {.importc: "vec3d_fma", header: "sol.h".}
+proc vec3d_fmaf*(a: Vec3d, f: Floatd, b: Vec3d): Vec3d {.importc: "vec3d_fmaf", header: "sol.h".}
+proc vec3d_madd*(a, b: Vec3d, f: Floatd): Vec3d {.importc: "vec3d_madd", header: "sol.h".}
+proc vec3d_lerp*(a, b: Vec3d, t: Floatd): Vec3d {.importc: "vec3d_lerp", header: "sol.h".}
+
+proc vec3d_floor*(v: Vec3d): Vec3d {.importc: "vec3d_floor", header: "sol.h".}
+proc vec3d_ceil*(v: Vec3d): Vec3d {.importc: "vec3d_ceil", header: "sol.h".}
+proc vec3d_round*(v: Vec3d): Vec3d {.importc: "vec3d_round", header: "sol.h".}
+
+proc vec3d_print*(v: Vec3d): void {.importc: "vec3d_print", header: "sol.h".}
+
+proc vec3d_load*(p: ptr Vec3pd): Vec3d {.importc: "vec3d_load", header: "sol.h".}
+proc vec3d_store*(p: ptr Vec3pd; v: Vec3d): void {.importc: "vec3d_store", header: "sol.h".}
+proc vec3d_load_array*(output: ptr Vec3d; input: ptr Vec3pd; n: csize): void {.importc: "vec3d_load_array", header: "sol.h".}
+proc vec3d_store_array*(output: ptr Vec3pd; input: ptr Vec3d; n: csize): void {.importc: "vec3d_store_array", header: "sol.h".}
+
+proc vec3d_add_array*(output, a, b: ptr Vec3pd; n: csize): void {.importc: "vec3d_add_array", header: "sol.h".}
+proc vec3d_sub_array*(output, a, b: ptr Vec3pd; n: csize): void {.importc: "vec3d_sub_array", header: "sol.h".}
+proc vec3d_mul_array*(output, a, b: ptr Vec3pd; n: csize): void {.importc: "vec3d_mul_array", header: "sol.h".}
+proc vec3d_div_array*(output, a, b: ptr Vec3pd; n: csize): void {.importc: "vec3d_div_array", header: "sol.h".}
+proc vec3d_mulf_array*(output, v: ptr Vec3pd; f: Floatd; n: csize): void {.importc: "vec3d_mulf_array", header: "sol.h".}
+proc vec3d_axpy_array*(output, x: ptr Vec3pd; f: Floatd; y: ptr Vec3pd; n: csize): void {.importc: "vec3d_axpy_array", header: "sol.h".}
+
+proc vec3x4d_load*(p: ptr Vec3pd): Vec3x4d {.importc: "vec3x4d_load", header: "sol.h".}
+proc vec3x8d_load*(p: ptr Vec3pd): Vec3x8d {.importc: "vec3x8d_load", header: "sol.h".}
+proc vec3d_dot4*(a: Vec3d; b: ptr Vec3x4d): Vec4d {.importc: "vec3d_dot4", header: "sol.h".}
+proc vec3d_dot8*(output: ptr Floatd; a: Vec3d; b: ptr Vec3x8d): void {.importc: "vec3d_dot8", header: "sol.h".}
+proc vec3d_dot_array*(output: ptr Floatd; a: Vec3d; b: ptr Vec3pd; n: csize): void {.importc: "vec3d_dot_array", header: "sol.h".}
+proc vec3d_dot_arrays*(output: ptr Floatd; a, b: ptr Vec3pd; n: csize): void {.importc: "vec3d_dot_arrays", header: "sol.h".}
+
+proc vec4d_init*(x, y, z, w: Floatd): Vec4d {.importc: "vec4d_init", header: "sol.h".}
+proc vec4d_initf*(f: Floatd): Vec4d {.importc: "vec4d_initf", header: "sol.h".}
+proc vec4d_zero*(): Vec4d {.importc: "vec4d_zero", header: "sol.h".}
+
+proc vec4d_norm*(v: Vec4d): Vec4d {.importc: "vec4d_norm", header: "sol.h".}
+proc vec4d_mag*(v: Vec4d): Floatd {.importc: "vec4d_mag", header: "sol.h".}
+proc vec4d_dot*(a, b: Vec4d): Floatd {.importc: "vec4d_dot", header: "sol.h".}
+
+proc vec4d_sum*(v: Vec4d): Floatd {.importc: "vec4d_sum", header: "sol.h".}
+proc vec4d_add*(a, b: Vec4d): Vec4d {.importc: "vec4d_add", header: "sol.h".}
+proc vec4d_addf*(v: Vec4d; f: Floatd): Vec4d {.importc: "vec4d_addf", header: "sol.h".}
+proc vec4d_sub*(a, b: Vec4d): Vec4d {.importc: "vec4d_sub", header: "sol.h".}
+proc vec4d_subf*(v: Vec4d; f: Floatd): Vec4d {.importc: "vec4d_subf", header: "sol.h".}
+proc vec4d_fsub*(f: Floatd; v: Vec4d): Vec4d {.importc: "vec4d_fsub", header: "sol.h".}
+proc vec4d_mul*(a, b: Vec4d): Vec4d {.importc: "vec4d_mul", header: "sol.h".}
+proc vec4d_mulf*(v: Vec4d; f: Floatd): Vec4d {.importc: "vec4d_mulf", header: "sol.h".}
+proc vec4d_div*(a, b: Vec4d): Vec4d {.importc: "vec4d_div", header: "sol.h".}
+proc vec4d_divf*(v: Vec4d; f: Floatd): Vec4d {.importc: "vec4d_divf", header: "sol.h".}
+proc vec4d_fdiv*(f: Floatd; v: Vec4d): Vec4d {.importc: "vec4d_fdiv", header: "sol.h".}
+proc vec4d_avg*(a, b: Vec4d): Vec4d {.importc: "vec4d_avg", header: "sol.h".}
+proc vec4d_avgf*(v: Vec4d, f: Floatd): Vec4d {.importc: "vec4d_avgf", header: "sol.h".}
+
+proc vec4d_fma*(a, b, c: Vec4d): Vec4d {.importc: "vec4d_fma", header: "sol.h".}
+proc vec4d_fmaf*(a: Vec4d, f: Floatd, b: Vec4d): Vec4d {.importc: "vec4d_fmaf", header: "sol.h".}
+proc vec4d_madd*(a, b: Vec4d, f: Floatd): Vec4d {.importc: "vec4d_madd", header: "sol.h".}
+proc vec4d_lerp*(a, b: Vec4d, t: Floatd): Vec4d {.importc: "vec4d_lerp", header: "sol.h".}
+
+proc vec4d_floor*(v: Vec4d): Vec4d {.importc: "vec4d_floor", header: "sol.h".}
+proc vec4d_ceil*(v: Vec4d): Vec4d {.importc: "vec4d_ceil", header: "sol.h".}
+proc vec4d_round*(v: Vec4d): Vec4d {.importc: "vec4d_round", header: "sol.h".}
+
+proc vec4d_print*(v: Vec4d): void {.importc: "vec4d_print", header: "sol.h".}
+
+proc vecnd_alloc*(len: csize): ptr VecNd {.importc: "vecnd_alloc", header: "sol.h".}
+proc vecnd_init*(f: ptr Floatd; len: csize): ptr VecNd {.importc: "vecnd_init", header: "sol.h".}
+proc vecnd_free*(v: ptr VecNd): void {.importc: "vecnd_free", header: "sol.h".}
+
+proc vecnd_add*(output, a, b: ptr VecNd): void {.importc: "vecnd_add", header: "sol.h".}
+proc vecnd_mulf*(output, v: ptr VecNd; f: Floatd): void {.importc: "vecnd_mulf", header: "sol.h".}
+proc vecnd_axpy*(output, x: ptr VecNd; f: Floatd; y: ptr VecNd): void {.importc: "vecnd_axpy", header: "sol.h".}
+proc vecnd_dot*(a, b: ptr VecNd): Floatd {.importc: "vecnd_dot", header: "sol.h".}
+proc vecnd_mag*(v: ptr VecNd): Floatd {.importc: "vecnd_mag", header: "sol.h".}
+proc vecnd_norm*(output, v: ptr VecNd): void {.importc: "vecnd_norm", header: "sol.h".}
+proc vecnd_dist*(a, b: ptr VecNd): Floatd {.importc: "vecnd_dist", header: "sol.h".}
+proc vecnd_cos*(a, b: ptr VecNd): Floatd {.importc: "vecnd_cos", header: "sol.h".}
+
+proc vecnd_dist_array*(output: ptr Floatd; q: ptr VecNd; v: ptr ptr VecNd; n: csize): void {.importc: "vecnd_dist_array", header: "sol.h".}
+proc vecnd_knn_l2*(idx: ptr csize; dist: ptr Floatd; k: csize; q: ptr ptr VecNd; nq: csize; db: ptr ptr VecNd; n: csize): void {.importc: "vecnd_knn_l2", header: "sol.h".}
+proc vecnd_knn_ip*(idx: ptr csize; score: ptr Floatd; k: csize; q: ptr ptr VecNd; nq: csize; db: ptr ptr VecNd; n: csize): void {.importc: "vecnd_knn_ip", header: "sol.h".}
+
+################################################################################
+# Parallel Functions ###########################################################
+################################################################################
+
+proc sol_parallel_for*(n, size: csize; fn: SolFor; ctx: pointer): void {.importc: "sol_parallel_for", header: "sol.h".}
+
+proc sol_graph_init*(): ptr SolGraph {.importc: "sol_graph_init", header: "sol.h".}
+proc sol_graph_free*(g: ptr SolGraph): void {.importc: "sol_graph_free", header: "sol.h".}
+proc sol_graph_add*(g: ptr SolGraph; n, size: csize; fn: SolFor; ctx: pointer): csize {.importc: "sol_graph_add", header: "sol.h".}
+proc sol_graph_after*(g: ptr SolGraph; node, dep: csize): bool {.importc: "sol_graph_after", header: "sol.h".}
+proc sol_graph_run*(g: ptr SolGraph): void {.importc: "sol_graph_run", header: "sol.h".}
+
+proc sol_set_threads*(n: csize): void {.importc: "sol_set_threads", header: "sol.h".}
+proc sol_get_threads*(): csize {.importc: "sol_get_threads", header: "sol.h".}
+proc sol_set_threshold*(bytes: csize): void {.importc: "sol_set_threshold", header: "sol.h".}
+proc sol_get_threshold*(): csize {.importc: "sol_get_threshold", header: "sol.h".}
+proc sol_set_chunk*(bytes: csize): void {.importc: "sol_set_chunk", header: "sol.h".}
+proc sol_get_chunk*(): csize {.importc: "sol_get_chunk", header: "sol.h".}
+
+################################################################################
+# Packed Storage Functions #####################################################
+################################################################################
+
+proc vec3h_encode*(v: Vec3): Vec3h {.importc: "vec3h_encode", header: "sol.h".}
+proc vec3h_decode*(h: Vec3h): Vec3 {.importc: "vec3h_decode", header: "sol.h".}
+proc vec4h_encode*(v: Vec4): Vec4h {.importc: "vec4h_encode", header: "sol.h".}
+proc vec4h_decode*(h: Vec4h): Vec4 {.importc: "vec4h_decode", header: "sol.h".}
+proc vec3s_encode*(v: Vec3): Vec3s {.importc: "vec3s_encode", header: "sol.h".}
+proc vec3s_decode*(s: Vec3s): Vec3 {.importc: "vec3s_decode", header: "sol.h".}
+proc vec4s_encode*(v: Vec4): Vec4s {.importc: "vec4s_encode", header: "sol.h".}
+proc vec4s_decode*(s: Vec4s): Vec4 {.importc: "vec4s_decode", header: "sol.h".}
+proc vec3u_encode*(v: Vec3): Vec3u {.importc: "vec3u_encode", header: "sol.h".}
+proc vec3u_decode*(u: Vec3u): Vec3 {.importc: "vec3u_decode", header: "sol.h".}
+proc vec4u_encode*(v: Vec4): Vec4u {.importc: "vec4u_encode", header: "sol.h".}
+proc vec4u_decode*(u: Vec4u): Vec4 {.importc: "vec4u_decode", header: "sol.h".}
+proc oct3_encode*(n: Vec3): Oct3 {.importc: "oct3_encode", header: "sol.h".}
+proc oct3_decode*(o: Oct3): Vec3 {.importc: "oct3_decode", header: "sol.h".}
+
+proc vec3h_encode_array*(output: ptr Vec3h; input: Soa3; n: csize): void {.importc: "vec3h_encode_array", header: "sol.h".}
+proc vec3h_decode_array*(output: Soa3; input: ptr Vec3h; n: csize): void {.importc: "vec3h_decode_array", header: "sol.h".}
+proc vec4h_encode_array*(output: ptr Vec4h; input: Soa4; n: csize): void {.importc: "vec4h_encode_array", header: "sol.h".}
+proc vec4h_decode_array*(output: Soa4; input: ptr Vec4h; n: csize): void {.importc: "vec4h_decode_array", header: "sol.h".}
+proc vec3s_encode_array*(output: ptr Vec3s; input: Soa3; n: csize): void {.importc: "vec3s_encode_array", header: "sol.h".}
+proc vec3s_decode_array*(output: Soa3; input: ptr Vec3s; n: csize): void {.importc: "vec3s_decode_array", header: "sol.h".}
+proc vec4s_encode_array*(output: ptr Vec4s; input: Soa4; n: csize): void {.importc: "vec4s_encode_array", header: "sol.h".}
+proc vec4s_decode_array*(output: Soa4; input: ptr Vec4s; n: csize): void {.importc: "vec4s_decode_array", header: "sol.h".}
+proc vec3u_encode_array*(output: ptr Vec3u; input: Soa3; n: csize): void {.importc: "vec3u_encode_array", header: "sol.h".}
+proc vec3u_decode_array*(output: Soa3; input: ptr Vec3u; n: csize): void {.importc: "vec3u_decode_array", header: "sol.h".}
+proc vec4u_encode_array*(output: ptr Vec4u; input: Soa4; n: csize): void {.importc: "vec4u_encode_array", header: "sol.h".}
+proc vec4u_decode_array*(output: Soa4; input: ptr Vec4u; n: csize): void {.importc: "vec4u_decode_array", header: "sol.h".}
+proc oct3_encode_array*(output: ptr Oct3; input: Soa3; n: csize): void {.importc: "oct3_encode_array", header: "sol.h".}
+proc oct3_decode_array*(output: Soa3; input: ptr Oct3; n: csize): void {.importc: "oct3_decode_array", header: "sol.h".}
+
+################################################################################
+# Reduction Functions ##########################################################
+################################################################################
+
+proc flt_sum_array*(f: ptr Float; n: csize): Float {.importc: "flt_sum_array", header: "sol.h".}
+proc flt_sum_exact_array*(f: ptr Float; n: csize): Float {.importc: "flt_sum_exact_array", header: "sol.h".}
+proc flt_dot_array*(a, b: ptr Float; n: csize): Float {.importc: "flt_dot_array", header: "sol.h".}
+proc flt_dot_exact_array*(a, b: ptr Float; n: csize): Float {.importc: "flt_dot_exact_array", header: "sol.h".}
+proc flt_min_array*(f: ptr Float; n: csize): Float {.importc: "flt_min_array", header: "sol.h".}
+proc flt_max_array*(f: ptr Float; n: csize): Float {.importc: "flt_max_array", header: "sol.h".}
+
+proc vec3_sum_array*(v: ptr Vec3p; n: csize): Vec3 {.importc: "vec3_sum_array", header: "sol.h".}
+proc vec3_sum_exact_array*(v: ptr Vec3p; n: csize): Vec3 {.importc: "vec3_sum_exact_array", header: "sol.h".}
+proc vec3_mean_array*(v: ptr Vec3p; n: csize): Vec3 {.importc: "vec3_mean_array", header: "sol.h".}
+proc vec3_mean_exact_array*(v: ptr Vec3p; n: csize): Vec3 {.importc: "vec3_mean_exact_array", header: "sol.h".}
+proc vec3_dot_sum_array*(a, b: ptr Vec3p; n: csize): Float {.importc: "vec3_dot_sum_array", header: "sol.h".}
+proc vec3_dot_sum_exact_array*(a, b: ptr Vec3p; n: csize): Float {.importc: "vec3_dot_sum_exact_array", header: "sol.h".}
+proc vec3_cov_array*(v: ptr Vec3p; n: csize): Sym3 {.importc: "vec3_cov_array", header: "sol.h".}
+proc vec3_cov_exact_array*(v: ptr Vec3p; n: csize): Sym3 {.importc: "vec3_cov_exact_array", header: "sol.h".}
+proc vec3_min_array*(v: ptr Vec3p; n: csize): Vec3 {.importc: "vec3_min_array", header: "sol.h".}
+proc vec3_max_array*(v: ptr Vec3p; n: csize): Vec3 {.importc: "vec3_max_array", header: "sol.h".}
+proc vec3_bounds_array*(v: ptr Vec3p; n: csize): Box3 {.importc: "vec3_bounds_array", header: "sol.h".}
+
+################################################################################
+# Random Sampling Functions ####################################################
+################################################################################
+
+proc sol_rand_seed*(r: ptr SolRand; seed, stream: uint64): void {.importc: "sol_rand_seed", header: "sol.h".}
+
+proc flt_rand_array*(r: ptr SolRand; output: ptr Float; n: csize): void {.importc: "flt_rand_array", header: "sol.h".}
+proc vec2_rand_disk_array*(r: ptr SolRand; output: Soa2; n: csize): void {.importc: "vec2_rand_disk_array", header: "sol.h".}
+proc vec3_rand_box_array*(r: ptr SolRand; output: Soa3; box: Box3; n: csize): void {.importc: "vec3_rand_box_array", header: "sol.h".}
+proc vec3_rand_sphere_array*(r: ptr SolRand; output: Soa3; n: csize): void {.importc: "vec3_rand_sphere_array", header: "sol.h".}
+proc vec4_rand_quat_array*(r: ptr SolRand; output: Soa4; n: csize): void {.importc: "vec4_rand_quat_array", header: "sol.h".}
+
+################################################################################
+# Integration Functions ########################################################
+################################################################################
+
+proc vec3_euler_array*(pos, vel, acc: Soa3; n: csize; dt: Float; m: ptr SolMotion): void {.importc: "vec3_euler_array", header: "sol.h".}
+proc vec3_verlet_array*(pos, vel, acc: Soa3; n: csize; dt: Float; m: ptr SolMotion): void {.importc: "vec3_verlet_array", header: "sol.h".}
+proc vec3_rk4_array*(pos, vel, acc: Soa3; work: ptr Float; n: csize; dt: Float; m: ptr SolMotion): void {.importc: "vec3_rk4_array", header: "sol.h".}
+
+################################################################################
+# N-Body Functions #############################################################
+################################################################################
+
+proc vec3_gravity_direct_array*(acc, pos: Soa3; n: csize; grav: ptr SolGravity): void {.importc: "vec3_gravity_direct_array", header: "sol.h".}
+proc vec3_gravity_tree_array*(acc, pos: Soa3; n: csize; grav: ptr SolGravity): void {.importc: "vec3_gravity_tree_array", header: "sol.h".}
+proc vec3_gravity_field*(ctx: pointer; acc, pos, vel: Soa3; n: csize): void {.cdecl, importc: "vec3_gravity_field", header: "sol.h".}
+
+################################################################################
+# Noise Functions ##############################################################
+################################################################################
+
+proc noise2*(p: Vec2): Float {.importc: "noise2", header: "sol.h".}
+proc noise2_perlin*(p: Vec2): Float {.importc: "noise2_perlin", header: "sol.h".}
+proc noise2_fbm*(p: Vec2; octaves: csize; lacunarity, gain: Float): Float {.importc: "noise2_fbm", header: "sol.h".}
+proc noise3*(p: Vec3): Float {.importc: "noise3", header: "sol.h".}
+proc noise3_perlin*(p: Vec3): Float {.importc: "noise3_perlin", header: "sol.h".}
+proc noise3_fbm*(p: Vec3; octaves: csize; lacunarity, gain: Float): Float {.importc: "noise3_fbm", header: "sol.h".}
+
+proc noise2_array*(output: ptr Float; points: ptr Vec2; n: csize): void {.importc: "noise2_array", header: "sol.h".}
+proc noise2_perlin_array*(output: ptr Float; points: ptr Vec2; n: csize): void {.importc: "noise2_perlin_array", header: "sol.h".}
+proc noise2_fbm_array*(output: ptr Float; points: ptr Vec2; n, octaves: csize; lacunarity, gain: Float): void {.importc: "noise2_fbm_array", header: "sol.h".}
+proc noise3_array*(output: ptr Float; points: ptr Vec3p; n: csize): void {.importc: "noise3_array", header: "sol.h".}
+proc noise3_perlin_array*(output: ptr Float; points: ptr Vec3p; n: csize): void {.importc: "noise3_perlin_array", header: "sol.h".}
+proc noise3_fbm_array*(output: ptr Float; points: ptr Vec3p; n, octaves: csize; lacunarity, gain: Float): void {.importc: "noise3_fbm_array", header: "sol.h".}
+
+################################################################################
+# Broadphase Functions #########################################################
+################################################################################
+
+proc sol_sap_init*(): ptr SolSap {.importc: "sol_sap_init", header: "sol.h".}
+proc sol_sap_free*(s: ptr SolSap): void {.importc: "sol_sap_free", header: "sol.h".}
+proc sol_sap_update*(s: ptr SolSap; boxes: ptr Box3; n: csize): csize {.importc: "sol_sap_update", header: "sol.h".}
+proc sol_sap_pairs*(s: ptr SolSap): ptr SolPair {.importc: "sol_sap_pairs", header: "sol.h".}
+
+################################################################################
+# Collision Functions ##########################################################
+################################################################################
+
+proc vec3_support_array*(v: Soa3; n: csize; dir: Vec3): csize {.importc: "vec3_support_array", header: "sol.h".}
+
+proc sol_support_hull*(shape: pointer; dir: Vec3): Vec3 {.cdecl, importc: "sol_support_hull", header: "sol.h".}
+proc sol_support_sph3*(shape: pointer; dir: Vec3): Vec3 {.cdecl, importc: "sol_support_sph3", header: "sol.h".}
+proc sol_support_box3*(shape: pointer; dir: Vec3): Vec3 {.cdecl, importc: "sol_support_box3", header: "sol.h".}
+proc sol_support_seg3*(shape: pointer; dir: Vec3): Vec3 {.cdecl, importc: "sol_support_seg3", header: "sol.h".}
+
+proc sol_shape_hull*(h: ptr SolHull): SolShape {.importc: "sol_shape_hull", header: "sol.h".}
+proc sol_shape_sph3*(s: ptr Sph3): SolShape {.importc: "sol_shape_sph3", header: "sol.h".}
+proc sol_shape_box3*(b: ptr Box3): SolShape {.importc: "sol_shape_box3", header: "sol.h".}
+proc sol_shape_capsule*(s: ptr Seg3; radius: Float): SolShape {.importc: "sol_shape_capsule", header: "sol.h".}
+
+proc sol_gjk_intersect*(a, b: SolShape; cache: ptr SolSimplex): bool {.importc: "sol_gjk_intersect", header: "sol.h".}
+proc sol_gjk_distance*(c: ptr SolContact; a, b: SolShape; cache: ptr SolSimplex): bool {.importc: "sol_gjk_distance", header: "sol.h".}
+proc sol_gjk_penetration*(c: ptr SolContact; a, b: SolShape; cache: ptr SolSimplex): bool {.importc: "sol_gjk_penetration", header: "sol.h".}
+
+################################################################################
+# Convex Hull Functions ########################################################
+################################################################################
+
+proc vec2_hull_array*(idx: ptr csize; v: ptr Vec2; n: csize): csize {.importc: "vec2_hull_array", header: "sol.h".}
+proc vec3_hull_array*(idx: ptr csize; v: ptr Vec3p; n: csize): csize {.importc: "vec3_hull_array", header: "sol.h".}
+
+################################################################################
+# Mesh Functions ###############################################################
+################################################################################
+
+proc sol_mesh_init*(v: ptr Vec3p; idx: ptr uint32; n: csize): ptr SolMesh {.importc: "sol_mesh_init", header: "sol.h".}
+proc sol_mesh_free*(m: ptr SolMesh): void {.importc: "sol_mesh_free", header: "sol.h".}
+proc sol_mesh_raycast*(hit: ptr SolHit; m: ptr SolMesh; ray: Seg3): bool {.importc: "sol_mesh_raycast", header: "sol.h".}
+proc sol_mesh_occluded*(m: ptr SolMesh; ray: Seg3): bool {.importc: "sol_mesh_occluded", header: "sol.h".}
+proc sol_mesh_raycast_array*(hits: ptr SolHit; m: ptr SolMesh; rays: ptr Seg3; n: csize): void {.importc: "sol_mesh_raycast_array", header: "sol.h".}
+proc sol_mesh_distance*(tri: ptr csize; m: ptr SolMesh; p: Vec3): Float {.importc: "sol_mesh_distance", header: "sol.h".}
+proc sol_mesh_distance_array*(dist: ptr Float; tri: ptr csize; m: ptr SolMesh; p: ptr Vec3p; n: csize): void {.importc: "sol_mesh_distance_array", header: "sol.h".}
+
+proc vec3_closest_tri_array*(output, p, a, b, c: Soa3; n: csize): void {.importc: "vec3_closest_tri_array", header: "sol.h".}
+
+################################################################################
+# Voxel Functions ##############################################################
+################################################################################
+
+proc sol_voxels_init*(origin: Vec3; size: Float; nx, ny, nz: csize): ptr SolVoxels {.importc: "sol_voxels_init", header: "sol.h".}
+proc sol_voxels_free*(g: ptr SolVoxels): void {.importc: "sol_voxels_free", header: "sol.h".}
+proc sol_voxels_get*(g: ptr SolVoxels; x, y, z: csize): bool {.importc: "sol_voxels_get", header: "sol.h".}
+proc sol_voxelize*(g: ptr SolVoxels; v: ptr Vec3p; idx: ptr uint32; n: csize; solid: bool): bool {.importc: "sol_voxelize", header: "sol.h".}
+
+proc sol_field_init*(origin: Vec3; size: Float; nx, ny, nz: csize): ptr SolField {.importc: "sol_field_init", header: "sol.h".}
+proc sol_field_free*(f: ptr SolField): void {.importc: "sol_field_free", header: "sol.h".}
+proc sol_field_mesh*(f: ptr SolField; v: ptr Vec3p; idx: ptr uint32; n: csize; band: csize): bool {.importc: "sol_field_mesh", header: "sol.h".}
+proc sol_field_points*(f: ptr SolField; p: ptr Vec3p; n: csize): bool {.importc: "sol_field_points", header: "sol.h".}
+proc sol_field_sample_array*(d: ptr Float; grad: ptr Vec3p; f: ptr SolField; p: ptr Vec3p; n: csize): void {.importc: "sol_field_sample_array", header: "sol.h".}
+
+proc vec3_voxel_mean_array*(output: ptr Vec3p; v: ptr Vec3p; n: csize; size: Float): csize {.importc: "vec3_voxel_mean_array", header: "sol.h".}
+proc vec3_voxel_first_array*(idx: ptr csize; v: ptr Vec3p; n: csize; size: Float): csize {.importc: "vec3_voxel_first_array", header: "sol.h".}
+proc vec3_voxel_nearest_array*(idx: ptr csize; v: ptr Vec3p; n: csize; size: Float): csize {.importc: "vec3_voxel_nearest_array", header: "sol.h".}
+
+################################################################################
+# Eigen Functions ##############################################################
+################################################################################
+
+proc sym3_eigen*(vec: ptr Vec3; m: Sym3): Vec3 {.importc: "sym3_eigen", header: "sol.h".}
+proc sym3_eigen_array*(val, vec0, vec1, vec2: Soa3; m: SoaSym3; n: csize): void {.importc: "sym3_eigen_array", header: "sol.h".}
+
+proc vec3_cov_knn_array*(cov: SoaSym3; v: ptr Vec3p; idx: ptr csize; k, n: csize): void {.importc: "vec3_cov_knn_array", header: "sol.h".}
+proc vec3_normal_array*(normal: Soa3; curv: ptr Float; v: ptr Vec3p; idx: ptr csize; k, n: csize; view: Vec3): void {.importc: "vec3_normal_array", header: "sol.h".}
+
 #########################
 # Vec2 Initializer Meta #
 #########################
@@ -461,3 +1066,255 @@ proc `/`*(v: Vec4; f: Float): Vec4 {.inline.} =
 
 proc `/`*(f: Float; v: Vec4): Vec4 {.inline.} =
     return vec4_fdiv(f, v)
+
+#######################
+# Vec2d Advanced Meta #
+#######################
+
+proc norm*(v: Vec2d): Vec2d {.inline.} =
+    return vec2d_norm(v)
+
+proc mag*(v: Vec2d): Floatd {.inline.} =
+    return vec2d_mag(v)
+
+proc rot*(v: Vec2d; rad: Floatd): Vec2d {.inline.} =
+    return vec2d_rot(v, rad)
+
+proc `cross`*(a, b: Vec2d): Floatd {.inline.} =
+    return vec2d_cross(a, b)
+
+proc `dot`*(a, b: Vec2d): Floatd {.inline.} =
+    return vec2d_dot(a, b)
+
+##################
+# Vec2d Op= Meta #
+##################
+
+proc `+=`*(a: var Vec2d; b: Vec2d) {.inline.} =
+    a = vec2d_add(a, b)
+
+proc `+=`*(v: var Vec2d; f: Floatd) {.inline.} =
+    v = vec2d_addf(v, f)
+
+proc `-=`*(a: var Vec2d; b: Vec2d) {.inline.} =
+    a = vec2d_sub(a, b)
+
+proc `-=`*(v: var Vec2d; f: Floatd) {.inline.} =
+    v = vec2d_subf(v, f)
+
+proc `*=`*(a: var Vec2d; b: Vec2d) {.inline.} =
+    a = vec2d_mul(a, b)
+
+proc `*=`*(v: var Vec2d; f: Floatd) {.inline.} =
+    v = vec2d_mulf(v, f)
+
+proc `/=`*(a: var Vec2d; b: Vec2d) {.inline.} =
+    a = vec2d_div(a, b)
+
+proc `/=`*(v: var Vec2d; f: Floatd) {.inline.} =
+    v = vec2d_divf(v, f)
+
+####################
+# Vec2d Basic Meta #
+####################
+
+proc `+`*(a, b: Vec2d): Vec2d {.inline.} =
+    return vec2d_add(a, b)
+
+proc `+`*(v: Vec2d; f: Floatd): Vec2d {.inline.} =
+    return vec2d_addf(v, f)
+
+proc `+`*(f: Floatd; v: Vec2d): Vec2d {.inline.} =
+    return vec2d_addf(v, f)
+
+proc `-`*(a, b: Vec2d): Vec2d {.inline.} =
+    return vec2d_sub(a, b)
+
+proc `-`*(v: Vec2d; f: Floatd): Vec2d {.inline.} =
+    return vec2d_subf(v, f)
+
+proc `-`*(f: Floatd; v: Vec2d): Vec2d {.inline.} =
+    return vec2d_fsub(f, v)
+
+proc `*`*(a, b: Vec2d): Vec2d {.inline.} =
+    return vec2d_mul(a, b)
+
+proc `*`*(v: Vec2d; f: Floatd): Vec2d {.inline.} =
+    return vec2d_mulf(v, f)
+
+proc `*`*(f: Floatd; v: Vec2d): Vec2d {.inline.} =
+    return vec2d_mulf(v, f)
+
+proc `/`*(a, b: Vec2d): Vec2d {.inline.} =
+    return vec2d_div(a, b)
+
+proc `/`*(v: Vec2d; f: Floatd): Vec2d {.inline.} =
+    return vec2d_divf(v, f)
+
+proc `/`*(f: Floatd, v: Vec2d): Vec2d {.inline.} =
+    return vec2d_fdiv(f, v)
+
+#######################
+# Vec3d Advanced Meta #
+#######################
+
+proc norm*(v: Vec3d): Vec3d {.inline.} =
+    return vec3d_norm(v)
+
+proc mag*(v: Vec3d): Floatd {.inline.} =
+    return vec3d_mag(v)
+
+proc rot*(v: Vec3d; q: Vec4d): Vec3d {.inline.} =
+    return vec3d_rot(v, q)
+
+proc `cross`*(a, b: Vec3d): Vec3d {.inline.} =
+    return vec3d_cross(a, b)
+
+proc `dot`*(a, b: Vec3d): Floatd {.inline.} =
+    return vec3d_dot(a, b)
+
+##################
+# Vec3d Op= Meta #
+##################
+
+proc `+=`*(a: var Vec3d; b: Vec3d) {.inline.} =
+    a = vec3d_add(a, b)
+
+proc `+=`*(v: var Vec3d; f: Floatd) {.inline.} =
+    v = vec3d_addf(v, f)
+
+proc `-=`*(a: var Vec3d; b: Vec3d) {.inline.} =
+    a = vec3d_sub(a, b)
+
+proc `-=`*(v: var Vec3d; f: Floatd) {.inline.} =
+    v = vec3d_subf(v, f)
+
+proc `*=`*(a: var Vec3d; b: Vec3d) {.inline.} =
+    a = vec3d_mul(a, b)
+
+proc `*=`*(v: var Vec3d; f: Floatd) {.inline.} =
+    v = vec3d_mulf(v, f)
+
+proc `/=`*(a: var Vec3d; b: Vec3d) {.inline.} =
+    a = vec3d_div(a, b)
+
+proc `/=`*(v: var Vec3d; f: Floatd) {.inline.} =
+    v = vec3d_divf(v, f)
+
+####################
+# Vec3d Basic Meta #
+####################
+
+proc `+`*(a, b: Vec3d): Vec3d {.inline.} =
+    return vec3d_add(a, b)
+
+proc `+`*(v: Vec3d; f: Floatd): Vec3d {.inline.} =
+    return vec3d_addf(v, f)
+
+proc `+`*(f: Floatd, v: Vec3d): Vec3d {.inline.} =
+    return vec3d_addf(v, f)
+
+proc `-`*(a, b: Vec3d): Vec3d {.inline.} =
+    return vec3d_sub(a, b)
+
+proc `-`*(v: Vec3d; f: Floatd): Vec3d {.inline.} =
+    return vec3d_subf(v, f)
+
+proc `-`*(f: Floatd; v: Vec3d): Vec3d {.inline.} =
+    return vec3d_fsub(f, v)
+
+proc `*`*(a, b: Vec3d): Vec3d {.inline.} =
+    return vec3d_mul(a, b)
+
+proc `*`*(v: Vec3d; f: Floatd): Vec3d {.inline.} =
+    return vec3d_mulf(v, f)
+
+proc `*`*(f: Floatd; v: Vec3d): Vec3d {.inline.} =
+    return vec3d_mulf(v, f)
+
+proc `/`*(a, b: Vec3d): Vec3d {.inline.} =
+    return vec3d_div(a, b)
+
+proc `/`*(v: Vec3d; f: Floatd): Vec3d {.inline.} =
+    return vec3d_divf(v, f)
+
+proc `/`*(f: Floatd; v: Vec3d): Vec3d {.inline.} =
+    return vec3d_fdiv(f, v)
+
+#######################
+# Vec4d Advanced Meta #
+#######################
+
+proc norm*(v: Vec4d): Vec4d {.inline.} =
+    return vec4d_norm(v)
+
+proc mag*(v: Vec4d): Floatd {.inline.} =
+    return vec4d_mag(v)
+
+##################
+# Vec4d Op= Meta #
+##################
+
+proc `+=`*(a: var Vec4d; b: Vec4d) {.inline.} =
+    a = vec4d_add(a, b)
+
+proc `+=`*(v: var Vec4d; f: Floatd) {.inline.} =
+    v = vec4d_addf(v, f)
+
+proc `-=`*(a: var Vec4d; b: Vec4d) {.inline.} =
+    a = vec4d_sub(a, b)
+
+proc `-=`*(v: var Vec4d; f: Floatd) {.inline.} =
+    v = vec4d_subf(v, f)
+
+proc `*=`*(a: var Vec4d; b: Vec4d) {.inline.} =
+    a = vec4d_mul(a, b)
+
+proc `*=`*(v: var Vec4d; f: Floatd) {.inline.} =
+    v = vec4d_mulf(v, f)
+
+proc `/=`*(a: var Vec4d; b: Vec4d) {.inline.} =
+    a = vec4d_div(a, b)
+
+proc `/=`*(v: var Vec4d; f: Floatd) {.inline.} =
+    v = vec4d_divf(v, f)
+
+####################
+# Vec4d Basic Meta #
+####################
+
+proc `+`*(a, b: Vec4d): Vec4d {.inline.} =
+    return vec4d_add(a, b)
+
+proc `+`*(v: Vec4d; f: Floatd): Vec4d {.inline.} =
+    return vec4d_addf(v, f)
+
+proc `+`*(f: Floatd; v: Vec4d): Vec4d {.inline.} =
+    return vec4d_addf(v, f)
+
+proc `-`*(a, b: Vec4d): Vec4d {.inline.} =
+    return vec4d_sub(a, b)
+
+proc `-`*(v: Vec4d; f: Floatd): Vec4d {.inline.} =
+    return vec4d_subf(v, f)
+
+proc `-`*(f: Floatd; v: Vec4d): Vec4d {.inline.} =
+    return vec4d_fsub(f, v)
+
+proc `*`*(a, b: Vec4d): Vec4d {.inline.} =
+    return vec4d_mul(a, b)
+
+proc `*`*(v: Vec4d; f: Floatd): Vec4d {.inline.} =
+    return vec4d_mulf(v, f)
+
+proc `*`*(f: Floatd; v: Vec4d): Vec4d {.inline.} =
+    return vec4d_mulf(v, f)
+
+proc `/`*(a, b: Vec4d): Vec4d {.inline.} =
+    return vec4d_div(a, b)
+
+proc `/`*(v: Vec4d; f: Floatd): Vec4d {.inline.} =
+    return vec4d_divf(v, f)
+
+proc `/`*(f: Floatd; v: Vec4d): Vec4d {.inline.} =
+    return vec4d_fdiv(f, v)
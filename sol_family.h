@@ -0,0 +1,713 @@
+    /////////////////////////////////////////////////////////////////
+   // sol_family.h /////////////////////////////////////////////////
+  // Description: Float width dependent parts of Sol. /////////////
+ // Author: David Garland (https://github.com/davidgarland/sol) //
+/////////////////////////////////////////////////////////////////
+
+// sol.h includes this header once per float family. Each inclusion selects
+// the SIMD flags and name suffix for the current SOL_F_SIZE, and the first
+// inclusion for a given size declares that family's types and functions.
+// Names are written unsuffixed and mapped through SOL_T/SOL_FN, so "Vec3"
+// declares Vec3f for SOL_F_SIZE 32 and Vec3d for SOL_F_SIZE 64. Outside of
+// a family pass the unsuffixed names refer to the configured default.
+
+#ifdef SOL_H
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Family Selection //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// SOL_SSE_32 and SOL_SSE_64 mark the float and double families on x86;
+// SOL_SSE_64 only covers Vec2 (__m128d), while SOL_AVX_64 additionally gives
+// Vec3 and Vec4 a __m256d. SOL_SSE_32 is set on the AVX tier as well, since
+// the float family uses __m128 there too.
+
+#undef SOL_SUFFIX
+#undef SOL_SSE_32
+#undef SOL_SSE_64
+#undef SOL_AVX_64
+#undef SOL_NEON_64
+
+#if SOL_F_SIZE > 64
+      #define SOL_SUFFIX l
+#elif SOL_F_SIZE > 32
+      #define SOL_SUFFIX d
+      #if defined(SOL_SSE)
+            #define SOL_SSE_64
+            #if defined(SOL_AVX)
+                  #define SOL_AVX_64
+            #endif
+      #elif defined(SOL_NEON)
+            #define SOL_NEON_64
+      #endif
+#else
+      #define SOL_SUFFIX f
+      #if defined(SOL_SSE)
+            #define SOL_SSE_32
+      #endif
+#endif
+
+#if SOL_F_SIZE > 64
+      #if !defined(SOL_FAMILY_80)
+            #define SOL_FAMILY_80
+            #define SOL_FAMILY_DECLARE
+      #endif
+#elif SOL_F_SIZE > 32
+      #if !defined(SOL_FAMILY_64)
+            #define SOL_FAMILY_64
+            #define SOL_FAMILY_DECLARE
+      #endif
+#else
+      #if !defined(SOL_FAMILY_32)
+            #define SOL_FAMILY_32
+            #define SOL_FAMILY_DECLARE
+      #endif
+#endif
+
+#ifdef SOL_FAMILY_DECLARE
+#undef SOL_FAMILY_DECLARE
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Family Names //////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef SOL_FAMILY_NAMES
+#define SOL_FAMILY_NAMES
+
+// Types
+
+#define Float SOL_T(Float)
+#define Vec2 SOL_T(Vec2)
+#define Vec3 SOL_T(Vec3)
+#define Vec3p SOL_T(Vec3p)
+#define Vec3x4 SOL_T(Vec3x4)
+#define Vec3x8 SOL_T(Vec3x8)
+#define Vec4 SOL_T(Vec4)
+#define VecN SOL_T(VecN)
+#define Seg2 SOL_T(Seg2)
+#define Seg3 SOL_T(Seg3)
+#define Box2 SOL_T(Box2)
+#define Box3 SOL_T(Box3)
+#define Sph2 SOL_T(Sph2)
+#define Sph3 SOL_T(Sph3)
+#define type_vec3 SOL_T(type_vec3)
+#define type_vecn SOL_T(type_vecn)
+#define type_box2 SOL_T(type_box2)
+#define type_box3 SOL_T(type_box3)
+#define type_sph2 SOL_T(type_sph2)
+#define type_sph3 SOL_T(type_sph3)
+
+// Float Functions
+
+#define flt_clamp SOL_FN(flt, clamp)
+#define flt_pow SOL_FN(flt, pow)
+#define flt_exp SOL_FN(flt, exp)
+#define flt_sqrt SOL_FN(flt, sqrt)
+#define flt_sin SOL_FN(flt, sin)
+#define flt_cos SOL_FN(flt, cos)
+#define flt_acos SOL_FN(flt, acos)
+#define flt_abs SOL_FN(flt, abs)
+#define flt_floor SOL_FN(flt, floor)
+#define flt_ceil SOL_FN(flt, ceil)
+#define flt_round SOL_FN(flt, round)
+#define flt_fma SOL_FN(flt, fma)
+
+// Conversion Functions
+
+#define cv_axis_quat SOL_FN(cv, axis_quat)
+#define cv_quat_axis SOL_FN(cv, quat_axis)
+#define cv_vec3_vec2 SOL_FN(cv, vec3_vec2)
+#define cv_vec4_vec2 SOL_FN(cv, vec4_vec2)
+#define cv_vec2_vec3 SOL_FN(cv, vec2_vec3)
+#define cv_vec4_vec3 SOL_FN(cv, vec4_vec3)
+#define cv_vec2_vec4 SOL_FN(cv, vec2_vec4)
+#define cv_vec3_vec4 SOL_FN(cv, vec3_vec4)
+#define cv_deg_rad SOL_FN(cv, deg_rad)
+#define cv_rad_deg SOL_FN(cv, rad_deg)
+#define cv_flt_half SOL_FN(cv, flt_half)
+#define cv_half_flt SOL_FN(cv, half_flt)
+
+// Vec2 Functions
+
+#define vec2_init SOL_FN(vec2, init)
+#define vec2_initf SOL_FN(vec2, initf)
+#define vec2_zero SOL_FN(vec2, zero)
+#define vec2_norm SOL_FN(vec2, norm)
+#define vec2_mag SOL_FN(vec2, mag)
+#define vec2_rot SOL_FN(vec2, rot)
+#define vec2_cross SOL_FN(vec2, cross)
+#define vec2_dot SOL_FN(vec2, dot)
+#define vec2_sum SOL_FN(vec2, sum)
+#define vec2_add SOL_FN(vec2, add)
+#define vec2_addf SOL_FN(vec2, addf)
+#define vec2_sub SOL_FN(vec2, sub)
+#define vec2_subf SOL_FN(vec2, subf)
+#define vec2_fsub SOL_FN(vec2, fsub)
+#define vec2_mul SOL_FN(vec2, mul)
+#define vec2_mulf SOL_FN(vec2, mulf)
+#define vec2_div SOL_FN(vec2, div)
+#define vec2_divf SOL_FN(vec2, divf)
+#define vec2_fdiv SOL_FN(vec2, fdiv)
+#define vec2_avg SOL_FN(vec2, avg)
+#define vec2_avgf SOL_FN(vec2, avgf)
+#define vec2_fma SOL_FN(vec2, fma)
+#define vec2_fmaf SOL_FN(vec2, fmaf)
+#define vec2_madd SOL_FN(vec2, madd)
+#define vec2_lerp SOL_FN(vec2, lerp)
+#define vec2_floor SOL_FN(vec2, floor)
+#define vec2_ceil SOL_FN(vec2, ceil)
+#define vec2_round SOL_FN(vec2, round)
+#define vec2_print SOL_FN(vec2, print)
+
+// Vec3 Functions
+
+#define vec3_init SOL_FN(vec3, init)
+#define vec3_initf SOL_FN(vec3, initf)
+#define vec3_zero SOL_FN(vec3, zero)
+#define vec3_norm SOL_FN(vec3, norm)
+#define vec3_mag SOL_FN(vec3, mag)
+#define vec3_rot SOL_FN(vec3, rot)
+#define vec3_cross SOL_FN(vec3, cross)
+#define vec3_dot SOL_FN(vec3, dot)
+#define vec3_sum SOL_FN(vec3, sum)
+#define vec3_add SOL_FN(vec3, add)
+#define vec3_addf SOL_FN(vec3, addf)
+#define vec3_sub SOL_FN(vec3, sub)
+#define vec3_subf SOL_FN(vec3, subf)
+#define vec3_fsub SOL_FN(vec3, fsub)
+#define vec3_mul SOL_FN(vec3, mul)
+#define vec3_mulf SOL_FN(vec3, mulf)
+#define vec3_div SOL_FN(vec3, div)
+#define vec3_divf SOL_FN(vec3, divf)
+#define vec3_fdiv SOL_FN(vec3, fdiv)
+#define vec3_avg SOL_FN(vec3, avg)
+#define vec3_avgf SOL_FN(vec3, avgf)
+#define vec3_fma SOL_FN(vec3, fma)
+#define vec3_fmaf SOL_FN(vec3, fmaf)
+#define vec3_madd SOL_FN(vec3, madd)
+#define vec3_lerp SOL_FN(vec3, lerp)
+#define vec3_floor SOL_FN(vec3, floor)
+#define vec3_ceil SOL_FN(vec3, ceil)
+#define vec3_round SOL_FN(vec3, round)
+#define vec3_print SOL_FN(vec3, print)
+#define vec3_load SOL_FN(vec3, load)
+#define vec3_store SOL_FN(vec3, store)
+#define vec3_load_array SOL_FN(vec3, load_array)
+#define vec3_store_array SOL_FN(vec3, store_array)
+#define vec3_add_array SOL_FN(vec3, add_array)
+#define vec3_sub_array SOL_FN(vec3, sub_array)
+#define vec3_mul_array SOL_FN(vec3, mul_array)
+#define vec3_div_array SOL_FN(vec3, div_array)
+#define vec3_mulf_array SOL_FN(vec3, mulf_array)
+#define vec3_axpy_array SOL_FN(vec3, axpy_array)
+#define vec3x4_load SOL_FN(vec3x4, load)
+#define vec3x8_load SOL_FN(vec3x8, load)
+#define vec3_dot4 SOL_FN(vec3, dot4)
+#define vec3_dot8 SOL_FN(vec3, dot8)
+#define vec3_dot_array SOL_FN(vec3, dot_array)
+#define vec3_dot_arrays SOL_FN(vec3, dot_arrays)
+
+// Vec4 Functions
+
+#define vec4_init SOL_FN(vec4, init)
+#define vec4_initf SOL_FN(vec4, initf)
+#define vec4_zero SOL_FN(vec4, zero)
+#define vec4_norm SOL_FN(vec4, norm)
+#define vec4_mag SOL_FN(vec4, mag)
+#define vec4_dot SOL_FN(vec4, dot)
+#define vec4_sum SOL_FN(vec4, sum)
+#define vec4_add SOL_FN(vec4, add)
+#define vec4_addf SOL_FN(vec4, addf)
+#define vec4_sub SOL_FN(vec4, sub)
+#define vec4_subf SOL_FN(vec4, subf)
+#define vec4_fsub SOL_FN(vec4, fsub)
+#define vec4_mul SOL_FN(vec4, mul)
+#define vec4_mulf SOL_FN(vec4, mulf)
+#define vec4_div SOL_FN(vec4, div)
+#define vec4_divf SOL_FN(vec4, divf)
+#define vec4_fdiv SOL_FN(vec4, fdiv)
+#define vec4_avg SOL_FN(vec4, avg)
+#define vec4_avgf SOL_FN(vec4, avgf)
+#define vec4_fma SOL_FN(vec4, fma)
+#define vec4_fmaf SOL_FN(vec4, fmaf)
+#define vec4_madd SOL_FN(vec4, madd)
+#define vec4_lerp SOL_FN(vec4, lerp)
+#define vec4_floor SOL_FN(vec4, floor)
+#define vec4_ceil SOL_FN(vec4, ceil)
+#define vec4_round SOL_FN(vec4, round)
+#define vec4_print SOL_FN(vec4, print)
+
+// VecN Functions
+
+#define vecn_alloc SOL_FN(vecn, alloc)
+#define vecn_init SOL_FN(vecn, init)
+#define vecn_free SOL_FN(vecn, free)
+#define vecn_add SOL_FN(vecn, add)
+#define vecn_mulf SOL_FN(vecn, mulf)
+#define vecn_axpy SOL_FN(vecn, axpy)
+#define vecn_dot SOL_FN(vecn, dot)
+#define vecn_mag SOL_FN(vecn, mag)
+#define vecn_norm SOL_FN(vecn, norm)
+#define vecn_dist SOL_FN(vecn, dist)
+#define vecn_cos SOL_FN(vecn, cos)
+#define vecn_dist_array SOL_FN(vecn, dist_array)
+#define vecn_knn_l2 SOL_FN(vecn, knn_l2)
+#define vecn_knn_ip SOL_FN(vecn, knn_ip)
+
+#endif
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Core Type Definitions /////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#if SOL_F_SIZE > 64
+      typedef long double Float;
+#elif SOL_F_SIZE > 32
+      typedef double Float;
+#else
+      typedef float Float;
+#endif
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Struct Type Definitions ///////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+/// Vec2 ///
+// Description
+//   A type comprised of two floats to represent a 2D vector or position.
+// Fields
+//   x: dimension (Float)
+//   y: dimension (Float)
+//   dim: dimensions (Float[2])
+
+typedef struct {
+  union {
+    struct {
+      Float x, y;
+    };
+    Float dim[2];
+    #if defined(SOL_SSE_64)
+          __m128d vec;
+    #elif defined(SOL_SSE_32)
+          __m128 vec;
+    #elif defined(SOL_NEON_64)
+          f64x2_t vec;
+    #elif defined(SOL_NEON)
+          f32x2_t vec;
+    #endif
+  };
+} Vec2;
+
+/// Vec3 ///
+// Description
+//   A type comprised of three floats to represent a 3D vector or position.
+// Fields
+//   x: dimension (sol_f)
+//   y: dimension (sol_f)
+//   z: dimension (sol_F)
+//   dim: dimensions (Float[3])
+
+typedef struct type_vec3 {
+  union { 
+    struct {
+      Float x, y, z;
+    };
+    Float dim[3];
+    #if defined(SOL_AVX_64)
+          __m256d vec;
+    #elif defined(SOL_SSE_32)
+          __m128 vec;
+    #elif defined(SOL_NEON_64)
+          f64x4_t vec;
+    #elif defined(SOL_NEON)
+          f32x4_t vec;
+    #endif
+  };
+} Vec3;
+
+/// Vec3p ///
+// Description
+//   A packed type comprised of three floats used to store 3D vectors in
+//   arrays. Unlike Vec3 it carries no SIMD padding lane, so it occupies
+//   exactly 3 * sizeof(Float) bytes; use vec3_load and vec3_store to move
+//   between it and the register form.
+// Fields
+//   x: dimension (Float)
+//   y: dimension (Float)
+//   z: dimension (Float)
+//   dim: dimensions (Float[3])
+
+typedef struct {
+  union {
+    struct {
+      Float x, y, z;
+    };
+    Float dim[3];
+  };
+} Vec3p;
+
+/// Vec3x4 ///
+// Description
+//   Four 3D vectors stored transposed, with each dimension in its own row,
+//   so that one SIMD register holds the same dimension of every vector. Use
+//   vec3x4_load to fill it from packed vectors.
+// Fields
+//   x: dimensions (Float[4])
+//   y: dimensions (Float[4])
+//   z: dimensions (Float[4])
+//   dim: dimensions (Float[3][4])
+
+typedef struct {
+  union {
+    struct {
+      Float x[4], y[4], z[4];
+    };
+    Float dim[3][4];
+  };
+} Vec3x4;
+
+/// Vec3x8 ///
+// Description
+//   Eight 3D vectors stored transposed, like Vec3x4. Use vec3x8_load to fill
+//   it from packed vectors.
+// Fields
+//   x: dimensions (Float[8])
+//   y: dimensions (Float[8])
+//   z: dimensions (Float[8])
+//   dim: dimensions (Float[3][8])
+
+typedef struct {
+  union {
+    struct {
+      Float x[8], y[8], z[8];
+    };
+    Float dim[3][8];
+  };
+} Vec3x8;
+
+/// Vec4 ///
+// Description
+//   A type comprised of four floats to represent a quaternion or axis/angle
+//   rotation.
+// Fields
+//   x: dimension (Float)
+//   y: dimension (Float)
+//   z: dimension (Float)
+//   w: dimension (Float)
+//   dim: dimensions (Float[4])
+// Declarations
+//   Vec4
+//   struct type_vec4
+
+typedef struct {
+  union {
+    struct {
+      Float x, y, z, w;
+    };
+    Float dim[4];
+    #if defined(SOL_AVX_64)
+          __m256d vec;
+    #elif defined(SOL_SSE_32)
+          __m128 vec;
+    #elif defined(SOL_NEON_64)
+          f64x4_t vec;
+    #elif defined(SOL_NEON)
+          f32x4_t vec;
+    #endif
+  };
+} Vec4;
+
+/// VecN ///
+// Description
+//   A heap-allocated vector with any number of dimensions, for feature
+//   vectors such as embeddings and descriptors. The dimensions follow the
+//   header in one allocation aligned to SOL_VECN_ALIGN; with SOL_NO_FAM they
+//   are reached through a pointer instead of a flexible array member. Create
+//   it with vecn_alloc or vecn_init and release it with vecn_free.
+// Fields
+//   len: dimension count (size_t)
+//   dim: dimensions (Float[len])
+
+typedef struct type_vecn {
+  union {
+    size_t len;
+    char head[SOL_VECN_ALIGN];
+  };
+  #if defined(SOL_FAM)
+        Float dim[];
+  #else
+        Float *dim;
+  #endif
+} VecN;
+
+/// Seg2 ///
+// Description
+//   A type comprised of two 2D positions that represent a line segment.
+// Fields
+//   orig: position (Vec2)
+//   dest: position (Vec2)
+
+typedef struct {
+  Vec2 orig, dest;
+} Seg2;
+
+/// Seg3 ///
+// Description
+//   A type comprised of two 3D positions that represent a line segment.
+// Fields
+//   orig: position (Vec3)
+//   dest: position (Vec3)
+
+typedef struct {
+  Vec3 orig, dest;
+} Seg3;
+
+/// Box2 ///
+// Description
+//   A type comprised of two 2D positions that represent a bounding box.
+// Fields
+//   lower: position (Vec2)
+//   upper: position (Vec2)
+
+typedef struct type_box2 {
+  Vec2 lower, upper;
+} Box2;
+
+/// Box3 ///
+// Description
+//   A type comprised of two 3D positions that represent a bounding box.
+// Fields
+//   upper: position (Vec3)
+//   lower: position (Vec3)
+
+typedef struct type_box3 {
+  Vec3 lower, upper;
+} Box3;
+
+/// Sph2 ///
+// Description
+//   A type comprised of a 2D position and a radius that represent a bounding
+//   sphere.
+// Fields
+//   pos: position (Vec2)
+//   rad: radius (Float)
+
+typedef struct type_sph2 {
+  Vec2 pos;
+  Float rad;
+} Sph2;
+
+/// Sph3 ///
+// Description
+//   A type comprised of a 3D position and a radius that represent a bounding
+//   sphere.
+// Fields
+//   pos: position (Vec3)
+//   rad: radius (Float)
+
+typedef struct type_sph3 {
+  Vec3 pos;
+  Float rad;
+} Sph3;
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Float Function Declarations ///////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+Float flt_clamp(Float f, Float lower, Float upper);
+Float flt_pow(Float a, Float b);
+Float flt_exp(Float f);
+Float flt_sqrt(Float f);
+Float flt_sin(Float f);
+Float flt_cos(Float f);
+Float flt_acos(Float f);
+Float flt_abs(Float f);
+Float flt_floor(Float f);
+Float flt_ceil(Float f);
+Float flt_round(Float f);
+Float flt_fma(Float a, Float b, Float c);
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Conversion Function Declarations //////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+Vec4 cv_axis_quat(Vec4 axis);
+Vec4 cv_quat_axis(Vec4 quat);
+
+Vec2 cv_vec3_vec2(Vec3 v);
+Vec2 cv_vec4_vec2(Vec4 v);
+Vec3 cv_vec2_vec3(Vec2 v, Float z);
+Vec3 cv_vec4_vec3(Vec4 v);
+Vec4 cv_vec2_vec4(Vec2 v, Float z, Float w);
+Vec4 cv_vec3_vec4(Vec3 v, Float w);
+
+Float cv_deg_rad(Float deg);
+Float cv_rad_deg(Float rad);
+
+uint16_t cv_flt_half(Float f);
+Float cv_half_flt(uint16_t h);
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Vec2 Function Declarations ////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+Vec2 vec2_init(Float x, Float y);
+Vec2 vec2_initf(Float f);
+Vec2 vec2_zero(void);
+
+Vec2 vec2_norm(Vec2 v);
+Float vec2_mag(Vec2 v);
+
+Vec2 vec2_rot(Vec2 v, Float rad);
+
+Float vec2_cross(Vec2 a, Vec2 b);
+Float vec2_dot(Vec2 a, Vec2 b);
+
+Float vec2_sum(Vec2 v);
+Vec2 vec2_add(Vec2 a, Vec2 b);
+Vec2 vec2_addf(Vec2 v, Float f);
+Vec2 vec2_sub(Vec2 a, Vec2 b);
+Vec2 vec2_subf(Vec2 v, Float f);
+Vec2 vec2_fsub(Float f, Vec2 v);
+Vec2 vec2_mul(Vec2 a, Vec2 b);
+Vec2 vec2_mulf(Vec2 v, Float f);
+Vec2 vec2_div(Vec2 a, Vec2 b);
+Vec2 vec2_divf(Vec2 v, Float f);
+Vec2 vec2_fdiv(Float f, Vec2 v);
+Vec2 vec2_avg(Vec2 a, Vec2 b);
+Vec2 vec2_avgf(Vec2 v, Float f);
+
+Vec2 vec2_fma(Vec2 a, Vec2 b, Vec2 c);
+Vec2 vec2_fmaf(Vec2 a, Float f, Vec2 b);
+Vec2 vec2_madd(Vec2 a, Vec2 b, Float f);
+Vec2 vec2_lerp(Vec2 a, Vec2 b, Float t);
+
+Vec2 vec2_floor(Vec2 v);
+Vec2 vec2_ceil(Vec2 v);
+Vec2 vec2_round(Vec2 v);
+
+void vec2_print(Vec2 v);
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Vec3 Function Declarations ////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+Vec3 vec3_init(Float x, Float y, Float z);
+Vec3 vec3_initf(Float f);
+Vec3 vec3_zero(void);
+
+Vec3 vec3_norm(Vec3 v);
+Float vec3_mag(Vec3 v);
+
+Vec3 vec3_rot(Vec3 v, Vec4 q);
+
+Vec3 vec3_cross(Vec3 a, Vec3 b);
+Float vec3_dot(Vec3 a, Vec3 b);
+
+Float vec3_sum(Vec3 v);
+Vec3 vec3_add(Vec3 a, Vec3 b);
+Vec3 vec3_addf(Vec3 v, Float f);
+Vec3 vec3_sub(Vec3 a, Vec3 b);
+Vec3 vec3_subf(Vec3 v, Float f);
+Vec3 vec3_fsub(Float f, Vec3 v);
+Vec3 vec3_mul(Vec3 a, Vec3 b);
+Vec3 vec3_mulf(Vec3 v, Float f);
+Vec3 vec3_div(Vec3 a, Vec3 b);
+Vec3 vec3_divf(Vec3 v, Float f);
+Vec3 vec3_fdiv(Float f, Vec3 v);
+Vec3 vec3_avg(Vec3 a, Vec3 b);
+Vec3 vec3_avgf(Vec3 v, Float f);
+
+Vec3 vec3_fma(Vec3 a, Vec3 b, Vec3 c);
+Vec3 vec3_fmaf(Vec3 a, Float f, Vec3 b);
+Vec3 vec3_madd(Vec3 a, Vec3 b, Float f);
+Vec3 vec3_lerp(Vec3 a, Vec3 b, Float t);
+
+Vec3 vec3_floor(Vec3 v);
+Vec3 vec3_ceil(Vec3 v);
+Vec3 vec3_round(Vec3 v);
+
+void vec3_print(Vec3 v);
+
+Vec3 vec3_load(const Vec3p *p);
+void vec3_store(Vec3p *p, Vec3 v);
+void vec3_load_array(Vec3 *out, const Vec3p *in, size_t n);
+void vec3_store_array(Vec3p *out, const Vec3 *in, size_t n);
+
+void vec3_add_array(Vec3p *out, const Vec3p *a, const Vec3p *b, size_t n);
+void vec3_sub_array(Vec3p *out, const Vec3p *a, const Vec3p *b, size_t n);
+void vec3_mul_array(Vec3p *out, const Vec3p *a, const Vec3p *b, size_t n);
+void vec3_div_array(Vec3p *out, const Vec3p *a, const Vec3p *b, size_t n);
+void vec3_mulf_array(Vec3p *out, const Vec3p *v, Float f, size_t n);
+void vec3_axpy_array(Vec3p *out, const Vec3p *x, Float f, const Vec3p *y, size_t n);
+
+Vec3x4 vec3x4_load(const Vec3p *p);
+Vec3x8 vec3x8_load(const Vec3p *p);
+Vec4 vec3_dot4(Vec3 a, const Vec3x4 *b);
+void vec3_dot8(Float *out, Vec3 a, const Vec3x8 *b);
+void vec3_dot_array(Float *out, Vec3 a, const Vec3p *b, size_t n);
+void vec3_dot_arrays(Float *out, const Vec3p *a, const Vec3p *b, size_t n);
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Vec4 Function Declarations ////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+Vec4 vec4_init(Float x, Float y, Float z, Float w);
+Vec4 vec4_initf(Float f);
+Vec4 vec4_zero(void);
+
+Vec4 vec4_norm(Vec4 v);
+Float vec4_mag(Vec4 v);
+Float vec4_dot(Vec4 a, Vec4 b);
+
+Float vec4_sum(Vec4 v);
+Vec4 vec4_add(Vec4 a, Vec4 b);
+Vec4 vec4_addf(Vec4 v, Float f);
+Vec4 vec4_sub(Vec4 a, Vec4 b);
+Vec4 vec4_subf(Vec4 v, Float f);
+Vec4 vec4_fsub(Float f, Vec4 v);
+Vec4 vec4_mul(Vec4 a, Vec4 b);
+Vec4 vec4_mulf(Vec4 v, Float f);
+Vec4 vec4_div(Vec4 a, Vec4 b);
+Vec4 vec4_divf(Vec4 v, Float f);
+Vec4 vec4_fdiv(Float f, Vec4 v);
+Vec4 vec4_avg(Vec4 a, Vec4 b);
+Vec4 vec4_avgf(Vec4 v, Float f);
+
+Vec4 vec4_fma(Vec4 a, Vec4 b, Vec4 c);
+Vec4 vec4_fmaf(Vec4 a, Float f, Vec4 b);
+Vec4 vec4_madd(Vec4 a, Vec4 b, Float f);
+Vec4 vec4_lerp(Vec4 a, Vec4 b, Float t);
+
+Vec4 vec4_floor(Vec4 v);
+Vec4 vec4_ceil(Vec4 v);
+Vec4 vec4_round(Vec4 v);
+
+void vec4_print(Vec4 v);
+
+  //////////////////////////////////////////////////////////////////////////////
+ // VecN Function Declarations ////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+VecN *vecn_alloc(size_t len);
+VecN *vecn_init(const Float *f, size_t len);
+void vecn_free(VecN *v);
+
+void vecn_add(VecN *out, const VecN *a, const VecN *b);
+void vecn_mulf(VecN *out, const VecN *v, Float f);
+void vecn_axpy(VecN *out, const VecN *x, Float f, const VecN *y);
+Float vecn_dot(const VecN *a, const VecN *b);
+Float vecn_mag(const VecN *v);
+void vecn_norm(VecN *out, const VecN *v);
+Float vecn_dist(const VecN *a, const VecN *b);
+Float vecn_cos(const VecN *a, const VecN *b);
+
+void vecn_dist_array(Float *out, const VecN *q, const VecN *const *v, size_t n);
+bool vecn_knn_l2(size_t *idx, Float *dist, size_t k, const VecN *const *q, size_t nq,
+                 const VecN *const *db, size_t n);
+bool vecn_knn_ip(size_t *idx, Float *score, size_t k, const VecN *const *q, size_t nq,
+                 const VecN *const *db, size_t n);
+
+#endif
+
+#endif
@@ -13,6 +13,7 @@
 //////////////////////
 
 #include <math.h>
+#include <string.h>
 
   ///////////////////////
  // Vector Conversion //
@@ -105,3 +106,83 @@ sol_inline
 Float cv_rad_deg(Float rad) {
   return rad * (180 / M_PI);
 }
+
+  ///////////////////////////
+ // Half-Float Conversion //
+///////////////////////////
+
+/// cv_flt_half ///
+// Description
+//   Converts a Float into an IEEE 754 half-precision bit pattern, rounding
+//   to nearest even. Out-of-range values become infinity, NaN stays NaN.
+// Arguments
+//   f: Number (Float)
+// Returns
+//   Half (uint16_t)
+
+sol_inline
+uint16_t cv_flt_half(Float f) {
+  const float g = (float) f;
+  uint32_t b;
+  memcpy(&b, &g, sizeof(b));
+  const uint32_t sign = (b >> 16) & 0x8000;
+  const int32_t exp = (int32_t) ((b >> 23) & 0xFF) - 127 + 15;
+  uint32_t man = b & 0x7FFFFF;
+  if ((b & 0x7FFFFFFF) >= 0x7F800000)
+    return (uint16_t) (sign | 0x7C00 | (man ? 0x200 | (man >> 13) : 0));
+  if (exp >= 31)
+    return (uint16_t) (sign | 0x7C00);
+  if (exp <= 0) {
+    if (exp < -10)
+      return (uint16_t) sign;
+    man |= 0x800000;
+    const uint32_t shift = (uint32_t) (14 - exp);
+    const uint32_t rem = man & ((1u << shift) - 1);
+    const uint32_t half = 1u << (shift - 1);
+    uint32_t out = man >> shift;
+    if (rem > half || (rem == half && (out & 1)))
+      out++;
+    return (uint16_t) (sign | out);
+  }
+  uint32_t out = sign | ((uint32_t) exp << 10) | (man >> 13);
+  const uint32_t rem = man & 0x1FFF;
+  if (rem > 0x1000 || (rem == 0x1000 && (out & 1)))
+    out++;
+  return (uint16_t) out;
+}
+
+/// cv_half_flt ///
+// Description
+//   Converts an IEEE 754 half-precision bit pattern into a Float. The
+//   conversion is exact.
+// Arguments
+//   h: Half (uint16_t)
+// Returns
+//   Number (Float)
+
+sol_inline
+Float cv_half_flt(uint16_t h) {
+  const uint32_t sign = (uint32_t) (h & 0x8000) << 16;
+  uint32_t exp = (h >> 10) & 0x1F;
+  uint32_t man = h & 0x3FF;
+  uint32_t b;
+  if (exp == 0) {
+    if (man == 0) {
+      b = sign;
+    } else {
+      exp = 127 - 15 + 1;
+      while (!(man & 0x400)) {
+        man <<= 1;
+        exp--;
+      }
+      b = sign | (exp << 23) | ((man & 0x3FF) << 13);
+    }
+  } else if (exp == 31) {
+    b = sign | 0x7F800000 | (man << 13);
+  } else {
+    b = sign | ((exp + 127 - 15) << 23) | (man << 13);
+  }
+  float g;
+  memcpy(&g, &b, sizeof(g));
+  return g;
+}
@@ -0,0 +1,450 @@
+    ////////////////////////////////////////////////////////////////////////
+   // sol_eig.c ///////////////////////////////////////////////////////////
+  // Description: Adds symmetric eigensolvers and point normals to Sol. //
+ // Author: David Garland (https://github.com/davidgarland/sol) /////////
+////////////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Local Headers /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include "../sol.h"
+#include "sol_simd.h"
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Standard Headers //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <float.h>
+#include <math.h>
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Eigen Types ///////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Symmetric 3x3 matrices are diagonalised by cyclic Jacobi: each sweep
+// rotates away the three off-diagonal entries in turn, and the product of
+// the rotations is the eigenvectors. Every lane runs the same rotations on
+// its own matrix without branching, and a block stops sweeping once all of
+// its lanes are diagonal to within EIG_EPS, which takes three or four sweeps
+// in practice; EIG_SWEEPS only bounds it. Matrices are scaled by their
+// largest entry first so that nothing overflows or underflows on the way.
+
+#if SOL_F_SIZE > 64
+      #define EIG_EPS LDBL_EPSILON
+#elif SOL_F_SIZE > 32
+      #define EIG_EPS DBL_EPSILON
+#else
+      #define EIG_EPS FLT_EPSILON
+#endif
+
+#define EIG_SWEEPS 8
+
+typedef struct {
+  Soa3 val, vec[3];
+  SoaSym3 m;
+} EigJob;
+
+typedef struct {
+  SoaSym3 cov;
+  const Vec3p *v;
+  const size_t *idx;
+  size_t k;
+} EigCov;
+
+typedef struct {
+  Soa3 normal;
+  Float *curv;
+  const Vec3p *v;
+  const size_t *idx;
+  size_t k;
+  Vec3 view;
+} EigNormal;
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Lane Kernels //////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// A SimdReg holds one entry of SIMD_LANES matrices. Without SIMD it is a
+// single Float and the kernels below run a matrix at a time.
+
+// Rotates entry (p, q) of a away, r being the third index, and folds the
+// rotation into the eigenvectors v, whose columns are the vectors.
+static inline
+void eig_rotate(SimdReg a[3][3], SimdReg v[3][3], size_t p, size_t q, size_t r) {
+  const SimdReg zero = simd_set1(0), one = simd_set1(1);
+  const SimdReg apq = a[p][q], h = simd_sub(a[q][q], a[p][p]);
+  const SimdReg root = simd_sqrt(simd_add(simd_mul(h, h), simd_mul(simd_set1(4), simd_mul(apq, apq))));
+  SimdReg den = simd_add(h, simd_sel(simd_lt(h, zero), simd_sub(zero, root), root));
+  den = simd_add(den, simd_sel(simd_le(root, zero), one, zero)); // Already diagonal.
+  const SimdReg t = simd_div(simd_add(apq, apq), den);
+  const SimdReg c = simd_div(one, simd_sqrt(simd_add(one, simd_mul(t, t)))), s = simd_mul(t, c);
+  a[p][p] = simd_sub(a[p][p], simd_mul(t, apq));
+  a[q][q] = simd_add(a[q][q], simd_mul(t, apq));
+  a[p][q] = a[q][p] = zero;
+  const SimdReg arp = a[r][p], arq = a[r][q];
+  a[r][p] = a[p][r] = simd_sub(simd_mul(c, arp), simd_mul(s, arq));
+  a[r][q] = a[q][r] = simd_add(simd_mul(s, arp), simd_mul(c, arq));
+  for (size_t k = 0; k < 3; k++) {
+    const SimdReg vp = v[k][p], vq = v[k][q];
+    v[k][p] = simd_sub(simd_mul(c, vp), simd_mul(s, vq));
+    v[k][q] = simd_add(simd_mul(s, vp), simd_mul(c, vq));
+  }
+}
+
+// Swaps eigenpairs i and j where j's value is the smaller.
+static inline
+void eig_order(SimdReg val[3], SimdReg v[3][3], size_t i, size_t j) {
+  const SimdMask m = simd_lt(val[j], val[i]);
+  const SimdReg lo = simd_sel(m, val[j], val[i]), hi = simd_sel(m, val[i], val[j]);
+  val[i] = lo;
+  val[j] = hi;
+  for (size_t k = 0; k < 3; k++) {
+    const SimdReg a = simd_sel(m, v[k][j], v[k][i]), b = simd_sel(m, v[k][i], v[k][j]);
+    v[k][i] = a;
+    v[k][j] = b;
+  }
+}
+
+// Finds the eigenvalues of the matrices m (xx, xy, xz, yy, yz, zz) in
+// ascending order, and the eigenvectors as the columns of v.
+static inline
+void eig_solve(SimdReg val[3], SimdReg v[3][3], const SimdReg m[6]) {
+  const SimdReg zero = simd_set1(0), one = simd_set1(1);
+  SimdReg s = simd_abs(m[0]);
+  for (size_t k = 1; k < 6; k++)
+    s = simd_max(s, simd_abs(m[k]));
+  const SimdReg inv = simd_div(one, simd_add(s, simd_sel(simd_le(s, zero), one, zero)));
+  SimdReg a[3][3];
+  a[0][0] = simd_mul(m[0], inv);
+  a[0][1] = a[1][0] = simd_mul(m[1], inv);
+  a[0][2] = a[2][0] = simd_mul(m[2], inv);
+  a[1][1] = simd_mul(m[3], inv);
+  a[1][2] = a[2][1] = simd_mul(m[4], inv);
+  a[2][2] = simd_mul(m[5], inv);
+  for (size_t i = 0; i < 3; i++)
+    for (size_t k = 0; k < 3; k++)
+      v[i][k] = i == k ? one : zero;
+  const SimdReg tol = simd_set1(EIG_EPS * EIG_EPS);
+  for (size_t sweep = 0; sweep < EIG_SWEEPS; sweep++) {
+    const SimdReg off = simd_add(simd_add(simd_mul(a[0][1], a[0][1]), simd_mul(a[0][2], a[0][2])), simd_mul(a[1][2], a[1][2]));
+    const SimdReg diag = simd_add(simd_add(simd_mul(a[0][0], a[0][0]), simd_mul(a[1][1], a[1][1])), simd_mul(a[2][2], a[2][2]));
+    if (simd_all(simd_le(off, simd_mul(tol, diag))))
+      break;
+    eig_rotate(a, v, 0, 1, 2);
+    eig_rotate(a, v, 0, 2, 1);
+    eig_rotate(a, v, 1, 2, 0);
+  }
+  for (size_t k = 0; k < 3; k++)
+    val[k] = simd_mul(a[k][k], s);
+  eig_order(val, v, 0, 1);
+  eig_order(val, v, 1, 2);
+  eig_order(val, v, 0, 1);
+}
+
+// Runs eig_solve over a block of matrices laid out one entry per row.
+static inline
+void eig_block(Float val[3][SIMD_LANES], Float vec[9][SIMD_LANES], Float m[6][SIMD_LANES]) {
+  SimdReg r[6], l[3], v[3][3];
+  for (size_t k = 0; k < 6; k++)
+    r[k] = simd_load(m[k]);
+  eig_solve(l, v, r);
+  for (size_t k = 0; k < 3; k++) {
+    simd_store(val[k], l[k]);
+    for (size_t i = 0; i < 3; i++)
+      simd_store(vec[3 * k + i], v[i][k]);
+  }
+}
+
+// eig_rotate on one matrix, skipping entries that are already zero.
+static inline
+void eig1_rotate(Float a[3][3], Float v[3][3], size_t p, size_t q, size_t r) {
+  const Float apq = a[p][q];
+  if (apq == 0)
+    return;
+  const Float h = a[q][q] - a[p][p];
+  const Float root = flt_sqrt(h * h + 4 * apq * apq);
+  const Float t = (apq + apq) / (h < 0 ? h - root : h + root);
+  const Float c = 1 / flt_sqrt(1 + t * t), s = t * c;
+  a[p][p] -= t * apq;
+  a[q][q] += t * apq;
+  a[p][q] = a[q][p] = 0;
+  const Float arp = a[r][p], arq = a[r][q];
+  a[r][p] = a[p][r] = c * arp - s * arq;
+  a[r][q] = a[q][r] = s * arp + c * arq;
+  for (size_t k = 0; k < 3; k++) {
+    const Float vp = v[k][p], vq = v[k][q];
+    v[k][p] = c * vp - s * vq;
+    v[k][q] = s * vp + c * vq;
+  }
+}
+
+// eig_order on one matrix.
+static inline
+void eig1_order(Float val[3], Float v[3][3], size_t i, size_t j) {
+  if (!(val[j] < val[i]))
+    return;
+  const Float t = val[i];
+  val[i] = val[j];
+  val[j] = t;
+  for (size_t k = 0; k < 3; k++) {
+    const Float u = v[k][i];
+    v[k][i] = v[k][j];
+    v[k][j] = u;
+  }
+}
+
+// eig_solve on one matrix, for sym3_eigen, which would otherwise pay for a
+// whole block of copies.
+static inline
+void eig1_solve(Float val[3], Float v[3][3], const Float m[6]) {
+  Float s = 0;
+  for (size_t k = 0; k < 6; k++)
+    s = flt_abs(m[k]) > s ? flt_abs(m[k]) : s;
+  const Float inv = 1 / (s > 0 ? s : 1);
+  Float a[3][3];
+  a[0][0] = m[0] * inv;
+  a[0][1] = a[1][0] = m[1] * inv;
+  a[0][2] = a[2][0] = m[2] * inv;
+  a[1][1] = m[3] * inv;
+  a[1][2] = a[2][1] = m[4] * inv;
+  a[2][2] = m[5] * inv;
+  for (size_t i = 0; i < 3; i++)
+    for (size_t k = 0; k < 3; k++)
+      v[i][k] = i == k ? 1 : 0;
+  for (size_t sweep = 0; sweep < EIG_SWEEPS; sweep++) {
+    const Float off = a[0][1] * a[0][1] + a[0][2] * a[0][2] + a[1][2] * a[1][2];
+    const Float diag = a[0][0] * a[0][0] + a[1][1] * a[1][1] + a[2][2] * a[2][2];
+    if (off <= EIG_EPS * EIG_EPS * diag)
+      break;
+    eig1_rotate(a, v, 0, 1, 2);
+    eig1_rotate(a, v, 0, 2, 1);
+    eig1_rotate(a, v, 1, 2, 0);
+  }
+  for (size_t k = 0; k < 3; k++)
+    val[k] = a[k][k] * s;
+  eig1_order(val, v, 0, 1);
+  eig1_order(val, v, 1, 2);
+  eig1_order(val, v, 0, 1);
+}
+
+// Writes the population covariance of a point's neighbours, listed in the
+// k entries at nb and skipping SIZE_MAX, about their mean.
+static inline
+void eig_cov(Float c[6], const Vec3p *v, const size_t *nb, size_t k) {
+  Float m[3] = {0, 0, 0};
+  size_t count = 0;
+  for (size_t j = 0; j < k; j++) {
+    if (nb[j] == SIZE_MAX)
+      continue;
+    const Vec3p p = v[nb[j]];
+    m[0] += p.x;
+    m[1] += p.y;
+    m[2] += p.z;
+    count++;
+  }
+  for (size_t i = 0; i < 6; i++)
+    c[i] = 0;
+  if (!count)
+    return;
+  const Float inv = 1 / (Float) count;
+  m[0] *= inv;
+  m[1] *= inv;
+  m[2] *= inv;
+  for (size_t j = 0; j < k; j++) {
+    if (nb[j] == SIZE_MAX)
+      continue;
+    const Vec3p p = v[nb[j]];
+    const Float d[3] = {p.x - m[0], p.y - m[1], p.z - m[2]};
+    c[0] += d[0] * d[0];
+    c[1] += d[0] * d[1];
+    c[2] += d[0] * d[2];
+    c[3] += d[1] * d[1];
+    c[4] += d[1] * d[2];
+    c[5] += d[2] * d[2];
+  }
+  for (size_t i = 0; i < 6; i++)
+    c[i] *= inv;
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Eigen Tasks ///////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+static
+void eig_task(void *ctx, size_t lo, size_t hi) {
+  const EigJob *j = ctx;
+  Float *const in[6] = {j->m.xx, j->m.xy, j->m.xz, j->m.yy, j->m.yz, j->m.zz};
+  size_t i = lo;
+  for (; i + SIMD_LANES <= hi; i += SIMD_LANES) {
+    SimdReg r[6], l[3], v[3][3];
+    for (size_t k = 0; k < 6; k++)
+      r[k] = simd_load(in[k] + i);
+    eig_solve(l, v, r);
+    simd_store(j->val.x + i, l[0]);
+    simd_store(j->val.y + i, l[1]);
+    simd_store(j->val.z + i, l[2]);
+    for (size_t k = 0; k < 3; k++) {
+      simd_store(j->vec[k].x + i, v[0][k]);
+      simd_store(j->vec[k].y + i, v[1][k]);
+      simd_store(j->vec[k].z + i, v[2][k]);
+    }
+  }
+  // The last few through a padded block.
+  if (i < hi) {
+    const size_t n = hi - i;
+    Float m[6][SIMD_LANES] = {{0}}, val[3][SIMD_LANES], vec[9][SIMD_LANES];
+    for (size_t k = 0; k < 6; k++)
+      for (size_t l = 0; l < n; l++)
+        m[k][l] = in[k][i + l];
+    eig_block(val, vec, m);
+    for (size_t l = 0; l < n; l++) {
+      j->val.x[i + l] = val[0][l];
+      j->val.y[i + l] = val[1][l];
+      j->val.z[i + l] = val[2][l];
+      for (size_t k = 0; k < 3; k++) {
+        j->vec[k].x[i + l] = vec[3 * k][l];
+        j->vec[k].y[i + l] = vec[3 * k + 1][l];
+        j->vec[k].z[i + l] = vec[3 * k + 2][l];
+      }
+    }
+  }
+}
+
+static
+void eig_cov_task(void *ctx, size_t lo, size_t hi) {
+  const EigCov *j = ctx;
+  for (size_t i = lo; i < hi; i++) {
+    Float c[6];
+    eig_cov(c, j->v, j->idx + i * j->k, j->k);
+    j->cov.xx[i] = c[0];
+    j->cov.xy[i] = c[1];
+    j->cov.xz[i] = c[2];
+    j->cov.yy[i] = c[3];
+    j->cov.yz[i] = c[4];
+    j->cov.zz[i] = c[5];
+  }
+}
+
+static
+void eig_normal_task(void *ctx, size_t lo, size_t hi) {
+  const EigNormal *j = ctx;
+  for (size_t i = lo; i < hi; i += SIMD_LANES) {
+    const size_t n = hi - i < SIMD_LANES ? hi - i : SIMD_LANES;
+    Float m[6][SIMD_LANES] = {{0}}, val[3][SIMD_LANES], vec[9][SIMD_LANES];
+    for (size_t l = 0; l < n; l++) {
+      Float c[6];
+      eig_cov(c, j->v, j->idx + (i + l) * j->k, j->k);
+      for (size_t k = 0; k < 6; k++)
+        m[k][l] = c[k];
+    }
+    eig_block(val, vec, m);
+    for (size_t l = 0; l < n; l++) {
+      // The smallest eigenvector, turned to face the viewpoint.
+      const Vec3p p = j->v[i + l];
+      const Float t[3] = {j->view.x - p.x, j->view.y - p.y, j->view.z - p.z};
+      const Float side = vec[0][l] * t[0] + vec[1][l] * t[1] + vec[2][l] * t[2] < 0 ? -1 : 1;
+      j->normal.x[i + l] = vec[0][l] * side;
+      j->normal.y[i + l] = vec[1][l] * side;
+      j->normal.z[i + l] = vec[2][l] * side;
+      if (j->curv) {
+        const Float low = val[0][l] > 0 ? val[0][l] : 0, sum = low + val[1][l] + val[2][l];
+        j->curv[i + l] = sum > 0 ? low / sum : 0;
+      }
+    }
+  }
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Eigen Functions ///////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+/// sym3_eigen ///
+// Description
+//   Finds the eigenvalues and eigenvectors of a symmetric matrix.
+// Arguments
+//   vec: unit eigenvectors, written; vec[k] goes with the kth eigenvalue
+//        (Vec3[3])
+//   m: matrix (Sym3)
+// Returns
+//   eigenvalues in ascending order (Vec3)
+
+sol_inline
+Vec3 sym3_eigen(Vec3 vec[3], Sym3 m) {
+  const Float e[6] = {m.xx, m.xy, m.xz, m.yy, m.yz, m.zz};
+  Float val[3], v[3][3];
+  eig1_solve(val, v, e);
+  for (size_t k = 0; k < 3; k++) {
+    vec[k].x = v[0][k];
+    vec[k].y = v[1][k];
+    vec[k].z = v[2][k];
+  }
+  Vec3 out;
+  out.x = val[0];
+  out.y = val[1];
+  out.z = val[2];
+  return out;
+}
+
+/// sym3_eigen_array ///
+// Description
+//   Finds the eigenvalues and eigenvectors of n symmetric matrices, a block
+//   of them per SIMD iteration.
+// Arguments
+//   val: eigenvalues in ascending order, x the smallest (Soa3)
+//   vec0, vec1, vec2: unit eigenvectors for val.x, val.y and val.z (Soa3)
+//   m: matrices (SoaSym3)
+//   n: matrix count (size_t)
+// Returns
+//   void
+
+sol_inline
+void sym3_eigen_array(Soa3 val, Soa3 vec0, Soa3 vec1, Soa3 vec2, SoaSym3 m, size_t n) {
+  EigJob j = {val, {vec0, vec1, vec2}, m};
+  sol_parallel_for(n, sizeof(Float) * 18, eig_task, &j);
+}
+
+/// vec3_cov_knn_array ///
+// Description
+//   Finds the population covariance of every point's neighbours about their
+//   mean, for neighbour lists laid out as vecn_knn_l2 writes them.
+// Arguments
+//   cov: covariances, zero for points without neighbours (SoaSym3)
+//   v: points (Vec3p*)
+//   idx: k neighbour indices per point, SIZE_MAX for none (size_t*)
+//   k: neighbours per point (size_t)
+//   n: point count (size_t)
+// Returns
+//   void
+
+sol_inline
+void vec3_cov_knn_array(SoaSym3 cov, const Vec3p *v, const size_t *idx, size_t k, size_t n) {
+  EigCov j = {cov, v, idx, k};
+  sol_parallel_for(n, k * (sizeof(Vec3p) + sizeof(size_t)) + sizeof(Float) * 6, eig_cov_task, &j);
+}
+
+/// vec3_normal_array ///
+// Description
+//   Estimates every point's normal as the eigenvector of its neighbours'
+//   covariance with the smallest eigenvalue, facing the viewpoint. Points
+//   whose neighbours don't span a plane get an arbitrary unit normal.
+// Arguments
+//   normal: unit normals (Soa3)
+//   curv: surface variation, the smallest eigenvalue over their sum, or
+//         NULL (Float*)
+//   v: points (Vec3p*)
+//   idx: k neighbour indices per point, SIZE_MAX for none (size_t*)
+//   k: neighbours per point (size_t)
+//   n: point count (size_t)
+//   view: viewpoint, such as the sensor's position (Vec3)
+// Returns
+//   void
+
+sol_inline
+void vec3_normal_array(Soa3 normal, Float *curv, const Vec3p *v, const size_t *idx, size_t k, size_t n, Vec3 view) {
+  EigNormal j = {normal, curv, v, idx, k, view};
+  sol_parallel_for(n, k * (sizeof(Vec3p) + sizeof(size_t)) + sizeof(Float) * 4, eig_normal_task, &j);
+}
@@ -0,0 +1,33 @@
+    /////////////////////////////////////////////////////////////////
+   // sol_f32.c ////////////////////////////////////////////////////
+  // Description: Instantiates Sol's single precision family. /////
+ // Author: David Garland (https://github.com/davidgarland/sol) //
+/////////////////////////////////////////////////////////////////
+
+// The Float, Vec2, Vec3, Vec4 and VecN sources are compiled as-is for the
+// default family. When the default isn't 32-bit, this unit compiles them again
+// with SOL_F_SIZE set to 32, which maps every name onto the "f" suffix (for
+// example vec3_add becomes vec3f_add) and selects the matching SIMD types.
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Local Headers /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include "../sol.h"
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Family Sources ////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#if SOL_F_SIZE_CONFIG != 32
+      #undef SOL_F_SIZE
+      #define SOL_F_SIZE 32
+      #include "../sol_family.h"
+
+      #include "sol_flt.c"
+      #include "sol_conv.c"
+      #include "sol_vec2.c"
+      #include "sol_vec3.c"
+      #include "sol_vec4.c"
+      #include "sol_vecn.c"
+#endif
@@ -0,0 +1,33 @@
+    /////////////////////////////////////////////////////////////////
+   // sol_f64.c ////////////////////////////////////////////////////
+  // Description: Instantiates Sol's double precision family. /////
+ // Author: David Garland (https://github.com/davidgarland/sol) //
+/////////////////////////////////////////////////////////////////
+
+// The Float, Vec2, Vec3, Vec4 and VecN sources are compiled as-is for the
+// default family. When the default isn't 64-bit, this unit compiles them again
+// with SOL_F_SIZE set to 64, which maps every name onto the "d" suffix (for
+// example vec3_add becomes vec3d_add) and selects the matching SIMD types.
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Local Headers /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include "../sol.h"
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Family Sources ////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#if SOL_F_SIZE_CONFIG != 64
+      #undef SOL_F_SIZE
+      #define SOL_F_SIZE 64
+      #include "../sol_family.h"
+
+      #include "sol_flt.c"
+      #include "sol_conv.c"
+      #include "sol_vec2.c"
+      #include "sol_vec3.c"
+      #include "sol_vec4.c"
+      #include "sol_vecn.c"
+#endif
@@ -39,6 +39,22 @@ Float flt_pow(Float a, Float b) {
   #endif
 }
 
+/// flt_exp ///
+// Description
+//   A wrapper for expf/exp/expl which respects
+//   the accuracy of Sol's Float type.
+
+sol_inline
+Float flt_exp(Float f) {
+  #if SOL_F_SIZE > 64
+        return expl(f);
+  #elif SOL_F_SIZE > 32
+        return exp(f);
+  #else
+        return expf(f);
+  #endif
+}
+
 /// flt_sqrt ///
 // Description
 //   A wrapper for sqrtf/sqrt/sqrtl which respects
@@ -102,3 +118,85 @@ Float flt_acos(Float f) {
         return acosf(f);
   #endif
 }
+
+/// flt_abs ///
+// Description
+//   A wrapper for fabsf/fabs/fabsl which respects
+//   the accuracy of Sol's Float type.
+
+sol_inline
+Float flt_abs(Float f) {
+  #if SOL_F_SIZE > 64
+        return fabsl(f);
+  #elif SOL_F_SIZE > 32
+        return fabs(f);
+  #else
+        return fabsf(f);
+  #endif
+}
+
+/// flt_floor ///
+// Description
+//   A wrapper for floorf/floor/floorl which respects
+//   the accuracy of Sol's Float type.
+
+sol_inline
+Float flt_floor(Float f) {
+  #if SOL_F_SIZE > 64
+        return floorl(f);
+  #elif SOL_F_SIZE > 32
+        return floor(f);
+  #else
+        return floorf(f);
+  #endif
+}
+
+/// flt_ceil ///
+// Description
+//   A wrapper for ceilf/ceil/ceill which respects
+//   the accuracy of Sol's Float type.
+
+sol_inline
+Float flt_ceil(Float f) {
+  #if SOL_F_SIZE > 64
+        return ceill(f);
+  #elif SOL_F_SIZE > 32
+        return ceil(f);
+  #else
+        return ceilf(f);
+  #endif
+}
+
+/// flt_round ///
+// Description
+//   A wrapper for nearbyintf/nearbyint/nearbyintl which respects
+//   the accuracy of Sol's Float type.
+//   Halfway cases round to even, matching the SIMD rounding modes.
+
+sol_inline
+Float flt_round(Float f) {
+  #if SOL_F_SIZE > 64
+        return nearbyintl(f);
+  #elif SOL_F_SIZE > 32
+        return nearbyint(f);
+  #else
+        return nearbyintf(f);
+  #endif
+}
+
+/// flt_fma ///
+// Description
+//   A wrapper for fmaf/fma/fmal which respects
+//   the accuracy of Sol's Float type.
+//   a * b + c is rounded once, matching the SOL_FMA vector paths.
+
+sol_inline
+Float flt_fma(Float a, Float b, Float c) {
+  #if SOL_F_SIZE > 64
+        return fmal(a, b, c);
+  #elif SOL_F_SIZE > 32
+        return fma(a, b, c);
+  #else
+        return fmaf(a, b, c);
+  #endif
+}
@@ -0,0 +1,737 @@
+    /////////////////////////////////////////////////////////////////
+   // sol_gjk.c ////////////////////////////////////////////////////
+  // Description: Adds GJK and EPA collision detection to Sol. ////
+ // Author: David Garland (https://github.com/davidgarland/sol) //
+/////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Local Headers /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include "../sol.h"
+#include "sol_simd.h"
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Standard Headers //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <float.h>
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Support Search Kernel /////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Vertices are projected SIMD_LANES at a time. The search keeps a running
+// maximum per lane and only touches the lane indices when some lane improves,
+// which after the first few registers is rare, so the loop is three loads, a
+// dot product, a compare and a max.
+
+/// vec3_support_array ///
+// Description
+//   Finds the point furthest along a direction, i.e. the support point of
+//   their convex hull. Ties go to the lowest index.
+// Arguments
+//   v: points (Soa3)
+//   n: point count (size_t)
+//   dir: direction, need not be unit length (Vec3)
+// Returns
+//   index of the point (size_t), or SIZE_MAX if n is 0
+
+sol_inline
+size_t vec3_support_array(Soa3 v, size_t n, Vec3 dir) {
+  if (!n)
+    return SIZE_MAX;
+  size_t i = 0, best_i = 0;
+  Float best = v.x[0] * dir.x + v.y[0] * dir.y + v.z[0] * dir.z;
+  #if SIMD_LANES > 1
+        if (n >= SIMD_LANES) {
+          const SimdReg dx = simd_set1(dir.x), dy = simd_set1(dir.y), dz = simd_set1(dir.z);
+          SimdReg top = simd_add(simd_add(simd_mul(simd_load(v.x), dx), simd_mul(simd_load(v.y), dy)),
+                               simd_mul(simd_load(v.z), dz));
+          size_t idx[SIMD_LANES];
+          for (size_t l = 0; l < SIMD_LANES; l++)
+            idx[l] = l;
+          for (i = SIMD_LANES; i + SIMD_LANES <= n; i += SIMD_LANES) {
+            const SimdReg d = simd_add(simd_add(simd_mul(simd_load(v.x + i), dx), simd_mul(simd_load(v.y + i), dy)),
+                                     simd_mul(simd_load(v.z + i), dz));
+            int bits = simd_bits(simd_gt(d, top));
+            if (bits) {
+              top = simd_max(top, d);
+              for (size_t l = i; bits; l++, bits >>= 1)
+                if (bits & 1)
+                  idx[l - i] = l;
+            }
+          }
+          Float f[SIMD_LANES];
+          memcpy(f, &top, sizeof(f));
+          best = f[0];
+          best_i = idx[0];
+          for (size_t l = 1; l < SIMD_LANES; l++) {
+            if (f[l] > best || (f[l] == best && idx[l] < best_i)) {
+              best = f[l];
+              best_i = idx[l];
+            }
+          }
+        }
+  #endif
+  for (; i < n; i++) {
+    const Float d = v.x[i] * dir.x + v.y[i] * dir.y + v.z[i] * dir.z;
+    if (d > best) {
+      best = d;
+      best_i = i;
+    }
+  }
+  return best_i;
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Support Functions /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Shapes are split into a core, which the support functions describe, and a
+// radius that SolShape carries. Spheres and capsules have a point and a
+// segment for a core, so GJK and EPA only ever see polytopes, converge in a
+// finite number of steps, and the radii are added back at the end exactly.
+
+/// sol_support_hull ///
+// Description
+//   The support function of a convex hull, given by its points.
+// Arguments
+//   shape: points (SolHull*)
+//   dir: direction (Vec3)
+// Returns
+//   furthest point along dir (Vec3)
+
+sol_inline
+Vec3 sol_support_hull(const void *shape, Vec3 dir) {
+  const SolHull *h = shape;
+  const size_t i = vec3_support_array(h->v, h->n, dir);
+  return vec3_init(h->v.x[i], h->v.y[i], h->v.z[i]);
+}
+
+/// sol_support_sph3 ///
+// Description
+//   The support function of a sphere's core, its centre.
+// Arguments
+//   shape: sphere (Sph3*)
+//   dir: direction (Vec3)
+// Returns
+//   centre (Vec3)
+
+sol_inline
+Vec3 sol_support_sph3(const void *shape, Vec3 dir) {
+  (void) dir;
+  return ((const Sph3 *) shape)->pos;
+}
+
+/// sol_support_box3 ///
+// Description
+//   The support function of a box, the corner furthest along dir.
+// Arguments
+//   shape: box (Box3*)
+//   dir: direction (Vec3)
+// Returns
+//   corner (Vec3)
+
+sol_inline
+Vec3 sol_support_box3(const void *shape, Vec3 dir) {
+  const Box3 *b = shape;
+  return vec3_init(dir.x < 0 ? b->lower.x : b->upper.x,
+                   dir.y < 0 ? b->lower.y : b->upper.y,
+                   dir.z < 0 ? b->lower.z : b->upper.z);
+}
+
+/// sol_support_seg3 ///
+// Description
+//   The support function of a segment, the core of a capsule.
+// Arguments
+//   shape: segment (Seg3*)
+//   dir: direction (Vec3)
+// Returns
+//   endpoint furthest along dir (Vec3)
+
+sol_inline
+Vec3 sol_support_seg3(const void *shape, Vec3 dir) {
+  const Seg3 *s = shape;
+  return vec3_dot(s->orig, dir) < vec3_dot(s->dest, dir) ? s->dest : s->orig;
+}
+
+/// sol_shape_hull ///
+// Description
+//   Makes a shape out of a convex hull. The points are read, not copied.
+// Arguments
+//   h: points (SolHull*)
+// Returns
+//   shape (SolShape)
+
+sol_inline
+SolShape sol_shape_hull(const SolHull *h) {
+  SolShape s = {sol_support_hull, h, 0};
+  return s;
+}
+
+/// sol_shape_sph3 ///
+// Description
+//   Makes a shape out of a sphere.
+// Arguments
+//   s: sphere (Sph3*)
+// Returns
+//   shape (SolShape)
+
+sol_inline
+SolShape sol_shape_sph3(const Sph3 *s) {
+  SolShape sh = {sol_support_sph3, s, s->rad};
+  return sh;
+}
+
+/// sol_shape_box3 ///
+// Description
+//   Makes a shape out of a box.
+// Arguments
+//   b: box (Box3*)
+// Returns
+//   shape (SolShape)
+
+sol_inline
+SolShape sol_shape_box3(const Box3 *b) {
+  SolShape s = {sol_support_box3, b, 0};
+  return s;
+}
+
+/// sol_shape_capsule ///
+// Description
+//   Makes a shape out of a capsule, the points within radius of a segment.
+// Arguments
+//   s: axis (Seg3*)
+//   radius: radius (Float)
+// Returns
+//   shape (SolShape)
+
+sol_inline
+SolShape sol_shape_capsule(const Seg3 *s, Float radius) {
+  SolShape sh = {sol_support_seg3, s, radius};
+  return sh;
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // GJK ///////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// GJK walks a simplex of points from the Minkowski difference of the two
+// cores, w = a - b, towards the origin. Each step reduces the simplex to the
+// smallest face nearest the origin, with barycentric weights that also give
+// the nearest points on each core. The loop ends when the distance stops
+// improving by more than GJK_TOL, when a lower bound on it exceeds the
+// caller's stop distance, or when the simplex closes around the origin.
+
+#define GJK_ITERS 64
+
+#if SOL_F_SIZE > 32
+      #define GJK_TOL ((Float) 1e-10)
+#else
+      #define GJK_TOL ((Float) 1e-5)
+#endif
+
+typedef struct {
+  Vec3 w, a, b; // Difference, and the support points it came from.
+  Vec3 d; // Search direction, kept for warm starts.
+} GjkVert;
+
+typedef struct {
+  SolShape sa, sb;
+  GjkVert v[4];
+  Float bary[4];
+  size_t n;
+  Vec3 p; // Point of the simplex nearest the origin.
+} Gjk;
+
+static
+GjkVert gjk_vert(const Gjk *g, Vec3 d) {
+  GjkVert v;
+  v.d = d;
+  v.a = g->sa.support(g->sa.data, d);
+  v.b = g->sb.support(g->sb.data, vec3_mulf(d, -1));
+  v.w = vec3_sub(v.a, v.b);
+  return v;
+}
+
+// Squared size of the simplex, which scales the tolerances.
+static
+Float gjk_scale(const Gjk *g) {
+  Float s = 0;
+  for (size_t i = 0; i < g->n; i++) {
+    const Float m = vec3_dot(g->v[i].w, g->v[i].w);
+    s = m > s ? m : s;
+  }
+  return s;
+}
+
+static
+bool gjk_push(Gjk *g, GjkVert v) {
+  for (size_t i = 0; i < g->n; i++)
+    if (v.w.x == g->v[i].w.x && v.w.y == g->v[i].w.y && v.w.z == g->v[i].w.z)
+      return false;
+  g->v[g->n++] = v;
+  return true;
+}
+
+// Keeps the listed vertices with the given weights.
+static
+void gjk_keep(Gjk *g, size_t n, const size_t *keep, const Float *bary) {
+  GjkVert v[4];
+  for (size_t k = 0; k < n; k++)
+    v[k] = g->v[keep[k]];
+  g->p = vec3_zero();
+  for (size_t k = 0; k < n; k++) {
+    g->v[k] = v[k];
+    g->bary[k] = bary[k];
+    g->p = vec3_fmaf(v[k].w, bary[k], g->p);
+  }
+  g->n = n;
+}
+
+static
+void gjk_segment(Gjk *g, size_t i, size_t j) {
+  const Vec3 a = g->v[i].w;
+  const Vec3 ab = vec3_sub(g->v[j].w, a);
+  const Float l2 = vec3_dot(ab, ab);
+  const Float t = l2 > 0 ? -vec3_dot(a, ab) / l2 : 0;
+  if (t <= 0) {
+    gjk_keep(g, 1, (size_t[]) {i}, (Float[]) {1});
+  } else if (t >= 1) {
+    gjk_keep(g, 1, (size_t[]) {j}, (Float[]) {1});
+  } else {
+    gjk_keep(g, 2, (size_t[]) {i, j}, (Float[]) {1 - t, t});
+  }
+}
+
+// The Voronoi region tests from Ericson's closest point on a triangle. A
+// triangle too thin to have a face region falls back to its nearest edge.
+
+static
+void gjk_triangle(Gjk *g, size_t i, size_t j, size_t k) {
+  const Vec3 a = g->v[i].w, b = g->v[j].w, c = g->v[k].w;
+  const Vec3 ab = vec3_sub(b, a), ac = vec3_sub(c, a);
+  const Float d1 = -vec3_dot(ab, a), d2 = -vec3_dot(ac, a);
+  if (d1 <= 0 && d2 <= 0) {
+    gjk_keep(g, 1, (size_t[]) {i}, (Float[]) {1});
+    return;
+  }
+  const Float d3 = -vec3_dot(ab, b), d4 = -vec3_dot(ac, b);
+  if (d3 >= 0 && d4 <= d3) {
+    gjk_keep(g, 1, (size_t[]) {j}, (Float[]) {1});
+    return;
+  }
+  const Float vc = d1 * d4 - d3 * d2;
+  if (vc <= 0 && d1 >= 0 && d3 <= 0) {
+    const Float t = d1 / (d1 - d3);
+    gjk_keep(g, 2, (size_t[]) {i, j}, (Float[]) {1 - t, t});
+    return;
+  }
+  const Float d5 = -vec3_dot(ab, c), d6 = -vec3_dot(ac, c);
+  if (d6 >= 0 && d5 <= d6) {
+    gjk_keep(g, 1, (size_t[]) {k}, (Float[]) {1});
+    return;
+  }
+  const Float vb = d5 * d2 - d1 * d6;
+  if (vb <= 0 && d2 >= 0 && d6 <= 0) {
+    const Float t = d2 / (d2 - d6);
+    gjk_keep(g, 2, (size_t[]) {i, k}, (Float[]) {1 - t, t});
+    return;
+  }
+  const Float va = d3 * d6 - d5 * d4;
+  if (va <= 0 && d4 - d3 >= 0 && d5 - d6 >= 0) {
+    const Float t = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+    gjk_keep(g, 2, (size_t[]) {j, k}, (Float[]) {1 - t, t});
+    return;
+  }
+  const Float sum = va + vb + vc;
+  if (sum > 0) {
+    const Float v = vb / sum, w = vc / sum;
+    gjk_keep(g, 3, (size_t[]) {i, j, k}, (Float[]) {1 - v - w, v, w});
+    return;
+  }
+  Gjk e[3] = {*g, *g, *g};
+  gjk_segment(&e[0], i, j);
+  gjk_segment(&e[1], i, k);
+  gjk_segment(&e[2], j, k);
+  size_t best = 0;
+  for (size_t m = 1; m < 3; m++)
+    if (vec3_dot(e[m].p, e[m].p) < vec3_dot(e[best].p, e[best].p))
+      best = m;
+  *g = e[best];
+}
+
+// The origin is inside the tetrahedron unless it lies beyond one of its
+// faces, in which case the nearest point is on the nearest such face. A flat
+// tetrahedron has every face count as facing the origin.
+
+static
+void gjk_tetra(Gjk *g) {
+  static const size_t face[4][4] = {{0, 1, 2, 3}, {0, 2, 3, 1}, {0, 3, 1, 2}, {1, 3, 2, 0}};
+  Gjk best;
+  Float best_d = 0;
+  bool outside = false;
+  for (size_t f = 0; f < 4; f++) {
+    const Vec3 a = g->v[face[f][0]].w;
+    const Vec3 n = vec3_cross(vec3_sub(g->v[face[f][1]].w, a), vec3_sub(g->v[face[f][2]].w, a));
+    const Float sp = -vec3_dot(n, a);
+    const Float so = vec3_dot(n, vec3_sub(g->v[face[f][3]].w, a));
+    if (so != 0 && sp * so >= 0)
+      continue;
+    Gjk t = *g;
+    gjk_triangle(&t, face[f][0], face[f][1], face[f][2]);
+    const Float d = vec3_dot(t.p, t.p);
+    if (!outside || d < best_d) {
+      best = t;
+      best_d = d;
+    }
+    outside = true;
+  }
+  if (outside) {
+    *g = best;
+    return;
+  }
+  g->p = vec3_zero();
+}
+
+static
+void gjk_closest(Gjk *g) {
+  switch (g->n) {
+    case 1:
+      g->bary[0] = 1;
+      g->p = g->v[0].w;
+      break;
+    case 2:
+      gjk_segment(g, 0, 1);
+      break;
+    case 3:
+      gjk_triangle(g, 0, 1, 2);
+      break;
+    default:
+      gjk_tetra(g);
+      break;
+  }
+}
+
+// Runs GJK on the cores, warm started from the simplex in cache if given.
+// Returns true if the cores overlap; otherwise g->p is the nearest point of
+// their difference to the origin, or a point known to be further than stop
+// when stop is not negative.
+
+static
+bool gjk_run(Gjk *g, Float stop, const SolSimplex *cache) {
+  g->n = 0;
+  for (size_t i = 0; cache && i < cache->n && i < 4; i++)
+    gjk_push(g, gjk_vert(g, cache->dir[i]));
+  if (!g->n)
+    gjk_push(g, gjk_vert(g, vec3_init(1, 0, 0)));
+  gjk_closest(g);
+  for (size_t it = 0; it < GJK_ITERS; it++) {
+    const Float p2 = vec3_dot(g->p, g->p);
+    if (g->n == 4 || p2 <= GJK_TOL * GJK_TOL * gjk_scale(g))
+      return true;
+    const GjkVert s = gjk_vert(g, vec3_mulf(g->p, -1));
+    const Float pw = vec3_dot(g->p, s.w);
+    if (stop >= 0 && pw > 0 && pw * pw > stop * stop * p2)
+      return false;
+    if (p2 - pw <= GJK_TOL * p2)
+      return false;
+    const Gjk prev = *g;
+    if (!gjk_push(g, s))
+      return false;
+    gjk_closest(g);
+    if (g->n < 4 && vec3_dot(g->p, g->p) >= p2) {
+      *g = prev;
+      return false;
+    }
+  }
+  return false;
+}
+
+static
+void gjk_store(const Gjk *g, SolSimplex *cache) {
+  if (!cache)
+    return;
+  cache->n = g->n;
+  for (size_t i = 0; i < g->n; i++)
+    cache->dir[i] = g->v[i].d;
+}
+
+// Fills a contact from separated cores, moving the nearest points out by the
+// radii along the normal.
+
+static
+bool gjk_contact(SolContact *c, const Gjk *g) {
+  Vec3 pa = vec3_zero(), pb = vec3_zero();
+  for (size_t i = 0; i < g->n; i++) {
+    pa = vec3_fmaf(g->v[i].a, g->bary[i], pa);
+    pb = vec3_fmaf(g->v[i].b, g->bary[i], pb);
+  }
+  const Float d = vec3_mag(g->p);
+  c->normal = vec3_divf(g->p, -d);
+  c->distance = d - g->sa.radius - g->sb.radius;
+  c->point_a = vec3_fmaf(c->normal, g->sa.radius, pa);
+  c->point_b = vec3_fmaf(c->normal, -g->sb.radius, pb);
+  return c->distance <= 0;
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // EPA ///////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// EPA grows the simplex GJK finished with into a polytope inside the
+// Minkowski difference, each step pushing out its face nearest the origin
+// with the support point along that face's normal, until no point lies
+// further out. The nearest face then gives the penetration depth and normal.
+// GJK may stop on a simplex of fewer than four points when the origin lies on
+// it, so that is first grown into a tetrahedron.
+
+#define EPA_VERTS 64
+#define EPA_FACES 128
+
+typedef struct {
+  size_t v[3];
+  Vec3 n;
+  Float dist;
+} EpaFace;
+
+typedef struct {
+  GjkVert v[EPA_VERTS];
+  EpaFace f[EPA_FACES];
+  size_t nv, nf;
+} Epa;
+
+// Grows the simplex into a tetrahedron. Returns false if the difference is
+// flat, in which case dir is a normal of it and the depth is zero.
+
+static
+bool epa_seed(Gjk *g, Vec3 *dir) {
+  const Float tol = GJK_TOL * GJK_TOL * gjk_scale(g);
+  static const Float axis[6][3] = {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+  *dir = vec3_init(0, 0, 1);
+  if (g->n == 1) {
+    for (size_t i = 0; i < 6 && g->n == 1; i++) {
+      *dir = vec3_init(axis[i][0], axis[i][1], axis[i][2]);
+      const GjkVert s = gjk_vert(g, *dir);
+      const Vec3 e = vec3_sub(s.w, g->v[0].w);
+      if (vec3_dot(e, e) > tol)
+        g->v[g->n++] = s;
+    }
+  }
+  if (g->n == 2) {
+    const Vec3 e = vec3_sub(g->v[1].w, g->v[0].w);
+    const Float ax = e.x * e.x, ay = e.y * e.y, az = e.z * e.z;
+    const Vec3 k = ax <= ay && ax <= az ? vec3_init(1, 0, 0) : ay <= az ? vec3_init(0, 1, 0) : vec3_init(0, 0, 1);
+    const Vec3 u = vec3_cross(e, k);
+    const Vec3 dirs[4] = {u, vec3_mulf(u, -1), vec3_cross(e, u), vec3_mulf(vec3_cross(e, u), -1)};
+    for (size_t i = 0; i < 4 && g->n == 2; i++) {
+      *dir = dirs[i];
+      const GjkVert s = gjk_vert(g, *dir);
+      const Vec3 c = vec3_cross(e, vec3_sub(s.w, g->v[0].w));
+      if (vec3_dot(c, c) > tol * vec3_dot(e, e))
+        g->v[g->n++] = s;
+    }
+  }
+  if (g->n == 3) {
+    const Vec3 n = vec3_cross(vec3_sub(g->v[1].w, g->v[0].w), vec3_sub(g->v[2].w, g->v[0].w));
+    for (size_t i = 0; i < 2 && g->n == 3; i++) {
+      *dir = i ? vec3_mulf(n, -1) : n;
+      const GjkVert s = gjk_vert(g, *dir);
+      const Float h = vec3_dot(n, vec3_sub(s.w, g->v[0].w));
+      if (h * h > tol * vec3_dot(n, n))
+        g->v[g->n++] = s;
+    }
+  }
+  return g->n == 4;
+}
+
+static
+void epa_face(Epa *e, size_t i, size_t j, size_t k) {
+  EpaFace *f = &e->f[e->nf++];
+  const Vec3 a = e->v[i].w;
+  const Vec3 n = vec3_cross(vec3_sub(e->v[j].w, a), vec3_sub(e->v[k].w, a));
+  const Float m = vec3_mag(n);
+  f->v[0] = i;
+  f->v[1] = j;
+  f->v[2] = k;
+  f->n = m > 0 ? vec3_divf(n, m) : vec3_zero();
+  f->dist = m > 0 ? vec3_dot(f->n, a) : FLT_MAX; // Never the nearest.
+}
+
+// Runs EPA from a tetrahedron and returns its nearest face.
+static
+EpaFace epa_run(Epa *e, const Gjk *g) {
+  e->nv = 4;
+  e->nf = 0;
+  for (size_t i = 0; i < 4; i++)
+    e->v[i] = g->v[i];
+  const Vec3 o = vec3_sub(e->v[3].w, e->v[0].w);
+  const Vec3 n = vec3_cross(vec3_sub(e->v[1].w, e->v[0].w), vec3_sub(e->v[2].w, e->v[0].w));
+  if (vec3_dot(n, o) > 0) {
+    const GjkVert t = e->v[1];
+    e->v[1] = e->v[2];
+    e->v[2] = t;
+  }
+  epa_face(e, 0, 1, 2);
+  epa_face(e, 0, 3, 1);
+  epa_face(e, 0, 2, 3);
+  epa_face(e, 1, 3, 2);
+  const Float scale = flt_sqrt(gjk_scale(g));
+  for (;;) {
+    size_t near = 0;
+    for (size_t i = 1; i < e->nf; i++)
+      if (e->f[i].dist < e->f[near].dist)
+        near = i;
+    const EpaFace best = e->f[near];
+    const GjkVert s = gjk_vert(g, best.n);
+    if (vec3_dot(s.w, best.n) - best.dist <= GJK_TOL * scale || e->nv == EPA_VERTS)
+      return best;
+    // Faces that see the new point go; the edges they don't share with each
+    // other form the horizon, which is joined up to the new point.
+    size_t edge[3 * EPA_FACES][2];
+    size_t ne = 0, kept = 0;
+    for (size_t i = 0; i < e->nf; i++) {
+      const EpaFace f = e->f[i];
+      if (vec3_dot(f.n, vec3_sub(s.w, e->v[f.v[0]].w)) <= 0) {
+        e->f[kept++] = f;
+        continue;
+      }
+      for (size_t k = 0; k < 3; k++) {
+        const size_t a = f.v[k], b = f.v[(k + 1) % 3];
+        size_t m = 0;
+        while (m < ne && !(edge[m][0] == b && edge[m][1] == a))
+          m++;
+        if (m < ne) {
+          edge[m][0] = edge[ne - 1][0];
+          edge[m][1] = edge[ne - 1][1];
+          ne--;
+        } else {
+          edge[ne][0] = a;
+          edge[ne][1] = b;
+          ne++;
+        }
+      }
+    }
+    if (kept + ne > EPA_FACES || !ne)
+      return best;
+    e->nf = kept;
+    e->v[e->nv] = s;
+    for (size_t i = 0; i < ne; i++)
+      epa_face(e, edge[i][0], edge[i][1], e->nv);
+    e->nv++;
+  }
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Collision Functions ///////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+/// sol_gjk_intersect ///
+// Description
+//   Tests whether two convex shapes overlap, stopping as soon as a separating
+//   direction or a common point is found. Shapes that only touch count as
+//   overlapping. The cache, if given, holds the simplex from the last call
+//   for the same pair; coherent pairs then need only a step or two. Zero it
+//   before the first call.
+// Arguments
+//   a: shape (SolShape)
+//   b: shape (SolShape)
+//   cache: warm start simplex, updated, or NULL (SolSimplex*)
+// Returns
+//   whether they overlap (bool)
+
+sol_inline
+bool sol_gjk_intersect(SolShape a, SolShape b, SolSimplex *cache) {
+  Gjk g;
+  g.sa = a;
+  g.sb = b;
+  const Float r = a.radius + b.radius;
+  const bool hit = gjk_run(&g, r, cache) || vec3_dot(g.p, g.p) <= r * r;
+  gjk_store(&g, cache);
+  return hit;
+}
+
+/// sol_gjk_distance ///
+// Description
+//   Finds the distance between two convex shapes and their nearest points.
+//   Rounded shapes that overlap by less than their radii get a negative
+//   distance; if the cores themselves overlap, the depth is left to
+//   sol_gjk_penetration and the contact is only marked with a distance of
+//   zero and a zero normal.
+// Arguments
+//   c: contact, written (SolContact*)
+//   a: shape (SolShape)
+//   b: shape (SolShape)
+//   cache: warm start simplex, updated, or NULL (SolSimplex*)
+// Returns
+//   whether they overlap (bool)
+
+sol_inline
+bool sol_gjk_distance(SolContact *c, SolShape a, SolShape b, SolSimplex *cache) {
+  Gjk g;
+  g.sa = a;
+  g.sb = b;
+  const bool inside = gjk_run(&g, -1, cache);
+  gjk_store(&g, cache);
+  if (!inside)
+    return gjk_contact(c, &g);
+  c->distance = 0;
+  c->normal = vec3_zero();
+  c->point_a = c->point_b = g.v[0].a;
+  return true;
+}
+
+/// sol_gjk_penetration ///
+// Description
+//   Finds the signed distance between two convex shapes, with GJK while they
+//   are apart and EPA once they overlap. The normal points from a to b, so
+//   moving b by -distance along it separates the shapes; point_a and point_b
+//   are the points of each shape furthest into the other, or the nearest
+//   points while apart.
+// Arguments
+//   c: contact, written (SolContact*)
+//   a: shape (SolShape)
+//   b: shape (SolShape)
+//   cache: warm start simplex, updated, or NULL (SolSimplex*)
+// Returns
+//   whether they overlap (bool)
+
+sol_inline
+bool sol_gjk_penetration(SolContact *c, SolShape a, SolShape b, SolSimplex *cache) {
+  Gjk g;
+  g.sa = a;
+  g.sb = b;
+  const bool inside = gjk_run(&g, -1, cache);
+  gjk_store(&g, cache);
+  if (!inside)
+    return gjk_contact(c, &g);
+  Vec3 dir;
+  Float depth = 0;
+  Vec3 pa = g.v[0].a, pb = g.v[0].b;
+  if (epa_seed(&g, &dir)) {
+    Epa e;
+    const EpaFace f = epa_run(&e, &g);
+    const Vec3 wa = e.v[f.v[0]].w, wb = e.v[f.v[1]].w, wc = e.v[f.v[2]].w;
+    const Vec3 v0 = vec3_sub(wb, wa), v1 = vec3_sub(wc, wa);
+    const Vec3 v2 = vec3_sub(vec3_mulf(f.n, f.dist), wa);
+    const Float d00 = vec3_dot(v0, v0), d01 = vec3_dot(v0, v1), d11 = vec3_dot(v1, v1);
+    const Float d20 = vec3_dot(v2, v0), d21 = vec3_dot(v2, v1);
+    const Float den = d00 * d11 - d01 * d01;
+    const Float v = den > 0 ? (d11 * d20 - d01 * d21) / den : 0;
+    const Float w = den > 0 ? (d00 * d21 - d01 * d20) / den : 0;
+    const Float u = 1 - v - w;
+    pa = vec3_fmaf(e.v[f.v[0]].a, u, vec3_fmaf(e.v[f.v[1]].a, v, vec3_mulf(e.v[f.v[2]].a, w)));
+    pb = vec3_fmaf(e.v[f.v[0]].b, u, vec3_fmaf(e.v[f.v[1]].b, v, vec3_mulf(e.v[f.v[2]].b, w)));
+    dir = f.n;
+    depth = f.dist;
+  }
+  c->normal = vec3_norm(dir);
+  c->distance = -depth - a.radius - b.radius;
+  c->point_a = vec3_fmaf(c->normal, a.radius, pa);
+  c->point_b = vec3_fmaf(c->normal, -b.radius, pb);
+  return true;
+}
@@ -0,0 +1,775 @@
+    /////////////////////////////////////////////////////////////////
+   // sol_hull.c ///////////////////////////////////////////////////
+  // Description: Adds 2D and 3D convex hulls to Sol. /////////////
+ // Author: David Garland (https://github.com/davidgarland/sol) //
+/////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Local Headers /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include "../sol.h"
+#include "sol_simd.h"
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Standard Headers //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Plane Distance Kernel /////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Points are measured against a plane SIMD_LANES at a time. Quickhull spends
+// nearly all of its time measuring points against planes, both to pick the
+// furthest point and to sort points onto faces.
+
+// Writes the signed distance of m points to the plane n.p = d.
+static
+void hull_dist(Float *out, const Float *x, const Float *y, const Float *z, size_t m, const Float n[3], Float d) {
+  size_t i = 0;
+  #if SIMD_LANES > 1
+        const SimdReg nx = simd_set1(n[0]), ny = simd_set1(n[1]), nz = simd_set1(n[2]);
+        const SimdReg nd = simd_set1(d);
+        for (; i + SIMD_LANES <= m; i += SIMD_LANES) {
+          const SimdReg p = simd_add(simd_mul(simd_load(x + i), nx), simd_mul(simd_load(y + i), ny));
+          simd_store(out + i, simd_sub(simd_add(p, simd_mul(simd_load(z + i), nz)), nd));
+        }
+  #endif
+  for (; i < m; i++)
+    out[i] = x[i] * n[0] + y[i] * n[1] + z[i] * n[2] - d;
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Parallel Sort /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Points are sorted by x, then y, in HULL_SLICES slices at once, and the
+// sorted runs are then merged pairwise, every merge of a round in parallel.
+// The index breaks ties so that the result doesn't depend on the slicing.
+
+#define HULL_SLICES 64
+
+typedef struct {
+  Float x, y;
+  size_t id;
+} HullPt;
+
+typedef struct {
+  HullPt *src, *dst;
+  size_t n, width;
+} HullSort;
+
+static
+int hull_cmp(const void *a, const void *b) {
+  const HullPt *p = a, *q = b;
+  if (p->x != q->x)
+    return p->x < q->x ? -1 : 1;
+  if (p->y != q->y)
+    return p->y < q->y ? -1 : 1;
+  return p->id < q->id ? -1 : p->id > q->id;
+}
+
+static
+void hull_sort_task(void *ctx, size_t lo, size_t hi) {
+  HullSort *s = ctx;
+  for (size_t k = lo; k < hi; k++) {
+    const size_t a = s->n * k / HULL_SLICES, b = s->n * (k + 1) / HULL_SLICES;
+    qsort(s->src + a, b - a, sizeof(HullPt), hull_cmp);
+  }
+}
+
+static
+void hull_merge_task(void *ctx, size_t lo, size_t hi) {
+  HullSort *s = ctx;
+  for (size_t k = lo; k < hi; k++) {
+    const size_t a = s->n * (2 * k * s->width) / HULL_SLICES;
+    const size_t m = s->n * ((2 * k + 1) * s->width < HULL_SLICES ? (2 * k + 1) * s->width : HULL_SLICES) / HULL_SLICES;
+    const size_t b = s->n * ((2 * k + 2) * s->width < HULL_SLICES ? (2 * k + 2) * s->width : HULL_SLICES) / HULL_SLICES;
+    size_t i = a, j = m, o = a;
+    while (i < m && j < b)
+      s->dst[o++] = hull_cmp(&s->src[j], &s->src[i]) < 0 ? s->src[j++] : s->src[i++];
+    while (i < m)
+      s->dst[o++] = s->src[i++];
+    while (j < b)
+      s->dst[o++] = s->src[j++];
+  }
+}
+
+// Sorts p using tmp as scratch; returns whichever of the two holds the result.
+static
+HullPt *hull_sort(HullPt *p, HullPt *tmp, size_t n) {
+  HullSort s = {p, tmp, n, 1};
+  sol_parallel_for(HULL_SLICES, n / HULL_SLICES * 16 * sizeof(HullPt) + 1, hull_sort_task, &s);
+  for (; s.width < HULL_SLICES; s.width *= 2) {
+    const size_t pairs = (HULL_SLICES + 2 * s.width - 1) / (2 * s.width);
+    sol_parallel_for(pairs, n / pairs * 2 * sizeof(HullPt) + 1, hull_merge_task, &s);
+    HullPt *t = s.src;
+    s.src = s.dst;
+    s.dst = t;
+  }
+  return s.src;
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // 2D Hulls //////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Before sorting, points strictly inside the octagon spanned by the extremes
+// along x, y, x + y and x - y are thrown out (Akl-Toussaint), which for most
+// inputs leaves only a sliver of the points for the sort and the chain.
+
+typedef struct {
+  const Vec2 *v;
+  size_t n;
+  size_t ext[HULL_SLICES][8]; // Per slice extremes, then the octagon.
+  Float oct[8][2];
+  Float edge[8][2]; // From each corner to the next.
+  size_t corners;
+  size_t count[HULL_SLICES + 1];
+  HullPt *out;
+} Hull2;
+
+static inline
+void hull_keys(Float k[8], Vec2 p) {
+  k[0] = -p.x;
+  k[1] = -p.x - p.y;
+  k[2] = -p.y;
+  k[3] = p.x - p.y;
+  k[4] = p.x;
+  k[5] = p.x + p.y;
+  k[6] = p.y;
+  k[7] = p.y - p.x;
+}
+
+static
+void hull2_ext_task(void *ctx, size_t lo, size_t hi) {
+  Hull2 *h = ctx;
+  for (size_t s = lo; s < hi; s++) {
+    const size_t a = h->n * s / HULL_SLICES, b = h->n * (s + 1) / HULL_SLICES;
+    size_t *e = h->ext[s];
+    Float best[8], k[8];
+    hull_keys(best, h->v[a < b ? a : 0]);
+    for (size_t j = 0; j < 8; j++)
+      e[j] = a < b ? a : 0; // Empty slices leave any valid point.
+    for (size_t i = a; i < b; i++) {
+      hull_keys(k, h->v[i]);
+      for (size_t j = 0; j < 8; j++) {
+        e[j] = k[j] > best[j] ? i : e[j];
+        best[j] = k[j] > best[j] ? k[j] : best[j];
+      }
+    }
+  }
+}
+
+// Tested without branching, since about as many points fail as pass.
+static inline
+bool hull2_inside(const Hull2 *h, Vec2 p) {
+  bool in = true;
+  for (size_t k = 0; k < h->corners; k++)
+    in &= h->edge[k][0] * (p.y - h->oct[k][1]) - h->edge[k][1] * (p.x - h->oct[k][0]) > 0;
+  return in;
+}
+
+// Counts the survivors of each slice when out is NULL, writes them otherwise.
+static
+void hull2_filter_task(void *ctx, size_t lo, size_t hi) {
+  Hull2 *h = ctx;
+  for (size_t s = lo; s < hi; s++) {
+    const size_t a = h->n * s / HULL_SLICES, b = h->n * (s + 1) / HULL_SLICES;
+    size_t o = h->out ? h->count[s] : 0;
+    for (size_t i = a; i < b; i++) {
+      if (h->corners > 2 && hull2_inside(h, h->v[i]))
+        continue;
+      if (h->out) {
+        h->out[o].x = h->v[i].x;
+        h->out[o].y = h->v[i].y;
+        h->out[o].id = i;
+      }
+      o++;
+    }
+    if (!h->out)
+      h->count[s + 1] = o;
+  }
+}
+
+static inline
+Float hull_cross(const HullPt *o, const HullPt *a, const HullPt *b) {
+  return (a->x - o->x) * (b->y - o->y) - (a->y - o->y) * (b->x - o->x);
+}
+
+/// vec2_hull_array ///
+// Description
+//   Finds the convex hull of a set of points with Andrew's monotone chain,
+//   after discarding the points that are clearly inside and sorting the rest
+//   in parallel. Points on the hull's edges but not at its corners are left
+//   out, as are repeated points.
+// Arguments
+//   idx: hull corners as point indices, counterclockwise from the leftmost,
+//        written; room for n (size_t*)
+//   v: points (Vec2*)
+//   n: point count (size_t)
+// Returns
+//   corner count (size_t), or SIZE_MAX if allocation fails
+
+sol_inline
+size_t vec2_hull_array(size_t *idx, const Vec2 *v, size_t n) {
+  if (!n)
+    return 0;
+  Hull2 *h = malloc(sizeof(Hull2));
+  if (!h)
+    return SIZE_MAX;
+  h->v = v;
+  h->n = n;
+  h->out = NULL;
+  sol_parallel_for(HULL_SLICES, n / HULL_SLICES * sizeof(Vec2) + 1, hull2_ext_task, h);
+  size_t ext[8];
+  Float best[8], key[8];
+  for (size_t k = 0; k < 8; k++) {
+    ext[k] = h->ext[0][k];
+    hull_keys(key, v[ext[k]]);
+    best[k] = key[k];
+    for (size_t s = 1; s < HULL_SLICES; s++) {
+      const size_t i = h->ext[s][k];
+      hull_keys(key, v[i]);
+      if (key[k] > best[k]) {
+        best[k] = key[k];
+        ext[k] = i;
+      }
+    }
+  }
+  // The extremes in key order already run counterclockwise; drop repeats.
+  h->corners = 0;
+  for (size_t k = 0; k < 8; k++) {
+    const Vec2 p = v[ext[k]];
+    const Float *q = h->corners ? h->oct[h->corners - 1] : NULL;
+    if (q && q[0] == p.x && q[1] == p.y)
+      continue;
+    h->oct[h->corners][0] = p.x;
+    h->oct[h->corners][1] = p.y;
+    h->corners++;
+  }
+  while (h->corners > 1 && h->oct[h->corners - 1][0] == h->oct[0][0] && h->oct[h->corners - 1][1] == h->oct[0][1])
+    h->corners--;
+  for (size_t k = 0; k < h->corners; k++) {
+    const Float *a = h->oct[k], *b = h->oct[(k + 1) % h->corners];
+    h->edge[k][0] = b[0] - a[0];
+    h->edge[k][1] = b[1] - a[1];
+  }
+  h->count[0] = 0;
+  sol_parallel_for(HULL_SLICES, n / HULL_SLICES * sizeof(Vec2) + 1, hull2_filter_task, h);
+  for (size_t s = 0; s < HULL_SLICES; s++)
+    h->count[s + 1] += h->count[s];
+  const size_t m = h->count[HULL_SLICES];
+  HullPt *p = malloc(m * sizeof(HullPt));
+  HullPt *tmp = malloc(m * sizeof(HullPt));
+  size_t *chain = malloc((m + 1) * sizeof(size_t));
+  size_t k = SIZE_MAX;
+  if (p && tmp && chain) {
+    h->out = p;
+    sol_parallel_for(HULL_SLICES, n / HULL_SLICES * sizeof(Vec2) + 1, hull2_filter_task, h);
+    const HullPt *s = hull_sort(p, tmp, m);
+    // Lower hull left to right, then upper hull right to left.
+    k = 0;
+    for (size_t i = 0; i < m; i++) {
+      if (i && s[i].x == s[i - 1].x && s[i].y == s[i - 1].y)
+        continue;
+      while (k >= 2 && hull_cross(&s[chain[k - 2]], &s[chain[k - 1]], &s[i]) <= 0)
+        k--;
+      chain[k++] = i;
+    }
+    const size_t lower = k + 1;
+    for (size_t i = m - 1; i-- > 0;) {
+      if (s[i].x == s[i + 1].x && s[i].y == s[i + 1].y)
+        continue;
+      while (k >= lower && hull_cross(&s[chain[k - 2]], &s[chain[k - 1]], &s[i]) <= 0)
+        k--;
+      chain[k++] = i;
+    }
+    k -= k > 1; // The chain ends where it started.
+    for (size_t i = 0; i < k; i++)
+      idx[i] = s[chain[i]].id;
+  }
+  free(p);
+  free(tmp);
+  free(chain);
+  free(h);
+  return k;
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Quickhull /////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Faces are triangles kept counterclockwise from outside, each with its
+// three neighbours and the list of points above it. Every step takes the
+// face whose list is nonempty, finds the point furthest above it (the eye),
+// walks the faces the eye can see, replaces them with a fan from the eye to
+// the horizon, and hands the points above the old faces to the new ones;
+// points above none of them are inside for good. Points within QH_EPS of a
+// plane count as on it, and so does the eye: faces it is that close to are
+// replaced as well, since fanning from their edges leaves slivers whose
+// normals are mostly rounding error.
+
+#if SOL_F_SIZE > 64
+      #define QH_EPS LDBL_EPSILON
+#elif SOL_F_SIZE > 32
+      #define QH_EPS DBL_EPSILON
+#else
+      #define QH_EPS FLT_EPSILON
+#endif
+
+#define QH_NONE SIZE_MAX
+
+typedef struct {
+  size_t v[3]; // Points, counterclockwise from outside.
+  size_t adj[3]; // Face across the edge from v[k] to v[k + 1].
+  Float n[3], d; // Outward plane, n.p = d.
+  size_t head; // First point above this face.
+  size_t eye; // Furthest point above it.
+  Float far;
+  size_t stamp;
+  bool live, vis;
+} QhFace;
+
+typedef struct {
+  size_t n;
+  Float *x, *y, *z;
+  size_t *next; // Links the points above each face.
+  size_t *slot; // New face starting at each horizon point.
+  Float *tx, *ty, *tz, *dist; // Points being handed to new faces.
+  size_t *tid;
+  size_t *stack; // Faces seen from the eye, one per face.
+  size_t (*edge)[2]; // Horizon, as (face, edge) pairs, three per face.
+  QhFace *f;
+  size_t nf, cap;
+  Float eps;
+  size_t stamp;
+  bool fail; // Faces could not be allocated.
+} Qh;
+
+static
+bool qh_alloc(Qh *q, size_t n) {
+  memset(q, 0, sizeof(Qh));
+  q->n = n;
+  q->x = malloc(8 * n * sizeof(Float));
+  q->next = malloc(3 * n * sizeof(size_t));
+  if (!q->x || !q->next)
+    return false;
+  q->y = q->x + n;
+  q->z = q->y + n;
+  q->tx = q->z + n;
+  q->ty = q->tx + n;
+  q->tz = q->ty + n;
+  q->dist = q->tz + n;
+  q->slot = q->next + n;
+  q->tid = q->slot + n;
+  return true;
+}
+
+static
+void qh_free(Qh *q) {
+  free(q->x);
+  free(q->next);
+  free(q->stack);
+  free(q->edge);
+  free(q->f);
+}
+
+static
+size_t qh_face(Qh *q, size_t a, size_t b, size_t c) {
+  if (q->nf == q->cap) {
+    const size_t cap = q->cap ? q->cap * 2 : 64;
+    QhFace *f = realloc(q->f, cap * sizeof(QhFace));
+    size_t *stack = realloc(q->stack, cap * sizeof(size_t));
+    size_t (*edge)[2] = realloc(q->edge, 3 * cap * sizeof(*edge));
+    if (f)
+      q->f = f;
+    if (stack)
+      q->stack = stack;
+    if (edge)
+      q->edge = edge;
+    if (!f || !stack || !edge) {
+      q->fail = true;
+      return QH_NONE;
+    }
+    q->cap = cap;
+  }
+  QhFace *f = &q->f[q->nf];
+  const Float ux = q->x[b] - q->x[a], uy = q->y[b] - q->y[a], uz = q->z[b] - q->z[a];
+  const Float vx = q->x[c] - q->x[a], vy = q->y[c] - q->y[a], vz = q->z[c] - q->z[a];
+  Float n[3] = {uy * vz - uz * vy, uz * vx - ux * vz, ux * vy - uy * vx};
+  const Float m = flt_sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+  for (size_t k = 0; k < 3; k++)
+    f->n[k] = m > 0 ? n[k] / m : 0;
+  f->d = f->n[0] * q->x[a] + f->n[1] * q->y[a] + f->n[2] * q->z[a];
+  f->v[0] = a;
+  f->v[1] = b;
+  f->v[2] = c;
+  f->adj[0] = f->adj[1] = f->adj[2] = QH_NONE;
+  f->head = f->eye = QH_NONE;
+  f->far = 0;
+  f->stamp = 0;
+  f->live = true;
+  f->vis = false;
+  return q->nf++;
+}
+
+// Hands the m points in the scratch arrays to faces [lo, hi), each to the
+// first face it is above.
+static
+void qh_assign(Qh *q, size_t m, size_t lo, size_t hi) {
+  for (size_t fi = lo; fi < hi && m; fi++) {
+    QhFace *f = &q->f[fi];
+    hull_dist(q->dist, q->tx, q->ty, q->tz, m, f->n, f->d);
+    size_t keep = 0;
+    for (size_t i = 0; i < m; i++) {
+      const Float d = q->dist[i];
+      if (d > q->eps) {
+        q->next[q->tid[i]] = f->head;
+        f->head = q->tid[i];
+        if (d > f->far) {
+          f->far = d;
+          f->eye = q->tid[i];
+        }
+      } else {
+        q->tx[keep] = q->tx[i];
+        q->ty[keep] = q->ty[i];
+        q->tz[keep] = q->tz[i];
+        q->tid[keep] = q->tid[i];
+        keep++;
+      }
+    }
+    m = keep;
+  }
+}
+
+static
+size_t qh_far(const Qh *q, const Float n[3]) {
+  size_t best = 0;
+  Float bd = n[0] * q->x[0] + n[1] * q->y[0] + n[2] * q->z[0];
+  size_t i = 0;
+  while (i < q->n) {
+    const size_t m = q->n - i < 1024 ? q->n - i : 1024;
+    Float d[1024];
+    hull_dist(d, q->x + i, q->y + i, q->z + i, m, n, 0);
+    for (size_t j = 0; j < m; j++) {
+      if (d[j] > bd) {
+        bd = d[j];
+        best = i + j;
+      }
+    }
+    i += m;
+  }
+  return best;
+}
+
+// Builds the first tetrahedron from extreme points and hands every other
+// point to its faces. Returns false if the points are all but coplanar.
+static
+bool qh_init(Qh *q) {
+  Float scale = 0;
+  size_t ext[6];
+  for (size_t k = 0; k < 6; k++) {
+    Float n[3] = {0, 0, 0};
+    n[k / 2] = k & 1 ? -1 : 1;
+    ext[k] = qh_far(q, n);
+    const Float *c = k / 2 == 0 ? q->x : k / 2 == 1 ? q->y : q->z;
+    scale += c[ext[k]] < 0 ? -c[ext[k]] : c[ext[k]];
+  }
+  q->eps = 3 * scale * QH_EPS;
+  // The two extremes furthest apart.
+  size_t a = 0, b = 0;
+  Float best = -1;
+  for (size_t i = 0; i < 6; i++) {
+    for (size_t j = i + 1; j < 6; j++) {
+      const Float dx = q->x[ext[i]] - q->x[ext[j]];
+      const Float dy = q->y[ext[i]] - q->y[ext[j]];
+      const Float dz = q->z[ext[i]] - q->z[ext[j]];
+      const Float d = dx * dx + dy * dy + dz * dz;
+      if (d > best) {
+        best = d;
+        a = ext[i];
+        b = ext[j];
+      }
+    }
+  }
+  if (flt_sqrt(best) <= q->eps)
+    return false;
+  // The point furthest from their line.
+  const Float ux = q->x[b] - q->x[a], uy = q->y[b] - q->y[a], uz = q->z[b] - q->z[a];
+  size_t c = a;
+  best = 0;
+  for (size_t i = 0; i < q->n; i++) {
+    const Float px = q->x[i] - q->x[a], py = q->y[i] - q->y[a], pz = q->z[i] - q->z[a];
+    const Float cx = uy * pz - uz * py, cy = uz * px - ux * pz, cz = ux * py - uy * px;
+    const Float d = cx * cx + cy * cy + cz * cz;
+    if (d > best) {
+      best = d;
+      c = i;
+    }
+  }
+  if (flt_sqrt(best) <= q->eps * flt_sqrt(ux * ux + uy * uy + uz * uz))
+    return false;
+  // The point furthest from their plane, on either side.
+  const size_t f0 = qh_face(q, a, b, c);
+  if (f0 == QH_NONE)
+    return false;
+  Float n[3] = {q->f[f0].n[0], q->f[f0].n[1], q->f[f0].n[2]};
+  const size_t up = qh_far(q, n);
+  n[0] = -n[0];
+  n[1] = -n[1];
+  n[2] = -n[2];
+  const size_t down = qh_far(q, n);
+  const Float du = q->x[up] * -n[0] + q->y[up] * -n[1] + q->z[up] * -n[2] - q->f[f0].d;
+  const Float dd = q->x[down] * -n[0] + q->y[down] * -n[1] + q->z[down] * -n[2] - q->f[f0].d;
+  const size_t d = du > -dd ? up : down;
+  if ((du > -dd ? du : -dd) <= q->eps)
+    return false;
+  // Four faces with the fourth point below each.
+  q->nf = 0;
+  const size_t tet[4][4] = {{a, b, c, d}, {a, d, b, c}, {b, d, c, a}, {c, d, a, b}};
+  for (size_t k = 0; k < 4; k++) {
+    size_t fi = qh_face(q, tet[k][0], tet[k][1], tet[k][2]);
+    if (fi == QH_NONE)
+      return false;
+    const size_t o = tet[k][3];
+    const QhFace *f = &q->f[fi];
+    if (f->n[0] * q->x[o] + f->n[1] * q->y[o] + f->n[2] * q->z[o] > f->d) {
+      q->nf--;
+      fi = qh_face(q, tet[k][0], tet[k][2], tet[k][1]);
+    }
+  }
+  for (size_t i = 0; i < 4; i++)
+    for (size_t k = 0; k < 3; k++)
+      for (size_t j = 0; j < 4; j++)
+        for (size_t l = 0; l < 3; l++)
+          if (q->f[j].v[l] == q->f[i].v[(k + 1) % 3] && q->f[j].v[(l + 1) % 3] == q->f[i].v[k])
+            q->f[i].adj[k] = j;
+  size_t m = 0;
+  for (size_t i = 0; i < q->n; i++) {
+    if (i == a || i == b || i == c || i == d)
+      continue;
+    q->tx[m] = q->x[i];
+    q->ty[m] = q->y[i];
+    q->tz[m] = q->z[i];
+    q->tid[m] = i;
+    m++;
+  }
+  qh_assign(q, m, 0, 4);
+  return true;
+}
+
+// Whether the fan face over edge k of the visible face g would fold back
+// over the face h beyond it: seen along either face's normal, the eye is on
+// h's side of the edge. The eye would then see h too, but near-coplanar
+// faces can say otherwise within QH_EPS, so h is taken as visible anyway.
+static inline
+bool qh_folds(const Qh *q, const QhFace *g, size_t k, const QhFace *h, Float ex, Float ey, Float ez) {
+  const size_t a = g->v[k], b = g->v[(k + 1) % 3];
+  const Float ux = q->x[b] - q->x[a], uy = q->y[b] - q->y[a], uz = q->z[b] - q->z[a];
+  const Float wx = ex - q->x[a], wy = ey - q->y[a], wz = ez - q->z[a];
+  const Float cx = uy * wz - uz * wy, cy = uz * wx - ux * wz, cz = ux * wy - uy * wx;
+  return cx * g->n[0] + cy * g->n[1] + cz * g->n[2] < 0 && cx * h->n[0] + cy * h->n[1] + cz * h->n[2] < 0;
+}
+
+// Adds the eye of face fi to the hull. Returns false if allocation fails.
+static
+bool qh_step(Qh *q, size_t fi) {
+  const size_t eye = q->f[fi].eye;
+  const Float ex = q->x[eye], ey = q->y[eye], ez = q->z[eye];
+  const size_t stamp = ++q->stamp;
+  size_t top = 0, ne = 0, m = 0;
+  q->f[fi].stamp = stamp;
+  q->f[fi].vis = true;
+  q->stack[top++] = fi;
+  while (top) {
+    QhFace *g = &q->f[q->stack[--top]];
+    g->live = false;
+    for (size_t p = g->head; p != QH_NONE; p = q->next[p]) {
+      if (p == eye)
+        continue;
+      q->tx[m] = q->x[p];
+      q->ty[m] = q->y[p];
+      q->tz[m] = q->z[p];
+      q->tid[m] = p;
+      m++;
+    }
+    for (size_t k = 0; k < 3; k++) {
+      QhFace *h = &q->f[g->adj[k]];
+      if (h->stamp != stamp) {
+        h->stamp = stamp;
+        h->vis = h->n[0] * ex + h->n[1] * ey + h->n[2] * ez - h->d > -q->eps;
+        if (h->vis)
+          q->stack[top++] = g->adj[k];
+      }
+      if (!h->vis && qh_folds(q, g, k, h, ex, ey, ez)) {
+        h->vis = true;
+        q->stack[top++] = g->adj[k];
+      }
+      if (!h->vis) {
+        q->edge[ne][0] = (size_t) (g - q->f);
+        q->edge[ne][1] = k;
+        ne++;
+      }
+    }
+  }
+  // Faces that joined late leave stale horizon edges behind.
+  size_t keep = 0;
+  for (size_t i = 0; i < ne; i++) {
+    const QhFace *g = &q->f[q->edge[i][0]];
+    if (!q->f[g->adj[q->edge[i][1]]].vis) {
+      q->edge[keep][0] = q->edge[i][0];
+      q->edge[keep][1] = q->edge[i][1];
+      keep++;
+    }
+  }
+  ne = keep;
+  // A fan of new faces from the horizon to the eye. qh_face may move the
+  // face array, so faces are only ever held by index across it.
+  const size_t lo = q->nf;
+  for (size_t i = 0; i < ne; i++) {
+    const size_t g = q->edge[i][0], k = q->edge[i][1];
+    const size_t a = q->f[g].v[k], b = q->f[g].v[(k + 1) % 3], h = q->f[g].adj[k];
+    const size_t fn = qh_face(q, a, b, eye);
+    if (fn == QH_NONE)
+      return false;
+    q->f[fn].adj[0] = h;
+    for (size_t l = 0; l < 3; l++)
+      if (q->f[h].v[l] == b && q->f[h].v[(l + 1) % 3] == a)
+        q->f[h].adj[l] = fn;
+    q->slot[a] = fn;
+  }
+  for (size_t fn = lo; fn < q->nf; fn++) {
+    const size_t next = q->slot[q->f[fn].v[1]];
+    q->f[fn].adj[1] = next;
+    q->f[next].adj[2] = fn;
+  }
+  qh_assign(q, m, lo, q->nf);
+  return true;
+}
+
+static
+bool qh_run(Qh *q) {
+  if (!qh_init(q))
+    return false;
+  for (size_t fi = 0; fi < q->nf; fi++)
+    if (q->f[fi].live && q->f[fi].head != QH_NONE && !qh_step(q, fi))
+      return false;
+  return true;
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // 3D Hulls //////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Large inputs are cut into HULL_SLICES parts whose hulls are found in
+// parallel; only their corners go on to the final hull. A part too flat to
+// have a hull passes all of its points on instead.
+
+#define HULL_PART (64 * 1024) // Fewest points worth a part of their own.
+
+typedef struct {
+  const Vec3p *v;
+  size_t n, parts;
+  size_t *keep; // Per point: whether it goes on to the final hull.
+  bool fail;
+} Hull3;
+
+static
+void hull3_task(void *ctx, size_t lo, size_t hi) {
+  Hull3 *h = ctx;
+  for (size_t s = lo; s < hi; s++) {
+    const size_t a = h->n * s / h->parts, b = h->n * (s + 1) / h->parts;
+    Qh q;
+    if (!qh_alloc(&q, b - a)) {
+      qh_free(&q);
+      h->fail = true;
+      continue;
+    }
+    for (size_t i = a; i < b; i++) {
+      q.x[i - a] = h->v[i].x;
+      q.y[i - a] = h->v[i].y;
+      q.z[i - a] = h->v[i].z;
+    }
+    if (qh_run(&q)) {
+      for (size_t i = a; i < b; i++)
+        h->keep[i] = false;
+      for (size_t fi = 0; fi < q.nf; fi++)
+        for (size_t k = 0; q.f[fi].live && k < 3; k++)
+          h->keep[a + q.f[fi].v[k]] = true;
+    } else if (q.fail) {
+      h->fail = true;
+    } else {
+      for (size_t i = a; i < b; i++)
+        h->keep[i] = true;
+    }
+    qh_free(&q);
+  }
+}
+
+/// vec3_hull_array ///
+// Description
+//   Finds the convex hull of a set of points with Quickhull, run in
+//   parallel over parts of large inputs before a final pass over their
+//   corners. Points on the hull's faces but not at its corners are left out.
+// Arguments
+//   idx: triangles as point indices, three each and counterclockwise seen
+//        from outside, written; room for 3 * (2 * n - 4) (size_t*)
+//   v: points (Vec3p*)
+//   n: point count (size_t)
+// Returns
+//   triangle count (size_t), 0 if there are fewer than four points or they
+//   are all but coplanar, or SIZE_MAX if allocation fails
+
+sol_inline
+size_t vec3_hull_array(size_t *idx, const Vec3p *v, size_t n) {
+  if (n < 4)
+    return 0;
+  Hull3 h = {v, n, n / HULL_PART, NULL, false};
+  h.parts = h.parts > HULL_SLICES ? HULL_SLICES : h.parts;
+  size_t m = n;
+  size_t *id = NULL;
+  if (h.parts > 1) {
+    h.keep = malloc(n * sizeof(size_t));
+    if (!h.keep)
+      return SIZE_MAX;
+    sol_parallel_for(h.parts, n / h.parts * 64 * sizeof(Vec3p), hull3_task, &h);
+    m = 0;
+    for (size_t i = 0; i < n; i++)
+      if (h.keep[i])
+        h.keep[m++] = i;
+    id = h.keep;
+  }
+  Qh q;
+  memset(&q, 0, sizeof(q));
+  size_t out = SIZE_MAX;
+  if (!h.fail && qh_alloc(&q, m)) {
+    for (size_t i = 0; i < m; i++) {
+      const size_t k = id ? id[i] : i;
+      q.x[i] = v[k].x;
+      q.y[i] = v[k].y;
+      q.z[i] = v[k].z;
+    }
+    if (qh_run(&q)) {
+      out = 0;
+      for (size_t fi = 0; fi < q.nf; fi++) {
+        if (!q.f[fi].live)
+          continue;
+        for (size_t k = 0; k < 3; k++)
+          idx[3 * out + k] = id ? id[q.f[fi].v[k]] : q.f[fi].v[k];
+        out++;
+      }
+    } else if (!q.fail) {
+      out = 0;
+    }
+  }
+  qh_free(&q);
+  free(h.keep);
+  return out;
+}
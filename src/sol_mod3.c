@@ -1 +1,868 @@
+    ////////////////////////////////////////////////////////////////////////////////
+   // sol_mod3.c //////////////////////////////////////////////////////////////////
+  // Description: Adds triangle meshes, raycasting and distance queries to Sol. //
+ // Author: David Garland (https://github.com/davidgarland/sol) /////////////////
+////////////////////////////////////////////////////////////////////////////////
 
+  //////////////////////////////////////////////////////////////////////////////
+ // Local Headers /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include "../sol.h"
+#include "sol_simd.h"
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Standard Headers //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Mesh Types ////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Triangles are stored transposed, MESH_BLOCK to a block: each block holds
+// the first corner and the two edges leaving it for all of its triangles, so
+// the kernels read every operand straight out of a Vec3x8 without gathering
+// vertices through the index buffer. The last block is padded by repeating
+// its last triangle, which can only ever tie with the original.
+//
+// Triangles are sorted along a Morton curve through their centroids before
+// being cut into blocks, so each block covers a small patch of the mesh. The
+// blocks are the leaves of a bounding volume hierarchy kept implicitly: node
+// k covers the blocks [lo, hi), its left child k + 1 the blocks [lo, mid) and
+// its right child k + 2 (mid - lo) the rest, with mid = lo + (hi - lo) / 2.
+// Only the boxes are stored, in that preorder. Leaf boxes are grown by
+// MESH_EPS of their size so that rounding in the kernels never lets a
+// triangle poke out of its box.
+
+#define MESH_BLOCK 8
+#define MESH_BITS 10 // Morton key bits per axis.
+#define MESH_DEPTH 64 // Traversal stack, plenty for 2^32 blocks.
+
+#if SOL_F_SIZE > 64
+      #define MESH_EPS (16 * LDBL_EPSILON)
+#elif SOL_F_SIZE > 32
+      #define MESH_EPS (16 * DBL_EPSILON)
+#else
+      #define MESH_EPS (16 * FLT_EPSILON)
+#endif
+
+typedef struct {
+  Vec3x8 v0, e1, e2;
+} MeshBlock;
+
+typedef struct {
+  Float lo[3], hi[3];
+} MeshNode;
+
+struct type_mesh {
+  MeshBlock *block;
+  MeshNode *node;
+  size_t *id; // Caller's index of the triangle in each block lane.
+  size_t n, blocks;
+};
+
+typedef struct {
+  Float o[3], d[3], inv[3];
+} MeshRay;
+
+typedef struct {
+  size_t k, lo, hi;
+  Float key; // Entry t or squared distance of the node's box.
+} MeshVisit;
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Intersection Kernel ///////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// A SimdReg holds SIMD_LANES triangles of a block, so a block takes one AVX
+// float iteration, two for AVX doubles or SSE floats and four for SSE doubles.
+// The tests run on numerators scaled by the determinant, so only registers
+// with a hit pay for a division.
+
+// Tests a ray against a whole block and returns one bit per triangle hit
+// before tmax, writing the hit's t, u and v into that triangle's lane. Lanes
+// without their bit set hold nothing useful.
+static inline
+unsigned mesh_block(Float *t, Float *u, Float *v, const MeshBlock *b, const MeshRay *r, Float tmax) {
+  unsigned bits = 0;
+  #if SIMD_LANES > 1
+        const SimdReg dx = simd_set1(r->d[0]), dy = simd_set1(r->d[1]), dz = simd_set1(r->d[2]);
+        const SimdReg ox = simd_set1(r->o[0]), oy = simd_set1(r->o[1]), oz = simd_set1(r->o[2]);
+        const SimdReg zero = simd_set1(0), one = simd_set1(1), neg = simd_set1(-0.0);
+        const SimdReg far = simd_set1(tmax);
+        for (size_t j = 0; j < MESH_BLOCK; j += SIMD_LANES) {
+          const SimdReg e1x = simd_load(b->e1.x + j), e1y = simd_load(b->e1.y + j), e1z = simd_load(b->e1.z + j);
+          const SimdReg e2x = simd_load(b->e2.x + j), e2y = simd_load(b->e2.y + j), e2z = simd_load(b->e2.z + j);
+          const SimdReg px = simd_sub(simd_mul(dy, e2z), simd_mul(dz, e2y));
+          const SimdReg py = simd_sub(simd_mul(dz, e2x), simd_mul(dx, e2z));
+          const SimdReg pz = simd_sub(simd_mul(dx, e2y), simd_mul(dy, e2x));
+          const SimdReg det = simd_add(simd_add(simd_mul(e1x, px), simd_mul(e1y, py)), simd_mul(e1z, pz));
+          const SimdReg sx = simd_sub(ox, simd_load(b->v0.x + j));
+          const SimdReg sy = simd_sub(oy, simd_load(b->v0.y + j));
+          const SimdReg sz = simd_sub(oz, simd_load(b->v0.z + j));
+          const SimdReg qx = simd_sub(simd_mul(sy, e1z), simd_mul(sz, e1y));
+          const SimdReg qy = simd_sub(simd_mul(sz, e1x), simd_mul(sx, e1z));
+          const SimdReg qz = simd_sub(simd_mul(sx, e1y), simd_mul(sy, e1x));
+          const SimdReg iu = simd_add(simd_add(simd_mul(sx, px), simd_mul(sy, py)), simd_mul(sz, pz));
+          const SimdReg iv = simd_add(simd_add(simd_mul(dx, qx), simd_mul(dy, qy)), simd_mul(dz, qz));
+          const SimdReg it = simd_add(simd_add(simd_mul(e2x, qx), simd_mul(e2y, qy)), simd_mul(e2z, qz));
+          // The bounds are scaled by the determinant, its sign moved onto
+          // the numerators; a zero determinant needs 0 <= it < 0 and fails.
+          const SimdReg sign = simd_and(det, neg);
+          const SimdReg ad = simd_xor(det, sign);
+          const SimdReg su = simd_xor(iu, sign), sv = simd_xor(iv, sign), st = simd_xor(it, sign);
+          SimdReg hit = simd_and(simd_le(zero, su), simd_le(zero, sv));
+          hit = simd_and(hit, simd_le(simd_add(su, sv), ad));
+          hit = simd_and(hit, simd_and(simd_le(zero, st), simd_lt(st, simd_mul(far, ad))));
+          const unsigned m = (unsigned) simd_bits(hit);
+          if (m) {
+            const SimdReg inv = simd_div(one, det);
+            simd_store(t + j, simd_mul(it, inv));
+            simd_store(u + j, simd_mul(iu, inv));
+            simd_store(v + j, simd_mul(iv, inv));
+            bits |= m << j;
+          }
+        }
+  #else
+        for (size_t j = 0; j < MESH_BLOCK; j++) {
+          const Float e1[3] = {b->e1.x[j], b->e1.y[j], b->e1.z[j]};
+          const Float e2[3] = {b->e2.x[j], b->e2.y[j], b->e2.z[j]};
+          const Float p[3] = {
+            r->d[1] * e2[2] - r->d[2] * e2[1],
+            r->d[2] * e2[0] - r->d[0] * e2[2],
+            r->d[0] * e2[1] - r->d[1] * e2[0]
+          };
+          const Float det = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+          if (det == 0)
+            continue;
+          const Float s[3] = {r->o[0] - b->v0.x[j], r->o[1] - b->v0.y[j], r->o[2] - b->v0.z[j]};
+          const Float q[3] = {
+            s[1] * e1[2] - s[2] * e1[1],
+            s[2] * e1[0] - s[0] * e1[2],
+            s[0] * e1[1] - s[1] * e1[0]
+          };
+          const Float inv = 1 / det;
+          const Float bu = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) * inv;
+          const Float bv = (r->d[0] * q[0] + r->d[1] * q[1] + r->d[2] * q[2]) * inv;
+          const Float bt = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) * inv;
+          if (bu >= 0 && bv >= 0 && bu + bv <= 1 && bt >= 0 && bt < tmax) {
+            t[j] = bt;
+            u[j] = bu;
+            v[j] = bv;
+            bits |= 1u << j;
+          }
+        }
+  #endif
+  return bits;
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Closest Point Kernel //////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// The closest point on a triangle to p is found by Voronoi region (Ericson,
+// "Real-Time Collision Detection", 5.1.5): the corner, edge or face region p
+// falls in gives the barycentrics (v, w) of the point a + v ab + w ac. The
+// register version works out every region's answer and blends them from the
+// lowest to the highest priority, so lanes never branch. Triangles too thin
+// for the face region to be trusted, down to MESH_EPS of their squared sine,
+// are treated as their longest edge instead.
+
+#if SIMD_LANES > 1
+
+// Writes the closest points on SIMD_LANES triangles to SIMD_LANES points.
+static inline
+void mesh_closest(SimdReg out[3], const SimdReg p[3], const SimdReg a[3], const SimdReg ab[3], const SimdReg ac[3]) {
+  const SimdReg zero = simd_set1(0), one = simd_set1(1), eps = simd_set1(MESH_EPS);
+  const SimdReg ap[3] = {simd_sub(p[0], a[0]), simd_sub(p[1], a[1]), simd_sub(p[2], a[2])};
+  const SimdReg d1 = simd_add(simd_add(simd_mul(ab[0], ap[0]), simd_mul(ab[1], ap[1])), simd_mul(ab[2], ap[2]));
+  const SimdReg d2 = simd_add(simd_add(simd_mul(ac[0], ap[0]), simd_mul(ac[1], ap[1])), simd_mul(ac[2], ap[2]));
+  const SimdReg aa = simd_add(simd_add(simd_mul(ab[0], ab[0]), simd_mul(ab[1], ab[1])), simd_mul(ab[2], ab[2]));
+  const SimdReg bc = simd_add(simd_add(simd_mul(ab[0], ac[0]), simd_mul(ab[1], ac[1])), simd_mul(ab[2], ac[2]));
+  const SimdReg cc = simd_add(simd_add(simd_mul(ac[0], ac[0]), simd_mul(ac[1], ac[1])), simd_mul(ac[2], ac[2]));
+  const SimdReg d3 = simd_sub(d1, aa), d4 = simd_sub(d2, bc);
+  const SimdReg d5 = simd_sub(d1, bc), d6 = simd_sub(d2, cc);
+  const SimdReg va = simd_sub(simd_mul(d3, d6), simd_mul(d5, d4));
+  const SimdReg vb = simd_sub(simd_mul(d5, d2), simd_mul(d1, d6));
+  const SimdReg vc = simd_sub(simd_mul(d1, d4), simd_mul(d3, d2));
+  const SimdReg area = simd_add(simd_add(va, vb), vc);
+  const SimdReg e43 = simd_sub(d4, d3), e56 = simd_sub(d5, d6);
+  const SimdReg e13 = simd_sub(d1, d3), e26 = simd_sub(d2, d6), e4356 = simd_add(e43, e56);
+  SimdReg m, v = zero, w = zero;
+  // Face.
+  m = simd_lt(zero, area);
+  v = simd_sel(m, simd_div(vb, area), v);
+  w = simd_sel(m, simd_div(vc, area), w);
+  // Edge bc.
+  m = simd_and(simd_and(simd_le(va, zero), simd_le(zero, e43)), simd_and(simd_le(zero, e56), simd_lt(zero, e4356)));
+  const SimdReg f = simd_div(e43, e4356);
+  v = simd_sel(m, simd_sub(one, f), v);
+  w = simd_sel(m, f, w);
+  // Edge ac.
+  m = simd_and(simd_and(simd_le(vb, zero), simd_le(zero, d2)), simd_and(simd_le(d6, zero), simd_lt(zero, e26)));
+  v = simd_sel(m, zero, v);
+  w = simd_sel(m, simd_div(d2, e26), w);
+  // Corner c.
+  m = simd_and(simd_le(zero, d6), simd_le(d5, d6));
+  v = simd_sel(m, zero, v);
+  w = simd_sel(m, one, w);
+  // Edge ab.
+  m = simd_and(simd_and(simd_le(vc, zero), simd_le(zero, d1)), simd_and(simd_le(d3, zero), simd_lt(zero, e13)));
+  v = simd_sel(m, simd_div(d1, e13), v);
+  w = simd_sel(m, zero, w);
+  // Corner b.
+  m = simd_and(simd_le(zero, d3), simd_le(d4, d3));
+  v = simd_sel(m, one, v);
+  w = simd_sel(m, zero, w);
+  // Corner a.
+  m = simd_and(simd_le(d1, zero), simd_le(d2, zero));
+  v = simd_sel(m, zero, v);
+  w = simd_sel(m, zero, w);
+  // Thin triangles, projected onto the longest edge.
+  const SimdReg bb = simd_sub(simd_add(aa, cc), simd_add(bc, bc));
+  const SimdReg ca = simd_lt(aa, cc), cb = simd_lt(simd_max(aa, cc), bb);
+  const SimdReg len = simd_sel(cb, bb, simd_max(aa, cc));
+  SimdReg t = simd_sel(cb, simd_sub(d2, d1), simd_sel(ca, d2, d1));
+  t = simd_sel(cb, simd_add(t, simd_sub(aa, bc)), t); // From b, not a.
+  t = simd_sel(simd_lt(zero, len), simd_div(t, len), zero);
+  t = simd_max(simd_min(t, one), zero);
+  m = simd_le(simd_sub(simd_mul(aa, cc), simd_mul(bc, bc)), simd_mul(eps, simd_mul(aa, cc)));
+  v = simd_sel(m, simd_sel(cb, simd_sub(one, t), simd_sel(ca, zero, t)), v);
+  w = simd_sel(m, simd_sel(cb, t, simd_sel(ca, t, zero)), w);
+  for (size_t k = 0; k < 3; k++)
+    out[k] = simd_add(a[k], simd_add(simd_mul(ab[k], v), simd_mul(ac[k], w)));
+}
+
+#endif
+
+// The same for a single triangle, taking the first region that matches.
+static inline
+void mesh_closest1(Float out[3], const Float p[3], const Float a[3], const Float ab[3], const Float ac[3]) {
+  const Float ap[3] = {p[0] - a[0], p[1] - a[1], p[2] - a[2]};
+  const Float d1 = ab[0] * ap[0] + ab[1] * ap[1] + ab[2] * ap[2];
+  const Float d2 = ac[0] * ap[0] + ac[1] * ap[1] + ac[2] * ap[2];
+  const Float aa = ab[0] * ab[0] + ab[1] * ab[1] + ab[2] * ab[2];
+  const Float bc = ab[0] * ac[0] + ab[1] * ac[1] + ab[2] * ac[2];
+  const Float cc = ac[0] * ac[0] + ac[1] * ac[1] + ac[2] * ac[2];
+  const Float d3 = d1 - aa, d4 = d2 - bc, d5 = d1 - bc, d6 = d2 - cc;
+  const Float va = d3 * d6 - d5 * d4, vb = d5 * d2 - d1 * d6, vc = d1 * d4 - d3 * d2;
+  Float v = 0, w = 0;
+  if (aa * cc - bc * bc <= MESH_EPS * (aa * cc)) {
+    const Float bb = aa + cc - 2 * bc;
+    const bool ca = aa < cc, cb = (ca ? cc : aa) < bb;
+    const Float len = cb ? bb : (ca ? cc : aa);
+    Float t = cb ? d2 - d1 + aa - bc : (ca ? d2 : d1);
+    t = len > 0 ? t / len : 0;
+    t = t < 0 ? 0 : (t > 1 ? 1 : t);
+    v = cb ? 1 - t : (ca ? 0 : t);
+    w = cb || ca ? t : 0;
+  } else if (d1 <= 0 && d2 <= 0) {
+    v = w = 0;
+  } else if (d3 >= 0 && d4 <= d3) {
+    v = 1;
+  } else if (vc <= 0 && d1 >= 0 && d3 <= 0 && d1 - d3 > 0) {
+    v = d1 / (d1 - d3);
+  } else if (d6 >= 0 && d5 <= d6) {
+    w = 1;
+  } else if (vb <= 0 && d2 >= 0 && d6 <= 0 && d2 - d6 > 0) {
+    w = d2 / (d2 - d6);
+  } else if (va <= 0 && d4 - d3 >= 0 && d5 - d6 >= 0 && (d4 - d3) + (d5 - d6) > 0) {
+    w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+    v = 1 - w;
+  } else if (va + vb + vc > 0) {
+    v = vb / (va + vb + vc);
+    w = vc / (va + vb + vc);
+  }
+  for (size_t k = 0; k < 3; k++)
+    out[k] = a[k] + ab[k] * v + ac[k] * w;
+}
+
+// Writes the squared distances from p to every triangle of a block.
+static inline
+void mesh_block_dist(Float *d2, const MeshBlock *b, const Float p[3]) {
+  #if SIMD_LANES > 1
+        const SimdReg q[3] = {simd_set1(p[0]), simd_set1(p[1]), simd_set1(p[2])};
+        for (size_t j = 0; j < MESH_BLOCK; j += SIMD_LANES) {
+          const SimdReg a[3] = {simd_load(b->v0.x + j), simd_load(b->v0.y + j), simd_load(b->v0.z + j)};
+          const SimdReg ab[3] = {simd_load(b->e1.x + j), simd_load(b->e1.y + j), simd_load(b->e1.z + j)};
+          const SimdReg ac[3] = {simd_load(b->e2.x + j), simd_load(b->e2.y + j), simd_load(b->e2.z + j)};
+          SimdReg c[3];
+          mesh_closest(c, q, a, ab, ac);
+          const SimdReg dx = simd_sub(c[0], q[0]), dy = simd_sub(c[1], q[1]), dz = simd_sub(c[2], q[2]);
+          simd_store(d2 + j, simd_add(simd_add(simd_mul(dx, dx), simd_mul(dy, dy)), simd_mul(dz, dz)));
+        }
+  #else
+        for (size_t j = 0; j < MESH_BLOCK; j++) {
+          const Float a[3] = {b->v0.x[j], b->v0.y[j], b->v0.z[j]};
+          const Float ab[3] = {b->e1.x[j], b->e1.y[j], b->e1.z[j]};
+          const Float ac[3] = {b->e2.x[j], b->e2.y[j], b->e2.z[j]};
+          Float c[3];
+          mesh_closest1(c, p, a, ab, ac);
+          d2[j] = (c[0] - p[0]) * (c[0] - p[0]) + (c[1] - p[1]) * (c[1] - p[1]) + (c[2] - p[2]) * (c[2] - p[2]);
+        }
+  #endif
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Hierarchy Traversal ///////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+static inline
+MeshRay mesh_ray(Seg3 s) {
+  MeshRay r = {
+    {s.orig.x, s.orig.y, s.orig.z},
+    {s.dest.x - s.orig.x, s.dest.y - s.orig.y, s.dest.z - s.orig.z},
+    {0, 0, 0}
+  };
+  for (size_t k = 0; k < 3; k++)
+    r.inv[k] = r.d[k] != 0 ? 1 / r.d[k] : 0;
+  return r;
+}
+
+// Clips the ray to a box, writing where it enters. Axes the ray runs along
+// only check that the origin is between the planes.
+static inline
+bool mesh_slab(Float *enter, const MeshNode *b, const MeshRay *r, Float tmax) {
+  Float t0 = 0, t1 = tmax;
+  for (size_t k = 0; k < 3; k++) {
+    if (r->d[k] == 0) {
+      if (r->o[k] < b->lo[k] || r->o[k] > b->hi[k])
+        return false;
+      continue;
+    }
+    Float a = (b->lo[k] - r->o[k]) * r->inv[k], c = (b->hi[k] - r->o[k]) * r->inv[k];
+    if (a > c) {
+      const Float t = a;
+      a = c;
+      c = t;
+    }
+    t0 = a > t0 ? a : t0;
+    t1 = c < t1 ? c : t1;
+  }
+  *enter = t0;
+  return t0 <= t1;
+}
+
+static inline
+Float mesh_box_dist(const MeshNode *b, const Float p[3]) {
+  Float d2 = 0;
+  for (size_t k = 0; k < 3; k++) {
+    const Float d = p[k] < b->lo[k] ? b->lo[k] - p[k] : p[k] > b->hi[k] ? p[k] - b->hi[k] : 0;
+    d2 += d * d;
+  }
+  return d2;
+}
+
+// Walks the hierarchy nearest box first, shrinking tmax to each hit so that
+// boxes and triangles further along the ray are skipped. With any set, the
+// first hit found wins.
+static
+bool mesh_cast(SolHit *hit, const SolMesh *m, Seg3 ray, bool any) {
+  const MeshRay r = mesh_ray(ray);
+  Float t[MESH_BLOCK], u[MESH_BLOCK], v[MESH_BLOCK];
+  Float tmax = 1, enter;
+  bool found = false;
+  MeshVisit stack[MESH_DEPTH];
+  size_t top = 0;
+  if (m->blocks && mesh_slab(&enter, m->node, &r, tmax))
+    stack[top++] = (MeshVisit) {0, 0, m->blocks, enter};
+  while (top) {
+    const MeshVisit n = stack[--top];
+    if (n.key >= tmax)
+      continue;
+    if (n.hi - n.lo == 1) {
+      unsigned bits = mesh_block(t, u, v, m->block + n.lo, &r, tmax);
+      if (bits && any)
+        return true;
+      for (size_t j = 0; bits; j++, bits >>= 1) {
+        if ((bits & 1) && t[j] < tmax) {
+          tmax = t[j];
+          hit->t = t[j];
+          hit->u = u[j];
+          hit->v = v[j];
+          hit->tri = m->id[n.lo * MESH_BLOCK + j];
+          found = true;
+        }
+      }
+      continue;
+    }
+    const size_t mid = n.lo + (n.hi - n.lo) / 2;
+    MeshVisit l = {n.k + 1, n.lo, mid, 0}, h = {n.k + 2 * (mid - n.lo), mid, n.hi, 0};
+    const bool hl = mesh_slab(&l.key, m->node + l.k, &r, tmax);
+    const bool hh = mesh_slab(&h.key, m->node + h.k, &r, tmax);
+    if (hl && hh && h.key < l.key) {
+      stack[top++] = l;
+      stack[top++] = h;
+    } else {
+      if (hh)
+        stack[top++] = h;
+      if (hl)
+        stack[top++] = l;
+    }
+  }
+  return found;
+}
+
+// Walks the hierarchy nearest box first, skipping boxes further away than
+// the nearest triangle so far. Returns the squared distance.
+static
+Float mesh_nearest(size_t *tri, const SolMesh *m, const Float p[3]) {
+  Float d2[MESH_BLOCK];
+  Float best = INFINITY;
+  MeshVisit stack[MESH_DEPTH];
+  size_t top = 0;
+  *tri = SIZE_MAX;
+  if (m->blocks)
+    stack[top++] = (MeshVisit) {0, 0, m->blocks, mesh_box_dist(m->node, p)};
+  while (top) {
+    const MeshVisit n = stack[--top];
+    if (n.key >= best)
+      continue;
+    if (n.hi - n.lo == 1) {
+      mesh_block_dist(d2, m->block + n.lo, p);
+      for (size_t j = 0; j < MESH_BLOCK; j++) {
+        if (d2[j] < best) {
+          best = d2[j];
+          *tri = m->id[n.lo * MESH_BLOCK + j];
+        }
+      }
+      continue;
+    }
+    const size_t mid = n.lo + (n.hi - n.lo) / 2;
+    MeshVisit l = {n.k + 1, n.lo, mid, 0}, h = {n.k + 2 * (mid - n.lo), mid, n.hi, 0};
+    l.key = mesh_box_dist(m->node + l.k, p);
+    h.key = mesh_box_dist(m->node + h.k, p);
+    if (h.key < l.key) {
+      stack[top++] = l;
+      stack[top++] = h;
+    } else {
+      stack[top++] = h;
+      stack[top++] = l;
+    }
+  }
+  return best;
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Hierarchy Construction ////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+typedef struct {
+  SolMesh *m;
+  const Vec3p *v;
+  const uint32_t *idx;
+  uint32_t *key;
+  size_t *order;
+  Float lo[3], scale;
+} MeshBuild;
+
+static inline
+uint32_t mesh_spread(uint32_t v) {
+  v &= 0x3FF;
+  v = (v | v << 16) & 0x30000FF;
+  v = (v | v << 8) & 0x300F00F;
+  v = (v | v << 4) & 0x30C30C3;
+  v = (v | v << 2) & 0x9249249;
+  return v;
+}
+
+static inline
+void mesh_centroid(Float c[3], const MeshBuild *j, size_t i) {
+  const Vec3p a = j->v[j->idx[3 * i]], b = j->v[j->idx[3 * i + 1]], d = j->v[j->idx[3 * i + 2]];
+  c[0] = (a.x + b.x + d.x) / 3;
+  c[1] = (a.y + b.y + d.y) / 3;
+  c[2] = (a.z + b.z + d.z) / 3;
+}
+
+static
+void mesh_key_task(void *ctx, size_t lo, size_t hi) {
+  MeshBuild *j = ctx;
+  const Float top = (Float) ((1 << MESH_BITS) - 1);
+  for (size_t i = lo; i < hi; i++) {
+    Float c[3];
+    mesh_centroid(c, j, i);
+    uint32_t key = 0;
+    for (size_t d = 0; d < 3; d++) {
+      Float f = (c[d] - j->lo[d]) * j->scale;
+      f = f < 0 ? 0 : (f > top ? top : f);
+      key |= mesh_spread((uint32_t) f) << (2 - d);
+    }
+    j->key[i] = key;
+    j->order[i] = i;
+  }
+}
+
+// Sorts the triangle order by key, 11 bits a pass.
+static
+bool mesh_sort(MeshBuild *j) {
+  const size_t n = j->m->n;
+  uint32_t *key = malloc(n * sizeof(uint32_t));
+  size_t *order = malloc(n * sizeof(size_t));
+  size_t *count = malloc(2049 * sizeof(size_t));
+  const bool ok = key && order && count;
+  for (size_t shift = 0; ok && shift < 3 * MESH_BITS; shift += 11) {
+    memset(count, 0, 2049 * sizeof(size_t));
+    for (size_t i = 0; i < n; i++)
+      count[((j->key[i] >> shift) & 2047) + 1]++;
+    for (size_t b = 0; b < 2048; b++)
+      count[b + 1] += count[b];
+    for (size_t i = 0; i < n; i++) {
+      const size_t to = count[(j->key[i] >> shift) & 2047]++;
+      key[to] = j->key[i];
+      order[to] = j->order[i];
+    }
+    uint32_t *tk = j->key;
+    size_t *to = j->order;
+    j->key = key;
+    j->order = order;
+    key = tk;
+    order = to;
+  }
+  free(key);
+  free(order);
+  free(count);
+  return ok;
+}
+
+static
+void mesh_block_task(void *ctx, size_t lo, size_t hi) {
+  const MeshBuild *j = ctx;
+  SolMesh *m = j->m;
+  for (size_t k = lo; k < hi; k++) {
+    MeshBlock *b = m->block + k;
+    MeshNode *box = m->node + k; // Leaf boxes in block order, for now.
+    for (size_t d = 0; d < 3; d++) {
+      box->lo[d] = INFINITY;
+      box->hi[d] = -INFINITY;
+    }
+    for (size_t l = 0; l < MESH_BLOCK; l++) {
+      const size_t s = k * MESH_BLOCK + l;
+      const size_t i = j->order[s < m->n ? s : m->n - 1];
+      const Vec3p a = j->v[j->idx[3 * i]];
+      const Vec3p p = j->v[j->idx[3 * i + 1]];
+      const Vec3p q = j->v[j->idx[3 * i + 2]];
+      m->id[s] = i;
+      b->v0.x[l] = a.x;
+      b->v0.y[l] = a.y;
+      b->v0.z[l] = a.z;
+      b->e1.x[l] = p.x - a.x;
+      b->e1.y[l] = p.y - a.y;
+      b->e1.z[l] = p.z - a.z;
+      b->e2.x[l] = q.x - a.x;
+      b->e2.y[l] = q.y - a.y;
+      b->e2.z[l] = q.z - a.z;
+      const Float c[3][3] = {{a.x, a.y, a.z}, {p.x, p.y, p.z}, {q.x, q.y, q.z}};
+      for (size_t e = 0; e < 3; e++) {
+        for (size_t d = 0; d < 3; d++) {
+          box->lo[d] = c[e][d] < box->lo[d] ? c[e][d] : box->lo[d];
+          box->hi[d] = c[e][d] > box->hi[d] ? c[e][d] : box->hi[d];
+        }
+      }
+    }
+    for (size_t d = 0; d < 3; d++) {
+      const Float al = box->lo[d] < 0 ? -box->lo[d] : box->lo[d];
+      const Float ah = box->hi[d] < 0 ? -box->hi[d] : box->hi[d];
+      const Float pad = MESH_EPS * ((al > ah ? al : ah) + box->hi[d] - box->lo[d]);
+      box->lo[d] -= pad;
+      box->hi[d] += pad;
+    }
+  }
+}
+
+// Fills the boxes of node k, covering blocks [lo, hi), from the leaf boxes.
+static
+void mesh_node(MeshNode *node, const MeshNode *leaf, size_t k, size_t lo, size_t hi) {
+  if (hi - lo == 1) {
+    node[k] = leaf[lo];
+    return;
+  }
+  const size_t mid = lo + (hi - lo) / 2;
+  const size_t l = k + 1, h = k + 2 * (mid - lo);
+  mesh_node(node, leaf, l, lo, mid);
+  mesh_node(node, leaf, h, mid, hi);
+  for (size_t d = 0; d < 3; d++) {
+    node[k].lo[d] = node[l].lo[d] < node[h].lo[d] ? node[l].lo[d] : node[h].lo[d];
+    node[k].hi[d] = node[l].hi[d] > node[h].hi[d] ? node[l].hi[d] : node[h].hi[d];
+  }
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Mesh Tasks ////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+typedef struct {
+  const SolMesh *m;
+  const Seg3 *rays;
+  SolHit *hits;
+} MeshCast;
+
+static
+void mesh_cast_task(void *ctx, size_t lo, size_t hi) {
+  const MeshCast *j = ctx;
+  for (size_t i = lo; i < hi; i++) {
+    if (!mesh_cast(j->hits + i, j->m, j->rays[i], false)) {
+      j->hits[i].t = INFINITY;
+      j->hits[i].u = j->hits[i].v = 0;
+      j->hits[i].tri = SIZE_MAX;
+    }
+  }
+}
+
+typedef struct {
+  const SolMesh *m;
+  const Vec3p *p;
+  Float *dist;
+  size_t *tri;
+} MeshDist;
+
+static
+void mesh_dist_task(void *ctx, size_t lo, size_t hi) {
+  const MeshDist *j = ctx;
+  for (size_t i = lo; i < hi; i++) {
+    const Float p[3] = {j->p[i].x, j->p[i].y, j->p[i].z};
+    size_t tri;
+    j->dist[i] = flt_sqrt(mesh_nearest(&tri, j->m, p));
+    if (j->tri)
+      j->tri[i] = tri;
+  }
+}
+
+typedef struct {
+  Soa3 out, p, a, b, c;
+} MeshClosest;
+
+static
+void mesh_closest_task(void *ctx, size_t lo, size_t hi) {
+  const MeshClosest *j = ctx;
+  size_t i = lo;
+  #if SIMD_LANES > 1
+        for (; i + SIMD_LANES <= hi; i += SIMD_LANES) {
+          const SimdReg p[3] = {simd_load(j->p.x + i), simd_load(j->p.y + i), simd_load(j->p.z + i)};
+          const SimdReg a[3] = {simd_load(j->a.x + i), simd_load(j->a.y + i), simd_load(j->a.z + i)};
+          const SimdReg ab[3] = {
+            simd_sub(simd_load(j->b.x + i), a[0]),
+            simd_sub(simd_load(j->b.y + i), a[1]),
+            simd_sub(simd_load(j->b.z + i), a[2])
+          };
+          const SimdReg ac[3] = {
+            simd_sub(simd_load(j->c.x + i), a[0]),
+            simd_sub(simd_load(j->c.y + i), a[1]),
+            simd_sub(simd_load(j->c.z + i), a[2])
+          };
+          SimdReg out[3];
+          mesh_closest(out, p, a, ab, ac);
+          simd_store(j->out.x + i, out[0]);
+          simd_store(j->out.y + i, out[1]);
+          simd_store(j->out.z + i, out[2]);
+        }
+  #endif
+  for (; i < hi; i++) {
+    const Float p[3] = {j->p.x[i], j->p.y[i], j->p.z[i]};
+    const Float a[3] = {j->a.x[i], j->a.y[i], j->a.z[i]};
+    const Float ab[3] = {j->b.x[i] - a[0], j->b.y[i] - a[1], j->b.z[i] - a[2]};
+    const Float ac[3] = {j->c.x[i] - a[0], j->c.y[i] - a[1], j->c.z[i] - a[2]};
+    Float out[3];
+    mesh_closest1(out, p, a, ab, ac);
+    j->out.x[i] = out[0];
+    j->out.y[i] = out[1];
+    j->out.z[i] = out[2];
+  }
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Mesh Functions ////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+/// sol_mesh_init ///
+// Description
+//   Builds a triangle mesh for raycasting and distance queries from a vertex
+//   array and an index buffer, sorting the triangles into a bounding volume
+//   hierarchy. The vertices and indices are copied out and may be freed after.
+// Arguments
+//   v: vertices (Vec3p*)
+//   idx: three vertex indices per triangle (uint32_t*)
+//   n: triangle count (size_t)
+// Returns
+//   mesh (SolMesh*), or NULL if allocation fails
+
+sol_inline
+SolMesh *sol_mesh_init(const Vec3p *v, const uint32_t *idx, size_t n) {
+  SolMesh *m = malloc(sizeof(SolMesh));
+  if (!m)
+    return NULL;
+  m->n = n;
+  m->blocks = (n + MESH_BLOCK - 1) / MESH_BLOCK;
+  m->block = malloc((m->blocks ? m->blocks : 1) * sizeof(MeshBlock));
+  m->node = malloc((m->blocks ? 2 * m->blocks - 1 : 1) * sizeof(MeshNode));
+  m->id = malloc((m->blocks ? m->blocks : 1) * MESH_BLOCK * sizeof(size_t));
+  MeshNode *leaf = malloc((m->blocks ? m->blocks : 1) * sizeof(MeshNode));
+  MeshBuild j = {m, v, idx, malloc((n ? n : 1) * sizeof(uint32_t)), malloc((n ? n : 1) * sizeof(size_t)), {0, 0, 0}, 0};
+  bool ok = m->block && m->node && m->id && leaf && j.key && j.order;
+  if (ok && n) {
+    // Morton keys over the bounds of the centroids.
+    Float hi[3] = {-INFINITY, -INFINITY, -INFINITY}, size = 0;
+    j.lo[0] = j.lo[1] = j.lo[2] = INFINITY;
+    for (size_t i = 0; i < n; i++) {
+      Float c[3];
+      mesh_centroid(c, &j, i);
+      for (size_t d = 0; d < 3; d++) {
+        j.lo[d] = c[d] < j.lo[d] ? c[d] : j.lo[d];
+        hi[d] = c[d] > hi[d] ? c[d] : hi[d];
+      }
+    }
+    for (size_t d = 0; d < 3; d++)
+      size = hi[d] - j.lo[d] > size ? hi[d] - j.lo[d] : size;
+    j.scale = size > 0 ? (Float) (1 << MESH_BITS) / size : 0;
+    sol_parallel_for(n, sizeof(Vec3p) * 3, mesh_key_task, &j);
+    ok = mesh_sort(&j);
+  }
+  if (ok && n) {
+    MeshNode *node = m->node;
+    m->node = leaf;
+    sol_parallel_for(m->blocks, sizeof(MeshBlock) * 2, mesh_block_task, &j);
+    m->node = node;
+    mesh_node(node, leaf, 0, 0, m->blocks);
+  }
+  free(leaf);
+  free(j.key);
+  free(j.order);
+  if (!ok) {
+    sol_mesh_free(m);
+    return NULL;
+  }
+  return m;
+}
+
+/// sol_mesh_free ///
+// Description
+//   Frees a mesh.
+// Arguments
+//   m: mesh (SolMesh*)
+// Returns
+//   void
+
+sol_inline
+void sol_mesh_free(SolMesh *m) {
+  if (!m)
+    return;
+  free(m->block);
+  free(m->node);
+  free(m->id);
+  free(m);
+}
+
+/// sol_mesh_raycast ///
+// Description
+//   Finds the nearest triangle a ray hits. The ray runs from orig to dest and
+//   hits past dest are ignored; both faces of a triangle count.
+// Arguments
+//   hit: nearest hit, written only if there is one (SolHit*)
+//   m: mesh (SolMesh*)
+//   ray: ray (Seg3)
+// Returns
+//   whether the ray hits the mesh (bool)
+
+sol_inline
+bool sol_mesh_raycast(SolHit *hit, const SolMesh *m, Seg3 ray) {
+  return mesh_cast(hit, m, ray, false);
+}
+
+/// sol_mesh_occluded ///
+// Description
+//   Tests whether anything in the mesh lies between the two ends of a ray,
+//   stopping at the first hit found; cheaper than sol_mesh_raycast when only
+//   line of sight matters.
+// Arguments
+//   m: mesh (SolMesh*)
+//   ray: ray (Seg3)
+// Returns
+//   whether the ray hits the mesh (bool)
+
+sol_inline
+bool sol_mesh_occluded(const SolMesh *m, Seg3 ray) {
+  return mesh_cast(NULL, m, ray, true);
+}
+
+/// sol_mesh_raycast_array ///
+// Description
+//   Casts n rays in parallel with sol_mesh_raycast. Rays that miss get a t of
+//   infinity and a tri of SIZE_MAX.
+// Arguments
+//   hits: nearest hits (SolHit*)
+//   m: mesh (SolMesh*)
+//   rays: rays (Seg3*)
+//   n: ray count (size_t)
+// Returns
+//   void
+
+sol_inline
+void sol_mesh_raycast_array(SolHit *hits, const SolMesh *m, const Seg3 *rays, size_t n) {
+  MeshCast j = {m, rays, hits};
+  sol_parallel_for(n, m->blocks * sizeof(MeshBlock) + sizeof(Seg3), mesh_cast_task, &j);
+}
+
+/// sol_mesh_distance ///
+// Description
+//   Finds the unsigned distance from a point to the nearest triangle of a
+//   mesh.
+// Arguments
+//   tri: index of the nearest triangle, or NULL (size_t*)
+//   m: mesh (SolMesh*)
+//   p: point (Vec3)
+// Returns
+//   distance (Float), or infinity with a tri of SIZE_MAX for an empty mesh
+
+sol_inline
+Float sol_mesh_distance(size_t *tri, const SolMesh *m, Vec3 p) {
+  const Float q[3] = {p.x, p.y, p.z};
+  size_t k;
+  const Float d = flt_sqrt(mesh_nearest(&k, m, q));
+  if (tri)
+    *tri = k;
+  return d;
+}
+
+/// sol_mesh_distance_array ///
+// Description
+//   Finds the distances from n points to a mesh in parallel with
+//   sol_mesh_distance.
+// Arguments
+//   dist: distances (Float*)
+//   tri: indices of the nearest triangles, or NULL (size_t*)
+//   m: mesh (SolMesh*)
+//   p: points (Vec3p*)
+//   n: point count (size_t)
+// Returns
+//   void
+
+sol_inline
+void sol_mesh_distance_array(Float *dist, size_t *tri, const SolMesh *m, const Vec3p *p, size_t n) {
+  MeshDist j = {m, p, dist, tri};
+  sol_parallel_for(n, m->blocks * sizeof(MeshBlock) + sizeof(Vec3p), mesh_dist_task, &j);
+}
+
+/// vec3_closest_tri_array ///
+// Description
+//   Finds the closest point on each of n triangles to the matching point,
+//   branch free across SIMD lanes. Zero-area triangles give their nearest
+//   corner or edge point, or a when p projects onto their inside.
+// Arguments
+//   out: closest points (Soa3)
+//   p: points (Soa3)
+//   a, b, c: triangle corners (Soa3)
+//   n: triangle count (size_t)
+// Returns
+//   void
+
+sol_inline
+void vec3_closest_tri_array(Soa3 out, Soa3 p, Soa3 a, Soa3 b, Soa3 c, size_t n) {
+  MeshClosest j = {out, p, a, b, c};
+  sol_parallel_for(n, sizeof(Float) * 15, mesh_closest_task, &j);
+}
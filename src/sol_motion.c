@@ -0,0 +1,262 @@
+    /////////////////////////////////////////////////////////////////
+   // sol_motion.c /////////////////////////////////////////////////
+  // Description: Adds particle integrators to Sol. ///////////////
+ // Author: David Garland (https://github.com/davidgarland/sol) //
+/////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Local Headers /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include "../sol.h"
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Standard Headers //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <string.h>
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Step Kernels //////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Every kernel makes one pass over the buffers it touches, doing the kick,
+// drift, gravity, damping and walls for an element while it is in registers.
+// The dimensions of a Soa3 are independent, so each runs as its own loop of
+// straight-line, branch-free code over flat arrays, which the compiler turns
+// into full-width SIMD for every Float type. Tasks split the particles.
+
+typedef struct {
+  Soa3 pos, vel, acc;
+  Soa3 sp, sv, sa, dx, dv;  // RK4 stage state, stage acceleration and sums.
+  SolMotion m;
+  Float dt, decay;
+  int stage;
+} MotionJob;
+
+#define MOTION_SIZE (12 * sizeof(Float))
+
+static inline
+Float *motion_dim(Soa3 s, size_t d) {
+  return d == 0 ? s.x : (d == 1 ? s.y : s.z);
+}
+
+// Reflects positions that left [lo, hi] back inside and reverses their
+// velocity, keeping restitution e of the speed.
+static inline
+void motion_wall(Float *x, Float *v, size_t lo, size_t hi, const MotionJob *j, size_t d) {
+  const Float a = j->m.bounds.lower.dim[d], b = j->m.bounds.upper.dim[d], e = j->m.restitution;
+  for (size_t i = lo; i < hi; i++) {
+    const bool below = x[i] < a, above = x[i] > b;
+    const Float r = below ? 2 * a - x[i] : (above ? 2 * b - x[i] : x[i]);
+    x[i] = r < a ? a : (r > b ? b : r);
+    v[i] = below || above ? -v[i] * e : v[i];
+  }
+}
+
+static
+void motion_euler_task(void *job, size_t lo, size_t hi) {
+  const MotionJob *j = job;
+  for (size_t d = 0; d < 3; d++) {
+    Float *x = motion_dim(j->pos, d), *v = motion_dim(j->vel, d);
+    const Float *a = motion_dim(j->acc, d);
+    const Float g = j->m.gravity.dim[d], dt = j->dt, k = j->decay;
+    for (size_t i = lo; i < hi; i++) {
+      v[i] = (v[i] + (a[i] + g) * dt) * k;
+      x[i] += v[i] * dt;
+    }
+    if (j->m.bounded)
+      motion_wall(x, v, lo, hi, j, d);
+  }
+}
+
+// A whole step under constant acceleration, which is exact and is what both
+// Verlet and RK4 reduce to without an acceleration field.
+static
+void motion_const_task(void *job, size_t lo, size_t hi) {
+  const MotionJob *j = job;
+  for (size_t d = 0; d < 3; d++) {
+    Float *x = motion_dim(j->pos, d), *v = motion_dim(j->vel, d);
+    const Float *a = motion_dim(j->acc, d);
+    const Float g = j->m.gravity.dim[d], dt = j->dt, k = j->decay;
+    for (size_t i = lo; i < hi; i++) {
+      const Float dv = (a[i] + g) * dt;
+      x[i] += (v[i] + dv * (Float) 0.5) * dt;
+      v[i] = (v[i] + dv) * k;
+    }
+    if (j->m.bounded)
+      motion_wall(x, v, lo, hi, j, d);
+  }
+}
+
+// Verlet's first half kick and drift.
+static
+void motion_drift_task(void *job, size_t lo, size_t hi) {
+  const MotionJob *j = job;
+  for (size_t d = 0; d < 3; d++) {
+    Float *x = motion_dim(j->pos, d), *v = motion_dim(j->vel, d);
+    const Float *a = motion_dim(j->acc, d);
+    const Float g = j->m.gravity.dim[d], h = j->dt * (Float) 0.5, dt = j->dt;
+    for (size_t i = lo; i < hi; i++) {
+      v[i] += (a[i] + g) * h;
+      x[i] += v[i] * dt;
+    }
+    if (j->m.bounded)
+      motion_wall(x, v, lo, hi, j, d);
+  }
+}
+
+// Verlet's second half kick, with the acceleration at the new positions.
+static
+void motion_kick_task(void *job, size_t lo, size_t hi) {
+  const MotionJob *j = job;
+  for (size_t d = 0; d < 3; d++) {
+    Float *v = motion_dim(j->vel, d);
+    const Float *a = motion_dim(j->acc, d);
+    const Float g = j->m.gravity.dim[d], h = j->dt * (Float) 0.5, k = j->decay;
+    for (size_t i = lo; i < hi; i++)
+      v[i] = (v[i] + (a[i] + g) * h) * k;
+  }
+}
+
+// One RK4 stage. The stage derivative is (sv, sa + g); stage 0 starts from
+// the state itself. It is folded into the weighted sums (dx, dv) and used to
+// build the next stage state, or, at stage 3, to finish the step.
+static
+void motion_rk4_task(void *job, size_t lo, size_t hi) {
+  const MotionJob *j = job;
+  const int s = j->stage;
+  const Float h = s == 2 ? j->dt : j->dt * (Float) 0.5, w = s == 0 ? 1 : 2;
+  for (size_t d = 0; d < 3; d++) {
+    Float *x = motion_dim(j->pos, d), *v = motion_dim(j->vel, d);
+    Float *sp = motion_dim(j->sp, d), *sv = motion_dim(j->sv, d);
+    Float *dx = motion_dim(j->dx, d), *dv = motion_dim(j->dv, d);
+    const Float *kx = s == 0 ? v : sv, *ka = motion_dim(s == 0 ? j->acc : j->sa, d);
+    const Float g = j->m.gravity.dim[d], dt6 = j->dt / 6, k = j->decay;
+    if (s == 3) {
+      for (size_t i = lo; i < hi; i++) {
+        x[i] += (dx[i] + kx[i]) * dt6;
+        v[i] = (v[i] + (dv[i] + ka[i] + g) * dt6) * k;
+      }
+      if (j->m.bounded)
+        motion_wall(x, v, lo, hi, j, d);
+    } else {
+      for (size_t i = lo; i < hi; i++) {
+        const Float px = kx[i], pv = ka[i] + g;
+        dx[i] = (s == 0 ? 0 : dx[i]) + px * w;
+        dv[i] = (s == 0 ? 0 : dv[i]) + pv * w;
+        sp[i] = x[i] + px * h;
+        sv[i] = v[i] + pv * h;
+      }
+    }
+  }
+}
+
+static
+MotionJob motion_job(Soa3 pos, Soa3 vel, Soa3 acc, Float dt, const SolMotion *m) {
+  MotionJob j;
+  memset(&j, 0, sizeof(j));
+  j.pos = pos;
+  j.vel = vel;
+  j.acc = acc;
+  if (m)
+    j.m = *m;
+  j.dt = dt;
+  j.decay = j.m.damping != 0 ? flt_exp(-j.m.damping * dt) : 1;
+  return j;
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Integrators ///////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+/// vec3_euler_array ///
+// Description
+//   Advances particles by one semi-implicit Euler step: velocities take the
+//   acceleration first, then positions move with the new velocities. First
+//   order, but stable for oscillators and cheap: one pass, no field calls.
+// Arguments
+//   pos: positions, updated (Soa3)
+//   vel: velocities, updated (Soa3)
+//   acc: accelerations, read (Soa3)
+//   n: particle count (size_t)
+//   dt: time step (Float)
+//   m: gravity, damping and walls, or NULL (SolMotion*)
+// Returns
+//   void
+
+sol_inline
+void vec3_euler_array(Soa3 pos, Soa3 vel, Soa3 acc, size_t n, Float dt, const SolMotion *m) {
+  MotionJob j = motion_job(pos, vel, acc, dt, m);
+  sol_parallel_for(n, MOTION_SIZE, motion_euler_task, &j);
+}
+
+/// vec3_verlet_array ///
+// Description
+//   Advances particles by one velocity Verlet step, second order and
+//   time-reversible. acc must hold the acceleration at the current positions
+//   and holds it at the new ones on return; with an acceleration field the
+//   step is a half kick and drift, one field call and a second half kick,
+//   and without one it is a single exact constant-acceleration pass.
+// Arguments
+//   pos: positions, updated (Soa3)
+//   vel: velocities, updated (Soa3)
+//   acc: accelerations, updated by m->accel (Soa3)
+//   n: particle count (size_t)
+//   dt: time step (Float)
+//   m: gravity, damping, walls and field, or NULL (SolMotion*)
+// Returns
+//   void
+
+sol_inline
+void vec3_verlet_array(Soa3 pos, Soa3 vel, Soa3 acc, size_t n, Float dt, const SolMotion *m) {
+  MotionJob j = motion_job(pos, vel, acc, dt, m);
+  if (!j.m.accel) {
+    sol_parallel_for(n, MOTION_SIZE, motion_const_task, &j);
+    return;
+  }
+  sol_parallel_for(n, MOTION_SIZE, motion_drift_task, &j);
+  j.m.accel(j.m.ctx, acc, pos, vel, n);
+  sol_parallel_for(n, MOTION_SIZE, motion_kick_task, &j);
+}
+
+/// vec3_rk4_array ///
+// Description
+//   Advances particles by one classical fourth-order Runge-Kutta step,
+//   calling the acceleration field four times. acc is overwritten with the
+//   acceleration at the start of the step. Without a field the acceleration
+//   is constant and the step is the same exact pass as vec3_verlet_array.
+//   The stage state lives in work, which the caller keeps across steps so
+//   that stepping never allocates.
+// Arguments
+//   pos: positions, updated (Soa3)
+//   vel: velocities, updated (Soa3)
+//   acc: accelerations, updated by m->accel (Soa3)
+//   work: 15 * n Floats of scratch, or NULL without a field (Float*)
+//   n: particle count (size_t)
+//   dt: time step (Float)
+//   m: gravity, damping, walls and field, or NULL (SolMotion*)
+// Returns
+//   void
+
+sol_inline
+void vec3_rk4_array(Soa3 pos, Soa3 vel, Soa3 acc, Float *work, size_t n, Float dt, const SolMotion *m) {
+  MotionJob j = motion_job(pos, vel, acc, dt, m);
+  if (!j.m.accel) {
+    sol_parallel_for(n, MOTION_SIZE, motion_const_task, &j);
+    return;
+  }
+  Soa3 *scratch[5] = {&j.sp, &j.sv, &j.sa, &j.dx, &j.dv};
+  for (size_t s = 0; s < 5; s++) {
+    scratch[s]->x = work + (s * 3 + 0) * n;
+    scratch[s]->y = work + (s * 3 + 1) * n;
+    scratch[s]->z = work + (s * 3 + 2) * n;
+  }
+  j.m.accel(j.m.ctx, acc, pos, vel, n);
+  for (j.stage = 0; j.stage < 4; j.stage++) {
+    if (j.stage > 0)
+      j.m.accel(j.m.ctx, j.sa, j.sp, j.sv, n);
+    sol_parallel_for(n, MOTION_SIZE, motion_rk4_task, &j);
+  }
+}
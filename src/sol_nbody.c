@@ -0,0 +1,665 @@
+    /////////////////////////////////////////////////////////////////
+   // sol_nbody.c //////////////////////////////////////////////////
+  // Description: Adds N-body gravity to Sol. /////////////////////
+ // Author: David Garland (https://github.com/davidgarland/sol) //
+/////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Local Headers /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include "../sol.h"
+#include "sol_simd.h"
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Standard Headers //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Interaction Kernel ////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Every force in this file is the softened monopole m d / (|d|^2 + e^2)^1.5
+// of a source at offset d, taken SIMD_LANES sources at a time. Pairs at zero
+// softened distance, i.e. a body and itself without softening, are masked
+// out.
+
+#if SIMD_LANES > 1
+      static inline
+      Float nb_sum(SimdReg r) {
+        Float f[SIMD_LANES];
+        memcpy(f, &r, sizeof(f));
+        Float s = 0;
+        for (size_t i = 0; i < SIMD_LANES; i++)
+          s += f[i];
+        return s;
+      }
+#endif
+
+// Sources in struct-of-arrays form; m may be NULL for unit masses.
+typedef struct {
+  const Float *x, *y, *z, *m;
+} NbSrc;
+
+// Adds the pull of sources [lo, hi) on the point (px, py, pz) to a.
+static inline
+void nb_direct(Float *a, Float px, Float py, Float pz, NbSrc s, size_t lo, size_t hi, Float e2) {
+  Float ax = 0, ay = 0, az = 0;
+  size_t j = lo;
+  #if SIMD_LANES > 1
+        const SimdReg x = simd_set1(px), y = simd_set1(py), z = simd_set1(pz), e = simd_set1(e2);
+        SimdReg vx = simd_zero(), vy = simd_zero(), vz = simd_zero();
+        for (; j + SIMD_LANES <= hi; j += SIMD_LANES) {
+          const SimdReg dx = simd_sub(simd_load(s.x + j), x);
+          const SimdReg dy = simd_sub(simd_load(s.y + j), y);
+          const SimdReg dz = simd_sub(simd_load(s.z + j), z);
+          const SimdReg r2 = simd_add(simd_add(simd_mul(dx, dx), simd_mul(dy, dy)), simd_add(simd_mul(dz, dz), e));
+          const SimdReg r = simd_and(simd_rsqrt(r2), simd_gt(r2, simd_zero()));
+          SimdReg w = simd_mul(simd_mul(r, r), r);
+          w = s.m ? simd_mul(w, simd_load(s.m + j)) : w;
+          vx = simd_add(vx, simd_mul(dx, w));
+          vy = simd_add(vy, simd_mul(dy, w));
+          vz = simd_add(vz, simd_mul(dz, w));
+        }
+        ax = nb_sum(vx);
+        ay = nb_sum(vy);
+        az = nb_sum(vz);
+  #endif
+  for (; j < hi; j++) {
+    const Float dx = s.x[j] - px, dy = s.y[j] - py, dz = s.z[j] - pz;
+    const Float r2 = dx * dx + dy * dy + dz * dz + e2;
+    const Float r = r2 > 0 ? 1 / flt_sqrt(r2) : 0;
+    const Float w = r * r * r * (s.m ? s.m[j] : 1);
+    ax += dx * w;
+    ay += dy * w;
+    az += dz * w;
+  }
+  a[0] += ax;
+  a[1] += ay;
+  a[2] += az;
+}
+
+static
+SolGravity nb_params(const SolGravity *grav) {
+  SolGravity g = {NULL, 1, 0, 0};
+  return grav ? *grav : g;
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Direct Summation //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Sources are swept in tiles of NB_TILE bodies, small enough to stay in L1
+// while every target of a task passes over them.
+
+#define NB_TILE 1024
+
+typedef struct {
+  Soa3 acc;
+  NbSrc src;
+  size_t n;
+  SolGravity g;
+  size_t *idx;
+  const void *tree;
+} NbJob;
+
+static
+void nb_direct_task(void *job, size_t lo, size_t hi) {
+  const NbJob *j = job;
+  const Float e2 = j->g.softening * j->g.softening;
+  for (size_t i = lo; i < hi; i++)
+    j->acc.x[i] = j->acc.y[i] = j->acc.z[i] = 0;
+  for (size_t t = 0; t < j->n; t += NB_TILE) {
+    const size_t t_end = t + NB_TILE < j->n ? t + NB_TILE : j->n;
+    for (size_t i = lo; i < hi; i++) {
+      Float a[3] = {0, 0, 0};
+      nb_direct(a, j->src.x[i], j->src.y[i], j->src.z[i], j->src, t, t_end, e2);
+      j->acc.x[i] += a[0];
+      j->acc.y[i] += a[1];
+      j->acc.z[i] += a[2];
+    }
+  }
+  for (size_t i = lo; i < hi; i++) {
+    j->acc.x[i] *= j->g.g;
+    j->acc.y[i] *= j->g.g;
+    j->acc.z[i] *= j->g.g;
+  }
+}
+
+/// vec3_gravity_direct_array ///
+// Description
+//   Computes the gravitational acceleration of every body due to all the
+//   others by direct summation, O(n^2) but exact up to rounding. Best below
+//   a few thousand bodies, and as a reference for vec3_gravity_tree_array.
+// Arguments
+//   acc: accelerations, written (Soa3)
+//   pos: positions (Soa3)
+//   n: body count (size_t)
+//   grav: masses, G and softening, or NULL for G = 1 and unit masses (SolGravity*)
+// Returns
+//   void
+
+sol_inline
+void vec3_gravity_direct_array(Soa3 acc, Soa3 pos, size_t n, const SolGravity *grav) {
+  NbJob j = {acc, {pos.x, pos.y, pos.z, NULL}, n, nb_params(grav), NULL, NULL};
+  j.src.m = j.g.mass;
+  sol_parallel_for(n, n * 4 * sizeof(Float), nb_direct_task, &j);
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Octree ////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// The Barnes-Hut tree is built from bodies sorted along a Morton curve, so
+// every node owns a contiguous run of bodies and the children of a node are
+// where the run's codes change in the node's three level bits. Levels where
+// all bodies share an octant are skipped, so each inner node has at least
+// two children and the tree has fewer than 2n nodes. Nodes carry their mass,
+// centre of mass and the squared distance beyond which they can stand in for
+// their bodies: (largest box edge / theta)^2.
+//
+// The top of the tree is built serially until runs drop under a grain size;
+// those subtrees are then built in parallel, and the top nodes summed last.
+// Forces are evaluated in Morton order as well, so neighbouring targets
+// can share one walk.
+
+#define NB_BITS 21
+#define NB_LEAF 8
+#define NB_STACK 256
+
+typedef struct {
+  Float x, y, z, m;
+  Float lower[3], upper[3];
+  Float open2;
+  size_t first, count;
+  bool leaf, pending;
+} NbNode;
+
+typedef struct {
+  size_t node, lo, hi;
+  int shift;
+} NbDefer;
+
+typedef struct {
+  NbNode *node;
+  _Atomic size_t used;
+  uint64_t *code;
+  NbSrc body;
+  Float theta2;
+  size_t grain;
+  NbDefer *defer;
+  size_t defers, defer_cap;
+} NbTree;
+
+static inline
+uint64_t nb_spread(uint64_t v) {
+  v &= 0x1FFFFF;
+  v = (v | v << 32) & UINT64_C(0x1F00000000FFFF);
+  v = (v | v << 16) & UINT64_C(0x1F0000FF0000FF);
+  v = (v | v << 8) & UINT64_C(0x100F00F00F00F00F);
+  v = (v | v << 4) & UINT64_C(0x10C30C30C30C30C3);
+  v = (v | v << 2) & UINT64_C(0x1249249249249249);
+  return v;
+}
+
+// Sums a node from its bodies or children.
+static
+void nb_node_sum(NbTree *t, NbNode *nd) {
+  Float m = 0, x = 0, y = 0, z = 0;
+  for (size_t d = 0; d < 3; d++) {
+    nd->lower[d] = INFINITY;
+    nd->upper[d] = -INFINITY;
+  }
+  for (size_t k = nd->first; k < nd->first + nd->count; k++) {
+    Float bm, b[3];
+    const Float *lo = b, *hi = b;
+    if (nd->leaf) {
+      b[0] = t->body.x[k];
+      b[1] = t->body.y[k];
+      b[2] = t->body.z[k];
+      bm = t->body.m ? t->body.m[k] : 1;
+    } else {
+      const NbNode *c = &t->node[k];
+      b[0] = c->x;
+      b[1] = c->y;
+      b[2] = c->z;
+      bm = c->m;
+      lo = c->lower;
+      hi = c->upper;
+    }
+    m += bm;
+    x += b[0] * bm;
+    y += b[1] * bm;
+    z += b[2] * bm;
+    for (size_t d = 0; d < 3; d++) {
+      nd->lower[d] = lo[d] < nd->lower[d] ? lo[d] : nd->lower[d];
+      nd->upper[d] = hi[d] > nd->upper[d] ? hi[d] : nd->upper[d];
+    }
+  }
+  nd->m = m;
+  if (m != 0) {
+    nd->x = x / m;
+    nd->y = y / m;
+    nd->z = z / m;
+  } else {
+    nd->x = (nd->lower[0] + nd->upper[0]) / 2;
+    nd->y = (nd->lower[1] + nd->upper[1]) / 2;
+    nd->z = (nd->lower[2] + nd->upper[2]) / 2;
+  }
+  Float edge = 0;
+  for (size_t d = 0; d < 3; d++)
+    edge = nd->upper[d] - nd->lower[d] > edge ? nd->upper[d] - nd->lower[d] : edge;
+  nd->open2 = edge * edge / t->theta2;
+}
+
+// First index in [lo, hi) whose octant at shift is at least o.
+static inline
+size_t nb_octant_start(const uint64_t *code, size_t lo, size_t hi, int shift, uint64_t o) {
+  while (lo < hi) {
+    const size_t mid = lo + (hi - lo) / 2;
+    if (((code[mid] >> shift) & 7) < o)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+static
+bool nb_defer_room(NbTree *t) {
+  if (t->defers < t->defer_cap)
+    return true;
+  NbDefer *d = realloc(t->defer, (t->defer_cap * 2 + 64) * sizeof(NbDefer));
+  if (!d)
+    return false;
+  t->defer = d;
+  t->defer_cap = t->defer_cap * 2 + 64;
+  return true;
+}
+
+static
+void nb_build(NbTree *t, size_t node, size_t lo, size_t hi, int shift, bool top) {
+  NbNode *nd = &t->node[node];
+  while (shift >= 0 && hi - lo > NB_LEAF &&
+         ((t->code[lo] >> shift) & 7) == ((t->code[hi - 1] >> shift) & 7))
+    shift -= 3;
+  nd->pending = false;
+  if (hi - lo <= NB_LEAF) {
+    nd->leaf = true;
+    nd->first = lo;
+    nd->count = hi - lo;
+    nb_node_sum(t, nd);
+    return;
+  }
+  // Past the last level the bodies share a code; split them by index.
+  size_t start[9];
+  size_t k = 0;
+  for (uint64_t o = 0; o < 8; o++)
+    start[o] = shift < 0 ? lo + (hi - lo) * o / 8 : nb_octant_start(t->code, lo, hi, shift, o);
+  start[8] = hi;
+  for (size_t o = 0; o < 8; o++)
+    k += start[o + 1] > start[o];
+  nd->leaf = false;
+  nd->first = atomic_fetch_add_explicit(&t->used, k, memory_order_relaxed);
+  nd->count = k;
+  size_t c = nd->first;
+  for (size_t o = 0; o < 8; o++) {
+    if (start[o + 1] == start[o])
+      continue;
+    if (top && start[o + 1] - start[o] <= t->grain && nb_defer_room(t)) {
+      t->defer[t->defers++] = (NbDefer) {c, start[o], start[o + 1], shift < 0 ? shift : shift - 3};
+      nd->pending = true;
+    } else {
+      nb_build(t, c, start[o], start[o + 1], shift < 0 ? shift : shift - 3, top);
+      nd->pending |= t->node[c].pending;
+    }
+    c++;
+  }
+  if (!nd->pending)
+    nb_node_sum(t, nd);
+}
+
+static
+void nb_build_task(void *job, size_t lo, size_t hi) {
+  NbTree *t = job;
+  for (size_t i = lo; i < hi; i++)
+    nb_build(t, t->defer[i].node, t->defer[i].lo, t->defer[i].hi, t->defer[i].shift, false);
+}
+
+// Sums the top nodes once their deferred subtrees are in.
+static
+void nb_finish(NbTree *t, size_t node) {
+  NbNode *nd = &t->node[node];
+  if (!nd->pending)
+    return;
+  for (size_t c = nd->first; c < nd->first + nd->count; c++)
+    nb_finish(t, c);
+  nb_node_sum(t, nd);
+  nd->pending = false;
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Morton Sorting ////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Codes are 63 bits. One counting pass on the top 6 bits (the top two tree
+// levels) splits them into 64 buckets, which are then radix sorted in
+// parallel on the remaining bits, 8 bits at a time.
+
+#define NB_TOP 57
+
+typedef struct {
+  uint64_t *code, *tmp;
+  size_t *idx, *idx_tmp;
+  size_t start[65];
+} NbSort;
+
+static
+void nb_sort_task(void *job, size_t lo, size_t hi) {
+  NbSort *s = job;
+  for (size_t b = lo; b < hi; b++) {
+    const size_t a = s->start[b], e = s->start[b + 1];
+    uint64_t *code = s->code, *tmp = s->tmp;
+    size_t *idx = s->idx, *idx_tmp = s->idx_tmp;
+    for (int shift = 0; shift < NB_TOP; shift += 8) {
+      size_t count[257] = {0};
+      for (size_t i = a; i < e; i++)
+        count[((code[i] >> shift) & 0xFF) + 1]++;
+      for (size_t d = 0; d < 256; d++)
+        count[d + 1] += count[d];
+      for (size_t i = a; i < e; i++) {
+        const size_t to = a + count[(code[i] >> shift) & 0xFF]++;
+        tmp[to] = code[i];
+        idx_tmp[to] = idx[i];
+      }
+      uint64_t *c = code;
+      code = tmp;
+      tmp = c;
+      size_t *x = idx;
+      idx = idx_tmp;
+      idx_tmp = x;
+    }
+    // Eight passes leave the bucket back in s->code and s->idx.
+  }
+}
+
+typedef struct {
+  Soa3 pos;
+  Float lower[3], scale;
+  uint64_t *code;
+  size_t *idx;
+  atomic_flag lock;
+  Float box[6];
+} NbKeyJob;
+
+static
+void nb_bounds_task(void *job, size_t lo, size_t hi) {
+  NbKeyJob *j = job;
+  Float b[6] = {INFINITY, INFINITY, INFINITY, -INFINITY, -INFINITY, -INFINITY};
+  const Float *p[3] = {j->pos.x, j->pos.y, j->pos.z};
+  for (size_t d = 0; d < 3; d++) {
+    for (size_t i = lo; i < hi; i++) {
+      b[d] = p[d][i] < b[d] ? p[d][i] : b[d];
+      b[d + 3] = p[d][i] > b[d + 3] ? p[d][i] : b[d + 3];
+    }
+  }
+  while (atomic_flag_test_and_set_explicit(&j->lock, memory_order_acquire));
+  for (size_t d = 0; d < 3; d++) {
+    j->box[d] = b[d] < j->box[d] ? b[d] : j->box[d];
+    j->box[d + 3] = b[d + 3] > j->box[d + 3] ? b[d + 3] : j->box[d + 3];
+  }
+  atomic_flag_clear_explicit(&j->lock, memory_order_release);
+}
+
+static
+void nb_key_task(void *job, size_t lo, size_t hi) {
+  NbKeyJob *j = job;
+  const Float *p[3] = {j->pos.x, j->pos.y, j->pos.z};
+  const Float top = (Float) ((1 << NB_BITS) - 1);
+  for (size_t i = lo; i < hi; i++) {
+    uint64_t code = 0;
+    for (size_t d = 0; d < 3; d++) {
+      Float f = (p[d][i] - j->lower[d]) * j->scale;
+      f = f < 0 ? 0 : (f > top ? top : f);
+      code |= nb_spread((uint64_t) f) << (2 - d);
+    }
+    j->code[i] = code;
+    j->idx[i] = i;
+  }
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Tree Forces ///////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Targets are walked through the tree in groups of NB_GROUP consecutive
+// bodies in Morton order, which sit close together, so one walk serves the
+// whole group and every interaction is vectorized across its targets. A node
+// stands in for its bodies only if its centre of mass is beyond open2 of the
+// group's box and its own box does not touch the group's box, so no body is
+// ever pulled on by a monopole containing itself. Nodes of zero extent are
+// exact as monopoles and are never opened.
+
+#define NB_GROUP 16
+
+typedef struct {
+  Float x[NB_GROUP], y[NB_GROUP], z[NB_GROUP];
+} NbAcc;
+
+// Adds the pull of one source on the targets [lo, lo + m) to a.
+static inline
+void nb_pull(NbAcc *a, NbSrc s, size_t lo, size_t m, Float sx, Float sy, Float sz, Float sm, Float e2) {
+  size_t i = 0;
+  #if SIMD_LANES > 1
+        const SimdReg x = simd_set1(sx), y = simd_set1(sy), z = simd_set1(sz);
+        const SimdReg e = simd_set1(e2), w0 = simd_set1(sm);
+        for (; i + SIMD_LANES <= m; i += SIMD_LANES) {
+          const SimdReg dx = simd_sub(x, simd_load(s.x + lo + i));
+          const SimdReg dy = simd_sub(y, simd_load(s.y + lo + i));
+          const SimdReg dz = simd_sub(z, simd_load(s.z + lo + i));
+          const SimdReg r2 = simd_add(simd_add(simd_mul(dx, dx), simd_mul(dy, dy)), simd_add(simd_mul(dz, dz), e));
+          const SimdReg r = simd_and(simd_rsqrt(r2), simd_gt(r2, simd_zero()));
+          const SimdReg w = simd_mul(simd_mul(simd_mul(r, r), r), w0);
+          simd_store(a->x + i, simd_add(simd_load(a->x + i), simd_mul(dx, w)));
+          simd_store(a->y + i, simd_add(simd_load(a->y + i), simd_mul(dy, w)));
+          simd_store(a->z + i, simd_add(simd_load(a->z + i), simd_mul(dz, w)));
+        }
+  #endif
+  for (; i < m; i++) {
+    const Float dx = sx - s.x[lo + i], dy = sy - s.y[lo + i], dz = sz - s.z[lo + i];
+    const Float r2 = dx * dx + dy * dy + dz * dz + e2;
+    const Float r = r2 > 0 ? 1 / flt_sqrt(r2) : 0;
+    const Float w = r * r * r * sm;
+    a->x[i] += dx * w;
+    a->y[i] += dy * w;
+    a->z[i] += dz * w;
+  }
+}
+
+static
+void nb_tree_task(void *job, size_t lo, size_t hi) {
+  const NbJob *j = job;
+  const NbTree *t = j->tree;
+  const NbSrc b = t->body;
+  const Float e2 = j->g.softening * j->g.softening;
+  size_t stack[NB_STACK];
+  for (size_t g = lo; g < hi; g += NB_GROUP) {
+    const size_t m = hi - g < NB_GROUP ? hi - g : NB_GROUP;
+    Float gl[3] = {INFINITY, INFINITY, INFINITY}, gu[3] = {-INFINITY, -INFINITY, -INFINITY};
+    NbAcc a;
+    for (size_t i = 0; i < m; i++) {
+      const Float p[3] = {b.x[g + i], b.y[g + i], b.z[g + i]};
+      for (size_t d = 0; d < 3; d++) {
+        gl[d] = p[d] < gl[d] ? p[d] : gl[d];
+        gu[d] = p[d] > gu[d] ? p[d] : gu[d];
+      }
+      a.x[i] = a.y[i] = a.z[i] = 0;
+    }
+    size_t top = 0;
+    stack[top++] = 0;
+    while (top) {
+      const NbNode *nd = &t->node[stack[--top]];
+      if (nd->leaf) {
+        for (size_t k = nd->first; k < nd->first + nd->count; k++)
+          nb_pull(&a, b, g, m, b.x[k], b.y[k], b.z[k], b.m ? b.m[k] : 1, e2);
+        continue;
+      }
+      const Float c[3] = {nd->x, nd->y, nd->z};
+      Float d2 = 0;
+      bool touch = true;
+      for (size_t d = 0; d < 3; d++) {
+        const Float off = c[d] < gl[d] ? gl[d] - c[d] : (c[d] > gu[d] ? c[d] - gu[d] : 0);
+        d2 += off * off;
+        touch = touch && nd->lower[d] <= gu[d] && nd->upper[d] >= gl[d];
+      }
+      if (nd->open2 == 0 || (d2 > nd->open2 && !touch))
+        nb_pull(&a, b, g, m, nd->x, nd->y, nd->z, nd->m, e2);
+      else
+        for (size_t k = nd->first; k < nd->first + nd->count; k++)
+          stack[top++] = k;
+    }
+    for (size_t i = 0; i < m; i++) {
+      const size_t k = j->idx[g + i];
+      j->acc.x[k] = a.x[i] * j->g.g;
+      j->acc.y[k] = a.y[i] * j->g.g;
+      j->acc.z[k] = a.z[i] * j->g.g;
+    }
+  }
+}
+
+static
+void nb_solve(Soa3 acc, Soa3 pos, size_t n, const SolGravity *g, NbSort *sort, NbTree *t, Float *body) {
+  NbKeyJob key = {pos, {0, 0, 0}, 0, NULL, NULL, ATOMIC_FLAG_INIT,
+                  {INFINITY, INFINITY, INFINITY, -INFINITY, -INFINITY, -INFINITY}};
+
+  // Morton keys over the bounding cube.
+  sol_parallel_for(n, 3 * sizeof(Float), nb_bounds_task, &key);
+  Float edge = 0;
+  for (size_t d = 0; d < 3; d++) {
+    key.lower[d] = key.box[d];
+    edge = key.box[d + 3] - key.box[d] > edge ? key.box[d + 3] - key.box[d] : edge;
+  }
+  key.scale = edge > 0 ? (Float) (1 << NB_BITS) / edge : 0;
+  key.code = sort->tmp;
+  key.idx = sort->idx_tmp;
+  sol_parallel_for(n, 3 * sizeof(Float) + 16, nb_key_task, &key);
+
+  // Bucket on the top levels, then sort the buckets in parallel.
+  memset(sort->start, 0, sizeof(sort->start));
+  for (size_t i = 0; i < n; i++)
+    sort->start[(sort->tmp[i] >> NB_TOP) + 1]++;
+  for (size_t b = 0; b < 64; b++)
+    sort->start[b + 1] += sort->start[b];
+  size_t fill[64];
+  memcpy(fill, sort->start, sizeof(fill));
+  for (size_t i = 0; i < n; i++) {
+    const size_t to = fill[sort->tmp[i] >> NB_TOP]++;
+    sort->code[to] = sort->tmp[i];
+    sort->idx[to] = sort->idx_tmp[i];
+  }
+  sol_parallel_for(64, n / 64 * 16 * sizeof(uint64_t) + 1, nb_sort_task, sort);
+
+  // Bodies in Morton order.
+  t->body.x = body;
+  t->body.y = body + n;
+  t->body.z = body + 2 * n;
+  t->body.m = g->mass ? body + 3 * n : NULL;
+  for (size_t i = 0; i < n; i++) {
+    const size_t k = sort->idx[i];
+    body[i] = pos.x[k];
+    body[n + i] = pos.y[k];
+    body[2 * n + i] = pos.z[k];
+    if (g->mass)
+      body[3 * n + i] = g->mass[k];
+  }
+
+  // Tree.
+  t->code = sort->code;
+  t->theta2 = g->theta * g->theta;
+  t->grain = n / (sol_get_threads() * 8) + NB_LEAF;
+  atomic_init(&t->used, 1);
+  nb_build(t, 0, 0, n, 3 * (NB_BITS - 1), true);
+  sol_parallel_for(t->defers, n / (t->defers + 1) * 64 * sizeof(Float) + 1, nb_build_task, t);
+  nb_finish(t, 0);
+
+  // Forces.
+  size_t depth = 1;
+  for (size_t m = n; m > 1; m >>= 1)
+    depth++;
+  NbJob j = {acc, t->body, n, *g, sort->idx, t};
+  sol_parallel_for(n, depth * 64 * sizeof(Float), nb_tree_task, &j);
+}
+
+/// vec3_gravity_tree_array ///
+// Description
+//   Computes the gravitational acceleration of every body with a Barnes-Hut
+//   octree in O(n log n). A node is used in place of its bodies when it is
+//   seen at an angle under theta (its largest edge over its distance); 0.5
+//   is typical, smaller is more exact, and theta <= 0 falls back to direct
+//   summation, as does a tree that can't be allocated. Tree building and
+//   force evaluation are both parallel.
+// Arguments
+//   acc: accelerations, written (Soa3)
+//   pos: positions (Soa3)
+//   n: body count (size_t)
+//   grav: masses, G, softening and theta, or NULL for G = 1, unit masses
+//         and theta = 0.5 (SolGravity*)
+// Returns
+//   void
+
+sol_inline
+void vec3_gravity_tree_array(Soa3 acc, Soa3 pos, size_t n, const SolGravity *grav) {
+  SolGravity g = nb_params(grav);
+  if (!grav)
+    g.theta = (Float) 0.5;
+  if (g.theta <= 0 || n <= NB_LEAF) {
+    vec3_gravity_direct_array(acc, pos, n, &g);
+    return;
+  }
+  NbSort sort;
+  NbTree t;
+  memset(&t, 0, sizeof(t));
+  sort.code = malloc(n * sizeof(uint64_t));
+  sort.tmp = malloc(n * sizeof(uint64_t));
+  sort.idx = malloc(n * sizeof(size_t));
+  sort.idx_tmp = malloc(n * sizeof(size_t));
+  Float *body = malloc(4 * n * sizeof(Float));
+  t.node = malloc(2 * n * sizeof(NbNode));
+  if (sort.code && sort.tmp && sort.idx && sort.idx_tmp && body && t.node)
+    nb_solve(acc, pos, n, &g, &sort, &t, body);
+  else
+    vec3_gravity_direct_array(acc, pos, n, &g);
+  free(sort.code);
+  free(sort.tmp);
+  free(sort.idx);
+  free(sort.idx_tmp);
+  free(body);
+  free(t.node);
+  free(t.defer);
+}
+
+/// vec3_gravity_field ///
+// Description
+//   A SolAccel for the integrators: ctx points to a SolGravity, and the tree
+//   solver or, when its theta is 0, direct summation fills acc.
+// Arguments
+//   ctx: settings (SolGravity*)
+//   acc: accelerations, written (Soa3)
+//   pos: positions (Soa3)
+//   vel: velocities, unused (Soa3)
+//   n: body count (size_t)
+// Returns
+//   void
+
+sol_inline
+void vec3_gravity_field(void *ctx, Soa3 acc, Soa3 pos, Soa3 vel, size_t n) {
+  (void) vel;
+  vec3_gravity_tree_array(acc, pos, n, ctx);
+}
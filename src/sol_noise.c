@@ -0,0 +1,751 @@
+    /////////////////////////////////////////////////////////////////
+   // sol_noise.c //////////////////////////////////////////////////
+  // Description: Adds gradient noise to Sol. /////////////////////
+ // Author: David Garland (https://github.com/davidgarland/sol) //
+/////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Local Headers /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include "../sol.h"
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Standard Headers //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <math.h>
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Lattice Hashing ///////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Noise is evaluated in two steps. The point is first split, in Float
+// precision, into an integer lattice cell and a small offset inside it, so
+// large coordinates keep their detail. The rest runs on 32-bit floats and
+// integers, eight lanes at a time with AVX2 and one at a time otherwise.
+// Instead of a permutation table, which would need gathers, lattice corners
+// are hashed with multiplies and xor-shifts, and the top bits of the hash
+// pick a gradient with compares and sign flips.
+
+#define NOISE_HX 0x8DA6B343u
+#define NOISE_HY 0xD8163841u
+#define NOISE_HZ 0xCB1AB31Fu
+#define NOISE_HM 0x2C1B3C6Du
+
+// Skew factors between the square or cubic lattice and the simplex lattice.
+#define NOISE_F2 ((Float) 0.36602540378443864676)
+#define NOISE_G2 0.21132486540518711775f
+#define NOISE_F3 ((Float) (1.0 / 3.0))
+#define NOISE_G3 (1.0f / 6.0f)
+
+// Output scales mapping each kernel to about [-1, 1].
+#define NOISE_PERLIN2_SCALE 0.65f
+#define NOISE_PERLIN3_SCALE 1.0f
+#define NOISE_SIMPLEX2_SCALE 44.0f
+#define NOISE_SIMPLEX3_SCALE 74.0f
+
+enum {
+  NOISE_PERLIN,
+  NOISE_SIMPLEX
+};
+
+static inline
+uint32_t noise_mix(uint32_t h) {
+  h ^= h >> 15;
+  h *= NOISE_HM;
+  return h ^ (h >> 13);
+}
+
+static inline
+float noise_fade(float t) {
+  return t * t * t * (t * (t * 6 - 15) + 10);
+}
+
+static inline
+float noise_lerp(float t, float a, float b) {
+  return a + t * (b - a);
+}
+
+// One of the 8 directions (+-1, +-2), (+-2, +-1).
+static inline
+float noise_grad2(uint32_t h, float x, float y) {
+  h >>= 29;
+  const float u = h < 4 ? x : y, v = h < 4 ? y : x;
+  return (h & 1 ? -u : u) + (h & 2 ? -2 * v : 2 * v);
+}
+
+// One of the 12 cube edge directions, 4 of them doubled up to make 16.
+static inline
+float noise_grad3(uint32_t h, float x, float y, float z) {
+  h >>= 28;
+  const float u = h < 8 ? x : y;
+  const float v = h < 4 ? y : (h == 12 || h == 14 ? x : z);
+  return (h & 1 ? -u : u) + (h & 2 ? -v : v);
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Lattice Cells /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// A point reduced to its cell c and offset f, one lane of a batch.
+typedef struct {
+  uint32_t c[3][8];
+  float f[3][8];
+} NoiseCell;
+
+// Wraps a lattice coordinate to 32 bits. The hashes work modulo 2^32 anyway,
+// so cells past the int32_t range alias instead of overflowing the cast.
+static inline
+uint32_t noise_wrap(Float c) {
+  if (c >= (Float) -2147483648.0 && c < (Float) 2147483648.0)
+    return (uint32_t) (int32_t) c;
+  const Float w = c - flt_floor(c / (Float) 4294967296.0) * (Float) 4294967296.0;
+  return w >= 0 && w < (Float) 4294967296.0 ? (uint32_t) w : 0;
+}
+
+static inline
+void noise_cell2(NoiseCell *q, size_t l, int kind, Float x, Float y) {
+  Float cx, cy;
+  if (kind == NOISE_SIMPLEX) {
+    const Float s = (x + y) * NOISE_F2;
+    cx = flt_floor(x + s);
+    cy = flt_floor(y + s);
+    const Float t = (cx + cy) * (Float) NOISE_G2;
+    q->f[0][l] = (float) (x - (cx - t));
+    q->f[1][l] = (float) (y - (cy - t));
+  } else {
+    cx = flt_floor(x);
+    cy = flt_floor(y);
+    q->f[0][l] = (float) (x - cx);
+    q->f[1][l] = (float) (y - cy);
+  }
+  q->c[0][l] = noise_wrap(cx);
+  q->c[1][l] = noise_wrap(cy);
+}
+
+static inline
+void noise_cell3(NoiseCell *q, size_t l, int kind, Float x, Float y, Float z) {
+  Float cx, cy, cz;
+  if (kind == NOISE_SIMPLEX) {
+    const Float s = (x + y + z) * NOISE_F3;
+    cx = flt_floor(x + s);
+    cy = flt_floor(y + s);
+    cz = flt_floor(z + s);
+    const Float t = (cx + cy + cz) * (Float) NOISE_G3;
+    q->f[0][l] = (float) (x - (cx - t));
+    q->f[1][l] = (float) (y - (cy - t));
+    q->f[2][l] = (float) (z - (cz - t));
+  } else {
+    cx = flt_floor(x);
+    cy = flt_floor(y);
+    cz = flt_floor(z);
+    q->f[0][l] = (float) (x - cx);
+    q->f[1][l] = (float) (y - cy);
+    q->f[2][l] = (float) (z - cz);
+  }
+  q->c[0][l] = noise_wrap(cx);
+  q->c[1][l] = noise_wrap(cy);
+  q->c[2][l] = noise_wrap(cz);
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Scalar Kernels ////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Builds with AVX2 only take the eight-lane kernels below.
+
+#if !defined(SOL_AVX2)
+      static
+      float noise_perlin2_1(const NoiseCell *q, size_t l) {
+        const uint32_t x0 = q->c[0][l] * NOISE_HX, x1 = x0 + NOISE_HX;
+        const uint32_t y0 = q->c[1][l] * NOISE_HY, y1 = y0 + NOISE_HY;
+        const float fx = q->f[0][l], fy = q->f[1][l];
+        const float u = noise_fade(fx), v = noise_fade(fy);
+        const float a = noise_lerp(u, noise_grad2(noise_mix(x0 ^ y0), fx, fy),
+                                      noise_grad2(noise_mix(x1 ^ y0), fx - 1, fy));
+        const float b = noise_lerp(u, noise_grad2(noise_mix(x0 ^ y1), fx, fy - 1),
+                                      noise_grad2(noise_mix(x1 ^ y1), fx - 1, fy - 1));
+        return noise_lerp(v, a, b) * NOISE_PERLIN2_SCALE;
+      }
+
+      static
+      float noise_perlin3_1(const NoiseCell *q, size_t l) {
+        const uint32_t x0 = q->c[0][l] * NOISE_HX, x1 = x0 + NOISE_HX;
+        const uint32_t y0 = q->c[1][l] * NOISE_HY, y1 = y0 + NOISE_HY;
+        const uint32_t z0 = q->c[2][l] * NOISE_HZ, z1 = z0 + NOISE_HZ;
+        const float fx = q->f[0][l], fy = q->f[1][l], fz = q->f[2][l];
+        const float gx = fx - 1, gy = fy - 1, gz = fz - 1;
+        const float u = noise_fade(fx), v = noise_fade(fy), w = noise_fade(fz);
+        const float a = noise_lerp(u, noise_grad3(noise_mix(x0 ^ y0 ^ z0), fx, fy, fz),
+                                      noise_grad3(noise_mix(x1 ^ y0 ^ z0), gx, fy, fz));
+        const float b = noise_lerp(u, noise_grad3(noise_mix(x0 ^ y1 ^ z0), fx, gy, fz),
+                                      noise_grad3(noise_mix(x1 ^ y1 ^ z0), gx, gy, fz));
+        const float c = noise_lerp(u, noise_grad3(noise_mix(x0 ^ y0 ^ z1), fx, fy, gz),
+                                      noise_grad3(noise_mix(x1 ^ y0 ^ z1), gx, fy, gz));
+        const float d = noise_lerp(u, noise_grad3(noise_mix(x0 ^ y1 ^ z1), fx, gy, gz),
+                                      noise_grad3(noise_mix(x1 ^ y1 ^ z1), gx, gy, gz));
+        return noise_lerp(w, noise_lerp(v, a, b), noise_lerp(v, c, d)) * NOISE_PERLIN3_SCALE;
+      }
+
+      // A simplex corner's contribution, (r^2 - d^2)^4 times its gradient ramp,
+      // with r^2 = 1/2 so that it fades out before the neighbouring simplices.
+      static inline
+      float noise_corner2(uint32_t h, float x, float y) {
+        float t = 0.5f - x * x - y * y;
+        t = t > 0 ? t * t : 0;
+        return t * t * noise_grad2(h, x, y);
+      }
+
+      static inline
+      float noise_corner3(uint32_t h, float x, float y, float z) {
+        float t = 0.5f - x * x - y * y - z * z;
+        t = t > 0 ? t * t : 0;
+        return t * t * noise_grad3(h, x, y, z);
+      }
+
+      static
+      float noise_simplex2_1(const NoiseCell *q, size_t l) {
+        const uint32_t hx = q->c[0][l] * NOISE_HX;
+        const uint32_t hy = q->c[1][l] * NOISE_HY;
+        const float x0 = q->f[0][l], y0 = q->f[1][l];
+        const uint32_t i1 = x0 > y0, j1 = !i1;
+        const float x1 = x0 - (float) i1 + NOISE_G2, y1 = y0 - (float) j1 + NOISE_G2;
+        const float x2 = x0 - 1 + 2 * NOISE_G2, y2 = y0 - 1 + 2 * NOISE_G2;
+        const float n = noise_corner2(noise_mix(hx ^ hy), x0, y0)
+                      + noise_corner2(noise_mix((hx + i1 * NOISE_HX) ^ (hy + j1 * NOISE_HY)), x1, y1)
+                      + noise_corner2(noise_mix((hx + NOISE_HX) ^ (hy + NOISE_HY)), x2, y2);
+        return n * NOISE_SIMPLEX2_SCALE;
+      }
+
+      static
+      float noise_simplex3_1(const NoiseCell *q, size_t l) {
+        const uint32_t hx = q->c[0][l] * NOISE_HX;
+        const uint32_t hy = q->c[1][l] * NOISE_HY;
+        const uint32_t hz = q->c[2][l] * NOISE_HZ;
+        const float x0 = q->f[0][l], y0 = q->f[1][l], z0 = q->f[2][l];
+        // The second and third corners step along the largest offsets first.
+        const uint32_t xy = x0 >= y0, yz = y0 >= z0, xz = x0 >= z0;
+        const uint32_t i1 = xy & xz, j1 = (!xy) & yz, k1 = (!xz) & (!yz);
+        const uint32_t i2 = xy | xz, j2 = (!xy) | yz, k2 = !(xz & yz);
+        const float x1 = x0 - (float) i1 + NOISE_G3;
+        const float y1 = y0 - (float) j1 + NOISE_G3;
+        const float z1 = z0 - (float) k1 + NOISE_G3;
+        const float x2 = x0 - (float) i2 + 2 * NOISE_G3;
+        const float y2 = y0 - (float) j2 + 2 * NOISE_G3;
+        const float z2 = z0 - (float) k2 + 2 * NOISE_G3;
+        const float x3 = x0 - 1 + 3 * NOISE_G3;
+        const float y3 = y0 - 1 + 3 * NOISE_G3;
+        const float z3 = z0 - 1 + 3 * NOISE_G3;
+        const uint32_t h1 = (hx + i1 * NOISE_HX) ^ (hy + j1 * NOISE_HY) ^ (hz + k1 * NOISE_HZ);
+        const uint32_t h2 = (hx + i2 * NOISE_HX) ^ (hy + j2 * NOISE_HY) ^ (hz + k2 * NOISE_HZ);
+        const uint32_t h3 = (hx + NOISE_HX) ^ (hy + NOISE_HY) ^ (hz + NOISE_HZ);
+        const float n = noise_corner3(noise_mix(hx ^ hy ^ hz), x0, y0, z0)
+                      + noise_corner3(noise_mix(h1), x1, y1, z1)
+                      + noise_corner3(noise_mix(h2), x2, y2, z2)
+                      + noise_corner3(noise_mix(h3), x3, y3, z3);
+        return n * NOISE_SIMPLEX3_SCALE;
+      }
+#endif
+
+  //////////////////////////////////////////////////////////////////////////////
+ // AVX2 Kernels //////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// These mirror the scalar kernels lane for lane, eight points at a time.
+// Builds with AVX2 run every point through them, even single ones, so the
+// point and array functions agree bit for bit whether or not FMA is used.
+
+#if defined(SOL_AVX2)
+      #if defined(SOL_FMA)
+            #define noise_madd(a, b, c) _mm256_fmadd_ps(a, b, c)
+      #else
+            #define noise_madd(a, b, c) _mm256_add_ps(_mm256_mul_ps(a, b), c)
+      #endif
+
+      #define noise_set1i(i) _mm256_set1_epi32((int) (i))
+
+      static inline
+      __m256i noise_mix_8(__m256i h) {
+        h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 15));
+        h = _mm256_mullo_epi32(h, noise_set1i(NOISE_HM));
+        return _mm256_xor_si256(h, _mm256_srli_epi32(h, 13));
+      }
+
+      static inline
+      __m256 noise_fade_8(__m256 t) {
+        const __m256 p = noise_madd(t, _mm256_set1_ps(6), _mm256_set1_ps(-15));
+        const __m256 q = noise_madd(t, p, _mm256_set1_ps(10));
+        return _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(t, t), t), q);
+      }
+
+      static inline
+      __m256 noise_lerp_8(__m256 t, __m256 a, __m256 b) {
+        return noise_madd(t, _mm256_sub_ps(b, a), a);
+      }
+
+      // Moves bit b of each hash lane into the float sign bit.
+      static inline
+      __m256 noise_sign_8(__m256i h, int b) {
+        return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_srli_epi32(h, b), 31));
+      }
+
+      static inline
+      __m256 noise_grad2_8(__m256i h, __m256 x, __m256 y) {
+        h = _mm256_srli_epi32(h, 29);
+        const __m256 lt4 = _mm256_castsi256_ps(_mm256_cmpgt_epi32(noise_set1i(4), h));
+        const __m256 u = _mm256_blendv_ps(y, x, lt4);
+        __m256 v = _mm256_blendv_ps(x, y, lt4);
+        v = _mm256_add_ps(v, v);
+        return _mm256_add_ps(_mm256_xor_ps(u, noise_sign_8(h, 0)),
+                             _mm256_xor_ps(v, noise_sign_8(h, 1)));
+      }
+
+      static inline
+      __m256 noise_grad3_8(__m256i h, __m256 x, __m256 y, __m256 z) {
+        h = _mm256_srli_epi32(h, 28);
+        const __m256 lt8 = _mm256_castsi256_ps(_mm256_cmpgt_epi32(noise_set1i(8), h));
+        const __m256 lt4 = _mm256_castsi256_ps(_mm256_cmpgt_epi32(noise_set1i(4), h));
+        // h | 2 == 14 picks out h == 12 and h == 14.
+        const __m256 hx = _mm256_castsi256_ps(
+          _mm256_cmpeq_epi32(_mm256_or_si256(h, noise_set1i(2)), noise_set1i(14)));
+        const __m256 u = _mm256_blendv_ps(y, x, lt8);
+        const __m256 v = _mm256_blendv_ps(_mm256_blendv_ps(z, x, hx), y, lt4);
+        return _mm256_add_ps(_mm256_xor_ps(u, noise_sign_8(h, 0)),
+                             _mm256_xor_ps(v, noise_sign_8(h, 1)));
+      }
+
+      static inline
+      __m256i noise_hash_8(const NoiseCell *q, size_t d, uint32_t k) {
+        const __m256i c = _mm256_loadu_si256((const __m256i *) q->c[d]);
+        return _mm256_mullo_epi32(c, noise_set1i(k));
+      }
+
+      #define noise_load_8(q, d) _mm256_loadu_ps((q)->f[d])
+
+      static
+      __m256 noise_perlin2_8(const NoiseCell *q) {
+        const __m256i x0 = noise_hash_8(q, 0, NOISE_HX), x1 = _mm256_add_epi32(x0, noise_set1i(NOISE_HX));
+        const __m256i y0 = noise_hash_8(q, 1, NOISE_HY), y1 = _mm256_add_epi32(y0, noise_set1i(NOISE_HY));
+        const __m256 one = _mm256_set1_ps(1);
+        const __m256 fx = noise_load_8(q, 0), fy = noise_load_8(q, 1);
+        const __m256 gx = _mm256_sub_ps(fx, one), gy = _mm256_sub_ps(fy, one);
+        const __m256 u = noise_fade_8(fx), v = noise_fade_8(fy);
+        const __m256 a = noise_lerp_8(u, noise_grad2_8(noise_mix_8(_mm256_xor_si256(x0, y0)), fx, fy),
+                                         noise_grad2_8(noise_mix_8(_mm256_xor_si256(x1, y0)), gx, fy));
+        const __m256 b = noise_lerp_8(u, noise_grad2_8(noise_mix_8(_mm256_xor_si256(x0, y1)), fx, gy),
+                                         noise_grad2_8(noise_mix_8(_mm256_xor_si256(x1, y1)), gx, gy));
+        return _mm256_mul_ps(noise_lerp_8(v, a, b), _mm256_set1_ps(NOISE_PERLIN2_SCALE));
+      }
+
+      #define noise_h3(a, b, c) noise_mix_8(_mm256_xor_si256(_mm256_xor_si256(a, b), c))
+
+      static
+      __m256 noise_perlin3_8(const NoiseCell *q) {
+        const __m256i x0 = noise_hash_8(q, 0, NOISE_HX), x1 = _mm256_add_epi32(x0, noise_set1i(NOISE_HX));
+        const __m256i y0 = noise_hash_8(q, 1, NOISE_HY), y1 = _mm256_add_epi32(y0, noise_set1i(NOISE_HY));
+        const __m256i z0 = noise_hash_8(q, 2, NOISE_HZ), z1 = _mm256_add_epi32(z0, noise_set1i(NOISE_HZ));
+        const __m256 one = _mm256_set1_ps(1);
+        const __m256 fx = noise_load_8(q, 0), fy = noise_load_8(q, 1), fz = noise_load_8(q, 2);
+        const __m256 gx = _mm256_sub_ps(fx, one), gy = _mm256_sub_ps(fy, one), gz = _mm256_sub_ps(fz, one);
+        const __m256 u = noise_fade_8(fx), v = noise_fade_8(fy), w = noise_fade_8(fz);
+        const __m256 a = noise_lerp_8(u, noise_grad3_8(noise_h3(x0, y0, z0), fx, fy, fz),
+                                         noise_grad3_8(noise_h3(x1, y0, z0), gx, fy, fz));
+        const __m256 b = noise_lerp_8(u, noise_grad3_8(noise_h3(x0, y1, z0), fx, gy, fz),
+                                         noise_grad3_8(noise_h3(x1, y1, z0), gx, gy, fz));
+        const __m256 c = noise_lerp_8(u, noise_grad3_8(noise_h3(x0, y0, z1), fx, fy, gz),
+                                         noise_grad3_8(noise_h3(x1, y0, z1), gx, fy, gz));
+        const __m256 d = noise_lerp_8(u, noise_grad3_8(noise_h3(x0, y1, z1), fx, gy, gz),
+                                         noise_grad3_8(noise_h3(x1, y1, z1), gx, gy, gz));
+        const __m256 r = noise_lerp_8(w, noise_lerp_8(v, a, b), noise_lerp_8(v, c, d));
+        return _mm256_mul_ps(r, _mm256_set1_ps(NOISE_PERLIN3_SCALE));
+      }
+
+      static inline
+      __m256 noise_corner2_8(__m256i h, __m256 x, __m256 y) {
+        __m256 t = _mm256_sub_ps(_mm256_set1_ps(0.5f), _mm256_mul_ps(x, x));
+        t = _mm256_sub_ps(t, _mm256_mul_ps(y, y));
+        t = _mm256_max_ps(t, _mm256_setzero_ps());
+        t = _mm256_mul_ps(t, t);
+        return _mm256_mul_ps(_mm256_mul_ps(t, t), noise_grad2_8(noise_mix_8(h), x, y));
+      }
+
+      static inline
+      __m256 noise_corner3_8(__m256i h, __m256 x, __m256 y, __m256 z) {
+        __m256 t = _mm256_sub_ps(_mm256_set1_ps(0.5f), _mm256_mul_ps(x, x));
+        t = _mm256_sub_ps(t, _mm256_mul_ps(y, y));
+        t = _mm256_sub_ps(t, _mm256_mul_ps(z, z));
+        t = _mm256_max_ps(t, _mm256_setzero_ps());
+        t = _mm256_mul_ps(t, t);
+        return _mm256_mul_ps(_mm256_mul_ps(t, t), noise_grad3_8(noise_mix_8(h), x, y, z));
+      }
+
+      // Steps a corner along each axis whose mask is set: the offset drops by
+      // one and the hash term advances by one lattice step.
+      static inline
+      void noise_step_8(__m256 m, __m256 *f, __m256i *h, uint32_t k) {
+        *f = _mm256_sub_ps(*f, _mm256_and_ps(m, _mm256_set1_ps(1)));
+        *h = _mm256_add_epi32(*h, _mm256_and_si256(_mm256_castps_si256(m), noise_set1i(k)));
+      }
+
+      static
+      __m256 noise_simplex2_8(const NoiseCell *q) {
+        const __m256i hx = noise_hash_8(q, 0, NOISE_HX), hy = noise_hash_8(q, 1, NOISE_HY);
+        const __m256 x0 = noise_load_8(q, 0), y0 = noise_load_8(q, 1);
+        const __m256 g1 = _mm256_set1_ps(NOISE_G2), g2 = _mm256_set1_ps(2 * NOISE_G2 - 1);
+        const __m256 i1 = _mm256_cmp_ps(x0, y0, _CMP_GT_OQ);
+        const __m256 j1 = _mm256_andnot_ps(i1, _mm256_castsi256_ps(noise_set1i(~0u)));
+        __m256 x1 = _mm256_add_ps(x0, g1), y1 = _mm256_add_ps(y0, g1);
+        __m256i h1x = hx, h1y = hy;
+        noise_step_8(i1, &x1, &h1x, NOISE_HX);
+        noise_step_8(j1, &y1, &h1y, NOISE_HY);
+        const __m256 x2 = _mm256_add_ps(x0, g2), y2 = _mm256_add_ps(y0, g2);
+        const __m256i h2 = _mm256_xor_si256(_mm256_add_epi32(hx, noise_set1i(NOISE_HX)),
+                                            _mm256_add_epi32(hy, noise_set1i(NOISE_HY)));
+        __m256 n = noise_corner2_8(_mm256_xor_si256(hx, hy), x0, y0);
+        n = _mm256_add_ps(n, noise_corner2_8(_mm256_xor_si256(h1x, h1y), x1, y1));
+        n = _mm256_add_ps(n, noise_corner2_8(h2, x2, y2));
+        return _mm256_mul_ps(n, _mm256_set1_ps(NOISE_SIMPLEX2_SCALE));
+      }
+
+      static
+      __m256 noise_simplex3_8(const NoiseCell *q) {
+        const __m256i hx = noise_hash_8(q, 0, NOISE_HX);
+        const __m256i hy = noise_hash_8(q, 1, NOISE_HY);
+        const __m256i hz = noise_hash_8(q, 2, NOISE_HZ);
+        const __m256 x0 = noise_load_8(q, 0), y0 = noise_load_8(q, 1), z0 = noise_load_8(q, 2);
+        const __m256 all = _mm256_castsi256_ps(noise_set1i(~0u));
+        const __m256 xy = _mm256_cmp_ps(x0, y0, _CMP_GE_OQ);
+        const __m256 yz = _mm256_cmp_ps(y0, z0, _CMP_GE_OQ);
+        const __m256 xz = _mm256_cmp_ps(x0, z0, _CMP_GE_OQ);
+        const __m256 i1 = _mm256_and_ps(xy, xz);
+        const __m256 j1 = _mm256_andnot_ps(xy, yz);
+        const __m256 k1 = _mm256_andnot_ps(_mm256_or_ps(xz, yz), all);
+        const __m256 i2 = _mm256_or_ps(xy, xz);
+        const __m256 j2 = _mm256_or_ps(_mm256_andnot_ps(xy, all), yz);
+        const __m256 k2 = _mm256_andnot_ps(_mm256_and_ps(xz, yz), all);
+        const __m256 g1 = _mm256_set1_ps(NOISE_G3), g2 = _mm256_set1_ps(2 * NOISE_G3);
+        const __m256 g3 = _mm256_set1_ps(3 * NOISE_G3 - 1);
+        __m256 x1 = _mm256_add_ps(x0, g1), y1 = _mm256_add_ps(y0, g1), z1 = _mm256_add_ps(z0, g1);
+        __m256 x2 = _mm256_add_ps(x0, g2), y2 = _mm256_add_ps(y0, g2), z2 = _mm256_add_ps(z0, g2);
+        const __m256 x3 = _mm256_add_ps(x0, g3), y3 = _mm256_add_ps(y0, g3), z3 = _mm256_add_ps(z0, g3);
+        __m256i h1x = hx, h1y = hy, h1z = hz, h2x = hx, h2y = hy, h2z = hz;
+        noise_step_8(i1, &x1, &h1x, NOISE_HX);
+        noise_step_8(j1, &y1, &h1y, NOISE_HY);
+        noise_step_8(k1, &z1, &h1z, NOISE_HZ);
+        noise_step_8(i2, &x2, &h2x, NOISE_HX);
+        noise_step_8(j2, &y2, &h2y, NOISE_HY);
+        noise_step_8(k2, &z2, &h2z, NOISE_HZ);
+        const __m256i h3 = _mm256_xor_si256(_mm256_xor_si256(
+          _mm256_add_epi32(hx, noise_set1i(NOISE_HX)), _mm256_add_epi32(hy, noise_set1i(NOISE_HY))),
+          _mm256_add_epi32(hz, noise_set1i(NOISE_HZ)));
+        __m256 n = noise_corner3_8(_mm256_xor_si256(_mm256_xor_si256(hx, hy), hz), x0, y0, z0);
+        n = _mm256_add_ps(n, noise_corner3_8(_mm256_xor_si256(_mm256_xor_si256(h1x, h1y), h1z), x1, y1, z1));
+        n = _mm256_add_ps(n, noise_corner3_8(_mm256_xor_si256(_mm256_xor_si256(h2x, h2y), h2z), x2, y2, z2));
+        n = _mm256_add_ps(n, noise_corner3_8(h3, x3, y3, z3));
+        return _mm256_mul_ps(n, _mm256_set1_ps(NOISE_SIMPLEX3_SCALE));
+      }
+#endif
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Batch Evaluation //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+typedef struct {
+  Float *out;
+  const void *p;
+  int kind;
+  size_t octaves;
+  Float lacunarity, gain;
+} NoiseJob;
+
+// Sums octaves of one kernel for the points [i, i + m), m <= 8, taking the
+// AVX2 kernels with any unused lanes zeroed, or the scalar ones. Octave o is
+// sampled at frequency lacunarity^o with weight gain^o, and the total is
+// divided by the sum of the weights so it stays in the kernel's range.
+static
+void noise_batch(const NoiseJob *j, size_t dims, size_t i, size_t m) {
+  NoiseCell q;
+  for (size_t d = 0; d < 3; d++) {
+    for (size_t l = m; l < 8; l++) {
+      q.c[d][l] = 0;
+      q.f[d][l] = 0;
+    }
+  }
+  float acc[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  Float freq = 1, amp = 1, norm = 0;
+  for (size_t o = 0; o < j->octaves; o++) {
+    for (size_t l = 0; l < m; l++) {
+      const size_t k = i + l;
+      if (dims == 2) {
+        const Vec2 *p = (const Vec2 *) j->p + k;
+        noise_cell2(&q, l, j->kind, p->x * freq, p->y * freq);
+      } else {
+        const Vec3p *p = (const Vec3p *) j->p + k;
+        noise_cell3(&q, l, j->kind, p->x * freq, p->y * freq, p->z * freq);
+      }
+    }
+    #if defined(SOL_AVX2)
+          __m256 r;
+          if (dims == 2)
+            r = j->kind == NOISE_SIMPLEX ? noise_simplex2_8(&q) : noise_perlin2_8(&q);
+          else
+            r = j->kind == NOISE_SIMPLEX ? noise_simplex3_8(&q) : noise_perlin3_8(&q);
+          _mm256_storeu_ps(acc, noise_madd(r, _mm256_set1_ps((float) amp), _mm256_loadu_ps(acc)));
+    #else
+          for (size_t l = 0; l < m; l++) {
+            float r;
+            if (dims == 2)
+              r = j->kind == NOISE_SIMPLEX ? noise_simplex2_1(&q, l) : noise_perlin2_1(&q, l);
+            else
+              r = j->kind == NOISE_SIMPLEX ? noise_simplex3_1(&q, l) : noise_perlin3_1(&q, l);
+            acc[l] += (float) amp * r;
+          }
+    #endif
+    norm += amp;
+    amp *= j->gain;
+    freq *= j->lacunarity;
+  }
+  const Float inv = norm > 0 ? 1 / norm : 0;
+  for (size_t l = 0; l < m; l++)
+    j->out[i + l] = acc[l] * inv;
+}
+
+static
+void noise2_task(void *job, size_t lo, size_t hi) {
+  for (size_t i = lo; i < hi; i += 8)
+    noise_batch(job, 2, i, hi - i < 8 ? hi - i : 8);
+}
+
+static
+void noise3_task(void *job, size_t lo, size_t hi) {
+  for (size_t i = lo; i < hi; i += 8)
+    noise_batch(job, 3, i, hi - i < 8 ? hi - i : 8);
+}
+
+static
+Float noise2_one(Vec2 p, int kind, size_t octaves, Float lacunarity, Float gain) {
+  Float out;
+  const NoiseJob j = {&out, &p, kind, octaves, lacunarity, gain};
+  noise_batch(&j, 2, 0, 1);
+  return out;
+}
+
+static
+Float noise3_one(Vec3 p, int kind, size_t octaves, Float lacunarity, Float gain) {
+  Float out;
+  Vec3p v;
+  vec3_store(&v, p);
+  const NoiseJob j = {&out, &v, kind, octaves, lacunarity, gain};
+  noise_batch(&j, 3, 0, 1);
+  return out;
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Point Functions ///////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+/// noise2 ///
+// Description
+//   Samples 2D simplex noise, a smooth pseudo-random field in about [-1, 1]
+//   with features about one unit across.
+// Arguments
+//   p: position (Vec2)
+// Returns
+//   noise (Float)
+
+sol_inline
+Float noise2(Vec2 p) {
+  return noise2_one(p, NOISE_SIMPLEX, 1, 1, 1);
+}
+
+/// noise2_perlin ///
+// Description
+//   Samples 2D Perlin gradient noise, in about [-1, 1] and zero at every
+//   integer lattice point.
+// Arguments
+//   p: position (Vec2)
+// Returns
+//   noise (Float)
+
+sol_inline
+Float noise2_perlin(Vec2 p) {
+  return noise2_one(p, NOISE_PERLIN, 1, 1, 1);
+}
+
+/// noise2_fbm ///
+// Description
+//   Samples fractal Brownian motion: octaves of simplex noise, each at
+//   lacunarity times the frequency and gain times the weight of the last,
+//   normalized by the total weight. Typical values are 2 and 0.5.
+// Arguments
+//   p: position (Vec2)
+//   octaves: octave count (size_t)
+//   lacunarity: frequency multiplier (Float)
+//   gain: weight multiplier (Float)
+// Returns
+//   noise (Float)
+
+sol_inline
+Float noise2_fbm(Vec2 p, size_t octaves, Float lacunarity, Float gain) {
+  return noise2_one(p, NOISE_SIMPLEX, octaves, lacunarity, gain);
+}
+
+/// noise3 ///
+// Description
+//   Samples 3D simplex noise, a smooth pseudo-random field in about [-1, 1]
+//   with features about one unit across.
+// Arguments
+//   p: position (Vec3)
+// Returns
+//   noise (Float)
+
+sol_inline
+Float noise3(Vec3 p) {
+  return noise3_one(p, NOISE_SIMPLEX, 1, 1, 1);
+}
+
+/// noise3_perlin ///
+// Description
+//   Samples 3D Perlin gradient noise, in about [-1, 1] and zero at every
+//   integer lattice point.
+// Arguments
+//   p: position (Vec3)
+// Returns
+//   noise (Float)
+
+sol_inline
+Float noise3_perlin(Vec3 p) {
+  return noise3_one(p, NOISE_PERLIN, 1, 1, 1);
+}
+
+/// noise3_fbm ///
+// Description
+//   Samples fractal Brownian motion over 3D simplex noise; see noise2_fbm.
+// Arguments
+//   p: position (Vec3)
+//   octaves: octave count (size_t)
+//   lacunarity: frequency multiplier (Float)
+//   gain: weight multiplier (Float)
+// Returns
+//   noise (Float)
+
+sol_inline
+Float noise3_fbm(Vec3 p, size_t octaves, Float lacunarity, Float gain) {
+  return noise3_one(p, NOISE_SIMPLEX, octaves, lacunarity, gain);
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Array Functions ///////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Each point costs on the order of a hundred operations per octave, so the
+// threading size is scaled up to match.
+#define NOISE_COST 64
+
+/// noise2_array ///
+// Description
+//   Samples 2D simplex noise at every point of an array, matching noise2.
+// Arguments
+//   out: output (Float*)
+//   points: positions (Vec2*)
+//   n: count (size_t)
+// Returns
+//   void
+
+sol_inline
+void noise2_array(Float *out, const Vec2 *points, size_t n) {
+  NoiseJob j = {out, points, NOISE_SIMPLEX, 1, 1, 1};
+  sol_parallel_for(n, sizeof(Vec2) * NOISE_COST, noise2_task, &j);
+}
+
+/// noise2_perlin_array ///
+// Description
+//   Samples 2D Perlin noise at every point of an array, matching noise2_perlin.
+// Arguments
+//   out: output (Float*)
+//   points: positions (Vec2*)
+//   n: count (size_t)
+// Returns
+//   void
+
+sol_inline
+void noise2_perlin_array(Float *out, const Vec2 *points, size_t n) {
+  NoiseJob j = {out, points, NOISE_PERLIN, 1, 1, 1};
+  sol_parallel_for(n, sizeof(Vec2) * NOISE_COST, noise2_task, &j);
+}
+
+/// noise2_fbm_array ///
+// Description
+//   Samples fractal Brownian motion at every point of an array, matching
+//   noise2_fbm.
+// Arguments
+//   out: output (Float*)
+//   points: positions (Vec2*)
+//   n: count (size_t)
+//   octaves: octave count (size_t)
+//   lacunarity: frequency multiplier (Float)
+//   gain: weight multiplier (Float)
+// Returns
+//   void
+
+sol_inline
+void noise2_fbm_array(Float *out, const Vec2 *points, size_t n,
+                      size_t octaves, Float lacunarity, Float gain) {
+  NoiseJob j = {out, points, NOISE_SIMPLEX, octaves, lacunarity, gain};
+  sol_parallel_for(n, sizeof(Vec2) * NOISE_COST * (octaves + 1), noise2_task, &j);
+}
+
+/// noise3_array ///
+// Description
+//   Samples 3D simplex noise at every point of an array, matching noise3.
+// Arguments
+//   out: output (Float*)
+//   points: positions (Vec3p*)
+//   n: count (size_t)
+// Returns
+//   void
+
+sol_inline
+void noise3_array(Float *out, const Vec3p *points, size_t n) {
+  NoiseJob j = {out, points, NOISE_SIMPLEX, 1, 1, 1};
+  sol_parallel_for(n, sizeof(Vec3p) * NOISE_COST, noise3_task, &j);
+}
+
+/// noise3_perlin_array ///
+// Description
+//   Samples 3D Perlin noise at every point of an array, matching noise3_perlin.
+// Arguments
+//   out: output (Float*)
+//   points: positions (Vec3p*)
+//   n: count (size_t)
+// Returns
+//   void
+
+sol_inline
+void noise3_perlin_array(Float *out, const Vec3p *points, size_t n) {
+  NoiseJob j = {out, points, NOISE_PERLIN, 1, 1, 1};
+  sol_parallel_for(n, sizeof(Vec3p) * NOISE_COST, noise3_task, &j);
+}
+
+/// noise3_fbm_array ///
+// Description
+//   Samples fractal Brownian motion at every point of an array, matching
+//   noise3_fbm.
+// Arguments
+//   out: output (Float*)
+//   points: positions (Vec3p*)
+//   n: count (size_t)
+//   octaves: octave count (size_t)
+//   lacunarity: frequency multiplier (Float)
+//   gain: weight multiplier (Float)
+// Returns
+//   void
+
+sol_inline
+void noise3_fbm_array(Float *out, const Vec3p *points, size_t n,
+                      size_t octaves, Float lacunarity, Float gain) {
+  NoiseJob j = {out, points, NOISE_SIMPLEX, octaves, lacunarity, gain};
+  sol_parallel_for(n, sizeof(Vec3p) * NOISE_COST * (octaves + 1), noise3_task, &j);
+}
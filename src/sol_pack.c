@@ -0,0 +1,1085 @@
+    /////////////////////////////////////////////////////////////////
+   // sol_pack.c ///////////////////////////////////////////////////
+  // Description: Adds compact vector storage formats to Sol. /////
+ // Author: David Garland (https://github.com/davidgarland/sol) //
+/////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Local Headers /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include "../sol.h"
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Standard Headers //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <math.h>
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Lane Helpers //////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// The batch kernels work on 8 elements at a time: the 16-bit components are
+// de-interleaved in integer registers, widened to 8 floats and written to (or
+// read from) the SoA arrays, converting to double when Float is double.
+
+#if defined(SOL_AVX)
+
+static inline
+__m256 pack_load8(const Float *f) {
+  #if defined(SOL_AVX_64)
+        return _mm256_set_m128(_mm256_cvtpd_ps(_mm256_loadu_pd(f + 4)),
+                               _mm256_cvtpd_ps(_mm256_loadu_pd(f)));
+  #else
+        return _mm256_loadu_ps(f);
+  #endif
+}
+
+static inline
+void pack_store8(Float *f, __m256 v) {
+  #if defined(SOL_AVX_64)
+        _mm256_storeu_pd(f, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+        _mm256_storeu_pd(f + 4, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+  #else
+        _mm256_storeu_ps(f, v);
+  #endif
+}
+
+static inline
+__m256i pack_join128(__m128i lo, __m128i hi) {
+  return _mm256_insertf128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+static inline
+void pack_split3(const void *p, __m128i *x, __m128i *y, __m128i *z) {
+  const __m128i r0 = _mm_loadu_si128((const __m128i *) p);
+  const __m128i r1 = _mm_loadu_si128((const __m128i *) p + 1);
+  const __m128i r2 = _mm_loadu_si128((const __m128i *) p + 2);
+  *x = _mm_or_si128(_mm_or_si128(
+         _mm_shuffle_epi8(r0, _mm_setr_epi8(0, 1, 6, 7, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1)),
+         _mm_shuffle_epi8(r1, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, 2, 3, 8, 9, 14, 15, -1, -1, -1, -1))),
+         _mm_shuffle_epi8(r2, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 4, 5, 10, 11)));
+  *y = _mm_or_si128(_mm_or_si128(
+         _mm_shuffle_epi8(r0, _mm_setr_epi8(2, 3, 8, 9, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1)),
+         _mm_shuffle_epi8(r1, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, 4, 5, 10, 11, -1, -1, -1, -1, -1, -1))),
+         _mm_shuffle_epi8(r2, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 1, 6, 7, 12, 13)));
+  *z = _mm_or_si128(_mm_or_si128(
+         _mm_shuffle_epi8(r0, _mm_setr_epi8(4, 5, 10, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1)),
+         _mm_shuffle_epi8(r1, _mm_setr_epi8(-1, -1, -1, -1, 0, 1, 6, 7, 12, 13, -1, -1, -1, -1, -1, -1))),
+         _mm_shuffle_epi8(r2, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, 3, 8, 9, 14, 15)));
+}
+
+static inline
+void pack_merge3(void *p, __m128i x, __m128i y, __m128i z) {
+  const __m128i r0 = _mm_or_si128(_mm_or_si128(
+         _mm_shuffle_epi8(x, _mm_setr_epi8(0, 1, -1, -1, -1, -1, 2, 3, -1, -1, -1, -1, 4, 5, -1, -1)),
+         _mm_shuffle_epi8(y, _mm_setr_epi8(-1, -1, 0, 1, -1, -1, -1, -1, 2, 3, -1, -1, -1, -1, 4, 5))),
+         _mm_shuffle_epi8(z, _mm_setr_epi8(-1, -1, -1, -1, 0, 1, -1, -1, -1, -1, 2, 3, -1, -1, -1, -1)));
+  const __m128i r1 = _mm_or_si128(_mm_or_si128(
+         _mm_shuffle_epi8(x, _mm_setr_epi8(-1, -1, 6, 7, -1, -1, -1, -1, 8, 9, -1, -1, -1, -1, 10, 11)),
+         _mm_shuffle_epi8(y, _mm_setr_epi8(-1, -1, -1, -1, 6, 7, -1, -1, -1, -1, 8, 9, -1, -1, -1, -1))),
+         _mm_shuffle_epi8(z, _mm_setr_epi8(4, 5, -1, -1, -1, -1, 6, 7, -1, -1, -1, -1, 8, 9, -1, -1)));
+  const __m128i r2 = _mm_or_si128(_mm_or_si128(
+         _mm_shuffle_epi8(x, _mm_setr_epi8(-1, -1, -1, -1, 12, 13, -1, -1, -1, -1, 14, 15, -1, -1, -1, -1)),
+         _mm_shuffle_epi8(y, _mm_setr_epi8(10, 11, -1, -1, -1, -1, 12, 13, -1, -1, -1, -1, 14, 15, -1, -1))),
+         _mm_shuffle_epi8(z, _mm_setr_epi8(-1, -1, 10, 11, -1, -1, -1, -1, 12, 13, -1, -1, -1, -1, 14, 15)));
+  _mm_storeu_si128((__m128i *) p, r0);
+  _mm_storeu_si128((__m128i *) p + 1, r1);
+  _mm_storeu_si128((__m128i *) p + 2, r2);
+}
+
+static inline
+void pack_split4(const void *p, __m128i *x, __m128i *y, __m128i *z, __m128i *w) {
+  const __m128i r0 = _mm_loadu_si128((const __m128i *) p);
+  const __m128i r1 = _mm_loadu_si128((const __m128i *) p + 1);
+  const __m128i r2 = _mm_loadu_si128((const __m128i *) p + 2);
+  const __m128i r3 = _mm_loadu_si128((const __m128i *) p + 3);
+  const __m128i t0 = _mm_unpacklo_epi16(r0, r1);
+  const __m128i t1 = _mm_unpackhi_epi16(r0, r1);
+  const __m128i t2 = _mm_unpacklo_epi16(r2, r3);
+  const __m128i t3 = _mm_unpackhi_epi16(r2, r3);
+  const __m128i u0 = _mm_unpacklo_epi16(t0, t1);
+  const __m128i u1 = _mm_unpackhi_epi16(t0, t1);
+  const __m128i u2 = _mm_unpacklo_epi16(t2, t3);
+  const __m128i u3 = _mm_unpackhi_epi16(t2, t3);
+  *x = _mm_unpacklo_epi64(u0, u2);
+  *y = _mm_unpackhi_epi64(u0, u2);
+  *z = _mm_unpacklo_epi64(u1, u3);
+  *w = _mm_unpackhi_epi64(u1, u3);
+}
+
+static inline
+void pack_merge4(void *p, __m128i x, __m128i y, __m128i z, __m128i w) {
+  const __m128i a0 = _mm_unpacklo_epi16(x, y);
+  const __m128i a1 = _mm_unpackhi_epi16(x, y);
+  const __m128i b0 = _mm_unpacklo_epi16(z, w);
+  const __m128i b1 = _mm_unpackhi_epi16(z, w);
+  _mm_storeu_si128((__m128i *) p, _mm_unpacklo_epi32(a0, b0));
+  _mm_storeu_si128((__m128i *) p + 1, _mm_unpackhi_epi32(a0, b0));
+  _mm_storeu_si128((__m128i *) p + 2, _mm_unpacklo_epi32(a1, b1));
+  _mm_storeu_si128((__m128i *) p + 3, _mm_unpackhi_epi32(a1, b1));
+}
+
+static inline
+__m256 pack_snorm_f(__m128i v) {
+  #if defined(SOL_AVX2)
+        const __m256i i = _mm256_cvtepi16_epi32(v);
+  #else
+        const __m256i i = pack_join128(_mm_cvtepi16_epi32(v),
+                                       _mm_cvtepi16_epi32(_mm_unpackhi_epi64(v, v)));
+  #endif
+  return _mm256_max_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(i),
+                                     _mm256_set1_ps(1.0f / 32767)),
+                       _mm256_set1_ps(-1));
+}
+
+// Quantizes 8 Floats the way pack_snorm does: clamped, scaled and rounded to
+// nearest even in Float, so the batch and scalar encoders agree bit for bit.
+static inline
+__m128i pack_snorm8(const Float *f) {
+  #if defined(SOL_AVX_64)
+        const __m256d neg = _mm256_set1_pd(-1), pos = _mm256_set1_pd(1), k = _mm256_set1_pd(32767);
+        const __m128i a = _mm256_cvtpd_epi32(_mm256_mul_pd(_mm256_min_pd(_mm256_max_pd(_mm256_loadu_pd(f), neg), pos), k));
+        const __m128i b = _mm256_cvtpd_epi32(_mm256_mul_pd(_mm256_min_pd(_mm256_max_pd(_mm256_loadu_pd(f + 4), neg), pos), k));
+        return _mm_packs_epi32(a, b);
+  #else
+        const __m256 c = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(f), _mm256_set1_ps(-1)), _mm256_set1_ps(1));
+        const __m256i i = _mm256_cvtps_epi32(_mm256_mul_ps(c, _mm256_set1_ps(32767)));
+        return _mm_packs_epi32(_mm256_castsi256_si128(i), _mm256_extractf128_si256(i, 1));
+  #endif
+}
+
+static inline
+__m256 pack_unorm_f(__m128i v) {
+  #if defined(SOL_AVX2)
+        const __m256i i = _mm256_cvtepu16_epi32(v);
+  #else
+        const __m256i i = pack_join128(_mm_cvtepu16_epi32(v),
+                                       _mm_cvtepu16_epi32(_mm_unpackhi_epi64(v, v)));
+  #endif
+  return _mm256_mul_ps(_mm256_cvtepi32_ps(i), _mm256_set1_ps(1.0f / 65535));
+}
+
+// Quantizes 8 Floats the way pack_unorm does.
+static inline
+__m128i pack_unorm8(const Float *f) {
+  #if defined(SOL_AVX_64)
+        const __m256d zero = _mm256_setzero_pd(), pos = _mm256_set1_pd(1), k = _mm256_set1_pd(65535);
+        const __m128i a = _mm256_cvtpd_epi32(_mm256_mul_pd(_mm256_min_pd(_mm256_max_pd(_mm256_loadu_pd(f), zero), pos), k));
+        const __m128i b = _mm256_cvtpd_epi32(_mm256_mul_pd(_mm256_min_pd(_mm256_max_pd(_mm256_loadu_pd(f + 4), zero), pos), k));
+        return _mm_packus_epi32(a, b);
+  #else
+        const __m256 c = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(f), _mm256_setzero_ps()), _mm256_set1_ps(1));
+        const __m256i i = _mm256_cvtps_epi32(_mm256_mul_ps(c, _mm256_set1_ps(65535)));
+        return _mm_packus_epi32(_mm256_castsi256_si128(i), _mm256_extractf128_si256(i, 1));
+  #endif
+}
+
+// Projects and folds 8 vectors onto the octahedron as oct3_encode does, in
+// Float, leaving the square coordinates in px and py.
+static inline
+void pack_oct8(Float *px, Float *py, const Float *x, const Float *y, const Float *z) {
+  #if defined(SOL_AVX_64)
+        const __m256d sign = _mm256_set1_pd(-0.0), one = _mm256_set1_pd(1), zero = _mm256_setzero_pd();
+        for (size_t h = 0; h < 8; h += 4) {
+          const __m256d vx = _mm256_loadu_pd(x + h), vy = _mm256_loadu_pd(y + h), vz = _mm256_loadu_pd(z + h);
+          const __m256d s = _mm256_add_pd(_mm256_add_pd(_mm256_andnot_pd(sign, vx), _mm256_andnot_pd(sign, vy)),
+                                          _mm256_andnot_pd(sign, vz));
+          const __m256d live = _mm256_cmp_pd(s, zero, _CMP_NEQ_OQ);
+          const __m256d qx = _mm256_and_pd(live, _mm256_div_pd(vx, s));
+          const __m256d qy = _mm256_and_pd(live, _mm256_div_pd(vy, s));
+          const __m256d fx = _mm256_or_pd(_mm256_sub_pd(one, _mm256_andnot_pd(sign, qy)),
+                                          _mm256_and_pd(sign, _mm256_cmp_pd(qx, zero, _CMP_LT_OQ)));
+          const __m256d fy = _mm256_or_pd(_mm256_sub_pd(one, _mm256_andnot_pd(sign, qx)),
+                                          _mm256_and_pd(sign, _mm256_cmp_pd(qy, zero, _CMP_LT_OQ)));
+          const __m256d lower = _mm256_and_pd(live, _mm256_cmp_pd(vz, zero, _CMP_LT_OQ));
+          _mm256_storeu_pd(px + h, _mm256_blendv_pd(qx, fx, lower));
+          _mm256_storeu_pd(py + h, _mm256_blendv_pd(qy, fy, lower));
+        }
+  #else
+        const __m256 sign = _mm256_set1_ps(-0.0f), one = _mm256_set1_ps(1), zero = _mm256_setzero_ps();
+        const __m256 vx = _mm256_loadu_ps(x), vy = _mm256_loadu_ps(y), vz = _mm256_loadu_ps(z);
+        const __m256 s = _mm256_add_ps(_mm256_add_ps(_mm256_andnot_ps(sign, vx), _mm256_andnot_ps(sign, vy)),
+                                       _mm256_andnot_ps(sign, vz));
+        const __m256 live = _mm256_cmp_ps(s, zero, _CMP_NEQ_OQ);
+        const __m256 qx = _mm256_and_ps(live, _mm256_div_ps(vx, s));
+        const __m256 qy = _mm256_and_ps(live, _mm256_div_ps(vy, s));
+        const __m256 fx = _mm256_or_ps(_mm256_sub_ps(one, _mm256_andnot_ps(sign, qy)),
+                                       _mm256_and_ps(sign, _mm256_cmp_ps(qx, zero, _CMP_LT_OQ)));
+        const __m256 fy = _mm256_or_ps(_mm256_sub_ps(one, _mm256_andnot_ps(sign, qx)),
+                                       _mm256_and_ps(sign, _mm256_cmp_ps(qy, zero, _CMP_LT_OQ)));
+        const __m256 lower = _mm256_and_ps(live, _mm256_cmp_ps(vz, zero, _CMP_LT_OQ));
+        _mm256_storeu_ps(px, _mm256_blendv_ps(qx, fx, lower));
+        _mm256_storeu_ps(py, _mm256_blendv_ps(qy, fy, lower));
+  #endif
+}
+
+#endif
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Scalar Quantization ///////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+static inline
+int16_t pack_snorm(Float f) {
+  return (int16_t) flt_round(flt_clamp(f, -1, 1) * 32767);
+}
+
+static inline
+Float pack_snorm_flt(int16_t s) {
+  const Float f = (Float) s / 32767;
+  return f < -1 ? -1 : f;
+}
+
+static inline
+uint16_t pack_unorm(Float f) {
+  return (uint16_t) flt_round(flt_clamp(f, 0, 1) * 65535);
+}
+
+static inline
+Float pack_unorm_flt(uint16_t u) {
+  return (Float) u / 65535;
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Batch Jobs ////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Every *_array function below is a task over elements [lo, hi) run through
+// sol_parallel_for. The task offsets the job's pointers by lo and then runs
+// the same loop as a whole-array call would.
+
+typedef struct {
+  void *out;
+  const void *in;
+  Soa4 soa;
+} PackJob;
+
+static inline
+Soa3 pack_soa3_at(const PackJob *j, size_t lo) {
+  const Soa3 out = {j->soa.x + lo, j->soa.y + lo, j->soa.z + lo};
+  return out;
+}
+
+static inline
+Soa4 pack_soa4_at(const PackJob *j, size_t lo) {
+  const Soa4 out = {j->soa.x + lo, j->soa.y + lo, j->soa.z + lo, j->soa.w + lo};
+  return out;
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Half-Precision Storage ////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+/// vec3h_encode ///
+// Description
+//   Encodes a vector as half-precision floats.
+// Arguments
+//   v: vector (Vec3)
+// Returns
+//   packed vector (Vec3h)
+
+sol_inline
+Vec3h vec3h_encode(Vec3 v) {
+  Vec3h out;
+  out.x = cv_flt_half(v.x);
+  out.y = cv_flt_half(v.y);
+  out.z = cv_flt_half(v.z);
+  return out;
+}
+
+/// vec3h_decode ///
+// Description
+//   Decodes a half-precision vector.
+// Arguments
+//   h: packed vector (Vec3h)
+// Returns
+//   vector (Vec3)
+
+sol_inline
+Vec3 vec3h_decode(Vec3h h) {
+  return vec3_init(cv_half_flt(h.x), cv_half_flt(h.y), cv_half_flt(h.z));
+}
+
+/// vec4h_encode ///
+// Description
+//   Encodes a quaternion as half-precision floats.
+// Arguments
+//   v: quaternion (Vec4)
+// Returns
+//   packed quaternion (Vec4h)
+
+sol_inline
+Vec4h vec4h_encode(Vec4 v) {
+  Vec4h out;
+  out.x = cv_flt_half(v.x);
+  out.y = cv_flt_half(v.y);
+  out.z = cv_flt_half(v.z);
+  out.w = cv_flt_half(v.w);
+  return out;
+}
+
+/// vec4h_decode ///
+// Description
+//   Decodes a half-precision quaternion.
+// Arguments
+//   h: packed quaternion (Vec4h)
+// Returns
+//   quaternion (Vec4)
+
+sol_inline
+Vec4 vec4h_decode(Vec4h h) {
+  return vec4_init(cv_half_flt(h.x), cv_half_flt(h.y),
+                   cv_half_flt(h.z), cv_half_flt(h.w));
+}
+
+static
+void vec3h_encode_task(void *job, size_t lo, size_t hi) {
+  const PackJob *j = job;
+  Vec3h *out = ((Vec3h *) j->out) + lo;
+  const Soa3 in = pack_soa3_at(j, lo);
+  const size_t n = hi - lo;
+  size_t i = 0;
+  #if defined(SOL_F16C)
+        for (; i + 8 <= n; i += 8)
+          pack_merge3(&out[i],
+                      _mm256_cvtps_ph(pack_load8(in.x + i), _MM_FROUND_TO_NEAREST_INT),
+                      _mm256_cvtps_ph(pack_load8(in.y + i), _MM_FROUND_TO_NEAREST_INT),
+                      _mm256_cvtps_ph(pack_load8(in.z + i), _MM_FROUND_TO_NEAREST_INT));
+  #endif
+  for (; i < n; i++) {
+    out[i].x = cv_flt_half(in.x[i]);
+    out[i].y = cv_flt_half(in.y[i]);
+    out[i].z = cv_flt_half(in.z[i]);
+  }
+}
+
+/// vec3h_encode_array ///
+// Description
+//   Encodes SoA vectors as an array of half-precision vectors.
+// Arguments
+//   out: packed vectors (Vec3h*)
+//   in: vectors (Soa3)
+//   n: count (size_t)
+// Returns
+//   void
+
+sol_inline
+void vec3h_encode_array(Vec3h *out, Soa3 in, size_t n) {
+  PackJob j = {out, NULL, {in.x, in.y, in.z, NULL}};
+  sol_parallel_for(n, sizeof(Vec3h) + 3 * sizeof(Float), vec3h_encode_task, &j);
+}
+
+static
+void vec3h_decode_task(void *job, size_t lo, size_t hi) {
+  const PackJob *j = job;
+  const Soa3 out = pack_soa3_at(j, lo);
+  const Vec3h *in = ((const Vec3h *) j->in) + lo;
+  const size_t n = hi - lo;
+  size_t i = 0;
+  #if defined(SOL_F16C)
+        for (; i + 8 <= n; i += 8) {
+          __m128i x, y, z;
+          pack_split3(&in[i], &x, &y, &z);
+          pack_store8(out.x + i, _mm256_cvtph_ps(x));
+          pack_store8(out.y + i, _mm256_cvtph_ps(y));
+          pack_store8(out.z + i, _mm256_cvtph_ps(z));
+        }
+  #endif
+  for (; i < n; i++) {
+    out.x[i] = cv_half_flt(in[i].x);
+    out.y[i] = cv_half_flt(in[i].y);
+    out.z[i] = cv_half_flt(in[i].z);
+  }
+}
+
+/// vec3h_decode_array ///
+// Description
+//   Decodes an array of half-precision vectors into SoA vectors.
+// Arguments
+//   out: vectors (Soa3)
+//   in: packed vectors (Vec3h*)
+//   n: count (size_t)
+// Returns
+//   void
+
+sol_inline
+void vec3h_decode_array(Soa3 out, const Vec3h *in, size_t n) {
+  PackJob j = {NULL, in, {out.x, out.y, out.z, NULL}};
+  sol_parallel_for(n, sizeof(Vec3h) + 3 * sizeof(Float), vec3h_decode_task, &j);
+}
+
+static
+void vec4h_encode_task(void *job, size_t lo, size_t hi) {
+  const PackJob *j = job;
+  Vec4h *out = ((Vec4h *) j->out) + lo;
+  const Soa4 in = pack_soa4_at(j, lo);
+  const size_t n = hi - lo;
+  size_t i = 0;
+  #if defined(SOL_F16C)
+        for (; i + 8 <= n; i += 8)
+          pack_merge4(&out[i],
+                      _mm256_cvtps_ph(pack_load8(in.x + i), _MM_FROUND_TO_NEAREST_INT),
+                      _mm256_cvtps_ph(pack_load8(in.y + i), _MM_FROUND_TO_NEAREST_INT),
+                      _mm256_cvtps_ph(pack_load8(in.z + i), _MM_FROUND_TO_NEAREST_INT),
+                      _mm256_cvtps_ph(pack_load8(in.w + i), _MM_FROUND_TO_NEAREST_INT));
+  #endif
+  for (; i < n; i++) {
+    out[i].x = cv_flt_half(in.x[i]);
+    out[i].y = cv_flt_half(in.y[i]);
+    out[i].z = cv_flt_half(in.z[i]);
+    out[i].w = cv_flt_half(in.w[i]);
+  }
+}
+
+/// vec4h_encode_array ///
+// Description
+//   Encodes SoA quaternions as an array of half-precision quaternions.
+// Arguments
+//   out: packed quaternions (Vec4h*)
+//   in: quaternions (Soa4)
+//   n: count (size_t)
+// Returns
+//   void
+
+sol_inline
+void vec4h_encode_array(Vec4h *out, Soa4 in, size_t n) {
+  PackJob j = {out, NULL, {in.x, in.y, in.z, in.w}};
+  sol_parallel_for(n, sizeof(Vec4h) + 4 * sizeof(Float), vec4h_encode_task, &j);
+}
+
+static
+void vec4h_decode_task(void *job, size_t lo, size_t hi) {
+  const PackJob *j = job;
+  const Soa4 out = pack_soa4_at(j, lo);
+  const Vec4h *in = ((const Vec4h *) j->in) + lo;
+  const size_t n = hi - lo;
+  size_t i = 0;
+  #if defined(SOL_F16C)
+        for (; i + 8 <= n; i += 8) {
+          __m128i x, y, z, w;
+          pack_split4(&in[i], &x, &y, &z, &w);
+          pack_store8(out.x + i, _mm256_cvtph_ps(x));
+          pack_store8(out.y + i, _mm256_cvtph_ps(y));
+          pack_store8(out.z + i, _mm256_cvtph_ps(z));
+          pack_store8(out.w + i, _mm256_cvtph_ps(w));
+        }
+  #endif
+  for (; i < n; i++) {
+    out.x[i] = cv_half_flt(in[i].x);
+    out.y[i] = cv_half_flt(in[i].y);
+    out.z[i] = cv_half_flt(in[i].z);
+    out.w[i] = cv_half_flt(in[i].w);
+  }
+}
+
+/// vec4h_decode_array ///
+// Description
+//   Decodes an array of half-precision quaternions into SoA quaternions.
+// Arguments
+//   out: quaternions (Soa4)
+//   in: packed quaternions (Vec4h*)
+//   n: count (size_t)
+// Returns
+//   void
+
+sol_inline
+void vec4h_decode_array(Soa4 out, const Vec4h *in, size_t n) {
+  PackJob j = {NULL, in, {out.x, out.y, out.z, out.w}};
+  sol_parallel_for(n, sizeof(Vec4h) + 4 * sizeof(Float), vec4h_decode_task, &j);
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Signed Normalized Storage /////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+/// vec3s_encode ///
+// Description
+//   Encodes a vector as signed normalized 16-bit integers, clamping each
+//   element to [-1, 1].
+// Arguments
+//   v: vector (Vec3)
+// Returns
+//   packed vector (Vec3s)
+
+sol_inline
+Vec3s vec3s_encode(Vec3 v) {
+  Vec3s out;
+  out.x = pack_snorm(v.x);
+  out.y = pack_snorm(v.y);
+  out.z = pack_snorm(v.z);
+  return out;
+}
+
+/// vec3s_decode ///
+// Description
+//   Decodes a signed normalized vector.
+// Arguments
+//   s: packed vector (Vec3s)
+// Returns
+//   vector (Vec3)
+
+sol_inline
+Vec3 vec3s_decode(Vec3s s) {
+  return vec3_init(pack_snorm_flt(s.x), pack_snorm_flt(s.y), pack_snorm_flt(s.z));
+}
+
+/// vec4s_encode ///
+// Description
+//   Encodes a quaternion as signed normalized 16-bit integers, clamping each
+//   element to [-1, 1].
+// Arguments
+//   v: quaternion (Vec4)
+// Returns
+//   packed quaternion (Vec4s)
+
+sol_inline
+Vec4s vec4s_encode(Vec4 v) {
+  Vec4s out;
+  out.x = pack_snorm(v.x);
+  out.y = pack_snorm(v.y);
+  out.z = pack_snorm(v.z);
+  out.w = pack_snorm(v.w);
+  return out;
+}
+
+/// vec4s_decode ///
+// Description
+//   Decodes a signed normalized quaternion.
+// Arguments
+//   s: packed quaternion (Vec4s)
+// Returns
+//   quaternion (Vec4)
+
+sol_inline
+Vec4 vec4s_decode(Vec4s s) {
+  return vec4_init(pack_snorm_flt(s.x), pack_snorm_flt(s.y),
+                   pack_snorm_flt(s.z), pack_snorm_flt(s.w));
+}
+
+static
+void vec3s_encode_task(void *job, size_t lo, size_t hi) {
+  const PackJob *j = job;
+  Vec3s *out = ((Vec3s *) j->out) + lo;
+  const Soa3 in = pack_soa3_at(j, lo);
+  const size_t n = hi - lo;
+  size_t i = 0;
+  #if defined(SOL_AVX)
+        for (; i + 8 <= n; i += 8)
+          pack_merge3(&out[i], pack_snorm8(in.x + i),
+                               pack_snorm8(in.y + i),
+                               pack_snorm8(in.z + i));
+  #endif
+  for (; i < n; i++) {
+    out[i].x = pack_snorm(in.x[i]);
+    out[i].y = pack_snorm(in.y[i]);
+    out[i].z = pack_snorm(in.z[i]);
+  }
+}
+
+/// vec3s_encode_array ///
+// Description
+//   Encodes SoA vectors as an array of signed normalized vectors.
+// Arguments
+//   out: packed vectors (Vec3s*)
+//   in: vectors (Soa3)
+//   n: count (size_t)
+// Returns
+//   void
+
+sol_inline
+void vec3s_encode_array(Vec3s *out, Soa3 in, size_t n) {
+  PackJob j = {out, NULL, {in.x, in.y, in.z, NULL}};
+  sol_parallel_for(n, sizeof(Vec3s) + 3 * sizeof(Float), vec3s_encode_task, &j);
+}
+
+static
+void vec3s_decode_task(void *job, size_t lo, size_t hi) {
+  const PackJob *j = job;
+  const Soa3 out = pack_soa3_at(j, lo);
+  const Vec3s *in = ((const Vec3s *) j->in) + lo;
+  const size_t n = hi - lo;
+  size_t i = 0;
+  #if defined(SOL_AVX)
+        for (; i + 8 <= n; i += 8) {
+          __m128i x, y, z;
+          pack_split3(&in[i], &x, &y, &z);
+          pack_store8(out.x + i, pack_snorm_f(x));
+          pack_store8(out.y + i, pack_snorm_f(y));
+          pack_store8(out.z + i, pack_snorm_f(z));
+        }
+  #endif
+  for (; i < n; i++) {
+    out.x[i] = pack_snorm_flt(in[i].x);
+    out.y[i] = pack_snorm_flt(in[i].y);
+    out.z[i] = pack_snorm_flt(in[i].z);
+  }
+}
+
+/// vec3s_decode_array ///
+// Description
+//   Decodes an array of signed normalized vectors into SoA vectors.
+// Arguments
+//   out: vectors (Soa3)
+//   in: packed vectors (Vec3s*)
+//   n: count (size_t)
+// Returns
+//   void
+
+sol_inline
+void vec3s_decode_array(Soa3 out, const Vec3s *in, size_t n) {
+  PackJob j = {NULL, in, {out.x, out.y, out.z, NULL}};
+  sol_parallel_for(n, sizeof(Vec3s) + 3 * sizeof(Float), vec3s_decode_task, &j);
+}
+
+static
+void vec4s_encode_task(void *job, size_t lo, size_t hi) {
+  const PackJob *j = job;
+  Vec4s *out = ((Vec4s *) j->out) + lo;
+  const Soa4 in = pack_soa4_at(j, lo);
+  const size_t n = hi - lo;
+  size_t i = 0;
+  #if defined(SOL_AVX)
+        for (; i + 8 <= n; i += 8)
+          pack_merge4(&out[i], pack_snorm8(in.x + i),
+                               pack_snorm8(in.y + i),
+                               pack_snorm8(in.z + i),
+                               pack_snorm8(in.w + i));
+  #endif
+  for (; i < n; i++) {
+    out[i].x = pack_snorm(in.x[i]);
+    out[i].y = pack_snorm(in.y[i]);
+    out[i].z = pack_snorm(in.z[i]);
+    out[i].w = pack_snorm(in.w[i]);
+  }
+}
+
+/// vec4s_encode_array ///
+// Description
+//   Encodes SoA quaternions as an array of signed normalized quaternions.
+// Arguments
+//   out: packed quaternions (Vec4s*)
+//   in: quaternions (Soa4)
+//   n: count (size_t)
+// Returns
+//   void
+
+sol_inline
+void vec4s_encode_array(Vec4s *out, Soa4 in, size_t n) {
+  PackJob j = {out, NULL, {in.x, in.y, in.z, in.w}};
+  sol_parallel_for(n, sizeof(Vec4s) + 4 * sizeof(Float), vec4s_encode_task, &j);
+}
+
+static
+void vec4s_decode_task(void *job, size_t lo, size_t hi) {
+  const PackJob *j = job;
+  const Soa4 out = pack_soa4_at(j, lo);
+  const Vec4s *in = ((const Vec4s *) j->in) + lo;
+  const size_t n = hi - lo;
+  size_t i = 0;
+  #if defined(SOL_AVX)
+        for (; i + 8 <= n; i += 8) {
+          __m128i x, y, z, w;
+          pack_split4(&in[i], &x, &y, &z, &w);
+          pack_store8(out.x + i, pack_snorm_f(x));
+          pack_store8(out.y + i, pack_snorm_f(y));
+          pack_store8(out.z + i, pack_snorm_f(z));
+          pack_store8(out.w + i, pack_snorm_f(w));
+        }
+  #endif
+  for (; i < n; i++) {
+    out.x[i] = pack_snorm_flt(in[i].x);
+    out.y[i] = pack_snorm_flt(in[i].y);
+    out.z[i] = pack_snorm_flt(in[i].z);
+    out.w[i] = pack_snorm_flt(in[i].w);
+  }
+}
+
+/// vec4s_decode_array ///
+// Description
+//   Decodes an array of signed normalized quaternions into SoA quaternions.
+// Arguments
+//   out: quaternions (Soa4)
+//   in: packed quaternions (Vec4s*)
+//   n: count (size_t)
+// Returns
+//   void
+
+sol_inline
+void vec4s_decode_array(Soa4 out, const Vec4s *in, size_t n) {
+  PackJob j = {NULL, in, {out.x, out.y, out.z, out.w}};
+  sol_parallel_for(n, sizeof(Vec4s) + 4 * sizeof(Float), vec4s_decode_task, &j);
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Unsigned Normalized Storage ///////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+/// vec3u_encode ///
+// Description
+//   Encodes a vector as unsigned normalized 16-bit integers, clamping each
+//   element to [0, 1].
+// Arguments
+//   v: vector (Vec3)
+// Returns
+//   packed vector (Vec3u)
+
+sol_inline
+Vec3u vec3u_encode(Vec3 v) {
+  Vec3u out;
+  out.x = pack_unorm(v.x);
+  out.y = pack_unorm(v.y);
+  out.z = pack_unorm(v.z);
+  return out;
+}
+
+/// vec3u_decode ///
+// Description
+//   Decodes an unsigned normalized vector.
+// Arguments
+//   u: packed vector (Vec3u)
+// Returns
+//   vector (Vec3)
+
+sol_inline
+Vec3 vec3u_decode(Vec3u u) {
+  return vec3_init(pack_unorm_flt(u.x), pack_unorm_flt(u.y), pack_unorm_flt(u.z));
+}
+
+/// vec4u_encode ///
+// Description
+//   Encodes a quaternion as unsigned normalized 16-bit integers, clamping
+//   each element to [0, 1].
+// Arguments
+//   v: quaternion (Vec4)
+// Returns
+//   packed quaternion (Vec4u)
+
+sol_inline
+Vec4u vec4u_encode(Vec4 v) {
+  Vec4u out;
+  out.x = pack_unorm(v.x);
+  out.y = pack_unorm(v.y);
+  out.z = pack_unorm(v.z);
+  out.w = pack_unorm(v.w);
+  return out;
+}
+
+/// vec4u_decode ///
+// Description
+//   Decodes an unsigned normalized quaternion.
+// Arguments
+//   u: packed quaternion (Vec4u)
+// Returns
+//   quaternion (Vec4)
+
+sol_inline
+Vec4 vec4u_decode(Vec4u u) {
+  return vec4_init(pack_unorm_flt(u.x), pack_unorm_flt(u.y),
+                   pack_unorm_flt(u.z), pack_unorm_flt(u.w));
+}
+
+static
+void vec3u_encode_task(void *job, size_t lo, size_t hi) {
+  const PackJob *j = job;
+  Vec3u *out = ((Vec3u *) j->out) + lo;
+  const Soa3 in = pack_soa3_at(j, lo);
+  const size_t n = hi - lo;
+  size_t i = 0;
+  #if defined(SOL_AVX)
+        for (; i + 8 <= n; i += 8)
+          pack_merge3(&out[i], pack_unorm8(in.x + i),
+                               pack_unorm8(in.y + i),
+                               pack_unorm8(in.z + i));
+  #endif
+  for (; i < n; i++) {
+    out[i].x = pack_unorm(in.x[i]);
+    out[i].y = pack_unorm(in.y[i]);
+    out[i].z = pack_unorm(in.z[i]);
+  }
+}
+
+/// vec3u_encode_array ///
+// Description
+//   Encodes SoA vectors as an array of unsigned normalized vectors.
+// Arguments
+//   out: packed vectors (Vec3u*)
+//   in: vectors (Soa3)
+//   n: count (size_t)
+// Returns
+//   void
+
+sol_inline
+void vec3u_encode_array(Vec3u *out, Soa3 in, size_t n) {
+  PackJob j = {out, NULL, {in.x, in.y, in.z, NULL}};
+  sol_parallel_for(n, sizeof(Vec3u) + 3 * sizeof(Float), vec3u_encode_task, &j);
+}
+
+static
+void vec3u_decode_task(void *job, size_t lo, size_t hi) {
+  const PackJob *j = job;
+  const Soa3 out = pack_soa3_at(j, lo);
+  const Vec3u *in = ((const Vec3u *) j->in) + lo;
+  const size_t n = hi - lo;
+  size_t i = 0;
+  #if defined(SOL_AVX)
+        for (; i + 8 <= n; i += 8) {
+          __m128i x, y, z;
+          pack_split3(&in[i], &x, &y, &z);
+          pack_store8(out.x + i, pack_unorm_f(x));
+          pack_store8(out.y + i, pack_unorm_f(y));
+          pack_store8(out.z + i, pack_unorm_f(z));
+        }
+  #endif
+  for (; i < n; i++) {
+    out.x[i] = pack_unorm_flt(in[i].x);
+    out.y[i] = pack_unorm_flt(in[i].y);
+    out.z[i] = pack_unorm_flt(in[i].z);
+  }
+}
+
+/// vec3u_decode_array ///
+// Description
+//   Decodes an array of unsigned normalized vectors into SoA vectors.
+// Arguments
+//   out: vectors (Soa3)
+//   in: packed vectors (Vec3u*)
+//   n: count (size_t)
+// Returns
+//   void
+
+sol_inline
+void vec3u_decode_array(Soa3 out, const Vec3u *in, size_t n) {
+  PackJob j = {NULL, in, {out.x, out.y, out.z, NULL}};
+  sol_parallel_for(n, sizeof(Vec3u) + 3 * sizeof(Float), vec3u_decode_task, &j);
+}
+
+static
+void vec4u_encode_task(void *job, size_t lo, size_t hi) {
+  const PackJob *j = job;
+  Vec4u *out = ((Vec4u *) j->out) + lo;
+  const Soa4 in = pack_soa4_at(j, lo);
+  const size_t n = hi - lo;
+  size_t i = 0;
+  #if defined(SOL_AVX)
+        for (; i + 8 <= n; i += 8)
+          pack_merge4(&out[i], pack_unorm8(in.x + i),
+                               pack_unorm8(in.y + i),
+                               pack_unorm8(in.z + i),
+                               pack_unorm8(in.w + i));
+  #endif
+  for (; i < n; i++) {
+    out[i].x = pack_unorm(in.x[i]);
+    out[i].y = pack_unorm(in.y[i]);
+    out[i].z = pack_unorm(in.z[i]);
+    out[i].w = pack_unorm(in.w[i]);
+  }
+}
+
+/// vec4u_encode_array ///
+// Description
+//   Encodes SoA quaternions as an array of unsigned normalized quaternions.
+// Arguments
+//   out: packed quaternions (Vec4u*)
+//   in: quaternions (Soa4)
+//   n: count (size_t)
+// Returns
+//   void
+
+sol_inline
+void vec4u_encode_array(Vec4u *out, Soa4 in, size_t n) {
+  PackJob j = {out, NULL, {in.x, in.y, in.z, in.w}};
+  sol_parallel_for(n, sizeof(Vec4u) + 4 * sizeof(Float), vec4u_encode_task, &j);
+}
+
+static
+void vec4u_decode_task(void *job, size_t lo, size_t hi) {
+  const PackJob *j = job;
+  const Soa4 out = pack_soa4_at(j, lo);
+  const Vec4u *in = ((const Vec4u *) j->in) + lo;
+  const size_t n = hi - lo;
+  size_t i = 0;
+  #if defined(SOL_AVX)
+        for (; i + 8 <= n; i += 8) {
+          __m128i x, y, z, w;
+          pack_split4(&in[i], &x, &y, &z, &w);
+          pack_store8(out.x + i, pack_unorm_f(x));
+          pack_store8(out.y + i, pack_unorm_f(y));
+          pack_store8(out.z + i, pack_unorm_f(z));
+          pack_store8(out.w + i, pack_unorm_f(w));
+        }
+  #endif
+  for (; i < n; i++) {
+    out.x[i] = pack_unorm_flt(in[i].x);
+    out.y[i] = pack_unorm_flt(in[i].y);
+    out.z[i] = pack_unorm_flt(in[i].z);
+    out.w[i] = pack_unorm_flt(in[i].w);
+  }
+}
+
+/// vec4u_decode_array ///
+// Description
+//   Decodes an array of unsigned normalized quaternions into SoA quaternions.
+// Arguments
+//   out: quaternions (Soa4)
+//   in: packed quaternions (Vec4u*)
+//   n: count (size_t)
+// Returns
+//   void
+
+sol_inline
+void vec4u_decode_array(Soa4 out, const Vec4u *in, size_t n) {
+  PackJob j = {NULL, in, {out.x, out.y, out.z, out.w}};
+  sol_parallel_for(n, sizeof(Vec4u) + 4 * sizeof(Float), vec4u_decode_task, &j);
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Octahedral Unit Vector Storage ////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+/// oct3_encode ///
+// Description
+//   Encodes a unit vector in octahedral form. The vector is projected onto
+//   the octahedron |x| + |y| + |z| = 1 and the lower hemisphere is folded
+//   over the diagonals so that both halves share the [-1, 1] square. A zero
+//   vector encodes as the +Z axis.
+// Arguments
+//   n: unit vector (Vec3)
+// Returns
+//   packed unit vector (Oct3)
+
+sol_inline
+Oct3 oct3_encode(Vec3 n) {
+  Oct3 out;
+  const Float s = flt_abs(n.x) + flt_abs(n.y) + flt_abs(n.z);
+  if (s == 0) {
+    out.x = 0;
+    out.y = 0;
+    return out;
+  }
+  Float px = n.x / s;
+  Float py = n.y / s;
+  if (n.z < 0) {
+    const Float fx = (1 - flt_abs(py)) * (px >= 0 ? 1 : -1);
+    const Float fy = (1 - flt_abs(px)) * (py >= 0 ? 1 : -1);
+    px = fx;
+    py = fy;
+  }
+  out.x = pack_snorm(px);
+  out.y = pack_snorm(py);
+  return out;
+}
+
+/// oct3_decode ///
+// Description
+//   Decodes an octahedral unit vector.
+// Arguments
+//   o: packed unit vector (Oct3)
+// Returns
+//   unit vector (Vec3)
+
+sol_inline
+Vec3 oct3_decode(Oct3 o) {
+  Float x = pack_snorm_flt(o.x);
+  Float y = pack_snorm_flt(o.y);
+  const Float z = 1 - flt_abs(x) - flt_abs(y);
+  const Float t = z < 0 ? -z : 0;
+  x += x >= 0 ? -t : t;
+  y += y >= 0 ? -t : t;
+  return vec3_norm(vec3_init(x, y, z));
+}
+
+static
+void oct3_encode_task(void *job, size_t lo, size_t hi) {
+  const PackJob *j = job;
+  Oct3 *out = ((Oct3 *) j->out) + lo;
+  const Soa3 in = pack_soa3_at(j, lo);
+  const size_t n = hi - lo;
+  size_t i = 0;
+  #if defined(SOL_AVX)
+        for (; i + 8 <= n; i += 8) {
+          Float px[8], py[8];
+          pack_oct8(px, py, in.x + i, in.y + i, in.z + i);
+          const __m128i qx = pack_snorm8(px);
+          const __m128i qy = pack_snorm8(py);
+          _mm_storeu_si128((__m128i *) &out[i], _mm_unpacklo_epi16(qx, qy));
+          _mm_storeu_si128((__m128i *) &out[i + 4], _mm_unpackhi_epi16(qx, qy));
+        }
+  #endif
+  for (; i < n; i++)
+    out[i] = oct3_encode(vec3_init(in.x[i], in.y[i], in.z[i]));
+}
+
+/// oct3_encode_array ///
+// Description
+//   Encodes SoA unit vectors as an array of octahedral unit vectors.
+// Arguments
+//   out: packed unit vectors (Oct3*)
+//   in: unit vectors (Soa3)
+//   n: count (size_t)
+// Returns
+//   void
+
+sol_inline
+void oct3_encode_array(Oct3 *out, Soa3 in, size_t n) {
+  PackJob j = {out, NULL, {in.x, in.y, in.z, NULL}};
+  sol_parallel_for(n, sizeof(Oct3) + 3 * sizeof(Float), oct3_encode_task, &j);
+}
+
+static
+void oct3_decode_task(void *job, size_t lo, size_t hi) {
+  const PackJob *j = job;
+  const Soa3 out = pack_soa3_at(j, lo);
+  const Oct3 *in = ((const Oct3 *) j->in) + lo;
+  const size_t n = hi - lo;
+  size_t i = 0;
+  #if defined(SOL_AVX)
+        const __m256 sign = _mm256_set1_ps(-0.0f);
+        for (; i + 8 <= n; i += 8) {
+          const __m128i r0 = _mm_loadu_si128((const __m128i *) &in[i]);
+          const __m128i r1 = _mm_loadu_si128((const __m128i *) &in[i + 4]);
+          const __m128i mx = _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1);
+          const __m128i my = _mm_setr_epi8(2, 3, 6, 7, 10, 11, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1);
+          __m256 x = pack_snorm_f(_mm_unpacklo_epi64(_mm_shuffle_epi8(r0, mx), _mm_shuffle_epi8(r1, mx)));
+          __m256 y = pack_snorm_f(_mm_unpacklo_epi64(_mm_shuffle_epi8(r0, my), _mm_shuffle_epi8(r1, my)));
+          const __m256 z = _mm256_sub_ps(_mm256_sub_ps(_mm256_set1_ps(1), _mm256_andnot_ps(sign, x)),
+                                         _mm256_andnot_ps(sign, y));
+          const __m256 t = _mm256_max_ps(_mm256_xor_ps(z, sign), _mm256_setzero_ps());
+          x = _mm256_sub_ps(x, _mm256_or_ps(t, _mm256_and_ps(x, sign)));
+          y = _mm256_sub_ps(y, _mm256_or_ps(t, _mm256_and_ps(y, sign)));
+          const __m256 inv = _mm256_div_ps(_mm256_set1_ps(1),
+                             _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x),
+                                                                        _mm256_mul_ps(y, y)),
+                                                          _mm256_mul_ps(z, z))));
+          pack_store8(out.x + i, _mm256_mul_ps(x, inv));
+          pack_store8(out.y + i, _mm256_mul_ps(y, inv));
+          pack_store8(out.z + i, _mm256_mul_ps(z, inv));
+        }
+  #endif
+  for (; i < n; i++) {
+    const Vec3 v = oct3_decode(in[i]);
+    out.x[i] = v.x;
+    out.y[i] = v.y;
+    out.z[i] = v.z;
+  }
+}
+
+/// oct3_decode_array ///
+// Description
+//   Decodes an array of octahedral unit vectors into SoA unit vectors.
+// Arguments
+//   out: unit vectors (Soa3)
+//   in: packed unit vectors (Oct3*)
+//   n: count (size_t)
+// Returns
+//   void
+
+sol_inline
+void oct3_decode_array(Soa3 out, const Oct3 *in, size_t n) {
+  PackJob j = {NULL, in, {out.x, out.y, out.z, NULL}};
+  sol_parallel_for(n, sizeof(Oct3) + 3 * sizeof(Float), oct3_decode_task, &j);
+}
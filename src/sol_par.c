@@ -0,0 +1,700 @@
+    ///////////////////////////////////////////////////////////////////
+   // sol_par.c //////////////////////////////////////////////////////
+  // Description: Adds multithreaded loops and task graphs to Sol. //
+ // Author: David Garland (https://github.com/davidgarland/sol) ////
+///////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Local Headers /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include "../sol.h"
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Standard Headers //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#if defined(SOL_OMP)
+      #include <omp.h>
+#elif defined(SOL_PTHREAD)
+      #include <pthread.h>
+      #include <unistd.h>
+#endif
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Parallel Settings /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Work is measured in bytes touched (n * size) rather than in elements, so
+// the same settings suit kernels that stream one array or five. Below the
+// threshold a loop runs inline on the calling thread; above it the range is
+// cut into chunks of about PAR_CHUNK bytes, small enough that each chunk's
+// inputs and outputs stay in a core's L2 while it works on them.
+
+#define PAR_THRESHOLD (1024 * 1024)
+#define PAR_CHUNK (64 * 1024)
+
+static size_t par_threads = 0; // 0 picks the number of online cores.
+static size_t par_threshold = PAR_THRESHOLD;
+static size_t par_chunk = PAR_CHUNK;
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Task Graph Types //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// A graph is a list of nodes, each a SolFor over [0, n) exactly like one
+// sol_parallel_for loop, plus "runs after" edges between them. Running it
+// starts every node without dependencies, and the chunk that finishes a node
+// releases its successors, so independent nodes share the threads and no
+// node waits on anything that isn't one of its own inputs.
+
+typedef struct {
+  SolFor fn;
+  void *ctx;
+  size_t n, size, chunk;
+  size_t deps; // Edges into this node.
+  size_t *next; // Nodes that run after this one.
+  size_t next_len, next_cap;
+  atomic_size_t wait; // Dependencies left in the current run.
+  atomic_size_t left; // Elements left in the current run.
+} TaskNode;
+
+struct type_graph {
+  TaskNode *node;
+  size_t len, cap;
+  atomic_size_t left; // Nodes left in the current run.
+};
+
+// Picks the chunk size for a node: small nodes run as one chunk, larger ones
+// as chunks of about par_chunk bytes, with at least one chunk per thread.
+
+static
+size_t task_chunk(size_t n, size_t size, size_t threads) {
+  if (n < par_threshold / size)
+    return n ? n : 1;
+  size_t chunk = par_chunk / size;
+  chunk = chunk < 8 ? 8 : chunk & ~(size_t) 7; // Whole 8-wide SIMD steps.
+  if (chunk * threads > n)
+    chunk = (n + threads - 1) / threads;
+  return chunk;
+}
+
+static
+void task_reset(SolGraph *g, size_t threads) {
+  for (size_t i = 0; i < g->len; i++) {
+    TaskNode *nd = &g->node[i];
+    nd->chunk = task_chunk(nd->n, nd->size, threads);
+    atomic_store(&nd->wait, nd->deps);
+    atomic_store(&nd->left, nd->n);
+  }
+  atomic_store(&g->left, g->len);
+}
+
+// Runs a graph on the calling thread in dependency order. Used when threads
+// are off or unavailable, and for graphs started from inside a task.
+
+static
+void task_run_inline(SolGraph *g) {
+  task_reset(g, 1);
+  size_t left = g->len;
+  bool progress = true;
+  while (left && progress) {
+    progress = false;
+    for (size_t i = 0; i < g->len; i++) {
+      TaskNode *nd = &g->node[i];
+      if (atomic_load(&nd->wait) != 0)
+        continue;
+      if (nd->n)
+        nd->fn(nd->ctx, 0, nd->n);
+      atomic_store(&nd->wait, SIZE_MAX); // Marks the node as run.
+      for (size_t j = 0; j < nd->next_len; j++)
+        atomic_fetch_sub(&g->node[nd->next[j]].wait, 1);
+      left--;
+      progress = true;
+    }
+  }
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Work-Stealing Scheduler ///////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#if defined(SOL_PTHREAD)
+
+// Each thread owns a deque of ranges; deque 0 belongs to whichever thread is
+// running a graph. A thread works from the bottom of its own deque and, when
+// that runs dry, steals from the top of the others'. Taking a range bigger
+// than one chunk splits it, pushing the upper half back, so the oldest (and
+// largest) ranges are the ones left for thieves. The pool is started on the
+// first parallel run and sleeps between runs; only one graph runs on it at a
+// time, and graphs or loops started from inside a task run inline.
+
+typedef struct {
+  SolGraph *graph;
+  TaskNode *node;
+  size_t lo, hi;
+} TaskItem;
+
+typedef struct {
+  pthread_mutex_t lock;
+  TaskItem *item;
+  size_t head, len, cap;
+} TaskDeque;
+
+static pthread_mutex_t par_call = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t par_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t par_wake = PTHREAD_COND_INITIALIZER;
+
+static pthread_t *par_pool = NULL;
+static size_t par_pool_size = 0;
+static size_t par_pool_want = 0;
+static bool par_quit = false;
+
+static TaskDeque *task_deque = NULL;
+static atomic_size_t task_queued;
+static atomic_size_t task_sleepers;
+
+static _Thread_local bool par_inside = false;
+static _Thread_local size_t task_self = 0;
+
+static void task_exec(TaskItem it);
+
+static
+void task_push(TaskItem it) {
+  TaskDeque *q = &task_deque[task_self];
+  pthread_mutex_lock(&q->lock);
+  if (q->len == q->cap) {
+    const size_t cap = q->cap ? q->cap * 2 : 64;
+    TaskItem *item = malloc(cap * sizeof(TaskItem));
+    if (!item) {
+      pthread_mutex_unlock(&q->lock);
+      task_exec(it);
+      return;
+    }
+    for (size_t i = 0; i < q->len; i++)
+      item[i] = q->item[(q->head + i) % q->cap];
+    free(q->item);
+    q->item = item;
+    q->head = 0;
+    q->cap = cap;
+  }
+  q->item[(q->head + q->len) % q->cap] = it;
+  q->len++;
+  pthread_mutex_unlock(&q->lock);
+  atomic_fetch_add(&task_queued, 1);
+  if (atomic_load(&task_sleepers)) {
+    pthread_mutex_lock(&par_lock);
+    pthread_cond_signal(&par_wake);
+    pthread_mutex_unlock(&par_lock);
+  }
+}
+
+static
+bool task_take(size_t d, bool bottom, TaskItem *it) {
+  TaskDeque *q = &task_deque[d];
+  bool found = false;
+  pthread_mutex_lock(&q->lock);
+  if (q->len) {
+    if (bottom) {
+      *it = q->item[(q->head + q->len - 1) % q->cap];
+    } else {
+      *it = q->item[q->head];
+      q->head = (q->head + 1) % q->cap;
+    }
+    q->len--;
+    found = true;
+  }
+  pthread_mutex_unlock(&q->lock);
+  if (found)
+    atomic_fetch_sub(&task_queued, 1);
+  return found;
+}
+
+static
+bool task_find(TaskItem *it) {
+  if (task_take(task_self, true, it))
+    return true;
+  const size_t count = par_pool_want + 1; // Fixed before any worker starts.
+  for (size_t k = 1; k < count; k++)
+    if (task_take((task_self + k) % count, false, it))
+      return true;
+  return false;
+}
+
+static
+void task_start(SolGraph *g, TaskNode *nd);
+
+static
+void task_finish(SolGraph *g, TaskNode *nd, size_t count) {
+  if (atomic_fetch_sub(&nd->left, count) != count)
+    return;
+  for (size_t i = 0; i < nd->next_len; i++) {
+    TaskNode *s = &g->node[nd->next[i]];
+    if (atomic_fetch_sub(&s->wait, 1) == 1)
+      task_start(g, s);
+  }
+  if (atomic_fetch_sub(&g->left, 1) == 1) {
+    pthread_mutex_lock(&par_lock);
+    pthread_cond_broadcast(&par_wake);
+    pthread_mutex_unlock(&par_lock);
+  }
+}
+
+static
+void task_start(SolGraph *g, TaskNode *nd) {
+  if (nd->n == 0) {
+    task_finish(g, nd, 0);
+    return;
+  }
+  const TaskItem it = {g, nd, 0, nd->n};
+  task_push(it);
+}
+
+static
+void task_exec(TaskItem it) {
+  const size_t chunk = it.node->chunk;
+  while (it.hi - it.lo > chunk) {
+    TaskItem rest = it;
+    rest.lo = it.lo + (it.hi - it.lo + chunk - 1) / chunk / 2 * chunk;
+    it.hi = rest.lo;
+    task_push(rest);
+  }
+  it.node->fn(it.node->ctx, it.lo, it.hi);
+  task_finish(it.graph, it.node, it.hi - it.lo);
+}
+
+// Sleeps until there is queued work, the pool is told to quit, or (for the
+// thread running the graph) g finishes.
+
+static
+void task_idle(SolGraph *g) {
+  pthread_mutex_lock(&par_lock);
+  atomic_fetch_add(&task_sleepers, 1);
+  while (!par_quit && !atomic_load(&task_queued) && (!g || atomic_load(&g->left)))
+    pthread_cond_wait(&par_wake, &par_lock);
+  atomic_fetch_sub(&task_sleepers, 1);
+  pthread_mutex_unlock(&par_lock);
+}
+
+static
+void *par_worker(void *arg) {
+  task_self = (size_t) (uintptr_t) arg;
+  par_inside = true;
+  for (;;) {
+    TaskItem it;
+    if (task_find(&it)) {
+      task_exec(it);
+      continue;
+    }
+    pthread_mutex_lock(&par_lock);
+    const bool quit = par_quit;
+    pthread_mutex_unlock(&par_lock);
+    if (quit)
+      break;
+    task_idle(NULL);
+  }
+  return NULL;
+}
+
+// Both expect par_call to be held.
+
+static
+void par_stop(void) {
+  pthread_mutex_lock(&par_lock);
+  par_quit = true;
+  pthread_cond_broadcast(&par_wake);
+  pthread_mutex_unlock(&par_lock);
+  for (size_t i = 0; i < par_pool_size; i++)
+    pthread_join(par_pool[i], NULL);
+  for (size_t i = 0; task_deque && i <= par_pool_want; i++) {
+    pthread_mutex_destroy(&task_deque[i].lock);
+    free(task_deque[i].item);
+  }
+  free(task_deque);
+  free(par_pool);
+  task_deque = NULL;
+  par_pool = NULL;
+  par_pool_size = 0;
+  par_pool_want = 0;
+  par_quit = false;
+}
+
+static
+void par_start(size_t workers) {
+  par_pool_want = workers;
+  task_deque = calloc(workers + 1, sizeof(TaskDeque));
+  par_pool = malloc(workers * sizeof(pthread_t));
+  if (!task_deque || !par_pool) {
+    free(task_deque);
+    free(par_pool);
+    task_deque = NULL;
+    par_pool = NULL;
+    par_pool_want = 0;
+    return;
+  }
+  for (size_t i = 0; i <= workers; i++)
+    pthread_mutex_init(&task_deque[i].lock, NULL);
+  while (par_pool_size < workers
+      && pthread_create(&par_pool[par_pool_size], NULL, par_worker,
+                        (void *) (uintptr_t) (par_pool_size + 1)) == 0)
+    par_pool_size++;
+}
+
+static
+void task_run_pool(SolGraph *g, size_t threads) {
+  pthread_mutex_lock(&par_call);
+  if (par_pool_want + 1 != threads) {
+    par_stop();
+    par_start(threads - 1);
+  }
+  if (!task_deque) {
+    pthread_mutex_unlock(&par_call);
+    task_run_inline(g);
+    return;
+  }
+  task_reset(g, par_pool_size + 1);
+  task_self = 0;
+  par_inside = true;
+  for (size_t i = 0; i < g->len; i++)
+    if (g->node[i].deps == 0)
+      task_start(g, &g->node[i]);
+  while (atomic_load(&g->left)) {
+    TaskItem it;
+    if (task_find(&it))
+      task_exec(it);
+    else
+      task_idle(g);
+  }
+  par_inside = false;
+  pthread_mutex_unlock(&par_call);
+}
+
+#elif defined(SOL_OMP)
+
+// Under OpenMP every chunk is an OpenMP task, and the chunk that finishes a
+// node spawns the tasks for whichever successors it released. The implicit
+// barrier at the end of the parallel region waits for all of them.
+
+static
+void task_start(SolGraph *g, TaskNode *nd);
+
+static
+void task_finish(SolGraph *g, TaskNode *nd, size_t count) {
+  if (atomic_fetch_sub(&nd->left, count) != count)
+    return;
+  for (size_t i = 0; i < nd->next_len; i++) {
+    TaskNode *s = &g->node[nd->next[i]];
+    if (atomic_fetch_sub(&s->wait, 1) == 1)
+      task_start(g, s);
+  }
+}
+
+static
+void task_start(SolGraph *g, TaskNode *nd) {
+  if (nd->n == 0) {
+    task_finish(g, nd, 0);
+    return;
+  }
+  for (size_t lo = 0; lo < nd->n; lo += nd->chunk) {
+    const size_t hi = nd->n - lo < nd->chunk ? nd->n : lo + nd->chunk;
+    #pragma omp task firstprivate(g, nd, lo, hi)
+    {
+      nd->fn(nd->ctx, lo, hi);
+      task_finish(g, nd, hi - lo);
+    }
+  }
+}
+
+static
+void task_run_pool(SolGraph *g, size_t threads) {
+  task_reset(g, threads);
+  #pragma omp parallel num_threads((int) threads)
+  #pragma omp single
+  for (size_t i = 0; i < g->len; i++)
+    if (g->node[i].deps == 0)
+      task_start(g, &g->node[i]);
+}
+
+#endif
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Parallel Loops ////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+/// sol_parallel_for ///
+// Description
+//   Runs fn over [0, n) split into chunks across the thread pool, or inline
+//   on the calling thread when the loop is small, threading is disabled, or
+//   it was called from inside another parallel loop or task. fn may run on
+//   several threads at once and must only touch the elements in its range.
+// Arguments
+//   n: element count (size_t)
+//   size: bytes read and written per element (size_t)
+//   fn: task (SolFor)
+//   ctx: task context (void*)
+// Returns
+//   void
+
+sol_inline
+void sol_parallel_for(size_t n, size_t size, SolFor fn, void *ctx) {
+  if (n == 0)
+    return;
+  size = size ? size : 1;
+  const size_t threads = sol_get_threads();
+  bool inline_only = threads < 2 || n < par_threshold / size;
+  #if defined(SOL_PTHREAD)
+        inline_only = inline_only || par_inside;
+  #elif defined(SOL_OMP)
+        inline_only = inline_only || omp_in_parallel();
+  #endif
+  if (inline_only) {
+    fn(ctx, 0, n);
+    return;
+  }
+  #if defined(SOL_OMP)
+        const size_t chunk = task_chunk(n, size, threads);
+        const size_t count = (n + chunk - 1) / chunk;
+        #pragma omp parallel for schedule(dynamic, 1) num_threads((int) threads)
+        for (size_t c = 0; c < count; c++) {
+          const size_t lo = c * chunk;
+          fn(ctx, lo, n - lo < chunk ? n : lo + chunk);
+        }
+  #elif defined(SOL_PTHREAD)
+        TaskNode node = {fn, ctx, n, size, 0, 0, NULL, 0, 0, 0, 0};
+        SolGraph g = {&node, 1, 1, 0};
+        task_run_pool(&g, threads);
+  #else
+        fn(ctx, 0, n);
+  #endif
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Task Graphs ///////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+/// sol_graph_init ///
+// Description
+//   Creates an empty task graph. Graphs can be run any number of times, so
+//   a per-frame pipeline only needs to be built once.
+// Arguments
+//   void
+// Returns
+//   graph (SolGraph*), or NULL if allocation fails
+
+sol_inline
+SolGraph *sol_graph_init(void) {
+  return calloc(1, sizeof(SolGraph));
+}
+
+/// sol_graph_free ///
+// Description
+//   Frees a task graph. Contexts passed to sol_graph_add are left alone.
+// Arguments
+//   g: graph (SolGraph*)
+// Returns
+//   void
+
+sol_inline
+void sol_graph_free(SolGraph *g) {
+  if (!g)
+    return;
+  for (size_t i = 0; i < g->len; i++)
+    free(g->node[i].next);
+  free(g->node);
+  free(g);
+}
+
+/// sol_graph_add ///
+// Description
+//   Adds a node that runs fn over [0, n), split into chunks the same way as
+//   sol_parallel_for. Use n = 1 for a single serial task.
+// Arguments
+//   g: graph (SolGraph*)
+//   n: element count (size_t)
+//   size: bytes read and written per element (size_t)
+//   fn: task (SolFor)
+//   ctx: task context (void*)
+// Returns
+//   node index (size_t), or SIZE_MAX if allocation fails
+
+sol_inline
+size_t sol_graph_add(SolGraph *g, size_t n, size_t size, SolFor fn, void *ctx) {
+  if (g->len == g->cap) {
+    const size_t cap = g->cap ? g->cap * 2 : 16;
+    TaskNode *node = realloc(g->node, cap * sizeof(TaskNode));
+    if (!node)
+      return SIZE_MAX;
+    g->node = node;
+    g->cap = cap;
+  }
+  TaskNode *nd = &g->node[g->len];
+  nd->fn = fn;
+  nd->ctx = ctx;
+  nd->n = n;
+  nd->size = size ? size : 1;
+  nd->chunk = 1;
+  nd->deps = 0;
+  nd->next = NULL;
+  nd->next_len = 0;
+  nd->next_cap = 0;
+  return g->len++;
+}
+
+/// sol_graph_after ///
+// Description
+//   Makes a node wait for another to finish. Edges must not form a cycle.
+// Arguments
+//   g: graph (SolGraph*)
+//   node: node that waits (size_t)
+//   dep: node it waits for (size_t)
+// Returns
+//   success (bool), false if an index is out of range or allocation fails
+
+sol_inline
+bool sol_graph_after(SolGraph *g, size_t node, size_t dep) {
+  if (node >= g->len || dep >= g->len || node == dep)
+    return false;
+  TaskNode *d = &g->node[dep];
+  if (d->next_len == d->next_cap) {
+    const size_t cap = d->next_cap ? d->next_cap * 2 : 4;
+    size_t *next = realloc(d->next, cap * sizeof(size_t));
+    if (!next)
+      return false;
+    d->next = next;
+    d->next_cap = cap;
+  }
+  d->next[d->next_len++] = node;
+  g->node[node].deps++;
+  return true;
+}
+
+/// sol_graph_run ///
+// Description
+//   Runs every node of a graph, each one only after all the nodes it waits
+//   for, and returns once all of them have finished. Independent nodes and
+//   the chunks within a node run concurrently across the thread pool.
+// Arguments
+//   g: graph (SolGraph*)
+// Returns
+//   void
+
+sol_inline
+void sol_graph_run(SolGraph *g) {
+  if (!g || g->len == 0)
+    return;
+  const size_t threads = sol_get_threads();
+  #if defined(SOL_PTHREAD)
+        if (threads > 1 && !par_inside) {
+          task_run_pool(g, threads);
+          return;
+        }
+  #elif defined(SOL_OMP)
+        if (threads > 1 && !omp_in_parallel()) {
+          task_run_pool(g, threads);
+          return;
+        }
+  #endif
+  (void) threads;
+  task_run_inline(g);
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Parallel Settings Access //////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// None of these may be called while a parallel loop or graph is running.
+
+/// sol_set_threads ///
+// Description
+//   Sets how many threads parallel loops use, counting the caller. 0 picks
+//   the number of online cores, and 1 keeps every loop on the caller.
+// Arguments
+//   n: thread count (size_t)
+// Returns
+//   void
+
+sol_inline
+void sol_set_threads(size_t n) {
+  par_threads = n;
+}
+
+/// sol_get_threads ///
+// Description
+//   Gets how many threads parallel loops use, counting the caller.
+// Arguments
+//   void
+// Returns
+//   thread count (size_t), always 1 without SOL_THREADS
+
+sol_inline
+size_t sol_get_threads(void) {
+  #if defined(SOL_OMP)
+        return par_threads ? par_threads : (size_t) omp_get_max_threads();
+  #elif defined(SOL_PTHREAD)
+        if (par_threads)
+          return par_threads;
+        const long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        return cores > 0 ? (size_t) cores : 1;
+  #else
+        return 1;
+  #endif
+}
+
+/// sol_set_threshold ///
+// Description
+//   Sets how much work (n * size bytes) a loop needs before it is split
+//   across threads.
+// Arguments
+//   bytes: threshold (size_t)
+// Returns
+//   void
+
+sol_inline
+void sol_set_threshold(size_t bytes) {
+  par_threshold = bytes;
+}
+
+/// sol_get_threshold ///
+// Description
+//   Gets how much work (n * size bytes) a loop needs before it is split
+//   across threads.
+// Arguments
+//   void
+// Returns
+//   threshold (size_t)
+
+sol_inline
+size_t sol_get_threshold(void) {
+  return par_threshold;
+}
+
+/// sol_set_chunk ///
+// Description
+//   Sets the target number of bytes each chunk of a parallel loop touches.
+// Arguments
+//   bytes: chunk size (size_t)
+// Returns
+//   void
+
+sol_inline
+void sol_set_chunk(size_t bytes) {
+  par_chunk = bytes ? bytes : PAR_CHUNK;
+}
+
+/// sol_get_chunk ///
+// Description
+//   Gets the target number of bytes each chunk of a parallel loop touches.
+// Arguments
+//   void
+// Returns
+//   chunk size (size_t)
+
+sol_inline
+size_t sol_get_chunk(void) {
+  return par_chunk;
+}
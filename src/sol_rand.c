@@ -0,0 +1,368 @@
+    /////////////////////////////////////////////////////////////////
+   // sol_rand.c ///////////////////////////////////////////////////
+  // Description: Adds SIMD random sampling to Sol. ///////////////
+ // Author: David Garland (https://github.com/davidgarland/sol) //
+/////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Local Headers /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include "../sol.h"
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Standard Headers //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Generator Lanes ///////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// SolRand runs SOL_RAND_LANES copies of xoshiro256+ in lockstep. The step is
+// adds, xors and shifts on 64-bit words, so the lanes map straight onto SIMD
+// registers: two AVX2 registers, four SSE2/NEON registers, or eight scalars.
+// RandReg is one register of RAND_WORDS lanes in the widest tier available.
+
+#if defined(SOL_AVX2)
+      #define RAND_WORDS 4
+      typedef __m256i RandReg;
+      #define rand_reg_load(p) _mm256_loadu_si256((const __m256i *) (p))
+      #define rand_reg_store(p, a) _mm256_storeu_si256((__m256i *) (p), a)
+      #define rand_reg_add _mm256_add_epi64
+      #define rand_reg_xor _mm256_xor_si256
+      #define rand_reg_or _mm256_or_si256
+      #define rand_reg_shl _mm256_slli_epi64
+      #define rand_reg_shr _mm256_srli_epi64
+#elif defined(SOL_SSE)
+      #define RAND_WORDS 2
+      typedef __m128i RandReg;
+      #define rand_reg_load(p) _mm_loadu_si128((const __m128i *) (p))
+      #define rand_reg_store(p, a) _mm_storeu_si128((__m128i *) (p), a)
+      #define rand_reg_add _mm_add_epi64
+      #define rand_reg_xor _mm_xor_si128
+      #define rand_reg_or _mm_or_si128
+      #define rand_reg_shl _mm_slli_epi64
+      #define rand_reg_shr _mm_srli_epi64
+#elif defined(SOL_NEON)
+      #define RAND_WORDS 2
+      typedef uint64x2_t RandReg;
+      #define rand_reg_load vld1q_u64
+      #define rand_reg_store vst1q_u64
+      #define rand_reg_add vaddq_u64
+      #define rand_reg_xor veorq_u64
+      #define rand_reg_or vorrq_u64
+      #define rand_reg_shl vshlq_n_u64
+      #define rand_reg_shr vshrq_n_u64
+#else
+      #define RAND_WORDS 1
+      typedef uint64_t RandReg;
+      #define rand_reg_load(p) (*(p))
+      #define rand_reg_store(p, a) (*(p) = (a))
+      #define rand_reg_add(a, b) ((a) + (b))
+      #define rand_reg_xor(a, b) ((a) ^ (b))
+      #define rand_reg_or(a, b) ((a) | (b))
+      #define rand_reg_shl(a, k) ((a) << (k))
+      #define rand_reg_shr(a, k) ((a) >> (k))
+#endif
+
+#define RAND_REGS (SOL_RAND_LANES / RAND_WORDS)
+
+#define rand_reg_rotl(a, k) rand_reg_or(rand_reg_shl(a, k), rand_reg_shr(a, 64 - (k)))
+
+// Words drawn per refill of the samplers' stack buffers.
+#define RAND_BLOCK 256
+
+// rand_bits writes steps * SOL_RAND_LANES outputs, lane-interleaved. The state
+// is held in registers for the whole call.
+static
+void rand_bits(SolRand *r, uint64_t *out, size_t steps) {
+  RandReg s0[RAND_REGS], s1[RAND_REGS], s2[RAND_REGS], s3[RAND_REGS];
+  for (size_t k = 0; k < RAND_REGS; k++) {
+    s0[k] = rand_reg_load(&r->s[0][k * RAND_WORDS]);
+    s1[k] = rand_reg_load(&r->s[1][k * RAND_WORDS]);
+    s2[k] = rand_reg_load(&r->s[2][k * RAND_WORDS]);
+    s3[k] = rand_reg_load(&r->s[3][k * RAND_WORDS]);
+  }
+  for (size_t i = 0; i < steps; i++) {
+    for (size_t k = 0; k < RAND_REGS; k++) {
+      rand_reg_store(out + i * SOL_RAND_LANES + k * RAND_WORDS, rand_reg_add(s0[k], s3[k]));
+      const RandReg t = rand_reg_shl(s1[k], 17);
+      s2[k] = rand_reg_xor(s2[k], s0[k]);
+      s3[k] = rand_reg_xor(s3[k], s1[k]);
+      s1[k] = rand_reg_xor(s1[k], s2[k]);
+      s0[k] = rand_reg_xor(s0[k], s3[k]);
+      s2[k] = rand_reg_xor(s2[k], t);
+      s3[k] = rand_reg_rotl(s3[k], 45);
+    }
+  }
+  for (size_t k = 0; k < RAND_REGS; k++) {
+    rand_reg_store(&r->s[0][k * RAND_WORDS], s0[k]);
+    rand_reg_store(&r->s[1][k * RAND_WORDS], s1[k]);
+    rand_reg_store(&r->s[2][k * RAND_WORDS], s2[k]);
+    rand_reg_store(&r->s[3][k * RAND_WORDS], s3[k]);
+  }
+}
+
+// A Float in [0, 1) takes the top bits of a word, which are the strongest in
+// xoshiro256+. Floats take 23 bits, so each word yields two of them.
+#if SOL_F_SIZE > 32
+      #define RAND_PER_WORD 1
+#else
+      #define RAND_PER_WORD 2
+#endif
+
+static inline
+void rand_unit_words(Float *out, const uint64_t *w, size_t n) {
+  #if SOL_F_SIZE > 64
+        for (size_t i = 0; i < n; i++)
+          out[i] = (Float) (w[i] >> 11) * 0x1p-53L;
+  #elif SOL_F_SIZE > 32
+        for (size_t i = 0; i < n; i++) {
+          const uint64_t b = (w[i] >> 12) | UINT64_C(0x3FF0000000000000);
+          double d;
+          memcpy(&d, &b, sizeof(d));
+          out[i] = d - 1;
+        }
+  #else
+        for (size_t i = 0; i < n; i++) {
+          const uint32_t b = (uint32_t) (w[i / 2] >> (i % 2 ? 9 : 41)) & 0x7FFFFF;
+          const uint32_t e = b | 0x3F800000;
+          float f;
+          memcpy(&f, &e, sizeof(f));
+          out[i] = f - 1;
+        }
+  #endif
+}
+
+// rand_unit fills out with n uniform Floats in [0, 1).
+static
+void rand_unit(SolRand *r, Float *out, size_t n) {
+  uint64_t w[RAND_BLOCK];
+  while (n) {
+    size_t m = (n + RAND_PER_WORD - 1) / RAND_PER_WORD;
+    m = m < RAND_BLOCK ? m : RAND_BLOCK;
+    m = (m + SOL_RAND_LANES - 1) / SOL_RAND_LANES;
+    rand_bits(r, w, m);
+    m *= SOL_RAND_LANES * RAND_PER_WORD;
+    m = m < n ? m : n;
+    rand_unit_words(out, w, m);
+    out += m;
+    n -= m;
+  }
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Seeding ///////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+static
+uint64_t rand_splitmix(uint64_t *x) {
+  uint64_t z = (*x += UINT64_C(0x9E3779B97F4A7C15));
+  z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+  z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+  return z ^ (z >> 31);
+}
+
+static
+void rand_step(uint64_t *s) {
+  const uint64_t t = s[1] << 17;
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = (s[3] << 45) | (s[3] >> 19);
+}
+
+// Advances s by the jump polynomial poly: 2^128 steps for RAND_JUMP and
+// 2^192 for RAND_LONG_JUMP.
+static
+void rand_jump(uint64_t *s, const uint64_t *poly) {
+  uint64_t j[4] = {0, 0, 0, 0};
+  for (size_t i = 0; i < 4; i++) {
+    for (size_t b = 0; b < 64; b++) {
+      if (poly[i] & (UINT64_C(1) << b))
+        for (size_t k = 0; k < 4; k++)
+          j[k] ^= s[k];
+      rand_step(s);
+    }
+  }
+  memcpy(s, j, sizeof(j));
+}
+
+static const uint64_t RAND_JUMP[4] = {
+  UINT64_C(0x180EC6D33CFD0ABA), UINT64_C(0xD5A61266F0C9392C),
+  UINT64_C(0xA9582618E03FC9AA), UINT64_C(0x39ABDC4529B1661C)
+};
+
+static const uint64_t RAND_LONG_JUMP[4] = {
+  UINT64_C(0x76E15D3EFEFDCBBF), UINT64_C(0xC5004E441C522FB3),
+  UINT64_C(0x77710069854EE241), UINT64_C(0x39109BB02ACBE635)
+};
+
+/// sol_rand_seed ///
+// Description
+//   Seeds a generator. Each stream starts 2^192 steps past the previous one
+//   and each lane 2^128 past the lane before it, so generators seeded with
+//   the same seed and different streams never overlap; give every thread its
+//   own stream. Seeding costs one long jump per stream, so streams are meant
+//   to be small numbers like thread indices.
+// Arguments
+//   r: generator (SolRand*)
+//   seed: seed (uint64_t)
+//   stream: stream index (uint64_t)
+// Returns
+//   void
+
+sol_inline
+void sol_rand_seed(SolRand *r, uint64_t seed, uint64_t stream) {
+  uint64_t s[4];
+  for (size_t k = 0; k < 4; k++)
+    s[k] = rand_splitmix(&seed);
+  for (uint64_t i = 0; i < stream; i++)
+    rand_jump(s, RAND_LONG_JUMP);
+  for (size_t l = 0; l < SOL_RAND_LANES; l++) {
+    for (size_t k = 0; k < 4; k++)
+      r->s[k][l] = s[k];
+    rand_jump(s, RAND_JUMP);
+  }
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Sampling //////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// The round samplers avoid trigonometry. They draw points in a square and
+// keep those inside the circle, writing every candidate and advancing the
+// output only on acceptance, so the loops have no data-dependent branches.
+// Points on the sphere and unit quaternions then follow from Marsaglia's
+// constructions, which are unit length up to rounding.
+
+/// flt_rand_array ///
+// Description
+//   Fills an array with uniform Floats in [0, 1).
+// Arguments
+//   r: generator (SolRand*)
+//   out: output (Float*)
+//   n: count (size_t)
+// Returns
+//   void
+
+sol_inline
+void flt_rand_array(SolRand *r, Float *out, size_t n) {
+  rand_unit(r, out, n);
+}
+
+/// vec2_rand_disk_array ///
+// Description
+//   Fills a structure of arrays with points distributed uniformly in the unit
+//   disk.
+// Arguments
+//   r: generator (SolRand*)
+//   out: output (Soa2)
+//   n: count (size_t)
+// Returns
+//   void
+
+sol_inline
+void vec2_rand_disk_array(SolRand *r, Soa2 out, size_t n) {
+  Float u[RAND_BLOCK];
+  size_t i = 0;
+  while (i < n) {
+    rand_unit(r, u, RAND_BLOCK);
+    for (size_t j = 0; j < RAND_BLOCK && i < n; j += 2) {
+      const Float a = 2 * u[j] - 1, b = 2 * u[j + 1] - 1;
+      out.x[i] = a;
+      out.y[i] = b;
+      i += a * a + b * b < 1;
+    }
+  }
+}
+
+/// vec3_rand_box_array ///
+// Description
+//   Fills a structure of arrays with points distributed uniformly in a box.
+// Arguments
+//   r: generator (SolRand*)
+//   out: output (Soa3)
+//   box: bounds (Box3)
+//   n: count (size_t)
+// Returns
+//   void
+
+sol_inline
+void vec3_rand_box_array(SolRand *r, Soa3 out, Box3 box, size_t n) {
+  Float *dim[3] = {out.x, out.y, out.z};
+  for (size_t d = 0; d < 3; d++) {
+    const Float lo = box.lower.dim[d], ext = box.upper.dim[d] - lo;
+    rand_unit(r, dim[d], n);
+    for (size_t i = 0; i < n; i++)
+      dim[d][i] = lo + dim[d][i] * ext;
+  }
+}
+
+/// vec3_rand_sphere_array ///
+// Description
+//   Fills a structure of arrays with unit vectors distributed uniformly over
+//   the sphere.
+// Arguments
+//   r: generator (SolRand*)
+//   out: output (Soa3)
+//   n: count (size_t)
+// Returns
+//   void
+
+sol_inline
+void vec3_rand_sphere_array(SolRand *r, Soa3 out, size_t n) {
+  Float u[RAND_BLOCK];
+  size_t i = 0;
+  while (i < n) {
+    rand_unit(r, u, RAND_BLOCK);
+    for (size_t j = 0; j < RAND_BLOCK && i < n; j += 2) {
+      const Float a = 2 * u[j] - 1, b = 2 * u[j + 1] - 1;
+      const Float s = a * a + b * b;
+      const Float h = 2 * flt_sqrt(s < 1 ? 1 - s : 0);
+      out.x[i] = a * h;
+      out.y[i] = b * h;
+      out.z[i] = 1 - 2 * s;
+      i += s < 1;
+    }
+  }
+}
+
+/// vec4_rand_quat_array ///
+// Description
+//   Fills a structure of arrays with unit quaternions distributed uniformly
+//   over the rotations, (x, y, z) being the vector part and w the scalar.
+// Arguments
+//   r: generator (SolRand*)
+//   out: output (Soa4)
+//   n: count (size_t)
+// Returns
+//   void
+
+sol_inline
+void vec4_rand_quat_array(SolRand *r, Soa4 out, size_t n) {
+  Float u[RAND_BLOCK];
+  size_t i = 0;
+  while (i < n) {
+    rand_unit(r, u, RAND_BLOCK);
+    for (size_t j = 0; j < RAND_BLOCK && i < n; j += 4) {
+      const Float a = 2 * u[j] - 1, b = 2 * u[j + 1] - 1;
+      const Float c = 2 * u[j + 2] - 1, d = 2 * u[j + 3] - 1;
+      const Float s1 = a * a + b * b, s2 = c * c + d * d;
+      const bool ok = s1 < 1 && s2 < 1 && s2 > 0;
+      const Float h = flt_sqrt(ok ? (1 - s1) / s2 : 0);
+      out.x[i] = a;
+      out.y[i] = b;
+      out.z[i] = c * h;
+      out.w[i] = d * h;
+      i += ok;
+    }
+  }
+}
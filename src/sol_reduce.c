@@ -0,0 +1,1057 @@
+    /////////////////////////////////////////////////////////////////
+   // sol_reduce.c /////////////////////////////////////////////////
+  // Description: Adds accurate array reductions to Sol. //////////
+ // Author: David Garland (https://github.com/davidgarland/sol) //
+/////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Local Headers /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include "../sol.h"
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Standard Headers //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Exact Accumulation ////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// The *_exact_array reductions are exact. Every Float, and every product of
+// two Floats, is split into an integer mantissa and exponent and added into a
+// fixed-point superaccumulator of 32-bit digits kept in 64-bit limbs, so
+// accumulation is integer addition and the order it happens in doesn't
+// matter. The total is rounded once at the end, to nearest-even, by integer
+// code. Results are therefore correctly rounded and bit-identical for every
+// thread count, threading backend, SIMD tier and set of compiler flags.
+
+#if SOL_F_SIZE > 64
+      typedef long double Accum;
+      #define RED_MANT LDBL_MANT_DIG
+      #define RED_MIN_EXP LDBL_MIN_EXP
+      #define RED_MAX_EXP LDBL_MAX_EXP
+      #define ACC_MANT LDBL_MANT_DIG
+      #define ACC_MIN_EXP LDBL_MIN_EXP
+#elif SOL_F_SIZE > 32
+      typedef double Accum;
+      #define RED_MANT DBL_MANT_DIG
+      #define RED_MIN_EXP DBL_MIN_EXP
+      #define RED_MAX_EXP DBL_MAX_EXP
+      #define ACC_MANT DBL_MANT_DIG
+      #define ACC_MIN_EXP DBL_MIN_EXP
+#else
+      typedef double Accum;
+      #define RED_MANT FLT_MANT_DIG
+      #define RED_MIN_EXP FLT_MIN_EXP
+      #define RED_MAX_EXP FLT_MAX_EXP
+      #define ACC_MANT DBL_MANT_DIG
+      #define ACC_MIN_EXP DBL_MIN_EXP
+#endif
+
+// Bit 0 of limb 0 weighs 2^RED_LOW, the smallest bit a product of two Floats
+// can have. The top limbs leave 64 bits of headroom over the largest product.
+#define RED_LOW (2 * (RED_MIN_EXP - RED_MANT))
+#define RED_LIMBS ((2 * RED_MAX_EXP - RED_LOW + 64) / 32 + 4)
+
+// Each addition moves a limb by less than 2^33, so carries are propagated
+// well before a limb could overflow.
+#define RED_NORM_EVERY ((size_t) 1 << 28)
+
+#define RED_DIGIT ((int64_t) 1 << 32)
+
+enum {
+  RED_PINF = 1,
+  RED_NINF = 2,
+  RED_NAN = 4
+};
+
+// A thread-local accumulator.
+typedef struct {
+  int64_t limb[RED_LIMBS];
+  size_t lo, hi;  // Only limbs in [lo, hi) may be nonzero.
+  size_t adds;    // Additions since carries were last propagated.
+  int special;    // Infinities and NaNs seen, as RED_* flags.
+} RedAcc;
+
+// A shared accumulator that chunks merge into without locking.
+typedef struct {
+  _Atomic int64_t limb[RED_LIMBS];
+  atomic_int special;
+} RedSum;
+
+static inline
+void red_init(RedAcc *a) {
+  memset(a->limb, 0, sizeof(a->limb));
+  a->lo = RED_LIMBS;
+  a->hi = 0;
+  a->adds = 0;
+  a->special = 0;
+}
+
+static inline
+void red_sum_init(RedSum *s) {
+  for (size_t i = 0; i < RED_LIMBS; i++)
+    atomic_init(&s->limb[i], 0);
+  atomic_init(&s->special, 0);
+}
+
+// Propagates carries so that every limb below the top one holds a digit in
+// [0, 2^32). The top limb keeps the sign; a nonnegative top limb is split
+// upward until it is a digit as well.
+static
+void red_norm(RedAcc *a) {
+  a->adds = 0;
+  if (a->lo >= a->hi)
+    return;
+  for (size_t i = a->lo; i + 1 < a->hi; i++) {
+    const int64_t carry = a->limb[i] >> 32;
+    a->limb[i] -= carry * RED_DIGIT;
+    a->limb[i + 1] += carry;
+  }
+  while (a->hi < RED_LIMBS && a->limb[a->hi - 1] >= RED_DIGIT) {
+    a->limb[a->hi] = a->limb[a->hi - 1] >> 32;
+    a->limb[a->hi - 1] &= RED_DIGIT - 1;
+    a->hi++;
+  }
+}
+
+// Adds (-1)^neg * m * 2^e.
+static inline
+void red_add(RedAcc *a, uint64_t m, int e, bool neg) {
+  const size_t k = (size_t) (e - RED_LOW);
+  const size_t q = k / 32;
+  const unsigned s = k % 32;
+  const uint64_t lo = (m & 0xFFFFFFFF) << s;
+  const uint64_t hi = (m >> 32) << s;
+  const int64_t d0 = (int64_t) (lo & 0xFFFFFFFF);
+  const int64_t d1 = (int64_t) ((lo >> 32) + (hi & 0xFFFFFFFF));
+  const int64_t d2 = (int64_t) (hi >> 32);
+  if (neg) {
+    a->limb[q] -= d0;
+    a->limb[q + 1] -= d1;
+    a->limb[q + 2] -= d2;
+  } else {
+    a->limb[q] += d0;
+    a->limb[q + 1] += d1;
+    a->limb[q + 2] += d2;
+  }
+  if (q < a->lo)
+    a->lo = q;
+  if (q + 3 > a->hi)
+    a->hi = q + 3;
+  if (++a->adds >= RED_NORM_EVERY)
+    red_norm(a);
+}
+
+// Splits f into sign, integer mantissa and exponent so that
+// f = (-1)^neg * m * 2^e, reading the bits directly where the format allows.
+// Returns the RED_* flag for infinities and NaNs, or 0 when f is finite.
+static inline
+int red_split(Float f, uint64_t *m, int *e, bool *neg) {
+  *m = 0;
+  *e = 0;
+  #if SOL_F_SIZE > 64
+        *neg = signbit(f) != 0;
+        if (isnan(f))
+          return RED_NAN;
+        if (isinf(f))
+          return *neg ? RED_NINF : RED_PINF;
+        int ex;
+        const Float fr = frexpl(fabsl(f), &ex);
+        *m = (uint64_t) ldexpl(fr, 64);
+        *e = ex - 64;
+        if (*m && *e < RED_MIN_EXP - RED_MANT) {
+          *m >>= (RED_MIN_EXP - RED_MANT) - *e;
+          *e = RED_MIN_EXP - RED_MANT;
+        }
+  #elif SOL_F_SIZE > 32
+        uint64_t b;
+        memcpy(&b, &f, sizeof(b));
+        *neg = (b >> 63) != 0;
+        const int ex = (int) ((b >> 52) & 0x7FF);
+        const uint64_t fr = b & (((uint64_t) 1 << 52) - 1);
+        if (ex == 0x7FF)
+          return fr ? RED_NAN : *neg ? RED_NINF : RED_PINF;
+        *m = ex ? fr | (uint64_t) 1 << 52 : fr;
+        *e = (ex ? ex : 1) - 1075;
+  #else
+        uint32_t b;
+        memcpy(&b, &f, sizeof(b));
+        *neg = (b >> 31) != 0;
+        const int ex = (int) ((b >> 23) & 0xFF);
+        const uint32_t fr = b & ((1u << 23) - 1);
+        if (ex == 0xFF)
+          return fr ? RED_NAN : *neg ? RED_NINF : RED_PINF;
+        *m = ex ? fr | 1u << 23 : fr;
+        *e = (ex ? ex : 1) - 150;
+  #endif
+  return 0;
+}
+
+// Adds a Float.
+static inline
+void red_add_flt(RedAcc *a, Float f) {
+  uint64_t m;
+  int e;
+  bool neg;
+  const int s = red_split(f, &m, &e, &neg);
+  if (s)
+    a->special |= s;
+  else if (m)
+    red_add(a, m, e, neg);
+}
+
+// Adds the exact product of two Floats.
+static inline
+void red_add_mul(RedAcc *a, Float x, Float y) {
+  uint64_t mx, my;
+  int ex, ey;
+  bool nx, ny;
+  const int sx = red_split(x, &mx, &ex, &nx);
+  const int sy = red_split(y, &my, &ey, &ny);
+  if (sx | sy) {
+    if (((sx | sy) & RED_NAN) || (!sx && !mx) || (!sy && !my))
+      a->special |= RED_NAN;
+    else
+      a->special |= nx != ny ? RED_NINF : RED_PINF;
+    return;
+  }
+  if (!mx || !my)
+    return;
+  const bool neg = nx != ny;
+  const int e = ex + ey;
+  #if SOL_F_SIZE > 32
+        const uint64_t xl = mx & 0xFFFFFFFF, xh = mx >> 32;
+        const uint64_t yl = my & 0xFFFFFFFF, yh = my >> 32;
+        red_add(a, xl * yl, e, neg);
+        red_add(a, xl * yh, e + 32, neg);
+        red_add(a, xh * yl, e + 32, neg);
+        red_add(a, xh * yh, e + 64, neg);
+  #else
+        red_add(a, mx * my, e, neg);
+  #endif
+}
+
+// Adds a finished chunk into a shared accumulator.
+static
+void red_merge(RedSum *s, RedAcc *a) {
+  red_norm(a);
+  for (size_t i = a->lo; i < a->hi; i++)
+    if (a->limb[i])
+      atomic_fetch_add_explicit(&s->limb[i], a->limb[i], memory_order_relaxed);
+  if (a->special)
+    atomic_fetch_or_explicit(&s->special, a->special, memory_order_relaxed);
+}
+
+// Reads a shared accumulator back once every chunk has merged.
+static
+void red_collect(RedAcc *a, RedSum *s) {
+  red_init(a);
+  for (size_t i = 0; i < RED_LIMBS; i++) {
+    a->limb[i] = atomic_load_explicit(&s->limb[i], memory_order_relaxed);
+    if (a->limb[i]) {
+      if (i < a->lo)
+        a->lo = i;
+      a->hi = i + 1;
+    }
+  }
+  a->special = atomic_load_explicit(&s->special, memory_order_relaxed);
+}
+
+static inline
+unsigned red_bit(const RedAcc *a, long i) {
+  if (i < 0)
+    return 0;
+  const size_t q = (size_t) i / 32;
+  if (q < a->lo || q >= a->hi)
+    return 0;
+  return (unsigned) (a->limb[q] >> (i % 32)) & 1;
+}
+
+// Checks for any set bit below bit i.
+static
+bool red_sticky(const RedAcc *a, long i) {
+  if (i <= 0)
+    return false;
+  const size_t q = (size_t) i / 32;
+  for (size_t j = a->lo; j < q && j < a->hi; j++)
+    if (a->limb[j])
+      return true;
+  if (q >= a->lo && q < a->hi)
+    return (a->limb[q] & (((int64_t) 1 << (i % 32)) - 1)) != 0;
+  return false;
+}
+
+// Rounds the total to nearest-even in a format with the given mantissa width
+// and minimum exponent, which may be wider than Float.
+static
+Accum red_round(RedAcc *a, int mant, int min_exp) {
+  if (a->special) {
+    if ((a->special & RED_NAN) || (a->special & RED_PINF && a->special & RED_NINF))
+      return (Accum) NAN;
+    return a->special & RED_PINF ? (Accum) INFINITY : -(Accum) INFINITY;
+  }
+  red_norm(a);
+  if (a->lo >= a->hi)
+    return 0;
+  const bool neg = a->limb[a->hi - 1] < 0;
+  if (neg) {
+    for (size_t i = a->lo; i < a->hi; i++)
+      a->limb[i] = -a->limb[i];
+    red_norm(a);
+  }
+  size_t h = a->hi;
+  while (h > a->lo && !a->limb[h - 1])
+    h--;
+  if (h == a->lo)
+    return 0;
+  long top = (long) (h - 1) * 32;
+  for (int64_t d = a->limb[h - 1]; d > 1; d >>= 1)
+    top++;
+  // r is the exponent of the last mantissa bit kept, rb its bit index.
+  long r = top + RED_LOW - (mant - 1);
+  if (r < min_exp - mant)
+    r = min_exp - mant;
+  if (r < RED_LOW)
+    r = RED_LOW;
+  const long rb = r - RED_LOW;
+  uint64_t m = 0;
+  for (long i = top; i >= rb; i--)
+    m = m << 1 | red_bit(a, i);
+  if (red_bit(a, rb - 1) && (m & 1 || red_sticky(a, rb - 1))) {
+    if (!++m) {
+      m = (uint64_t) 1 << 63;
+      r++;
+    }
+  }
+  #if SOL_F_SIZE > 64
+        const Accum out = ldexpl((Accum) m, (int) r);
+  #else
+        const Accum out = ldexp((Accum) m, (int) r);
+  #endif
+  return neg ? -out : out;
+}
+
+// Rounds the total to Float.
+static inline
+Float red_flt(RedAcc *a) {
+  return (Float) red_round(a, RED_MANT, RED_MIN_EXP);
+}
+
+// Rounds the total to Accum, for results that still get divided.
+static inline
+Accum red_wide(RedAcc *a) {
+  return red_round(a, ACC_MANT, ACC_MIN_EXP);
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Pairwise Accumulation /////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// The default reductions read Float data but accumulate in Accum, which is at
+// least double. Arrays are split pairwise down to RED_BLOCK elements and each
+// block is summed with SIMD accumulators, so the rounding error grows with
+// log(n) rather than n even when Float is already double. The result is
+// rounded to Float once, at the end. The block shape depends on the SIMD
+// tier, so the last bits may differ between builds; the *_exact_array
+// variants don't.
+
+#define RED_BLOCK 256
+
+typedef struct {
+  Accum x, y, z;
+} Red3;
+
+typedef struct {
+  Accum xx, xy, xz, yy, yz, zz;
+} Red6;
+
+#if defined(SOL_AVX)
+
+// Loads 4 Floats as doubles.
+static inline
+__m256d red_load4(const Float *p) {
+  #if defined(SOL_AVX_64)
+        return _mm256_loadu_pd(p);
+  #else
+        return _mm256_cvtps_pd(_mm_loadu_ps(p));
+  #endif
+}
+
+// Loads 4 packed vectors (12 Floats) and transposes them into X, Y and Z
+// registers of doubles.
+static inline
+void red_soa4(const Float *p, __m256d *x, __m256d *y, __m256d *z) {
+  const __m256d d0 = red_load4(p);
+  const __m256d d1 = red_load4(p + 4);
+  const __m256d d2 = red_load4(p + 8);
+  const __m256d m03 = _mm256_permute2f128_pd(d0, d1, 0x30);
+  const __m256d m14 = _mm256_permute2f128_pd(d0, d2, 0x21);
+  const __m256d m25 = _mm256_permute2f128_pd(d1, d2, 0x30);
+  *x = _mm256_shuffle_pd(m03, m14, 0xA);
+  *y = _mm256_shuffle_pd(m03, m25, 0x5);
+  *z = _mm256_shuffle_pd(m14, m25, 0xA);
+}
+
+static inline
+Accum red_hsum(__m256d v) {
+  double d[4];
+  _mm256_storeu_pd(d, v);
+  return (d[0] + d[1]) + (d[2] + d[3]);
+}
+
+#endif
+
+static
+Accum red_sum(const Float *f, size_t n) {
+  if (n > RED_BLOCK) {
+    const size_t h = n / 2;
+    return red_sum(f, h) + red_sum(f + h, n - h);
+  }
+  Accum out = 0;
+  size_t i = 0;
+  #if defined(SOL_AVX)
+        __m256d a0 = _mm256_setzero_pd(), a1 = a0, a2 = a0, a3 = a0;
+        for (; i + 16 <= n; i += 16) {
+          a0 = _mm256_add_pd(a0, red_load4(f + i));
+          a1 = _mm256_add_pd(a1, red_load4(f + i + 4));
+          a2 = _mm256_add_pd(a2, red_load4(f + i + 8));
+          a3 = _mm256_add_pd(a3, red_load4(f + i + 12));
+        }
+        out = red_hsum(_mm256_add_pd(_mm256_add_pd(a0, a1), _mm256_add_pd(a2, a3)));
+  #endif
+  for (; i < n; i++)
+    out += f[i];
+  return out;
+}
+
+static
+Accum red_dot(const Float *a, const Float *b, size_t n) {
+  if (n > RED_BLOCK) {
+    const size_t h = n / 2;
+    return red_dot(a, b, h) + red_dot(a + h, b + h, n - h);
+  }
+  Accum out = 0;
+  size_t i = 0;
+  #if defined(SOL_AVX)
+        __m256d a0 = _mm256_setzero_pd(), a1 = a0;
+        for (; i + 8 <= n; i += 8) {
+          a0 = _mm256_add_pd(a0, _mm256_mul_pd(red_load4(a + i), red_load4(b + i)));
+          a1 = _mm256_add_pd(a1, _mm256_mul_pd(red_load4(a + i + 4), red_load4(b + i + 4)));
+        }
+        out = red_hsum(_mm256_add_pd(a0, a1));
+  #endif
+  for (; i < n; i++)
+    out += (Accum) a[i] * b[i];
+  return out;
+}
+
+static
+Red3 red_sum3(const Float *p, size_t n) {
+  Red3 out = {0, 0, 0};
+  if (n > RED_BLOCK) {
+    const size_t h = n / 2;
+    const Red3 a = red_sum3(p, h);
+    const Red3 b = red_sum3(p + h * 3, n - h);
+    out.x = a.x + b.x;
+    out.y = a.y + b.y;
+    out.z = a.z + b.z;
+    return out;
+  }
+  size_t i = 0;
+  #if defined(SOL_AVX)
+        __m256d ax = _mm256_setzero_pd(), ay = ax, az = ax;
+        for (; i + 4 <= n; i += 4) {
+          __m256d x, y, z;
+          red_soa4(p + i * 3, &x, &y, &z);
+          ax = _mm256_add_pd(ax, x);
+          ay = _mm256_add_pd(ay, y);
+          az = _mm256_add_pd(az, z);
+        }
+        out.x = red_hsum(ax);
+        out.y = red_hsum(ay);
+        out.z = red_hsum(az);
+  #endif
+  for (; i < n; i++) {
+    out.x += p[i * 3];
+    out.y += p[i * 3 + 1];
+    out.z += p[i * 3 + 2];
+  }
+  return out;
+}
+
+static
+Red6 red_cov3(const Float *p, size_t n, Red3 m) {
+  Red6 out = {0, 0, 0, 0, 0, 0};
+  if (n > RED_BLOCK) {
+    const size_t h = n / 2;
+    const Red6 a = red_cov3(p, h, m);
+    const Red6 b = red_cov3(p + h * 3, n - h, m);
+    out.xx = a.xx + b.xx;
+    out.xy = a.xy + b.xy;
+    out.xz = a.xz + b.xz;
+    out.yy = a.yy + b.yy;
+    out.yz = a.yz + b.yz;
+    out.zz = a.zz + b.zz;
+    return out;
+  }
+  size_t i = 0;
+  #if defined(SOL_AVX)
+        const __m256d mx = _mm256_set1_pd(m.x);
+        const __m256d my = _mm256_set1_pd(m.y);
+        const __m256d mz = _mm256_set1_pd(m.z);
+        __m256d axx = _mm256_setzero_pd(), axy = axx, axz = axx;
+        __m256d ayy = axx, ayz = axx, azz = axx;
+        for (; i + 4 <= n; i += 4) {
+          __m256d x, y, z;
+          red_soa4(p + i * 3, &x, &y, &z);
+          x = _mm256_sub_pd(x, mx);
+          y = _mm256_sub_pd(y, my);
+          z = _mm256_sub_pd(z, mz);
+          axx = _mm256_add_pd(axx, _mm256_mul_pd(x, x));
+          axy = _mm256_add_pd(axy, _mm256_mul_pd(x, y));
+          axz = _mm256_add_pd(axz, _mm256_mul_pd(x, z));
+          ayy = _mm256_add_pd(ayy, _mm256_mul_pd(y, y));
+          ayz = _mm256_add_pd(ayz, _mm256_mul_pd(y, z));
+          azz = _mm256_add_pd(azz, _mm256_mul_pd(z, z));
+        }
+        out.xx = red_hsum(axx);
+        out.xy = red_hsum(axy);
+        out.xz = red_hsum(axz);
+        out.yy = red_hsum(ayy);
+        out.yz = red_hsum(ayz);
+        out.zz = red_hsum(azz);
+  #endif
+  for (; i < n; i++) {
+    const Accum x = p[i * 3] - m.x;
+    const Accum y = p[i * 3 + 1] - m.y;
+    const Accum z = p[i * 3 + 2] - m.z;
+    out.xx += x * x;
+    out.xy += x * y;
+    out.xz += x * z;
+    out.yy += y * y;
+    out.yz += y * z;
+    out.zz += z * z;
+  }
+  return out;
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Ordering //////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Minimums and maximums follow the IEEE 754 total order, so they're
+// independent of the order comparisons happen in: -0 sorts below +0, and NaNs
+// sort past the infinities on the side of their sign bit.
+
+#if SOL_F_SIZE > 64
+      static inline
+      int red_class(Float f) {
+        return isnan(f) ? (signbit(f) ? -1 : 1) : 0;
+      }
+
+      static inline
+      bool red_less(Float a, Float b) {
+        const int ca = red_class(a), cb = red_class(b);
+        if (ca || cb)
+          return ca < cb;
+        return a < b || (a == b && signbit(a) && !signbit(b));
+      }
+#elif SOL_F_SIZE > 32
+      static inline
+      int64_t red_key(Float f) {
+        int64_t b;
+        memcpy(&b, &f, sizeof(b));
+        return b ^ ((b >> 63) & INT64_MAX);
+      }
+
+      static inline
+      bool red_less(Float a, Float b) {
+        return red_key(a) < red_key(b);
+      }
+#else
+      static inline
+      int32_t red_key(Float f) {
+        int32_t b;
+        memcpy(&b, &f, sizeof(b));
+        return b ^ ((b >> 31) & INT32_MAX);
+      }
+
+      static inline
+      bool red_less(Float a, Float b) {
+        return red_key(a) < red_key(b);
+      }
+#endif
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Reduction Jobs ////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Jobs see the input as k interleaved Float streams: k is 1 for scalar
+// arrays and 3 for packed vectors. Each chunk reduces into accumulators on
+// its own stack and merges once when it's done.
+
+typedef struct {
+  const Float *a, *b;
+  size_t k;
+  Float m[3];
+  RedSum *sum;
+  atomic_flag lock;
+  Float lower[3], upper[3];
+  bool seen;
+} RedJob;
+
+static
+void red_sum_task(void *job, size_t lo, size_t hi) {
+  RedJob *j = job;
+  RedAcc acc[3];
+  for (size_t c = 0; c < j->k; c++)
+    red_init(&acc[c]);
+  const Float *a = j->a + lo * j->k;
+  for (size_t i = 0; i < (hi - lo) * j->k; i += j->k)
+    for (size_t c = 0; c < j->k; c++)
+      red_add_flt(&acc[c], a[i + c]);
+  for (size_t c = 0; c < j->k; c++)
+    red_merge(&j->sum[c], &acc[c]);
+}
+
+static
+void red_dot_task(void *job, size_t lo, size_t hi) {
+  RedJob *j = job;
+  RedAcc acc;
+  red_init(&acc);
+  const Float *a = j->a + lo * j->k;
+  const Float *b = j->b + lo * j->k;
+  for (size_t i = 0; i < (hi - lo) * j->k; i++)
+    red_add_mul(&acc, a[i], b[i]);
+  red_merge(j->sum, &acc);
+}
+
+// Covariance products of the deviations from m, in xx xy xz yy yz zz order.
+static
+void red_cov_task(void *job, size_t lo, size_t hi) {
+  RedJob *j = job;
+  RedAcc acc[6];
+  for (size_t c = 0; c < 6; c++)
+    red_init(&acc[c]);
+  const Float *a = j->a + lo * 3;
+  for (size_t i = 0; i < (hi - lo) * 3; i += 3) {
+    const Float x = a[i] - j->m[0];
+    const Float y = a[i + 1] - j->m[1];
+    const Float z = a[i + 2] - j->m[2];
+    red_add_mul(&acc[0], x, x);
+    red_add_mul(&acc[1], x, y);
+    red_add_mul(&acc[2], x, z);
+    red_add_mul(&acc[3], y, y);
+    red_add_mul(&acc[4], y, z);
+    red_add_mul(&acc[5], z, z);
+  }
+  for (size_t c = 0; c < 6; c++)
+    red_merge(&j->sum[c], &acc[c]);
+}
+
+static
+void red_bounds_task(void *job, size_t lo, size_t hi) {
+  RedJob *j = job;
+  Float l[3], u[3];
+  const Float *a = j->a + lo * j->k;
+  for (size_t c = 0; c < j->k; c++)
+    l[c] = u[c] = a[c];
+  for (size_t i = j->k; i < (hi - lo) * j->k; i += j->k) {
+    for (size_t c = 0; c < j->k; c++) {
+      if (red_less(a[i + c], l[c]))
+        l[c] = a[i + c];
+      if (red_less(u[c], a[i + c]))
+        u[c] = a[i + c];
+    }
+  }
+  while (atomic_flag_test_and_set_explicit(&j->lock, memory_order_acquire));
+  for (size_t c = 0; c < j->k; c++) {
+    if (!j->seen || red_less(l[c], j->lower[c]))
+      j->lower[c] = l[c];
+    if (!j->seen || red_less(j->upper[c], u[c]))
+      j->upper[c] = u[c];
+  }
+  j->seen = true;
+  atomic_flag_clear_explicit(&j->lock, memory_order_release);
+}
+
+// Runs fn over n elements of k Floats each, into k shared accumulators.
+static
+void red_run(RedJob *j, RedSum *sum, size_t sums, size_t n, size_t size, SolFor fn) {
+  for (size_t c = 0; c < sums; c++)
+    red_sum_init(&sum[c]);
+  j->sum = sum;
+  sol_parallel_for(n, size, fn, j);
+}
+
+static
+void red_bounds(RedJob *j, size_t n) {
+  atomic_flag_clear(&j->lock);
+  j->seen = false;
+  for (size_t c = 0; c < j->k; c++)
+    j->lower[c] = j->upper[c] = 0;
+  sol_parallel_for(n, sizeof(Float) * j->k, red_bounds_task, j);
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Scalar Reductions /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+/// flt_sum_array ///
+// Description
+//   Sums an array of Floats with wide, pairwise accumulation.
+// Arguments
+//   f: scalars (Float*)
+//   n: count (size_t)
+// Returns
+//   scalar (Float) {f[0] + ... + f[n - 1]}
+
+sol_inline
+Float flt_sum_array(const Float *f, size_t n) {
+  return (Float) red_sum(f, n);
+}
+
+/// flt_sum_exact_array ///
+// Description
+//   Sums an array of Floats exactly, rounding once at the end. The result is
+//   the same for any thread count.
+// Arguments
+//   f: scalars (Float*)
+//   n: count (size_t)
+// Returns
+//   scalar (Float) {f[0] + ... + f[n - 1]}
+
+sol_inline
+Float flt_sum_exact_array(const Float *f, size_t n) {
+  RedJob j = {.a = f, .k = 1};
+  RedSum s;
+  RedAcc a;
+  red_run(&j, &s, 1, n, sizeof(Float), red_sum_task);
+  red_collect(&a, &s);
+  return red_flt(&a);
+}
+
+/// flt_dot_array ///
+// Description
+//   Gets the dot product of two Float arrays with wide, pairwise
+//   accumulation. When Float is float every product is exact.
+// Arguments
+//   a: scalars (Float*)
+//   b: scalars (Float*)
+//   n: count (size_t)
+// Returns
+//   scalar (Float) {a[0] * b[0] + ... + a[n - 1] * b[n - 1]}
+
+sol_inline
+Float flt_dot_array(const Float *a, const Float *b, size_t n) {
+  return (Float) red_dot(a, b, n);
+}
+
+/// flt_dot_exact_array ///
+// Description
+//   Gets the dot product of two Float arrays. Every product and the sum of
+//   them all are exact, rounding once at the end. The result is the same for
+//   any thread count.
+// Arguments
+//   a: scalars (Float*)
+//   b: scalars (Float*)
+//   n: count (size_t)
+// Returns
+//   scalar (Float) {a[0] * b[0] + ... + a[n - 1] * b[n - 1]}
+
+sol_inline
+Float flt_dot_exact_array(const Float *a, const Float *b, size_t n) {
+  RedJob j = {.a = a, .b = b, .k = 1};
+  RedSum s;
+  RedAcc r;
+  red_run(&j, &s, 1, n, sizeof(Float) * 2, red_dot_task);
+  red_collect(&r, &s);
+  return red_flt(&r);
+}
+
+/// flt_min_array ///
+// Description
+//   Finds the smallest of an array of Floats in the IEEE 754 total order,
+//   where -0 is below +0.
+// Arguments
+//   f: scalars (Float*)
+//   n: count (size_t)
+// Returns
+//   scalar (Float), or zero if n is 0
+
+sol_inline
+Float flt_min_array(const Float *f, size_t n) {
+  RedJob j = {.a = f, .k = 1};
+  red_bounds(&j, n);
+  return j.lower[0];
+}
+
+/// flt_max_array ///
+// Description
+//   Finds the largest of an array of Floats in the IEEE 754 total order,
+//   where +0 is above -0.
+// Arguments
+//   f: scalars (Float*)
+//   n: count (size_t)
+// Returns
+//   scalar (Float), or zero if n is 0
+
+sol_inline
+Float flt_max_array(const Float *f, size_t n) {
+  RedJob j = {.a = f, .k = 1};
+  red_bounds(&j, n);
+  return j.upper[0];
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Vec3 Reductions ///////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+/// vec3_sum_array ///
+// Description
+//   Sums an array of packed vectors with wide, pairwise accumulation.
+// Arguments
+//   v: packed vectors (Vec3p*)
+//   n: count (size_t)
+// Returns
+//   vector (Vec3) {v[0].xyz + ... + v[n - 1].xyz}
+
+sol_inline
+Vec3 vec3_sum_array(const Vec3p *v, size_t n) {
+  const Red3 s = red_sum3(v->dim, n);
+  return vec3_init((Float) s.x, (Float) s.y, (Float) s.z);
+}
+
+/// vec3_sum_exact_array ///
+// Description
+//   Sums an array of packed vectors exactly, rounding once at the end. The
+//   result is the same for any thread count.
+// Arguments
+//   v: packed vectors (Vec3p*)
+//   n: count (size_t)
+// Returns
+//   vector (Vec3) {v[0].xyz + ... + v[n - 1].xyz}
+
+sol_inline
+Vec3 vec3_sum_exact_array(const Vec3p *v, size_t n) {
+  RedJob j = {.a = v->dim, .k = 3};
+  RedSum s[3];
+  RedAcc a[3];
+  red_run(&j, s, 3, n, sizeof(Vec3p), red_sum_task);
+  for (size_t c = 0; c < 3; c++)
+    red_collect(&a[c], &s[c]);
+  return vec3_init(red_flt(&a[0]), red_flt(&a[1]), red_flt(&a[2]));
+}
+
+/// vec3_mean_array ///
+// Description
+//   Finds the centroid of an array of packed vectors. The sum and division
+//   both happen at accumulator precision.
+// Arguments
+//   v: packed vectors (Vec3p*)
+//   n: count (size_t)
+// Returns
+//   vector (Vec3) {(v[0].xyz + ... + v[n - 1].xyz) / n}, or zero if n is 0
+
+sol_inline
+Vec3 vec3_mean_array(const Vec3p *v, size_t n) {
+  if (n == 0)
+    return vec3_zero();
+  const Red3 s = red_sum3(v->dim, n);
+  const Accum k = (Accum) n;
+  return vec3_init((Float) (s.x / k), (Float) (s.y / k), (Float) (s.z / k));
+}
+
+/// vec3_mean_exact_array ///
+// Description
+//   Finds the centroid of an array of packed vectors. The exact sum is
+//   rounded to accumulator precision and divided there. The result is the
+//   same for any thread count.
+// Arguments
+//   v: packed vectors (Vec3p*)
+//   n: count (size_t)
+// Returns
+//   vector (Vec3) {(v[0].xyz + ... + v[n - 1].xyz) / n}, or zero if n is 0
+
+sol_inline
+Vec3 vec3_mean_exact_array(const Vec3p *v, size_t n) {
+  if (n == 0)
+    return vec3_zero();
+  RedJob j = {.a = v->dim, .k = 3};
+  RedSum s[3];
+  RedAcc a[3];
+  red_run(&j, s, 3, n, sizeof(Vec3p), red_sum_task);
+  Float m[3];
+  for (size_t c = 0; c < 3; c++) {
+    red_collect(&a[c], &s[c]);
+    m[c] = (Float) (red_wide(&a[c]) / (Accum) n);
+  }
+  return vec3_init(m[0], m[1], m[2]);
+}
+
+/// vec3_dot_sum_array ///
+// Description
+//   Sums the dot products of two packed vector arrays element by element.
+// Arguments
+//   a: packed vectors (Vec3p*)
+//   b: packed vectors (Vec3p*)
+//   n: count (size_t)
+// Returns
+//   scalar (Float) {dot(a[0], b[0]) + ... + dot(a[n - 1], b[n - 1])}
+
+sol_inline
+Float vec3_dot_sum_array(const Vec3p *a, const Vec3p *b, size_t n) {
+  return (Float) red_dot(a->dim, b->dim, n * 3);
+}
+
+/// vec3_dot_sum_exact_array ///
+// Description
+//   Sums the dot products of two packed vector arrays element by element.
+//   Every product and the sum of them all are exact, rounding once at the
+//   end. The result is the same for any thread count.
+// Arguments
+//   a: packed vectors (Vec3p*)
+//   b: packed vectors (Vec3p*)
+//   n: count (size_t)
+// Returns
+//   scalar (Float) {dot(a[0], b[0]) + ... + dot(a[n - 1], b[n - 1])}
+
+sol_inline
+Float vec3_dot_sum_exact_array(const Vec3p *a, const Vec3p *b, size_t n) {
+  RedJob j = {.a = a->dim, .b = b->dim, .k = 3};
+  RedSum s;
+  RedAcc r;
+  red_run(&j, &s, 1, n, sizeof(Vec3p) * 2, red_dot_task);
+  red_collect(&r, &s);
+  return red_flt(&r);
+}
+
+/// vec3_cov_array ///
+// Description
+//   Finds the population covariance of an array of packed vectors. The mean
+//   is taken first and kept at accumulator precision, so the result doesn't
+//   suffer from the cancellation of the one-pass E[xx] - E[x]E[x] form.
+// Arguments
+//   v: packed vectors (Vec3p*)
+//   n: count (size_t)
+// Returns
+//   symmetric matrix (Sym3), or zero if n is 0
+
+sol_inline
+Sym3 vec3_cov_array(const Vec3p *v, size_t n) {
+  Sym3 out = {0, 0, 0, 0, 0, 0};
+  if (n == 0)
+    return out;
+  const Accum k = (Accum) n;
+  Red3 m = red_sum3(v->dim, n);
+  m.x /= k;
+  m.y /= k;
+  m.z /= k;
+  const Red6 c = red_cov3(v->dim, n, m);
+  out.xx = (Float) (c.xx / k);
+  out.xy = (Float) (c.xy / k);
+  out.xz = (Float) (c.xz / k);
+  out.yy = (Float) (c.yy / k);
+  out.yz = (Float) (c.yz / k);
+  out.zz = (Float) (c.zz / k);
+  return out;
+}
+
+/// vec3_cov_exact_array ///
+// Description
+//   Finds the population covariance of an array of packed vectors. The exact
+//   mean is taken first, then the deviations from it are formed in Float and
+//   their products summed exactly, so the result is the same for any thread
+//   count.
+// Arguments
+//   v: packed vectors (Vec3p*)
+//   n: count (size_t)
+// Returns
+//   symmetric matrix (Sym3), or zero if n is 0
+
+sol_inline
+Sym3 vec3_cov_exact_array(const Vec3p *v, size_t n) {
+  Sym3 out = {0, 0, 0, 0, 0, 0};
+  if (n == 0)
+    return out;
+  const Vec3 m = vec3_mean_exact_array(v, n);
+  RedJob j = {.a = v->dim, .k = 3, .m = {m.x, m.y, m.z}};
+  RedSum s[6];
+  RedAcc a;
+  red_run(&j, s, 6, n, sizeof(Vec3p), red_cov_task);
+  Float c[6];
+  for (size_t i = 0; i < 6; i++) {
+    red_collect(&a, &s[i]);
+    c[i] = (Float) (red_wide(&a) / (Accum) n);
+  }
+  out.xx = c[0];
+  out.xy = c[1];
+  out.xz = c[2];
+  out.yy = c[3];
+  out.yz = c[4];
+  out.zz = c[5];
+  return out;
+}
+
+/// vec3_min_array ///
+// Description
+//   Finds the componentwise minimum of an array of packed vectors in the
+//   IEEE 754 total order.
+// Arguments
+//   v: packed vectors (Vec3p*)
+//   n: count (size_t)
+// Returns
+//   vector (Vec3), or zero if n is 0
+
+sol_inline
+Vec3 vec3_min_array(const Vec3p *v, size_t n) {
+  RedJob j = {.a = v->dim, .k = 3};
+  red_bounds(&j, n);
+  return vec3_init(j.lower[0], j.lower[1], j.lower[2]);
+}
+
+/// vec3_max_array ///
+// Description
+//   Finds the componentwise maximum of an array of packed vectors in the
+//   IEEE 754 total order.
+// Arguments
+//   v: packed vectors (Vec3p*)
+//   n: count (size_t)
+// Returns
+//   vector (Vec3), or zero if n is 0
+
+sol_inline
+Vec3 vec3_max_array(const Vec3p *v, size_t n) {
+  RedJob j = {.a = v->dim, .k = 3};
+  red_bounds(&j, n);
+  return vec3_init(j.upper[0], j.upper[1], j.upper[2]);
+}
+
+/// vec3_bounds_array ///
+// Description
+//   Finds the axis-aligned bounding box of an array of packed vectors in one
+//   pass.
+// Arguments
+//   v: packed vectors (Vec3p*)
+//   n: count (size_t)
+// Returns
+//   box (Box3) {min(v), max(v)}, or zero if n is 0
+
+sol_inline
+Box3 vec3_bounds_array(const Vec3p *v, size_t n) {
+  RedJob j = {.a = v->dim, .k = 3};
+  red_bounds(&j, n);
+  Box3 out;
+  out.lower = vec3_init(j.lower[0], j.lower[1], j.lower[2]);
+  out.upper = vec3_init(j.upper[0], j.upper[1], j.upper[2]);
+  return out;
+}
@@ -0,0 +1,434 @@
+    /////////////////////////////////////////////////////////////////
+   // sol_sap.c ////////////////////////////////////////////////////
+  // Description: Adds a sweep-and-prune broadphase to Sol. ///////
+ // Author: David Garland (https://github.com/davidgarland/sol) //
+/////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Local Headers /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include "../sol.h"
+#include "sol_simd.h"
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Standard Headers //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Sweep-and-Prune Types /////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// The engine keeps one entry per box, ordered by the lower bound on the sweep
+// axis. Frames reuse the order of the last one: with coherent motion only a
+// few neighbours trade places, which insertion sort fixes in close to linear
+// time. The first frame, a change in box count, a change of sweep axis, or an
+// order shuffled by more than SAP_MOVES moves per box fall back to a radix
+// sort. The sorted boxes are then copied out as columns padded by SIMD_LANES,
+// so the sweep reads candidates a register at a time, and the sweep is split
+// into SAP_SLICES slices that fill their own pair buffers in parallel.
+
+#define SAP_MOVES 8 // Insertion sort moves per box before giving up.
+#define SAP_SWITCH 2 // Spread ratio needed to move the sweep axis.
+#define SAP_SLICES 64
+
+typedef struct {
+  Float lo, hi; // Sweep axis.
+  Float lo1, hi1, lo2, hi2; // The other two axes.
+  size_t id;
+} SapBox;
+
+#if SOL_F_SIZE > 32
+typedef uint64_t SapKey;
+#else
+typedef uint32_t SapKey;
+#endif
+
+typedef struct {
+  SapKey key;
+  size_t id;
+} SapRank;
+
+typedef struct {
+  SolPair *pair;
+  size_t len, cap;
+  bool fail;
+} SapSlice;
+
+struct type_sap {
+  SapBox *box;
+  SapRank *rank, *rank_tmp;
+  Float *col; // lo, lo1, hi1, lo2, hi2 columns of cap + SIMD_LANES each.
+  size_t len, cap;
+  size_t axis;
+  SolPair *pair;
+  size_t pair_len, pair_cap;
+  SapSlice slice[SAP_SLICES];
+};
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Sweep-and-Prune Helpers ///////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Maps a float to an unsigned integer with the same order, for radix sorting.
+// Wider floats go through double; rounding keeps the order but may tie keys
+// that were distinct, which the insertion pass after the radix sort fixes.
+
+static inline
+SapKey sap_key(Float f) {
+  #if SOL_F_SIZE > 32
+        const double d = (double) f;
+        uint64_t u;
+        memcpy(&u, &d, sizeof(u));
+        return u ^ ((uint64_t) -(int64_t) (u >> 63) | (UINT64_C(1) << 63));
+  #else
+        const float g = (float) f;
+        uint32_t u;
+        memcpy(&u, &g, sizeof(u));
+        return u ^ ((uint32_t) -(int32_t) (u >> 31) | (UINT32_C(1) << 31));
+  #endif
+}
+
+// Picks the axis along which the box centres are most spread out, which
+// leaves the fewest boxes overlapping on it. Centres are taken relative to
+// the first one so that scenes far from the origin keep their precision.
+
+static
+void sap_spread(const Box3 *boxes, size_t n, Float var[3]) {
+  Float sum[3] = {0, 0, 0};
+  Float sq[3] = {0, 0, 0};
+  for (size_t a = 0; a < 3; a++) {
+    const Float o = boxes[0].lower.dim[a] + boxes[0].upper.dim[a];
+    for (size_t i = 0; i < n; i++) {
+      const Float c = boxes[i].lower.dim[a] + boxes[i].upper.dim[a] - o;
+      sum[a] += c;
+      sq[a] += c * c;
+    }
+    var[a] = sq[a] - sum[a] * sum[a] / (Float) n;
+  }
+}
+
+static inline
+size_t sap_widest(const Float var[3]) {
+  size_t a = var[1] > var[0];
+  return var[2] > var[a] ? 2 : a;
+}
+
+static inline
+void sap_load_box(SapBox *b, const Box3 *box, size_t axis) {
+  const size_t a1 = axis == 0 ? 1 : 0;
+  const size_t a2 = axis == 2 ? 1 : 2;
+  b->lo = box->lower.dim[axis];
+  b->hi = box->upper.dim[axis];
+  b->lo1 = box->lower.dim[a1];
+  b->hi1 = box->upper.dim[a1];
+  b->lo2 = box->lower.dim[a2];
+  b->hi2 = box->upper.dim[a2];
+}
+
+// Grows every per-box array to hold n boxes; the contents are rebuilt by
+// sap_rebuild afterwards, so nothing needs to be kept.
+
+static
+bool sap_reserve(SolSap *s, size_t n) {
+  if (n <= s->cap)
+    return true;
+  free(s->box);
+  free(s->rank);
+  free(s->rank_tmp);
+  free(s->col);
+  s->box = malloc(n * sizeof(SapBox));
+  s->rank = malloc(n * sizeof(SapRank));
+  s->rank_tmp = malloc(n * sizeof(SapRank));
+  s->col = malloc(5 * (n + SIMD_LANES) * sizeof(Float));
+  if (!s->box || !s->rank || !s->rank_tmp || !s->col) {
+    free(s->box);
+    free(s->rank);
+    free(s->rank_tmp);
+    free(s->col);
+    s->box = NULL;
+    s->rank = s->rank_tmp = NULL;
+    s->col = NULL;
+    s->cap = 0;
+    return false;
+  }
+  s->cap = n;
+  return true;
+}
+
+// Insertion sort by lower bound, giving up once it has moved more than budget
+// entries. A failed pass leaves the entries half sorted, which the radix sort
+// that follows replaces anyway.
+
+static
+bool sap_insertion(SapBox *b, size_t n, size_t budget) {
+  size_t moves = 0;
+  for (size_t i = 1; i < n; i++) {
+    if (!(b[i].lo < b[i - 1].lo))
+      continue;
+    const SapBox t = b[i];
+    size_t j = i;
+    do {
+      b[j] = b[j - 1];
+      j--;
+      moves++;
+    } while (j > 0 && t.lo < b[j - 1].lo);
+    b[j] = t;
+    if (moves > budget)
+      return false;
+  }
+  return true;
+}
+
+// Sorts every box from scratch: an LSD radix sort of the lower bounds, a byte
+// per pass, skipping passes where every key has the same byte. The entries
+// are then loaded in sorted order.
+
+static
+void sap_rebuild(SolSap *s, const Box3 *boxes, size_t n) {
+  SapRank *r = s->rank;
+  SapRank *tmp = s->rank_tmp;
+  for (size_t i = 0; i < n; i++) {
+    r[i].key = sap_key(boxes[i].lower.dim[s->axis]);
+    r[i].id = i;
+  }
+  for (size_t shift = 0; shift < 8 * sizeof(SapKey); shift += 8) {
+    size_t count[256] = {0};
+    for (size_t i = 0; i < n; i++)
+      count[(r[i].key >> shift) & 255]++;
+    if (count[(r[0].key >> shift) & 255] == n)
+      continue;
+    size_t sum = 0;
+    for (size_t d = 0; d < 256; d++) {
+      const size_t c = count[d];
+      count[d] = sum;
+      sum += c;
+    }
+    for (size_t i = 0; i < n; i++)
+      tmp[count[(r[i].key >> shift) & 255]++] = r[i];
+    SapRank *swap = r;
+    r = tmp;
+    tmp = swap;
+  }
+  for (size_t i = 0; i < n; i++) {
+    s->box[i].id = r[i].id;
+    sap_load_box(&s->box[i], &boxes[r[i].id], s->axis);
+  }
+  #if SOL_F_SIZE > 64
+        sap_insertion(s->box, n, SIZE_MAX);
+  #endif
+}
+
+// Copies the sorted boxes out as columns. The padding sorts after every box,
+// so a register read past the end never reports a hit.
+
+static
+void sap_columns(SolSap *s) {
+  const size_t n = s->len, m = n + SIMD_LANES;
+  Float *lo = s->col, *lo1 = lo + m, *hi1 = lo1 + m, *lo2 = hi1 + m, *hi2 = lo2 + m;
+  for (size_t i = 0; i < n; i++) {
+    lo[i] = s->box[i].lo;
+    lo1[i] = s->box[i].lo1;
+    hi1[i] = s->box[i].hi1;
+    lo2[i] = s->box[i].lo2;
+    hi2[i] = s->box[i].hi2;
+  }
+  for (size_t i = n; i < m; i++) {
+    lo[i] = INFINITY;
+    lo1[i] = hi1[i] = lo2[i] = hi2[i] = 0;
+  }
+}
+
+static
+bool sap_emit(SapSlice *sl, size_t a, size_t b) {
+  if (sl->len == sl->cap) {
+    const size_t cap = sl->cap ? sl->cap * 2 : 64;
+    SolPair *pair = realloc(sl->pair, cap * sizeof(SolPair));
+    if (!pair)
+      return false;
+    sl->pair = pair;
+    sl->cap = cap;
+  }
+  SolPair *p = &sl->pair[sl->len++];
+  p->a = a < b ? a : b;
+  p->b = a < b ? b : a;
+  return true;
+}
+
+// Sweeps the boxes of one slice. Every box overlapping box i on the sweep
+// axis comes after it and starts before its upper bound, so candidates are
+// read from i + 1 until one starts past it, and tested on the other two axes,
+// SIMD_LANES candidates at a time with one mask bit per overlap.
+
+static
+void sap_sweep_task(void *ctx, size_t lo, size_t hi) {
+  SolSap *s = ctx;
+  const size_t n = s->len, m = n + SIMD_LANES;
+  const Float *clo = s->col, *clo1 = clo + m, *chi1 = clo1 + m;
+  const Float *clo2 = chi1 + m, *chi2 = clo2 + m;
+  for (size_t k = lo; k < hi; k++) {
+    SapSlice *sl = &s->slice[k];
+    const size_t end = n * (k + 1) / SAP_SLICES;
+    sl->len = 0;
+    sl->fail = false;
+    for (size_t i = n * k / SAP_SLICES; i < end && !sl->fail; i++) {
+      const SapBox p = s->box[i];
+      #if SIMD_LANES > 1
+            const SimdReg hi0 = simd_set1(p.hi);
+            const SimdReg lo1 = simd_set1(p.lo1), hi1 = simd_set1(p.hi1);
+            const SimdReg lo2 = simd_set1(p.lo2), hi2 = simd_set1(p.hi2);
+            const int full = (1 << SIMD_LANES) - 1;
+            int run = full;
+            for (size_t j = i + 1; run == full; j += SIMD_LANES) {
+              const SimdReg in = simd_le(simd_load(clo + j), hi0);
+              SimdReg hit = simd_and(simd_le(simd_load(clo1 + j), hi1), simd_le(lo1, simd_load(chi1 + j)));
+              hit = simd_and(hit, simd_and(simd_le(simd_load(clo2 + j), hi2), simd_le(lo2, simd_load(chi2 + j))));
+              int bits = simd_bits(simd_and(hit, in));
+              run = simd_bits(in);
+              for (size_t l = j; bits; l++, bits >>= 1)
+                if (bits & 1)
+                  sl->fail |= !sap_emit(sl, p.id, s->box[l].id);
+            }
+      #else
+            for (size_t j = i + 1; clo[j] <= p.hi; j++) {
+              const bool hit = (clo1[j] <= p.hi1) & (p.lo1 <= chi1[j])
+                             & (clo2[j] <= p.hi2) & (p.lo2 <= chi2[j]);
+              if (hit)
+                sl->fail |= !sap_emit(sl, p.id, s->box[j].id);
+            }
+      #endif
+    }
+  }
+}
+
+// Sweeps every slice, then gathers their pairs into one buffer.
+
+static
+bool sap_sweep(SolSap *s) {
+  sap_columns(s);
+  const size_t size = s->len / SAP_SLICES * 16 * sizeof(SapBox) + 1;
+  sol_parallel_for(SAP_SLICES, size, sap_sweep_task, s);
+  size_t total = 0;
+  for (size_t k = 0; k < SAP_SLICES; k++) {
+    if (s->slice[k].fail)
+      return false;
+    total += s->slice[k].len;
+  }
+  if (total > s->pair_cap) {
+    SolPair *pair = realloc(s->pair, total * sizeof(SolPair));
+    if (!pair)
+      return false;
+    s->pair = pair;
+    s->pair_cap = total;
+  }
+  for (size_t k = 0; k < SAP_SLICES; k++) {
+    if (!s->slice[k].len)
+      continue;
+    memcpy(s->pair + s->pair_len, s->slice[k].pair, s->slice[k].len * sizeof(SolPair));
+    s->pair_len += s->slice[k].len;
+  }
+  return true;
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Sweep-and-Prune Functions /////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+/// sol_sap_init ///
+// Description
+//   Creates an empty sweep-and-prune broadphase. Keep one per scene and call
+//   sol_sap_update every frame: buffers are only reallocated when the box
+//   count or the pair count grows past anything seen before.
+// Arguments
+//   void
+// Returns
+//   broadphase (SolSap*), or NULL if allocation fails
+
+sol_inline
+SolSap *sol_sap_init(void) {
+  return calloc(1, sizeof(SolSap));
+}
+
+/// sol_sap_free ///
+// Description
+//   Frees a broadphase and its pair buffer.
+// Arguments
+//   s: broadphase (SolSap*)
+// Returns
+//   void
+
+sol_inline
+void sol_sap_free(SolSap *s) {
+  if (!s)
+    return;
+  free(s->box);
+  free(s->rank);
+  free(s->rank_tmp);
+  free(s->col);
+  free(s->pair);
+  for (size_t k = 0; k < SAP_SLICES; k++)
+    free(s->slice[k].pair);
+  free(s);
+}
+
+/// sol_sap_update ///
+// Description
+//   Finds every pair of overlapping boxes; boxes that only touch count as
+//   overlapping. The boxes are swept along the axis their centres are most
+//   spread out on, and the order from the previous call is reused, so the
+//   cost is close to linear while the boxes move coherently and keep their
+//   count and index. Each pair is reported once with a < b, in no particular
+//   order, and is valid until the next update.
+// Arguments
+//   s: broadphase (SolSap*)
+//   boxes: bounding boxes (Box3*)
+//   n: box count (size_t)
+// Returns
+//   pair count (size_t), or SIZE_MAX if allocation fails
+
+sol_inline
+size_t sol_sap_update(SolSap *s, const Box3 *boxes, size_t n) {
+  s->pair_len = 0;
+  if (n < 2) {
+    s->len = n;
+    return 0;
+  }
+  Float var[3];
+  sap_spread(boxes, n, var);
+  const size_t best = sap_widest(var);
+  bool sorted = false;
+  if (n == s->len && var[best] <= SAP_SWITCH * var[s->axis]) {
+    for (size_t i = 0; i < n; i++)
+      sap_load_box(&s->box[i], &boxes[s->box[i].id], s->axis);
+    sorted = sap_insertion(s->box, n, SAP_MOVES * n);
+  } else {
+    s->axis = best;
+  }
+  if (!sorted) {
+    s->len = 0;
+    if (!sap_reserve(s, n))
+      return SIZE_MAX;
+    sap_rebuild(s, boxes, n);
+    s->len = n;
+  }
+  return sap_sweep(s) ? s->pair_len : SIZE_MAX;
+}
+
+/// sol_sap_pairs ///
+// Description
+//   Returns the pairs found by the last call to sol_sap_update.
+// Arguments
+//   s: broadphase (SolSap*)
+// Returns
+//   pairs (SolPair*), as many as the last update returned
+
+sol_inline
+const SolPair *sol_sap_pairs(const SolSap *s) {
+  return s->pair;
+}
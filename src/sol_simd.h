@@ -0,0 +1,165 @@
+    /////////////////////////////////////////////////////////////////
+   // sol_simd.h ///////////////////////////////////////////////////
+  // Description: Float-width SIMD registers for Sol's kernels. ///
+ // Author: David Garland (https://github.com/davidgarland/sol) //
+/////////////////////////////////////////////////////////////////
+
+// An internal header for the batch kernels, included after sol.h. SimdReg is
+// one register of SIMD_LANES Floats in the widest tier the default family
+// has: __m256d or __m256 with AVX, __m128d or __m128 with SSE. Without one,
+// SIMD_LANES is 1 and SimdReg is a plain Float, so kernels written against
+// the arithmetic and compare macros still compile as scalar loops; the
+// bitwise macros exist only when SIMD_LANES > 1.
+//
+// Compares give a SimdMask, all ones or all zeros per lane. simd_bits packs
+// a mask into an int, one bit per lane, and simd_sel(m, a, b) takes a where
+// m is set and b elsewhere. simd_rsqrt is 1 / sqrt(a): exact for doubles,
+// and the hardware estimate refined by one Newton step for floats, which
+// lands within a few ulps.
+
+#ifndef SOL_SIMD_H
+#define SOL_SIMD_H
+
+#if defined(SOL_AVX_64)
+      #define SIMD_LANES 4
+      typedef __m256d SimdReg;
+      typedef SimdReg SimdMask;
+      #define simd_load _mm256_loadu_pd
+      #define simd_store _mm256_storeu_pd
+      #define simd_set1 _mm256_set1_pd
+      #define simd_zero _mm256_setzero_pd
+      #define simd_add _mm256_add_pd
+      #define simd_sub _mm256_sub_pd
+      #define simd_mul _mm256_mul_pd
+      #define simd_div _mm256_div_pd
+      #define simd_sqrt _mm256_sqrt_pd
+      #define simd_rsqrt(a) _mm256_div_pd(_mm256_set1_pd(1), _mm256_sqrt_pd(a))
+      #define simd_min _mm256_min_pd
+      #define simd_max _mm256_max_pd
+      #define simd_abs(a) _mm256_andnot_pd(_mm256_set1_pd(-0.0), a)
+      #define simd_and _mm256_and_pd
+      #define simd_or _mm256_or_pd
+      #define simd_xor _mm256_xor_pd
+      #define simd_andnot _mm256_andnot_pd
+      #define simd_le(a, b) _mm256_cmp_pd(a, b, _CMP_LE_OQ)
+      #define simd_lt(a, b) _mm256_cmp_pd(a, b, _CMP_LT_OQ)
+      #define simd_gt(a, b) _mm256_cmp_pd(a, b, _CMP_GT_OQ)
+      #define simd_bits _mm256_movemask_pd
+#elif defined(SOL_AVX) && defined(SOL_SSE_32)
+      #define SIMD_LANES 8
+      typedef __m256 SimdReg;
+      typedef SimdReg SimdMask;
+      #define simd_load _mm256_loadu_ps
+      #define simd_store _mm256_storeu_ps
+      #define simd_set1 _mm256_set1_ps
+      #define simd_zero _mm256_setzero_ps
+      #define simd_add _mm256_add_ps
+      #define simd_sub _mm256_sub_ps
+      #define simd_mul _mm256_mul_ps
+      #define simd_div _mm256_div_ps
+      #define simd_sqrt _mm256_sqrt_ps
+      #define simd_rsqrt_est _mm256_rsqrt_ps
+      #define simd_min _mm256_min_ps
+      #define simd_max _mm256_max_ps
+      #define simd_abs(a) _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a)
+      #define simd_and _mm256_and_ps
+      #define simd_or _mm256_or_ps
+      #define simd_xor _mm256_xor_ps
+      #define simd_andnot _mm256_andnot_ps
+      #define simd_le(a, b) _mm256_cmp_ps(a, b, _CMP_LE_OQ)
+      #define simd_lt(a, b) _mm256_cmp_ps(a, b, _CMP_LT_OQ)
+      #define simd_gt(a, b) _mm256_cmp_ps(a, b, _CMP_GT_OQ)
+      #define simd_bits _mm256_movemask_ps
+#elif defined(SOL_SSE_64)
+      #define SIMD_LANES 2
+      typedef __m128d SimdReg;
+      typedef SimdReg SimdMask;
+      #define simd_load _mm_loadu_pd
+      #define simd_store _mm_storeu_pd
+      #define simd_set1 _mm_set1_pd
+      #define simd_zero _mm_setzero_pd
+      #define simd_add _mm_add_pd
+      #define simd_sub _mm_sub_pd
+      #define simd_mul _mm_mul_pd
+      #define simd_div _mm_div_pd
+      #define simd_sqrt _mm_sqrt_pd
+      #define simd_rsqrt(a) _mm_div_pd(_mm_set1_pd(1), _mm_sqrt_pd(a))
+      #define simd_min _mm_min_pd
+      #define simd_max _mm_max_pd
+      #define simd_abs(a) _mm_andnot_pd(_mm_set1_pd(-0.0), a)
+      #define simd_and _mm_and_pd
+      #define simd_or _mm_or_pd
+      #define simd_xor _mm_xor_pd
+      #define simd_andnot _mm_andnot_pd
+      #define simd_le _mm_cmple_pd
+      #define simd_lt _mm_cmplt_pd
+      #define simd_gt _mm_cmpgt_pd
+      #define simd_bits _mm_movemask_pd
+#elif defined(SOL_SSE_32)
+      #define SIMD_LANES 4
+      typedef __m128 SimdReg;
+      typedef SimdReg SimdMask;
+      #define simd_load _mm_loadu_ps
+      #define simd_store _mm_storeu_ps
+      #define simd_set1 _mm_set1_ps
+      #define simd_zero _mm_setzero_ps
+      #define simd_add _mm_add_ps
+      #define simd_sub _mm_sub_ps
+      #define simd_mul _mm_mul_ps
+      #define simd_div _mm_div_ps
+      #define simd_sqrt _mm_sqrt_ps
+      #define simd_rsqrt_est _mm_rsqrt_ps
+      #define simd_min _mm_min_ps
+      #define simd_max _mm_max_ps
+      #define simd_abs(a) _mm_andnot_ps(_mm_set1_ps(-0.0f), a)
+      #define simd_and _mm_and_ps
+      #define simd_or _mm_or_ps
+      #define simd_xor _mm_xor_ps
+      #define simd_andnot _mm_andnot_ps
+      #define simd_le _mm_cmple_ps
+      #define simd_lt _mm_cmplt_ps
+      #define simd_gt _mm_cmpgt_ps
+      #define simd_bits _mm_movemask_ps
+#else
+      #define SIMD_LANES 1
+      typedef Float SimdReg;
+      typedef bool SimdMask;
+      #define simd_load(p) (*(p))
+      #define simd_store(p, a) (*(p) = (a))
+      #define simd_set1(a) ((Float) (a))
+      #define simd_zero() ((Float) 0)
+      #define simd_add(a, b) ((a) + (b))
+      #define simd_sub(a, b) ((a) - (b))
+      #define simd_mul(a, b) ((a) * (b))
+      #define simd_div(a, b) ((a) / (b))
+      #define simd_sqrt flt_sqrt
+      #define simd_rsqrt(a) (1 / flt_sqrt(a))
+      #define simd_min(a, b) ((a) < (b) ? (a) : (b))
+      #define simd_max(a, b) ((a) > (b) ? (a) : (b))
+      #define simd_abs(a) ((a) < 0 ? -(a) : (a))
+      #define simd_le(a, b) ((a) <= (b))
+      #define simd_lt(a, b) ((a) < (b))
+      #define simd_gt(a, b) ((a) > (b))
+      #define simd_bits(m) ((int) (m))
+#endif
+
+#if SIMD_LANES > 1
+      #define simd_sel(m, a, b) simd_or(simd_and(m, a), simd_andnot(m, b))
+      #define simd_all(m) (simd_bits(m) == (1 << SIMD_LANES) - 1)
+#else
+      #define simd_sel(m, a, b) ((m) ? (a) : (b))
+      #define simd_all(m) (m)
+#endif
+
+#if defined(simd_rsqrt_est)
+      #define simd_rsqrt(a) simd_rsqrt_nr(a)
+
+      static inline
+      SimdReg simd_rsqrt_nr(SimdReg a) {
+        const SimdReg y = simd_rsqrt_est(a);
+        const SimdReg h = simd_mul(simd_mul(simd_set1(0.5f), a), simd_mul(y, y));
+        return simd_mul(y, simd_sub(simd_set1(1.5f), h));
+      }
+#endif
+
+#endif
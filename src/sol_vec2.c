@@ -36,10 +36,10 @@
 sol_inline
 Vec2 vec2_init(Float x, Float y) {
   Vec2 out;
-  #if defined(SOL_AVX_64)
-        out.vec = _mm_set_pd(x, y);
-  #elif defined(SOL_AVX)
-        out.vec = _mm_set_ps(x, y, 0, 0);
+  #if defined(SOL_SSE_64)
+        out.vec = _mm_set_pd(y, x);
+  #elif defined(SOL_SSE_32)
+        out.vec = _mm_set_ps(0, 0, y, x);
   #else
         out.x = x;
         out.y = y;
@@ -58,9 +58,9 @@ Vec2 vec2_init(Float x, Float y) {
 sol_inline
 Vec2 vec2_initf(Float f) {
   Vec2 out;
-  #if defined(SOL_AVX_64)
+  #if defined(SOL_SSE_64)
         out.vec = _mm_set1_pd(f);
-  #elif defined(SOL_AVX)
+  #elif defined(SOL_SSE_32)
         out.vec = _mm_set1_ps(f);
   #elif defined(SOL_NEON_64)
         out.vec = vdup_n_f64(f);
@@ -99,7 +99,7 @@ Vec2 vec2_zero(void) {
 
 sol_inline
 Vec2 vec2_norm(Vec2 v) {
-  return vec2_divf(v, vec2_mag(v));
+  return vec2_mulf(v, 1 / vec2_mag(v));
 }
 
 /// vec2_mag ///
@@ -166,8 +166,14 @@ Float vec2_cross(Vec2 a, Vec2 b) {
 
 sol_inline
 Float vec2_dot(Vec2 a, Vec2 b) {
-  const Vec2 out = vec2_mul(a, b);
-  return out.x + out.y;
+  #if defined(SOL_SSE_64) && defined(SOL_SSE41)
+        return _mm_cvtsd_f64(_mm_dp_pd(a.vec, b.vec, 0x31));
+  #elif defined(SOL_SSE_32) && defined(SOL_SSE41)
+        return _mm_cvtss_f32(_mm_dp_ps(a.vec, b.vec, 0x31));
+  #else
+        const Vec2 out = vec2_mul(a, b);
+        return out.x + out.y;
+  #endif
 }
 
   //////////////////////////////////////////////////////////////////////////////
@@ -199,9 +205,9 @@ Float vec2_sum(Vec2 v) {
 sol_inline
 Vec2 vec2_add(Vec2 a, Vec2 b) {
   Vec2 out;
-  #if defined(SOL_AVX_64)
+  #if defined(SOL_SSE_64)
         out.vec = _mm_add_pd(a.vec, b.vec);
-  #elif defined(SOL_AVX)
+  #elif defined(SOL_SSE_32)
         out.vec = _mm_add_ps(a.vec, b.vec);
   #elif defined(SOL_NEON_64)
         out.vec = vadd_f64(a.vec, b.vec);
@@ -240,9 +246,9 @@ Vec2 vec2_addf(Vec2 v, Float f) {
 sol_inline
 Vec2 vec2_sub(Vec2 a, Vec2 b) {
   Vec2 out;
-  #if defined(SOL_AVX_64)
+  #if defined(SOL_SSE_64)
         out.vec = _mm_sub_pd(a.vec, b.vec);
-  #elif defined(SOL_AVX)
+  #elif defined(SOL_SSE_32)
         out.vec = _mm_sub_ps(a.vec, b.vec);
   #elif defined(SOL_NEON_64)
         out.vec = vsub_f64(a.vec, b.vec);
@@ -295,9 +301,9 @@ Vec2 vec2_fsub(Float f, Vec2 v) {
 sol_inline
 Vec2 vec2_mul(Vec2 a, Vec2 b) {
   Vec2 out;
-  #if defined(SOL_AVX_64)
+  #if defined(SOL_SSE_64)
         out.vec = _mm_mul_pd(a.vec, b.vec);
-  #elif defined(SOL_AVX)
+  #elif defined(SOL_SSE_32)
         out.vec = _mm_mul_ps(a.vec, b.vec);
   #elif defined(SOL_NEON_64)
         out.vec = vmul_f64(a.vec, b.vec);
@@ -336,8 +342,14 @@ Vec2 vec2_mulf(Vec2 v, Float f) {
 sol_inline
 Vec2 vec2_div(Vec2 a, Vec2 b) {
   Vec2 out;
-  out.x = a.x / b.x;
-  out.y = a.y / b.y;
+  #if defined(SOL_SSE_64)
+        out.vec = _mm_div_pd(a.vec, b.vec);
+  #elif defined(SOL_SSE_32)
+        out.vec = _mm_div_ps(a.vec, b.vec);
+  #else
+        out.x = a.x / b.x;
+        out.y = a.y / b.y;
+  #endif
   return out;
 }
 
@@ -380,7 +392,7 @@ Vec2 vec2_fdiv(Float f, Vec2 v) {
 
 sol_inline
 Vec2 vec2_avg(Vec2 a, Vec2 b) {
-  return vec2_divf(vec2_add(a, b), 2);
+  return vec2_mulf(vec2_add(a, b), 0.5);
 }
 
 /// vec2_avgf ///
@@ -397,6 +409,154 @@ Vec2 vec2_avgf(Vec2 v, Float f) {
   return vec2_avg(v, vec2_initf(f));
 }
 
+  //////////////////////////////////////////////////////////////////////////////
+ // Vec2 Fused Math ///////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+/// vec2_fma ///
+// Description
+//   Multiplies two vectors and adds a third. With SOL_FMA the product isn't
+//   rounded before the addition.
+// Arguments
+//   a: vector (Vec2)
+//   b: vector (Vec2)
+//   c: vector (Vec2)
+// Returns
+//   vector (Vec2) {a.xy * b.xy + c.xy}
+
+sol_inline
+Vec2 vec2_fma(Vec2 a, Vec2 b, Vec2 c) {
+  Vec2 out;
+  #if defined(SOL_FMA) && defined(SOL_SSE_64)
+        out.vec = _mm_fmadd_pd(a.vec, b.vec, c.vec);
+  #elif defined(SOL_FMA) && defined(SOL_SSE_32)
+        out.vec = _mm_fmadd_ps(a.vec, b.vec, c.vec);
+  #elif defined(SOL_FMA) && defined(SOL_NEON_64)
+        out.vec = vfma_f64(c.vec, a.vec, b.vec);
+  #elif defined(SOL_FMA) && defined(SOL_NEON)
+        out.vec = vfma_f32(c.vec, a.vec, b.vec);
+  #else
+        out = vec2_add(vec2_mul(a, b), c);
+  #endif
+  return out;
+}
+
+/// vec2_fmaf ///
+// Description
+//   Multiplies a vector by a scalar and adds another vector.
+// Arguments
+//   a: vector (Vec2)
+//   f: scalar (Float)
+//   b: vector (Vec2)
+// Returns
+//   vector (Vec2) {a.xy * f + b.xy}
+
+sol_inline
+Vec2 vec2_fmaf(Vec2 a, Float f, Vec2 b) {
+  return vec2_fma(a, vec2_initf(f), b);
+}
+
+/// vec2_madd ///
+// Description
+//   Adds a vector scaled by a scalar onto another, as in a += b * f.
+// Arguments
+//   a: vector (Vec2)
+//   b: vector (Vec2)
+//   f: scalar (Float)
+// Returns
+//   vector (Vec2) {a.xy + b.xy * f}
+
+sol_inline
+Vec2 vec2_madd(Vec2 a, Vec2 b, Float f) {
+  return vec2_fma(b, vec2_initf(f), a);
+}
+
+/// vec2_lerp ///
+// Description
+//   Linearly interpolates between two vectors.
+// Arguments
+//   a: vector (Vec2)
+//   b: vector (Vec2)
+//   t: scalar (Float)
+// Returns
+//   vector (Vec2) {a.xy + (b.xy - a.xy) * t}
+
+sol_inline
+Vec2 vec2_lerp(Vec2 a, Vec2 b, Float t) {
+  return vec2_fma(vec2_sub(b, a), vec2_initf(t), a);
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Vec2 Rounding /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+/// vec2_floor ///
+// Description
+//   Rounds each element of a vector down to an integer.
+// Arguments
+//   v: vector (Vec2)
+// Returns
+//   vector (Vec2) {floor(v.xy)}
+
+sol_inline
+Vec2 vec2_floor(Vec2 v) {
+  Vec2 out;
+  #if defined(SOL_SSE_64) && defined(SOL_SSE41)
+        out.vec = _mm_floor_pd(v.vec);
+  #elif defined(SOL_SSE_32) && defined(SOL_SSE41)
+        out.vec = _mm_floor_ps(v.vec);
+  #else
+        out.x = flt_floor(v.x);
+        out.y = flt_floor(v.y);
+  #endif
+  return out;
+}
+
+/// vec2_ceil ///
+// Description
+//   Rounds each element of a vector up to an integer.
+// Arguments
+//   v: vector (Vec2)
+// Returns
+//   vector (Vec2) {ceil(v.xy)}
+
+sol_inline
+Vec2 vec2_ceil(Vec2 v) {
+  Vec2 out;
+  #if defined(SOL_SSE_64) && defined(SOL_SSE41)
+        out.vec = _mm_ceil_pd(v.vec);
+  #elif defined(SOL_SSE_32) && defined(SOL_SSE41)
+        out.vec = _mm_ceil_ps(v.vec);
+  #else
+        out.x = flt_ceil(v.x);
+        out.y = flt_ceil(v.y);
+  #endif
+  return out;
+}
+
+/// vec2_round ///
+// Description
+//   Rounds each element of a vector to the nearest integer, with halfway
+//   cases going to the even neighbour.
+// Arguments
+//   v: vector (Vec2)
+// Returns
+//   vector (Vec2) {round(v.xy)}
+
+sol_inline
+Vec2 vec2_round(Vec2 v) {
+  Vec2 out;
+  #if defined(SOL_SSE_64) && defined(SOL_SSE41)
+        out.vec = _mm_round_pd(v.vec, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+  #elif defined(SOL_SSE_32) && defined(SOL_SSE41)
+        out.vec = _mm_round_ps(v.vec, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+  #else
+        out.x = flt_round(v.x);
+        out.y = flt_round(v.y);
+  #endif
+  return out;
+}
+
   //////////////////////////////////////////////////////////////////////////////
  // Vec2 Terminal IO //////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
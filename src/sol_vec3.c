@@ -38,9 +38,9 @@ sol_inline
 Vec3 vec3_init(Float x, Float y, Float z) {
   Vec3 out;
   #if defined(SOL_AVX_64)
-        out.vec = _mm256_set_pd(x, y, z, 0);
-  #elif defined(SOL_AVX)
-        out.vec = _mm_set_ps(x, y, z, 0);
+        out.vec = _mm256_set_pd(0, z, y, x);
+  #elif defined(SOL_SSE_32)
+        out.vec = _mm_set_ps(0, z, y, x);
   #else
         out.x = x;
         out.y = y;
@@ -62,7 +62,7 @@ Vec3 vec3_initf(Float f) {
   Vec3 out;
   #if defined(SOL_AVX_64)
         out.vec = _mm256_set1_pd(f);
-  #elif defined(SOL_AVX)
+  #elif defined(SOL_SSE_32)
         out.vec = _mm_set1_ps(f);
   #elif defined(SOL_NEON_64)
         out.vec = vdupq_n_f64(f);
@@ -101,7 +101,7 @@ Vec3 vec3_zero(void) {
 
 sol_inline
 Vec3 vec3_norm(Vec3 v) {
-  return vec3_divf(v, vec3_mag(v));
+  return vec3_mulf(v, 1 / vec3_mag(v));
 }
 
 /// vec3_mag ///
@@ -132,9 +132,9 @@ Float vec3_mag(Vec3 v) {
 
 sol_inline
 Vec3 vec3_rot(Vec3 v, Vec4 q) {
-  Vec3 qv = vec3_init(q.x, q.y, q.z);
-  Vec3 t = vec3_mulf(vec3_cross(qv, v), 2);
-  return vec3_add(v, vec3_add(vec3_mulf(t, q.w), vec3_cross(qv, t)));
+  const Vec3 qv = vec3_init(q.x, q.y, q.z);
+  const Vec3 t = vec3_mulf(vec3_cross(qv, v), 2);
+  return vec3_add(vec3_fmaf(t, q.w, v), vec3_cross(qv, t));
 }
 
   //////////////////////////////////////////////////////////////////////////////
@@ -152,9 +152,23 @@ Vec3 vec3_rot(Vec3 v, Vec4 q) {
 
 sol_inline
 Vec3 vec3_cross(Vec3 a, Vec3 b) {
-  return vec3_init((a.y * b.z) - (a.z * b.y),
-                   (a.z * b.x) - (a.x * b.z),
-                   (a.x * b.y) - (a.y * b.x));
+  #if defined(SOL_SSE_32)
+        // a * b.yzx - a.yzx * b gives the cross product in ZXY order.
+        const __m128 a_yzx = _mm_shuffle_ps(a.vec, a.vec, _MM_SHUFFLE(3, 0, 2, 1));
+        const __m128 b_yzx = _mm_shuffle_ps(b.vec, b.vec, _MM_SHUFFLE(3, 0, 2, 1));
+        #if defined(SOL_FMA)
+              const __m128 c = _mm_fmsub_ps(a.vec, b_yzx, _mm_mul_ps(a_yzx, b.vec));
+        #else
+              const __m128 c = _mm_sub_ps(_mm_mul_ps(a.vec, b_yzx), _mm_mul_ps(a_yzx, b.vec));
+        #endif
+        Vec3 out;
+        out.vec = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+        return out;
+  #else
+        return vec3_init((a.y * b.z) - (a.z * b.y),
+                         (a.z * b.x) - (a.x * b.z),
+                         (a.x * b.y) - (a.y * b.x));
+  #endif
 }
 
 /// vec3_dot ///
@@ -168,7 +182,11 @@ Vec3 vec3_cross(Vec3 a, Vec3 b) {
 
 sol_inline
 Float vec3_dot(Vec3 a, Vec3 b) {
-  return vec3_sum(vec3_mul(a, b));
+  #if defined(SOL_SSE_32) && defined(SOL_SSE41)
+        return _mm_cvtss_f32(_mm_dp_ps(a.vec, b.vec, 0x71));
+  #else
+        return vec3_sum(vec3_mul(a, b));
+  #endif
 }
 
   //////////////////////////////////////////////////////////////////////////////
@@ -202,7 +220,7 @@ Vec3 vec3_add(Vec3 a, Vec3 b) {
   Vec3 out;
   #if defined(SOL_AVX_64)
         out.vec = _mm256_add_pd(a.vec, b.vec);
-  #elif defined(SOL_AVX)
+  #elif defined(SOL_SSE_32)
         out.vec = _mm_add_ps(a.vec, b.vec);
   #elif defined(SOL_NEON_64)
         out.vec = vaddq_f64(a.vec, b.vec);
@@ -243,9 +261,9 @@ sol_inline
 Vec3 vec3_sub(Vec3 a, Vec3 b) {
   Vec3 out;
   #if defined(SOL_AVX_64)
-        out.vec = _mm256_add_pd(a.vec, b.vec);
-  #elif defined(SOL_AVX)
-        out.vec = _mm_add_ps(a.vec, b.vec);
+        out.vec = _mm256_sub_pd(a.vec, b.vec);
+  #elif defined(SOL_SSE_32)
+        out.vec = _mm_sub_ps(a.vec, b.vec);
   #elif defined(SOL_NEON_64)
         out.vec = vsubq_f64(a.vec, b.vec);
   #elif defined(SOL_NEON)
@@ -299,9 +317,9 @@ sol_inline
 Vec3 vec3_mul(Vec3 a, Vec3 b) {
   Vec3 out;
   #if defined(SOL_AVX_64)
-        out.vec = _mm256_add_pd(a.vec, b.vec);
-  #elif defined(SOL_AVX)
-        out.vec = _mm_add_ps(a.vec, b.vec);
+        out.vec = _mm256_mul_pd(a.vec, b.vec);
+  #elif defined(SOL_SSE_32)
+        out.vec = _mm_mul_ps(a.vec, b.vec);
   #elif defined(SOL_NEON_64)
         out.vec = vmulq_f64(a.vec, b.vec);
   #elif defined(SOL_NEON)
@@ -340,9 +358,15 @@ Vec3 vec3_mulf(Vec3 v, Float f) {
 sol_inline
 Vec3 vec3_div(Vec3 a, Vec3 b) {
   Vec3 out;
-  out.x = a.x / b.x;
-  out.y = a.y / b.y;
-  out.z = a.z / b.z;
+  #if defined(SOL_AVX_64)
+        out.vec = _mm256_div_pd(a.vec, b.vec);
+  #elif defined(SOL_SSE_32)
+        out.vec = _mm_div_ps(a.vec, b.vec);
+  #else
+        out.x = a.x / b.x;
+        out.y = a.y / b.y;
+        out.z = a.z / b.z;
+  #endif
   return out;
 }
 
@@ -385,7 +409,7 @@ Vec3 vec3_fdiv(Float f, Vec3 v) {
 
 sol_inline
 Vec3 vec3_avg(Vec3 a, Vec3 b) {
-  return vec3_divf(vec3_add(a, b), 2);
+  return vec3_mulf(vec3_add(a, b), 0.5);
 }
 
 /// vec3_avgf ///
@@ -402,6 +426,157 @@ Vec3 vec3_avgf(Vec3 v, Float f) {
   return vec3_avg(v, vec3_initf(f));
 }
 
+  //////////////////////////////////////////////////////////////////////////////
+ // Vec3 Fused Math ///////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+/// vec3_fma ///
+// Description
+//   Multiplies two vectors and adds a third. With SOL_FMA the product isn't
+//   rounded before the addition.
+// Arguments
+//   a: vector (Vec3)
+//   b: vector (Vec3)
+//   c: vector (Vec3)
+// Returns
+//   vector (Vec3) {a.xyz * b.xyz + c.xyz}
+
+sol_inline
+Vec3 vec3_fma(Vec3 a, Vec3 b, Vec3 c) {
+  Vec3 out;
+  #if defined(SOL_FMA) && defined(SOL_AVX_64)
+        out.vec = _mm256_fmadd_pd(a.vec, b.vec, c.vec);
+  #elif defined(SOL_FMA) && defined(SOL_SSE_32)
+        out.vec = _mm_fmadd_ps(a.vec, b.vec, c.vec);
+  #elif defined(SOL_FMA) && defined(SOL_NEON_64)
+        out.vec = vfmaq_f64(c.vec, a.vec, b.vec);
+  #elif defined(SOL_FMA) && defined(SOL_NEON)
+        out.vec = vfmaq_f32(c.vec, a.vec, b.vec);
+  #else
+        out = vec3_add(vec3_mul(a, b), c);
+  #endif
+  return out;
+}
+
+/// vec3_fmaf ///
+// Description
+//   Multiplies a vector by a scalar and adds another vector.
+// Arguments
+//   a: vector (Vec3)
+//   f: scalar (Float)
+//   b: vector (Vec3)
+// Returns
+//   vector (Vec3) {a.xyz * f + b.xyz}
+
+sol_inline
+Vec3 vec3_fmaf(Vec3 a, Float f, Vec3 b) {
+  return vec3_fma(a, vec3_initf(f), b);
+}
+
+/// vec3_madd ///
+// Description
+//   Adds a vector scaled by a scalar onto another, as in a += b * f.
+// Arguments
+//   a: vector (Vec3)
+//   b: vector (Vec3)
+//   f: scalar (Float)
+// Returns
+//   vector (Vec3) {a.xyz + b.xyz * f}
+
+sol_inline
+Vec3 vec3_madd(Vec3 a, Vec3 b, Float f) {
+  return vec3_fma(b, vec3_initf(f), a);
+}
+
+/// vec3_lerp ///
+// Description
+//   Linearly interpolates between two vectors.
+// Arguments
+//   a: vector (Vec3)
+//   b: vector (Vec3)
+//   t: scalar (Float)
+// Returns
+//   vector (Vec3) {a.xyz + (b.xyz - a.xyz) * t}
+
+sol_inline
+Vec3 vec3_lerp(Vec3 a, Vec3 b, Float t) {
+  return vec3_fma(vec3_sub(b, a), vec3_initf(t), a);
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Vec3 Rounding /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+/// vec3_floor ///
+// Description
+//   Rounds each element of a vector down to an integer.
+// Arguments
+//   v: vector (Vec3)
+// Returns
+//   vector (Vec3) {floor(v.xyz)}
+
+sol_inline
+Vec3 vec3_floor(Vec3 v) {
+  Vec3 out;
+  #if defined(SOL_AVX_64)
+        out.vec = _mm256_floor_pd(v.vec);
+  #elif defined(SOL_SSE_32) && defined(SOL_SSE41)
+        out.vec = _mm_floor_ps(v.vec);
+  #else
+        out.x = flt_floor(v.x);
+        out.y = flt_floor(v.y);
+        out.z = flt_floor(v.z);
+  #endif
+  return out;
+}
+
+/// vec3_ceil ///
+// Description
+//   Rounds each element of a vector up to an integer.
+// Arguments
+//   v: vector (Vec3)
+// Returns
+//   vector (Vec3) {ceil(v.xyz)}
+
+sol_inline
+Vec3 vec3_ceil(Vec3 v) {
+  Vec3 out;
+  #if defined(SOL_AVX_64)
+        out.vec = _mm256_ceil_pd(v.vec);
+  #elif defined(SOL_SSE_32) && defined(SOL_SSE41)
+        out.vec = _mm_ceil_ps(v.vec);
+  #else
+        out.x = flt_ceil(v.x);
+        out.y = flt_ceil(v.y);
+        out.z = flt_ceil(v.z);
+  #endif
+  return out;
+}
+
+/// vec3_round ///
+// Description
+//   Rounds each element of a vector to the nearest integer, with halfway
+//   cases going to the even neighbour.
+// Arguments
+//   v: vector (Vec3)
+// Returns
+//   vector (Vec3) {round(v.xyz)}
+
+sol_inline
+Vec3 vec3_round(Vec3 v) {
+  Vec3 out;
+  #if defined(SOL_AVX_64)
+        out.vec = _mm256_round_pd(v.vec, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+  #elif defined(SOL_SSE_32) && defined(SOL_SSE41)
+        out.vec = _mm_round_ps(v.vec, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+  #else
+        out.x = flt_round(v.x);
+        out.y = flt_round(v.y);
+        out.z = flt_round(v.z);
+  #endif
+  return out;
+}
+
   //////////////////////////////////////////////////////////////////////////////
  // Vec3 Terminal IO //////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
@@ -424,3 +599,720 @@ void vec3_print(Vec3 v) {
         printf("(%f, %f, %f)\n", v.x, v.y, v.z);
   #endif
 }
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Vec3 Packed Storage ///////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+/// vec3_load ///
+// Description
+//   Loads a packed vector from memory into its register form. Only the three
+//   packed elements are read, so this is safe on the last element of an array.
+// Arguments
+//   p: packed vector (Vec3p*)
+// Returns
+//   vector (Vec3)
+
+sol_inline
+Vec3 vec3_load(const Vec3p *p) {
+  Vec3 out;
+  #if defined(SOL_AVX_64)
+        out.vec = _mm256_maskload_pd(p->dim, _mm256_set_epi64x(0, -1, -1, -1));
+  #elif defined(SOL_SSE_32)
+        out.vec = _mm_set_ps(0, p->z, p->y, p->x);
+  #else
+        out.x = p->x;
+        out.y = p->y;
+        out.z = p->z;
+  #endif
+  return out;
+}
+
+/// vec3_store ///
+// Description
+//   Stores a vector's XYZ values into packed memory, dropping the padding lane.
+// Arguments
+//   p: packed vector (Vec3p*)
+//   v: vector (Vec3)
+// Returns
+//   void
+
+sol_inline
+void vec3_store(Vec3p *p, Vec3 v) {
+  #if defined(SOL_AVX_64)
+        _mm256_maskstore_pd(p->dim, _mm256_set_epi64x(0, -1, -1, -1), v.vec);
+  #else
+        p->x = v.x;
+        p->y = v.y;
+        p->z = v.z;
+  #endif
+}
+
+// The array forms in this section and the next are tasks over vectors
+// [lo, hi), handed to sol_parallel_for so large arrays split across threads.
+
+typedef struct {
+  void *out;
+  const void *a, *b;
+  Float f;
+} Vec3Job;
+
+static
+void vec3_load_task(void *job, size_t lo, size_t hi) {
+  const Vec3Job *j = job;
+  Vec3 *out = j->out;
+  const Vec3p *in = j->a;
+  for (size_t i = lo; i < hi; i++)
+    out[i] = vec3_load(&in[i]);
+}
+
+static
+void vec3_store_task(void *job, size_t lo, size_t hi) {
+  const Vec3Job *j = job;
+  Vec3p *out = j->out;
+  const Vec3 *in = j->a;
+  for (size_t i = lo; i < hi; i++)
+    vec3_store(&out[i], in[i]);
+}
+
+/// vec3_load_array ///
+// Description
+//   Loads an array of packed vectors into their register form.
+// Arguments
+//   out: vectors (Vec3*)
+//   in: packed vectors (Vec3p*)
+//   n: count (size_t)
+// Returns
+//   void
+
+sol_inline
+void vec3_load_array(Vec3 *out, const Vec3p *in, size_t n) {
+  Vec3Job j = {out, in, NULL, 0};
+  sol_parallel_for(n, sizeof(Vec3) + sizeof(Vec3p), vec3_load_task, &j);
+}
+
+/// vec3_store_array ///
+// Description
+//   Stores an array of vectors into packed memory.
+// Arguments
+//   out: packed vectors (Vec3p*)
+//   in: vectors (Vec3*)
+//   n: count (size_t)
+// Returns
+//   void
+
+sol_inline
+void vec3_store_array(Vec3p *out, const Vec3 *in, size_t n) {
+  Vec3Job j = {out, in, NULL, 0};
+  sol_parallel_for(n, sizeof(Vec3) + sizeof(Vec3p), vec3_store_task, &j);
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Vec3 Array Math ///////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Element-wise operations don't care where one vector ends and the next
+// begins, so the array forms below walk a packed array as a flat run of
+// 3 * n Floats using the widest registers available, with a scalar tail.
+
+static
+void vec3_add_task(void *job, size_t lo, size_t hi) {
+  const Vec3Job *j = job;
+  Float *o = (Float *) j->out + lo * 3;
+  const Float *fa = (const Float *) j->a + lo * 3;
+  const Float *fb = (const Float *) j->b + lo * 3;
+  size_t i = 0, m = (hi - lo) * 3;
+  #if defined(SOL_AVX_64)
+        for (; i + 4 <= m; i += 4)
+          _mm256_storeu_pd(o + i, _mm256_add_pd(_mm256_loadu_pd(fa + i),
+                                                _mm256_loadu_pd(fb + i)));
+  #elif defined(SOL_AVX)
+        for (; i + 8 <= m; i += 8)
+          _mm256_storeu_ps(o + i, _mm256_add_ps(_mm256_loadu_ps(fa + i),
+                                                _mm256_loadu_ps(fb + i)));
+  #elif defined(SOL_SSE_64)
+        for (; i + 2 <= m; i += 2)
+          _mm_storeu_pd(o + i, _mm_add_pd(_mm_loadu_pd(fa + i),
+                                          _mm_loadu_pd(fb + i)));
+  #elif defined(SOL_SSE_32)
+        for (; i + 4 <= m; i += 4)
+          _mm_storeu_ps(o + i, _mm_add_ps(_mm_loadu_ps(fa + i),
+                                          _mm_loadu_ps(fb + i)));
+  #endif
+  for (; i < m; i++)
+    o[i] = fa[i] + fb[i];
+}
+
+/// vec3_add_array ///
+// Description
+//   Adds the elements of two packed vector arrays. out may alias a or b.
+// Arguments
+//   out: packed vectors (Vec3p*)
+//   a: packed vectors (Vec3p*)
+//   b: packed vectors (Vec3p*)
+//   n: count (size_t)
+// Returns
+//   void {out[i].xyz = a[i].xyz + b[i].xyz}
+
+sol_inline
+void vec3_add_array(Vec3p *out, const Vec3p *a, const Vec3p *b, size_t n) {
+  Vec3Job j = {out, a, b, 0};
+  sol_parallel_for(n, sizeof(Vec3p) * 3, vec3_add_task, &j);
+}
+
+static
+void vec3_sub_task(void *job, size_t lo, size_t hi) {
+  const Vec3Job *j = job;
+  Float *o = (Float *) j->out + lo * 3;
+  const Float *fa = (const Float *) j->a + lo * 3;
+  const Float *fb = (const Float *) j->b + lo * 3;
+  size_t i = 0, m = (hi - lo) * 3;
+  #if defined(SOL_AVX_64)
+        for (; i + 4 <= m; i += 4)
+          _mm256_storeu_pd(o + i, _mm256_sub_pd(_mm256_loadu_pd(fa + i),
+                                                _mm256_loadu_pd(fb + i)));
+  #elif defined(SOL_AVX)
+        for (; i + 8 <= m; i += 8)
+          _mm256_storeu_ps(o + i, _mm256_sub_ps(_mm256_loadu_ps(fa + i),
+                                                _mm256_loadu_ps(fb + i)));
+  #elif defined(SOL_SSE_64)
+        for (; i + 2 <= m; i += 2)
+          _mm_storeu_pd(o + i, _mm_sub_pd(_mm_loadu_pd(fa + i),
+                                          _mm_loadu_pd(fb + i)));
+  #elif defined(SOL_SSE_32)
+        for (; i + 4 <= m; i += 4)
+          _mm_storeu_ps(o + i, _mm_sub_ps(_mm_loadu_ps(fa + i),
+                                          _mm_loadu_ps(fb + i)));
+  #endif
+  for (; i < m; i++)
+    o[i] = fa[i] - fb[i];
+}
+
+/// vec3_sub_array ///
+// Description
+//   Subtracts the elements of one packed vector array from another. out may
+//   alias a or b.
+// Arguments
+//   out: packed vectors (Vec3p*)
+//   a: packed vectors (Vec3p*)
+//   b: packed vectors (Vec3p*)
+//   n: count (size_t)
+// Returns
+//   void {out[i].xyz = a[i].xyz - b[i].xyz}
+
+sol_inline
+void vec3_sub_array(Vec3p *out, const Vec3p *a, const Vec3p *b, size_t n) {
+  Vec3Job j = {out, a, b, 0};
+  sol_parallel_for(n, sizeof(Vec3p) * 3, vec3_sub_task, &j);
+}
+
+static
+void vec3_mul_task(void *job, size_t lo, size_t hi) {
+  const Vec3Job *j = job;
+  Float *o = (Float *) j->out + lo * 3;
+  const Float *fa = (const Float *) j->a + lo * 3;
+  const Float *fb = (const Float *) j->b + lo * 3;
+  size_t i = 0, m = (hi - lo) * 3;
+  #if defined(SOL_AVX_64)
+        for (; i + 4 <= m; i += 4)
+          _mm256_storeu_pd(o + i, _mm256_mul_pd(_mm256_loadu_pd(fa + i),
+                                                _mm256_loadu_pd(fb + i)));
+  #elif defined(SOL_AVX)
+        for (; i + 8 <= m; i += 8)
+          _mm256_storeu_ps(o + i, _mm256_mul_ps(_mm256_loadu_ps(fa + i),
+                                                _mm256_loadu_ps(fb + i)));
+  #elif defined(SOL_SSE_64)
+        for (; i + 2 <= m; i += 2)
+          _mm_storeu_pd(o + i, _mm_mul_pd(_mm_loadu_pd(fa + i),
+                                          _mm_loadu_pd(fb + i)));
+  #elif defined(SOL_SSE_32)
+        for (; i + 4 <= m; i += 4)
+          _mm_storeu_ps(o + i, _mm_mul_ps(_mm_loadu_ps(fa + i),
+                                          _mm_loadu_ps(fb + i)));
+  #endif
+  for (; i < m; i++)
+    o[i] = fa[i] * fb[i];
+}
+
+/// vec3_mul_array ///
+// Description
+//   Multiplies the elements of two packed vector arrays. out may alias a or b.
+// Arguments
+//   out: packed vectors (Vec3p*)
+//   a: packed vectors (Vec3p*)
+//   b: packed vectors (Vec3p*)
+//   n: count (size_t)
+// Returns
+//   void {out[i].xyz = a[i].xyz * b[i].xyz}
+
+sol_inline
+void vec3_mul_array(Vec3p *out, const Vec3p *a, const Vec3p *b, size_t n) {
+  Vec3Job j = {out, a, b, 0};
+  sol_parallel_for(n, sizeof(Vec3p) * 3, vec3_mul_task, &j);
+}
+
+static
+void vec3_div_task(void *job, size_t lo, size_t hi) {
+  const Vec3Job *j = job;
+  Float *o = (Float *) j->out + lo * 3;
+  const Float *fa = (const Float *) j->a + lo * 3;
+  const Float *fb = (const Float *) j->b + lo * 3;
+  size_t i = 0, m = (hi - lo) * 3;
+  #if defined(SOL_AVX_64)
+        for (; i + 4 <= m; i += 4)
+          _mm256_storeu_pd(o + i, _mm256_div_pd(_mm256_loadu_pd(fa + i),
+                                                _mm256_loadu_pd(fb + i)));
+  #elif defined(SOL_AVX)
+        for (; i + 8 <= m; i += 8)
+          _mm256_storeu_ps(o + i, _mm256_div_ps(_mm256_loadu_ps(fa + i),
+                                                _mm256_loadu_ps(fb + i)));
+  #elif defined(SOL_SSE_64)
+        for (; i + 2 <= m; i += 2)
+          _mm_storeu_pd(o + i, _mm_div_pd(_mm_loadu_pd(fa + i),
+                                          _mm_loadu_pd(fb + i)));
+  #elif defined(SOL_SSE_32)
+        for (; i + 4 <= m; i += 4)
+          _mm_storeu_ps(o + i, _mm_div_ps(_mm_loadu_ps(fa + i),
+                                          _mm_loadu_ps(fb + i)));
+  #endif
+  for (; i < m; i++)
+    o[i] = fa[i] / fb[i];
+}
+
+/// vec3_div_array ///
+// Description
+//   Divides the elements of one packed vector array by another. out may alias
+//   a or b.
+// Arguments
+//   out: packed vectors (Vec3p*)
+//   a: packed vectors (Vec3p*)
+//   b: packed vectors (Vec3p*)
+//   n: count (size_t)
+// Returns
+//   void {out[i].xyz = a[i].xyz / b[i].xyz}
+
+sol_inline
+void vec3_div_array(Vec3p *out, const Vec3p *a, const Vec3p *b, size_t n) {
+  Vec3Job j = {out, a, b, 0};
+  sol_parallel_for(n, sizeof(Vec3p) * 3, vec3_div_task, &j);
+}
+
+static
+void vec3_mulf_task(void *job, size_t lo, size_t hi) {
+  const Vec3Job *j = job;
+  const Float f = j->f;
+  Float *o = (Float *) j->out + lo * 3;
+  const Float *fv = (const Float *) j->a + lo * 3;
+  size_t i = 0, m = (hi - lo) * 3;
+  #if defined(SOL_AVX_64)
+        const __m256d vf = _mm256_set1_pd(f);
+        for (; i + 4 <= m; i += 4)
+          _mm256_storeu_pd(o + i, _mm256_mul_pd(_mm256_loadu_pd(fv + i), vf));
+  #elif defined(SOL_AVX)
+        const __m256 vf = _mm256_set1_ps(f);
+        for (; i + 8 <= m; i += 8)
+          _mm256_storeu_ps(o + i, _mm256_mul_ps(_mm256_loadu_ps(fv + i), vf));
+  #elif defined(SOL_SSE_64)
+        const __m128d vf = _mm_set1_pd(f);
+        for (; i + 2 <= m; i += 2)
+          _mm_storeu_pd(o + i, _mm_mul_pd(_mm_loadu_pd(fv + i), vf));
+  #elif defined(SOL_SSE_32)
+        const __m128 vf = _mm_set1_ps(f);
+        for (; i + 4 <= m; i += 4)
+          _mm_storeu_ps(o + i, _mm_mul_ps(_mm_loadu_ps(fv + i), vf));
+  #endif
+  for (; i < m; i++)
+    o[i] = fv[i] * f;
+}
+
+/// vec3_mulf_array ///
+// Description
+//   Multiplies each element of a packed vector array by a scalar. out may
+//   alias v.
+// Arguments
+//   out: packed vectors (Vec3p*)
+//   v: packed vectors (Vec3p*)
+//   f: scalar (Float)
+//   n: count (size_t)
+// Returns
+//   void {out[i].xyz = v[i].xyz * f}
+
+sol_inline
+void vec3_mulf_array(Vec3p *out, const Vec3p *v, Float f, size_t n) {
+  Vec3Job j = {out, v, NULL, f};
+  sol_parallel_for(n, sizeof(Vec3p) * 2, vec3_mulf_task, &j);
+}
+
+static
+void vec3_axpy_task(void *job, size_t lo, size_t hi) {
+  const Vec3Job *j = job;
+  const Float f = j->f;
+  Float *o = (Float *) j->out + lo * 3;
+  const Float *fx = (const Float *) j->a + lo * 3;
+  const Float *fy = (const Float *) j->b + lo * 3;
+  size_t i = 0, m = (hi - lo) * 3;
+  #if defined(SOL_AVX_64)
+        const __m256d vf = _mm256_set1_pd(f);
+        for (; i + 4 <= m; i += 4) {
+          const __m256d x = _mm256_loadu_pd(fx + i), y = _mm256_loadu_pd(fy + i);
+          #if defined(SOL_FMA)
+                _mm256_storeu_pd(o + i, _mm256_fmadd_pd(x, vf, y));
+          #else
+                _mm256_storeu_pd(o + i, _mm256_add_pd(_mm256_mul_pd(x, vf), y));
+          #endif
+        }
+  #elif defined(SOL_AVX)
+        const __m256 vf = _mm256_set1_ps(f);
+        for (; i + 8 <= m; i += 8) {
+          const __m256 x = _mm256_loadu_ps(fx + i), y = _mm256_loadu_ps(fy + i);
+          #if defined(SOL_FMA)
+                _mm256_storeu_ps(o + i, _mm256_fmadd_ps(x, vf, y));
+          #else
+                _mm256_storeu_ps(o + i, _mm256_add_ps(_mm256_mul_ps(x, vf), y));
+          #endif
+        }
+  #elif defined(SOL_SSE_64)
+        const __m128d vf = _mm_set1_pd(f);
+        for (; i + 2 <= m; i += 2)
+          _mm_storeu_pd(o + i, _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(fx + i), vf),
+                                          _mm_loadu_pd(fy + i)));
+  #elif defined(SOL_SSE_32)
+        const __m128 vf = _mm_set1_ps(f);
+        for (; i + 4 <= m; i += 4)
+          _mm_storeu_ps(o + i, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(fx + i), vf),
+                                          _mm_loadu_ps(fy + i)));
+  #endif
+  // The tail rounds like the vector body so results don't depend on n.
+  for (; i < m; i++) {
+    #if defined(SOL_FMA)
+          o[i] = flt_fma(fx[i], f, fy[i]);
+    #else
+          o[i] = fx[i] * f + fy[i];
+    #endif
+  }
+}
+
+/// vec3_axpy_array ///
+// Description
+//   Scales one packed vector array and adds another to it, as in the
+//   position and velocity updates of an integrator. With SOL_FMA the
+//   product isn't rounded before the addition. out may alias x or y.
+// Arguments
+//   out: packed vectors (Vec3p*)
+//   x: packed vectors (Vec3p*)
+//   f: scalar (Float)
+//   y: packed vectors (Vec3p*)
+//   n: count (size_t)
+// Returns
+//   void {out[i].xyz = x[i].xyz * f + y[i].xyz}
+
+sol_inline
+void vec3_axpy_array(Vec3p *out, const Vec3p *x, Float f, const Vec3p *y, size_t n) {
+  Vec3Job j = {out, x, y, f};
+  sol_parallel_for(n, sizeof(Vec3p) * 3, vec3_axpy_task, &j);
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Vec3 Transposed Math //////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Many dot products against the same vector are cheapest with the other side
+// transposed into X, Y and Z registers: every lane then holds a whole dot
+// product and no horizontal adds are needed. Vec3x4 and Vec3x8 keep vectors
+// in that layout, and the array forms transpose packed vectors on the fly.
+
+// ax * bx + ay * by + az * bz for one lane, rounded like the vector lanes.
+static inline
+Float vec3_dot_lane(Float ax, Float ay, Float az, Float bx, Float by, Float bz) {
+  #if defined(SOL_FMA)
+        return flt_fma(ax, bx, flt_fma(ay, by, az * bz));
+  #else
+        return ax * bx + ay * by + az * bz;
+  #endif
+}
+
+#if defined(SOL_AVX_64)
+      static inline
+      __m256d vec3_dot_m256d(__m256d ax, __m256d ay, __m256d az,
+                             __m256d bx, __m256d by, __m256d bz) {
+        #if defined(SOL_FMA)
+              return _mm256_fmadd_pd(ax, bx, _mm256_fmadd_pd(ay, by, _mm256_mul_pd(az, bz)));
+        #else
+              return _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(ax, bx), _mm256_mul_pd(ay, by)),
+                                   _mm256_mul_pd(az, bz));
+        #endif
+      }
+
+      // Loads 4 packed vectors and transposes them into X, Y and Z registers.
+      static inline
+      void vec3_soa_m256d(const Float *p, __m256d *x, __m256d *y, __m256d *z) {
+        const __m256d d0 = _mm256_loadu_pd(p);
+        const __m256d d1 = _mm256_loadu_pd(p + 4);
+        const __m256d d2 = _mm256_loadu_pd(p + 8);
+        const __m256d m03 = _mm256_permute2f128_pd(d0, d1, 0x30);
+        const __m256d m14 = _mm256_permute2f128_pd(d0, d2, 0x21);
+        const __m256d m25 = _mm256_permute2f128_pd(d1, d2, 0x30);
+        *x = _mm256_shuffle_pd(m03, m14, 0xA);
+        *y = _mm256_shuffle_pd(m03, m25, 0x5);
+        *z = _mm256_shuffle_pd(m14, m25, 0xA);
+      }
+#elif defined(SOL_SSE_64)
+      static inline
+      __m128d vec3_dot_m128d(__m128d ax, __m128d ay, __m128d az,
+                             __m128d bx, __m128d by, __m128d bz) {
+        return _mm_add_pd(_mm_add_pd(_mm_mul_pd(ax, bx), _mm_mul_pd(ay, by)),
+                          _mm_mul_pd(az, bz));
+      }
+
+      // Loads 2 packed vectors and transposes them into X, Y and Z registers.
+      static inline
+      void vec3_soa_m128d(const Float *p, __m128d *x, __m128d *y, __m128d *z) {
+        const __m128d d0 = _mm_loadu_pd(p);
+        const __m128d d1 = _mm_loadu_pd(p + 2);
+        const __m128d d2 = _mm_loadu_pd(p + 4);
+        *x = _mm_shuffle_pd(d0, d1, 0x2);
+        *y = _mm_shuffle_pd(d0, d2, 0x1);
+        *z = _mm_shuffle_pd(d1, d2, 0x2);
+      }
+#elif defined(SOL_SSE_32)
+      static inline
+      __m128 vec3_dot_m128(__m128 ax, __m128 ay, __m128 az,
+                           __m128 bx, __m128 by, __m128 bz) {
+        #if defined(SOL_FMA)
+              return _mm_fmadd_ps(ax, bx, _mm_fmadd_ps(ay, by, _mm_mul_ps(az, bz)));
+        #else
+              return _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)),
+                                _mm_mul_ps(az, bz));
+        #endif
+      }
+
+      // Loads 4 packed vectors and transposes them into X, Y and Z registers.
+      static inline
+      void vec3_soa_m128(const Float *p, __m128 *x, __m128 *y, __m128 *z) {
+        const __m128 p0 = _mm_loadu_ps(p);
+        const __m128 p1 = _mm_loadu_ps(p + 4);
+        const __m128 p2 = _mm_loadu_ps(p + 8);
+        const __m128 t0 = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(1, 0, 2, 1));
+        const __m128 t1 = _mm_shuffle_ps(p1, p2, _MM_SHUFFLE(2, 1, 3, 2));
+        *x = _mm_shuffle_ps(p0, t1, _MM_SHUFFLE(2, 0, 3, 0));
+        *y = _mm_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 1, 2, 0));
+        *z = _mm_shuffle_ps(t0, p2, _MM_SHUFFLE(3, 0, 3, 1));
+      }
+#endif
+
+/// vec3x4_load ///
+// Description
+//   Transposes 4 packed vectors into a Vec3x4.
+// Arguments
+//   p: packed vectors (Vec3p*)
+// Returns
+//   transposed vectors (Vec3x4)
+
+sol_inline
+Vec3x4 vec3x4_load(const Vec3p *p) {
+  Vec3x4 out;
+  for (size_t i = 0; i < 4; i++) {
+    out.x[i] = p[i].x;
+    out.y[i] = p[i].y;
+    out.z[i] = p[i].z;
+  }
+  return out;
+}
+
+/// vec3x8_load ///
+// Description
+//   Transposes 8 packed vectors into a Vec3x8.
+// Arguments
+//   p: packed vectors (Vec3p*)
+// Returns
+//   transposed vectors (Vec3x8)
+
+sol_inline
+Vec3x8 vec3x8_load(const Vec3p *p) {
+  Vec3x8 out;
+  for (size_t i = 0; i < 8; i++) {
+    out.x[i] = p[i].x;
+    out.y[i] = p[i].y;
+    out.z[i] = p[i].z;
+  }
+  return out;
+}
+
+/// vec3_dot4 ///
+// Description
+//   Gets the dot products of one vector with 4 transposed vectors.
+// Arguments
+//   a: vector (Vec3)
+//   b: transposed vectors (Vec3x4*)
+// Returns
+//   vector (Vec4) {dot(a, b[0]), ..., dot(a, b[3])}
+
+sol_inline
+Vec4 vec3_dot4(Vec3 a, const Vec3x4 *b) {
+  Vec4 out;
+  #if defined(SOL_AVX_64)
+        out.vec = vec3_dot_m256d(_mm256_set1_pd(a.x), _mm256_set1_pd(a.y), _mm256_set1_pd(a.z),
+                                 _mm256_loadu_pd(b->x), _mm256_loadu_pd(b->y), _mm256_loadu_pd(b->z));
+  #elif defined(SOL_SSE_64)
+        const __m128d ax = _mm_set1_pd(a.x), ay = _mm_set1_pd(a.y), az = _mm_set1_pd(a.z);
+        for (size_t i = 0; i < 4; i += 2)
+          _mm_storeu_pd(out.dim + i, vec3_dot_m128d(ax, ay, az, _mm_loadu_pd(b->x + i),
+                                                    _mm_loadu_pd(b->y + i), _mm_loadu_pd(b->z + i)));
+  #elif defined(SOL_SSE_32)
+        out.vec = vec3_dot_m128(_mm_set1_ps(a.x), _mm_set1_ps(a.y), _mm_set1_ps(a.z),
+                                _mm_loadu_ps(b->x), _mm_loadu_ps(b->y), _mm_loadu_ps(b->z));
+  #else
+        for (size_t i = 0; i < 4; i++)
+          out.dim[i] = vec3_dot_lane(a.x, a.y, a.z, b->x[i], b->y[i], b->z[i]);
+  #endif
+  return out;
+}
+
+/// vec3_dot8 ///
+// Description
+//   Gets the dot products of one vector with 8 transposed vectors.
+// Arguments
+//   out: scalars (Float[8])
+//   a: vector (Vec3)
+//   b: transposed vectors (Vec3x8*)
+// Returns
+//   void {out[i] = dot(a, b[i])}
+
+sol_inline
+void vec3_dot8(Float *out, Vec3 a, const Vec3x8 *b) {
+  size_t i = 0;
+  #if defined(SOL_AVX_64)
+        const __m256d ax = _mm256_set1_pd(a.x), ay = _mm256_set1_pd(a.y), az = _mm256_set1_pd(a.z);
+        for (; i < 8; i += 4)
+          _mm256_storeu_pd(out + i, vec3_dot_m256d(ax, ay, az, _mm256_loadu_pd(b->x + i),
+                                                   _mm256_loadu_pd(b->y + i), _mm256_loadu_pd(b->z + i)));
+  #elif defined(SOL_SSE_64)
+        const __m128d ax = _mm_set1_pd(a.x), ay = _mm_set1_pd(a.y), az = _mm_set1_pd(a.z);
+        for (; i < 8; i += 2)
+          _mm_storeu_pd(out + i, vec3_dot_m128d(ax, ay, az, _mm_loadu_pd(b->x + i),
+                                                _mm_loadu_pd(b->y + i), _mm_loadu_pd(b->z + i)));
+  #elif defined(SOL_AVX)
+        const __m256 bx = _mm256_loadu_ps(b->x), by = _mm256_loadu_ps(b->y), bz = _mm256_loadu_ps(b->z);
+        #if defined(SOL_FMA)
+              const __m256 d = _mm256_fmadd_ps(_mm256_set1_ps(a.x), bx,
+                                 _mm256_fmadd_ps(_mm256_set1_ps(a.y), by,
+                                                 _mm256_mul_ps(_mm256_set1_ps(a.z), bz)));
+        #else
+              const __m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(a.x), bx),
+                                                           _mm256_mul_ps(_mm256_set1_ps(a.y), by)),
+                                             _mm256_mul_ps(_mm256_set1_ps(a.z), bz));
+        #endif
+        _mm256_storeu_ps(out, d);
+        i = 8;
+  #elif defined(SOL_SSE_32)
+        const __m128 ax = _mm_set1_ps(a.x), ay = _mm_set1_ps(a.y), az = _mm_set1_ps(a.z);
+        for (; i < 8; i += 4)
+          _mm_storeu_ps(out + i, vec3_dot_m128(ax, ay, az, _mm_loadu_ps(b->x + i),
+                                               _mm_loadu_ps(b->y + i), _mm_loadu_ps(b->z + i)));
+  #endif
+  for (; i < 8; i++)
+    out[i] = vec3_dot_lane(a.x, a.y, a.z, b->x[i], b->y[i], b->z[i]);
+}
+
+static
+void vec3_dot_task(void *job, size_t lo, size_t hi) {
+  const Vec3Job *j = job;
+  const Vec3 a = *(const Vec3 *) j->b;
+  Float *o = (Float *) j->out + lo;
+  const Float *fb = (const Float *) j->a + lo * 3;
+  size_t i = 0, m = hi - lo;
+  #if defined(SOL_AVX_64)
+        const __m256d ax = _mm256_set1_pd(a.x), ay = _mm256_set1_pd(a.y), az = _mm256_set1_pd(a.z);
+        for (; i + 4 <= m; i += 4) {
+          __m256d x, y, z;
+          vec3_soa_m256d(fb + i * 3, &x, &y, &z);
+          _mm256_storeu_pd(o + i, vec3_dot_m256d(ax, ay, az, x, y, z));
+        }
+  #elif defined(SOL_SSE_64)
+        const __m128d ax = _mm_set1_pd(a.x), ay = _mm_set1_pd(a.y), az = _mm_set1_pd(a.z);
+        for (; i + 2 <= m; i += 2) {
+          __m128d x, y, z;
+          vec3_soa_m128d(fb + i * 3, &x, &y, &z);
+          _mm_storeu_pd(o + i, vec3_dot_m128d(ax, ay, az, x, y, z));
+        }
+  #elif defined(SOL_SSE_32)
+        const __m128 ax = _mm_set1_ps(a.x), ay = _mm_set1_ps(a.y), az = _mm_set1_ps(a.z);
+        for (; i + 4 <= m; i += 4) {
+          __m128 x, y, z;
+          vec3_soa_m128(fb + i * 3, &x, &y, &z);
+          _mm_storeu_ps(o + i, vec3_dot_m128(ax, ay, az, x, y, z));
+        }
+  #endif
+  for (; i < m; i++)
+    o[i] = vec3_dot_lane(a.x, a.y, a.z, fb[i * 3], fb[i * 3 + 1], fb[i * 3 + 2]);
+}
+
+/// vec3_dot_array ///
+// Description
+//   Gets the dot product of one vector with each element of a packed vector
+//   array, as in projecting points onto an axis or testing them against a
+//   plane.
+// Arguments
+//   out: scalars (Float*)
+//   a: vector (Vec3)
+//   b: packed vectors (Vec3p*)
+//   n: count (size_t)
+// Returns
+//   void {out[i] = dot(a, b[i])}
+
+sol_inline
+void vec3_dot_array(Float *out, Vec3 a, const Vec3p *b, size_t n) {
+  Vec3Job j = {out, b, &a, 0};
+  sol_parallel_for(n, sizeof(Vec3p) + sizeof(Float), vec3_dot_task, &j);
+}
+
+static
+void vec3_dots_task(void *job, size_t lo, size_t hi) {
+  const Vec3Job *j = job;
+  Float *o = (Float *) j->out + lo;
+  const Float *fa = (const Float *) j->a + lo * 3;
+  const Float *fb = (const Float *) j->b + lo * 3;
+  size_t i = 0, m = hi - lo;
+  #if defined(SOL_AVX_64)
+        for (; i + 4 <= m; i += 4) {
+          __m256d ax, ay, az, bx, by, bz;
+          vec3_soa_m256d(fa + i * 3, &ax, &ay, &az);
+          vec3_soa_m256d(fb + i * 3, &bx, &by, &bz);
+          _mm256_storeu_pd(o + i, vec3_dot_m256d(ax, ay, az, bx, by, bz));
+        }
+  #elif defined(SOL_SSE_64)
+        for (; i + 2 <= m; i += 2) {
+          __m128d ax, ay, az, bx, by, bz;
+          vec3_soa_m128d(fa + i * 3, &ax, &ay, &az);
+          vec3_soa_m128d(fb + i * 3, &bx, &by, &bz);
+          _mm_storeu_pd(o + i, vec3_dot_m128d(ax, ay, az, bx, by, bz));
+        }
+  #elif defined(SOL_SSE_32)
+        for (; i + 4 <= m; i += 4) {
+          __m128 ax, ay, az, bx, by, bz;
+          vec3_soa_m128(fa + i * 3, &ax, &ay, &az);
+          vec3_soa_m128(fb + i * 3, &bx, &by, &bz);
+          _mm_storeu_ps(o + i, vec3_dot_m128(ax, ay, az, bx, by, bz));
+        }
+  #endif
+  for (; i < m; i++)
+    o[i] = vec3_dot_lane(fa[i * 3], fa[i * 3 + 1], fa[i * 3 + 2],
+                         fb[i * 3], fb[i * 3 + 1], fb[i * 3 + 2]);
+}
+
+/// vec3_dot_arrays ///
+// Description
+//   Gets the dot products of two packed vector arrays element by element.
+// Arguments
+//   out: scalars (Float*)
+//   a: packed vectors (Vec3p*)
+//   b: packed vectors (Vec3p*)
+//   n: count (size_t)
+// Returns
+//   void {out[i] = dot(a[i], b[i])}
+
+sol_inline
+void vec3_dot_arrays(Float *out, const Vec3p *a, const Vec3p *b, size_t n) {
+  Vec3Job j = {out, a, b, 0};
+  sol_parallel_for(n, sizeof(Vec3p) * 2 + sizeof(Float), vec3_dots_task, &j);
+}
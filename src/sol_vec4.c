@@ -39,9 +39,9 @@ sol_inline
 Vec4 vec4_init(Float x, Float y, Float z, Float w) {
   Vec4 out;
   #if defined(SOL_AVX_64)
-        out.vec = _mm256_set_pd(x, y, z, w);
-  #elif defined(SOL_AVX)
-        out.vec = _mm_set_ps(x, y, z, w);
+        out.vec = _mm256_set_pd(w, z, y, x);
+  #elif defined(SOL_SSE_32)
+        out.vec = _mm_set_ps(w, z, y, x);
   #else
         out.x = x;
         out.y = y;
@@ -64,7 +64,7 @@ Vec4 vec4_initf(Float f) {
   Vec4 out;
   #if defined(SOL_AVX_64)
         out.vec = _mm256_set1_pd(f);
-  #elif defined(SOL_AVX)
+  #elif defined(SOL_SSE_32)
         out.vec = _mm_set1_ps(f);
   #elif defined(SOL_NEON_64)
         out.vec = vdupq_n_f64(f);
@@ -103,7 +103,7 @@ Vec4 vec4_zero(void) {
 
 sol_inline
 Vec4 vec4_norm(Vec4 v) {
-  return vec4_divf(v, vec4_mag(v));
+  return vec4_mulf(v, 1 / vec4_mag(v));
 }
 
 /// vec4_mag ///
@@ -116,7 +116,25 @@ Vec4 vec4_norm(Vec4 v) {
 
 sol_inline
 Float vec4_mag(Vec4 v) {
-  return flt_sqrt(vec4_sum(vec4_mul(v, v)));
+  return flt_sqrt(vec4_dot(v, v));
+}
+
+/// vec4_dot ///
+// Description
+//   Gets the dot product of two vectors.
+// Arguments
+//   a: vector (Vec4)
+//   b: vector (Vec4)
+// Returns
+//   scalar (Float) {sum a.xyzw * b.xyzw}
+
+sol_inline
+Float vec4_dot(Vec4 a, Vec4 b) {
+  #if defined(SOL_SSE_32) && defined(SOL_SSE41)
+        return _mm_cvtss_f32(_mm_dp_ps(a.vec, b.vec, 0xF1));
+  #else
+        return vec4_sum(vec4_mul(a, b));
+  #endif
 }
 
   //////////////////////////////////////////////////////////////////////////////
@@ -150,7 +168,7 @@ Vec4 vec4_add(Vec4 a, Vec4 b) {
   Vec4 out;
   #if defined(SOL_AVX_64)
         out.vec = _mm256_add_pd(a.vec, b.vec);
-  #elif defined(SOL_AVX)
+  #elif defined(SOL_SSE_32)
         out.vec = _mm_add_ps(a.vec, b.vec);
   #elif defined(SOL_NEON_64)
         out.vec = vaddq_f64(a.vec, b.vec);
@@ -192,9 +210,9 @@ sol_inline
 Vec4 vec4_sub(Vec4 a, Vec4 b) {
   Vec4 out;
   #if defined(SOL_AVX_64)
-        out.vec = _mm256_add_pd(a.vec, b.vec);
-  #elif defined(SOL_AVX)
-        out.vec = _mm_add_ps(a.vec, b.vec);
+        out.vec = _mm256_sub_pd(a.vec, b.vec);
+  #elif defined(SOL_SSE_32)
+        out.vec = _mm_sub_ps(a.vec, b.vec);
   #elif defined(SOL_NEON_64)
         out.vec = vsubq_f64(a.vec, b.vec);
   #elif defined(SOL_NEON)
@@ -250,7 +268,7 @@ Vec4 vec4_mul(Vec4 a, Vec4 b) {
   Vec4 out;
   #if defined(SOL_AVX_64)
         out.vec = _mm256_mul_pd(a.vec, b.vec);
-  #elif defined(SOL_AVX)
+  #elif defined(SOL_SSE_32)
         out.vec = _mm_mul_ps(a.vec, b.vec);
   #elif defined(SOL_NEON_64)
         out.vec = vmulq_f64(a.vec, b.vec);
@@ -291,10 +309,16 @@ Vec4 vec4_mulf(Vec4 v, Float f) {
 sol_inline
 Vec4 vec4_div(Vec4 a, Vec4 b) {
   Vec4 out;
-  out.x = a.x / b.x;
-  out.y = a.y / b.y;
-  out.z = a.z / b.z;
-  out.w = a.w / b.w;
+  #if defined(SOL_AVX_64)
+        out.vec = _mm256_div_pd(a.vec, b.vec);
+  #elif defined(SOL_SSE_32)
+        out.vec = _mm_div_ps(a.vec, b.vec);
+  #else
+        out.x = a.x / b.x;
+        out.y = a.y / b.y;
+        out.z = a.z / b.z;
+        out.w = a.w / b.w;
+  #endif
   return out;
 }
 
@@ -337,7 +361,7 @@ Vec4 vec4_fdiv(Float f, Vec4 v) {
 
 sol_inline
 Vec4 vec4_avg(Vec4 a, Vec4 b) {
-  return vec4_divf(vec4_mul(a, b), 2);
+  return vec4_mulf(vec4_add(a, b), 0.5);
 }
 
 /// vec4_avgf ///
@@ -354,6 +378,160 @@ Vec4 vec4_avgf(Vec4 v, Float f) {
   return vec4_avg(v, vec4_initf(f));
 }
 
+  //////////////////////////////////////////////////////////////////////////////
+ // Vec4 Fused Math ///////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+/// vec4_fma ///
+// Description
+//   Multiplies two vectors and adds a third. With SOL_FMA the product isn't
+//   rounded before the addition.
+// Arguments
+//   a: vector (Vec4)
+//   b: vector (Vec4)
+//   c: vector (Vec4)
+// Returns
+//   vector (Vec4) {a.xyzw * b.xyzw + c.xyzw}
+
+sol_inline
+Vec4 vec4_fma(Vec4 a, Vec4 b, Vec4 c) {
+  Vec4 out;
+  #if defined(SOL_FMA) && defined(SOL_AVX_64)
+        out.vec = _mm256_fmadd_pd(a.vec, b.vec, c.vec);
+  #elif defined(SOL_FMA) && defined(SOL_SSE_32)
+        out.vec = _mm_fmadd_ps(a.vec, b.vec, c.vec);
+  #elif defined(SOL_FMA) && defined(SOL_NEON_64)
+        out.vec = vfmaq_f64(c.vec, a.vec, b.vec);
+  #elif defined(SOL_FMA) && defined(SOL_NEON)
+        out.vec = vfmaq_f32(c.vec, a.vec, b.vec);
+  #else
+        out = vec4_add(vec4_mul(a, b), c);
+  #endif
+  return out;
+}
+
+/// vec4_fmaf ///
+// Description
+//   Multiplies a vector by a scalar and adds another vector.
+// Arguments
+//   a: vector (Vec4)
+//   f: scalar (Float)
+//   b: vector (Vec4)
+// Returns
+//   vector (Vec4) {a.xyzw * f + b.xyzw}
+
+sol_inline
+Vec4 vec4_fmaf(Vec4 a, Float f, Vec4 b) {
+  return vec4_fma(a, vec4_initf(f), b);
+}
+
+/// vec4_madd ///
+// Description
+//   Adds a vector scaled by a scalar onto another, as in a += b * f.
+// Arguments
+//   a: vector (Vec4)
+//   b: vector (Vec4)
+//   f: scalar (Float)
+// Returns
+//   vector (Vec4) {a.xyzw + b.xyzw * f}
+
+sol_inline
+Vec4 vec4_madd(Vec4 a, Vec4 b, Float f) {
+  return vec4_fma(b, vec4_initf(f), a);
+}
+
+/// vec4_lerp ///
+// Description
+//   Linearly interpolates between two vectors.
+// Arguments
+//   a: vector (Vec4)
+//   b: vector (Vec4)
+//   t: scalar (Float)
+// Returns
+//   vector (Vec4) {a.xyzw + (b.xyzw - a.xyzw) * t}
+
+sol_inline
+Vec4 vec4_lerp(Vec4 a, Vec4 b, Float t) {
+  return vec4_fma(vec4_sub(b, a), vec4_initf(t), a);
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Vec4 Rounding /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+/// vec4_floor ///
+// Description
+//   Rounds each element of a vector down to an integer.
+// Arguments
+//   v: vector (Vec4)
+// Returns
+//   vector (Vec4) {floor(v.xyzw)}
+
+sol_inline
+Vec4 vec4_floor(Vec4 v) {
+  Vec4 out;
+  #if defined(SOL_AVX_64)
+        out.vec = _mm256_floor_pd(v.vec);
+  #elif defined(SOL_SSE_32) && defined(SOL_SSE41)
+        out.vec = _mm_floor_ps(v.vec);
+  #else
+        out.x = flt_floor(v.x);
+        out.y = flt_floor(v.y);
+        out.z = flt_floor(v.z);
+        out.w = flt_floor(v.w);
+  #endif
+  return out;
+}
+
+/// vec4_ceil ///
+// Description
+//   Rounds each element of a vector up to an integer.
+// Arguments
+//   v: vector (Vec4)
+// Returns
+//   vector (Vec4) {ceil(v.xyzw)}
+
+sol_inline
+Vec4 vec4_ceil(Vec4 v) {
+  Vec4 out;
+  #if defined(SOL_AVX_64)
+        out.vec = _mm256_ceil_pd(v.vec);
+  #elif defined(SOL_SSE_32) && defined(SOL_SSE41)
+        out.vec = _mm_ceil_ps(v.vec);
+  #else
+        out.x = flt_ceil(v.x);
+        out.y = flt_ceil(v.y);
+        out.z = flt_ceil(v.z);
+        out.w = flt_ceil(v.w);
+  #endif
+  return out;
+}
+
+/// vec4_round ///
+// Description
+//   Rounds each element of a vector to the nearest integer, with halfway
+//   cases going to the even neighbour.
+// Arguments
+//   v: vector (Vec4)
+// Returns
+//   vector (Vec4) {round(v.xyzw)}
+
+sol_inline
+Vec4 vec4_round(Vec4 v) {
+  Vec4 out;
+  #if defined(SOL_AVX_64)
+        out.vec = _mm256_round_pd(v.vec, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+  #elif defined(SOL_SSE_32) && defined(SOL_SSE41)
+        out.vec = _mm_round_ps(v.vec, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+  #else
+        out.x = flt_round(v.x);
+        out.y = flt_round(v.y);
+        out.z = flt_round(v.z);
+        out.w = flt_round(v.w);
+  #endif
+  return out;
+}
+
   //////////////////////////////////////////////////////////////////////////////
  // Vec4 Terminal IO //////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
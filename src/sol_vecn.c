@@ -0,0 +1,629 @@
+    /////////////////////////////////////////////////////////////////
+   // sol_vecn.c ///////////////////////////////////////////////////
+  // Description: Adds N-dimensional vectors to Sol. //////////////
+ // Author: David Garland (https://github.com/davidgarland/sol) //
+/////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Local Headers /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include "../sol.h"
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Standard Headers //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+  //////////////////////////////////////////////////////////////////////////////
+ // VecN Kernels //////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// VecN storage always starts on a SOL_VECN_ALIGN boundary, so the loops below
+// use aligned loads over the widest register of the family and finish with a
+// scalar tail. The vecn_reg_* names map onto the intrinsics of that register.
+
+#if defined(SOL_AVX_64)
+      #define VECN_LANES 4
+      typedef __m256d VecNReg;
+      #define vecn_reg_load _mm256_load_pd
+      #define vecn_reg_store _mm256_store_pd
+      #define vecn_reg_storeu _mm256_storeu_pd
+      #define vecn_reg_set1 _mm256_set1_pd
+      #define vecn_reg_zero _mm256_setzero_pd
+      #define vecn_reg_add _mm256_add_pd
+      #define vecn_reg_sub _mm256_sub_pd
+      #define vecn_reg_mul _mm256_mul_pd
+      #if defined(SOL_FMA)
+            #define vecn_reg_madd _mm256_fmadd_pd
+      #endif
+#elif defined(SOL_SSE_64)
+      #define VECN_LANES 2
+      typedef __m128d VecNReg;
+      #define vecn_reg_load _mm_load_pd
+      #define vecn_reg_store _mm_store_pd
+      #define vecn_reg_storeu _mm_storeu_pd
+      #define vecn_reg_set1 _mm_set1_pd
+      #define vecn_reg_zero _mm_setzero_pd
+      #define vecn_reg_add _mm_add_pd
+      #define vecn_reg_sub _mm_sub_pd
+      #define vecn_reg_mul _mm_mul_pd
+#elif defined(SOL_AVX)
+      #define VECN_LANES 8
+      typedef __m256 VecNReg;
+      #define vecn_reg_load _mm256_load_ps
+      #define vecn_reg_store _mm256_store_ps
+      #define vecn_reg_storeu _mm256_storeu_ps
+      #define vecn_reg_set1 _mm256_set1_ps
+      #define vecn_reg_zero _mm256_setzero_ps
+      #define vecn_reg_add _mm256_add_ps
+      #define vecn_reg_sub _mm256_sub_ps
+      #define vecn_reg_mul _mm256_mul_ps
+      #if defined(SOL_FMA)
+            #define vecn_reg_madd _mm256_fmadd_ps
+      #endif
+#elif defined(SOL_SSE_32)
+      #define VECN_LANES 4
+      typedef __m128 VecNReg;
+      #define vecn_reg_load _mm_load_ps
+      #define vecn_reg_store _mm_store_ps
+      #define vecn_reg_storeu _mm_storeu_ps
+      #define vecn_reg_set1 _mm_set1_ps
+      #define vecn_reg_zero _mm_setzero_ps
+      #define vecn_reg_add _mm_add_ps
+      #define vecn_reg_sub _mm_sub_ps
+      #define vecn_reg_mul _mm_mul_ps
+      #if defined(SOL_FMA)
+            #define vecn_reg_madd _mm_fmadd_ps
+      #endif
+#endif
+
+#if defined(VECN_LANES) && !defined(vecn_reg_madd)
+      #define vecn_reg_madd(a, b, c) vecn_reg_add(vecn_reg_mul(a, b), c)
+#endif
+
+#if defined(VECN_LANES)
+      static inline
+      Float vecn_reg_sum(VecNReg r) {
+        Float lane[VECN_LANES];
+        vecn_reg_storeu(lane, r);
+        Float out = 0;
+        for (size_t i = 0; i < VECN_LANES; i++)
+          out += lane[i];
+        return out;
+      }
+#endif
+
+static
+Float vecn_dot_raw(const Float *a, const Float *b, size_t n) {
+  Float out = 0;
+  size_t i = 0;
+  #if defined(VECN_LANES)
+        VecNReg s0 = vecn_reg_zero(), s1 = s0;
+        for (; i + 2 * VECN_LANES <= n; i += 2 * VECN_LANES) {
+          s0 = vecn_reg_madd(vecn_reg_load(a + i), vecn_reg_load(b + i), s0);
+          s1 = vecn_reg_madd(vecn_reg_load(a + i + VECN_LANES),
+                             vecn_reg_load(b + i + VECN_LANES), s1);
+        }
+        out = vecn_reg_sum(vecn_reg_add(s0, s1));
+  #endif
+  for (; i < n; i++)
+    out += a[i] * b[i];
+  return out;
+}
+
+static
+Float vecn_dist2_raw(const Float *a, const Float *b, size_t n) {
+  Float out = 0;
+  size_t i = 0;
+  #if defined(VECN_LANES)
+        VecNReg s0 = vecn_reg_zero(), s1 = s0;
+        for (; i + 2 * VECN_LANES <= n; i += 2 * VECN_LANES) {
+          const VecNReg d0 = vecn_reg_sub(vecn_reg_load(a + i), vecn_reg_load(b + i));
+          const VecNReg d1 = vecn_reg_sub(vecn_reg_load(a + i + VECN_LANES),
+                                          vecn_reg_load(b + i + VECN_LANES));
+          s0 = vecn_reg_madd(d0, d0, s0);
+          s1 = vecn_reg_madd(d1, d1, s1);
+        }
+        out = vecn_reg_sum(vecn_reg_add(s0, s1));
+  #endif
+  for (; i < n; i++) {
+    const Float d = a[i] - b[i];
+    out += d * d;
+  }
+  return out;
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // VecN Initialization ///////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Bytes from the start of a VecN to its first dimension. Keeping this a
+// multiple of SOL_VECN_ALIGN keeps the dimensions aligned in both layouts.
+#define VECN_HEAD ((sizeof(VecN) + SOL_VECN_ALIGN - 1) & ~(size_t) (SOL_VECN_ALIGN - 1))
+
+/// vecn_alloc ///
+// Description
+//   Allocates a zeroed vector with the given number of dimensions. The
+//   dimensions are stored in the same allocation, aligned to SOL_VECN_ALIGN.
+// Arguments
+//   len: dimensions (size_t)
+// Returns
+//   vector (VecN*), or NULL if the allocation fails
+
+sol_inline
+VecN *vecn_alloc(size_t len) {
+  if (len > (SIZE_MAX - VECN_HEAD - SOL_VECN_ALIGN) / sizeof(Float))
+    return NULL;
+  size_t size = VECN_HEAD + len * sizeof(Float);
+  size = (size + SOL_VECN_ALIGN - 1) & ~(size_t) (SOL_VECN_ALIGN - 1);
+  VecN *out = aligned_alloc(SOL_VECN_ALIGN, size);
+  if (!out)
+    return NULL;
+  memset(out, 0, size);
+  out->len = len;
+  #if !defined(SOL_FAM)
+        out->dim = (Float *) ((char *) out + VECN_HEAD);
+  #endif
+  return out;
+}
+
+/// vecn_init ///
+// Description
+//   Allocates a vector and copies its dimensions from an array.
+// Arguments
+//   f: scalars (Float*)
+//   len: dimensions (size_t)
+// Returns
+//   vector (VecN*), or NULL if the allocation fails
+
+sol_inline
+VecN *vecn_init(const Float *f, size_t len) {
+  VecN *out = vecn_alloc(len);
+  if (out && len)
+    memcpy(out->dim, f, len * sizeof(Float));
+  return out;
+}
+
+/// vecn_free ///
+// Description
+//   Frees a vector from vecn_alloc or vecn_init. NULL is ignored.
+// Arguments
+//   v: vector (VecN*)
+// Returns
+//   void
+
+sol_inline
+void vecn_free(VecN *v) {
+  free(v);
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // VecN Math /////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Every vector passed to one call must have the same len. out may alias any
+// of the inputs.
+
+/// vecn_add ///
+// Description
+//   Adds the elements of two vectors.
+// Arguments
+//   out: vector (VecN*)
+//   a: vector (VecN*)
+//   b: vector (VecN*)
+// Returns
+//   void {out.dim = a.dim + b.dim}
+
+sol_inline
+void vecn_add(VecN *out, const VecN *a, const VecN *b) {
+  Float *o = out->dim;
+  const Float *fa = a->dim, *fb = b->dim;
+  size_t i = 0;
+  #if defined(VECN_LANES)
+        for (; i + VECN_LANES <= a->len; i += VECN_LANES)
+          vecn_reg_store(o + i, vecn_reg_add(vecn_reg_load(fa + i), vecn_reg_load(fb + i)));
+  #endif
+  for (; i < a->len; i++)
+    o[i] = fa[i] + fb[i];
+}
+
+/// vecn_mulf ///
+// Description
+//   Multiplies each element of a vector by a scalar.
+// Arguments
+//   out: vector (VecN*)
+//   v: vector (VecN*)
+//   f: scalar (Float)
+// Returns
+//   void {out.dim = v.dim * f}
+
+sol_inline
+void vecn_mulf(VecN *out, const VecN *v, Float f) {
+  Float *o = out->dim;
+  const Float *fv = v->dim;
+  size_t i = 0;
+  #if defined(VECN_LANES)
+        const VecNReg vf = vecn_reg_set1(f);
+        for (; i + VECN_LANES <= v->len; i += VECN_LANES)
+          vecn_reg_store(o + i, vecn_reg_mul(vecn_reg_load(fv + i), vf));
+  #endif
+  for (; i < v->len; i++)
+    o[i] = fv[i] * f;
+}
+
+/// vecn_axpy ///
+// Description
+//   Scales one vector and adds another to it.
+// Arguments
+//   out: vector (VecN*)
+//   x: vector (VecN*)
+//   f: scalar (Float)
+//   y: vector (VecN*)
+// Returns
+//   void {out.dim = x.dim * f + y.dim}
+
+sol_inline
+void vecn_axpy(VecN *out, const VecN *x, Float f, const VecN *y) {
+  Float *o = out->dim;
+  const Float *fx = x->dim, *fy = y->dim;
+  size_t i = 0;
+  #if defined(VECN_LANES)
+        const VecNReg vf = vecn_reg_set1(f);
+        for (; i + VECN_LANES <= x->len; i += VECN_LANES)
+          vecn_reg_store(o + i, vecn_reg_madd(vecn_reg_load(fx + i), vf, vecn_reg_load(fy + i)));
+  #endif
+  for (; i < x->len; i++)
+    o[i] = fx[i] * f + fy[i];
+}
+
+/// vecn_dot ///
+// Description
+//   Gets the dot product of two vectors.
+// Arguments
+//   a: vector (VecN*)
+//   b: vector (VecN*)
+// Returns
+//   scalar (Float)
+
+sol_inline
+Float vecn_dot(const VecN *a, const VecN *b) {
+  return vecn_dot_raw(a->dim, b->dim, a->len);
+}
+
+/// vecn_mag ///
+// Description
+//   Finds the magnitude of a vector.
+// Arguments
+//   v: vector (VecN*)
+// Returns
+//   scalar (Float)
+
+sol_inline
+Float vecn_mag(const VecN *v) {
+  return flt_sqrt(vecn_dot_raw(v->dim, v->dim, v->len));
+}
+
+/// vecn_norm ///
+// Description
+//   Normalizes a vector such that the magnitude is 1.
+// Arguments
+//   out: vector (VecN*)
+//   v: vector (VecN*)
+// Returns
+//   void
+
+sol_inline
+void vecn_norm(VecN *out, const VecN *v) {
+  vecn_mulf(out, v, 1 / vecn_mag(v));
+}
+
+/// vecn_dist ///
+// Description
+//   Finds the Euclidean distance between two vectors.
+// Arguments
+//   a: vector (VecN*)
+//   b: vector (VecN*)
+// Returns
+//   scalar (Float)
+
+sol_inline
+Float vecn_dist(const VecN *a, const VecN *b) {
+  return flt_sqrt(vecn_dist2_raw(a->dim, b->dim, a->len));
+}
+
+/// vecn_cos ///
+// Description
+//   Finds the cosine similarity of two vectors, the cosine of the angle
+//   between them.
+// Arguments
+//   a: vector (VecN*)
+//   b: vector (VecN*)
+// Returns
+//   scalar (Float) {dot(a, b) / (mag(a) * mag(b))}
+
+sol_inline
+Float vecn_cos(const VecN *a, const VecN *b) {
+  const Float ab = vecn_dot_raw(a->dim, b->dim, a->len);
+  const Float aa = vecn_dot_raw(a->dim, a->dim, a->len);
+  const Float bb = vecn_dot_raw(b->dim, b->dim, b->len);
+  return ab / flt_sqrt(aa * bb);
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // VecN Batch Math ///////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+typedef struct {
+  Float *out;
+  const VecN *q;
+  const VecN *const *v;
+} VecNJob;
+
+static
+void vecn_dist_task(void *job, size_t lo, size_t hi) {
+  const VecNJob *j = job;
+  for (size_t i = lo; i < hi; i++)
+    j->out[i] = flt_sqrt(vecn_dist2_raw(j->q->dim, j->v[i]->dim, j->q->len));
+}
+
+/// vecn_dist_array ///
+// Description
+//   Finds the Euclidean distance from one query vector to each of many, the
+//   inner loop of a brute-force nearest neighbor search.
+// Arguments
+//   out: scalars (Float*)
+//   q: vector (VecN*)
+//   v: vectors (VecN**)
+//   n: count (size_t)
+// Returns
+//   void {out[i] = dist(q, v[i])}
+
+sol_inline
+void vecn_dist_array(Float *out, const VecN *q, const VecN *const *v, size_t n) {
+  VecNJob j = {out, q, v};
+  sol_parallel_for(n, q->len * sizeof(Float) + sizeof(Float), vecn_dist_task, &j);
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // VecN Nearest Neighbors ////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// The search is blocked so that every database vector loaded from memory is
+// used many times. The database is walked in tiles of about VECN_TILE bytes,
+// which stay in L2 while every query of a task passes over them, and queries
+// are scored four at a time so that each load of a database lane feeds four
+// FMAs. Squared L2 distances come from ||q||^2 + ||d||^2 - 2 q.d, with the
+// database norms computed once up front. Each query keeps the k best hits in
+// a max-heap keyed so that smaller is better, and tasks split the queries.
+
+#define VECN_TILE ((size_t) 256 * 1024)
+
+typedef struct {
+  Float key;
+  size_t index;
+} VecNHit;
+
+typedef struct {
+  size_t *idx;
+  Float *score;
+  size_t k;
+  const VecN *const *q;
+  const VecN *const *db;
+  size_t n;
+  Float *norm; // Squared database norms, for L2.
+  VecNHit *heap; // k per query.
+  size_t *fill; // Heap sizes.
+  Float *qn; // Squared query norms, for L2.
+  bool ip;
+} VecNKnnJob;
+
+// Scores four queries against one database vector.
+static inline
+void vecn_dot4_raw(const Float *const *q, const Float *d, size_t len, Float *out) {
+  Float s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+  size_t i = 0;
+  #if defined(VECN_LANES)
+        VecNReg a0 = vecn_reg_zero(), a1 = a0, a2 = a0, a3 = a0;
+        for (; i + VECN_LANES <= len; i += VECN_LANES) {
+          const VecNReg v = vecn_reg_load(d + i);
+          a0 = vecn_reg_madd(vecn_reg_load(q[0] + i), v, a0);
+          a1 = vecn_reg_madd(vecn_reg_load(q[1] + i), v, a1);
+          a2 = vecn_reg_madd(vecn_reg_load(q[2] + i), v, a2);
+          a3 = vecn_reg_madd(vecn_reg_load(q[3] + i), v, a3);
+        }
+        s0 = vecn_reg_sum(a0);
+        s1 = vecn_reg_sum(a1);
+        s2 = vecn_reg_sum(a2);
+        s3 = vecn_reg_sum(a3);
+  #endif
+  for (; i < len; i++) {
+    s0 += q[0][i] * d[i];
+    s1 += q[1][i] * d[i];
+    s2 += q[2][i] * d[i];
+    s3 += q[3][i] * d[i];
+  }
+  out[0] = s0;
+  out[1] = s1;
+  out[2] = s2;
+  out[3] = s3;
+}
+
+static inline
+bool vecn_hit_less(VecNHit a, VecNHit b) {
+  return a.key < b.key || (a.key == b.key && a.index < b.index);
+}
+
+static
+void vecn_hit_down(VecNHit *h, size_t len, size_t i) {
+  for (;;) {
+    size_t top = i;
+    const size_t l = i * 2 + 1, r = l + 1;
+    if (l < len && vecn_hit_less(h[top], h[l]))
+      top = l;
+    if (r < len && vecn_hit_less(h[top], h[r]))
+      top = r;
+    if (top == i)
+      return;
+    const VecNHit t = h[i];
+    h[i] = h[top];
+    h[top] = t;
+    i = top;
+  }
+}
+
+// Offers a hit to a heap of at most k entries holding the k smallest keys.
+static inline
+void vecn_hit_push(VecNHit *h, size_t *len, size_t k, VecNHit hit) {
+  if (*len < k) {
+    size_t i = (*len)++;
+    while (i && vecn_hit_less(h[(i - 1) / 2], hit)) {
+      h[i] = h[(i - 1) / 2];
+      i = (i - 1) / 2;
+    }
+    h[i] = hit;
+  } else if (vecn_hit_less(hit, h[0])) {
+    h[0] = hit;
+    vecn_hit_down(h, k, 0);
+  }
+}
+
+static
+void vecn_norm_task(void *job, size_t lo, size_t hi) {
+  const VecNKnnJob *j = job;
+  for (size_t i = lo; i < hi; i++)
+    j->norm[i] = vecn_dot_raw(j->db[i]->dim, j->db[i]->dim, j->db[i]->len);
+}
+
+static
+void vecn_knn_task(void *job, size_t lo, size_t hi) {
+  const VecNKnnJob *j = job;
+  const size_t k = j->k, len = j->q[lo]->len, m = hi - lo;
+  VecNHit *heap = j->heap + lo * k;
+  size_t *fill = j->fill + lo;
+  Float *qn = j->qn + lo;
+  for (size_t i = 0; i < m; i++) {
+    fill[i] = 0;
+    qn[i] = j->ip ? 0 : vecn_dot_raw(j->q[lo + i]->dim, j->q[lo + i]->dim, len);
+  }
+  size_t tile = VECN_TILE / (len * sizeof(Float) + 1);
+  tile = tile ? tile : 1;
+  for (size_t t = 0; t < j->n; t += tile) {
+    const size_t t_end = t + tile < j->n ? t + tile : j->n;
+    for (size_t g = 0; g < m; g += 4) {
+      // Short groups repeat their last query; the extra lanes are dropped.
+      const Float *q[4];
+      for (size_t c = 0; c < 4; c++)
+        q[c] = j->q[lo + (g + c < m ? g + c : m - 1)]->dim;
+      for (size_t d = t; d < t_end; d++) {
+        Float dot[4];
+        vecn_dot4_raw(q, j->db[d]->dim, len, dot);
+        for (size_t c = 0; c < 4 && g + c < m; c++) {
+          VecNHit hit = {-dot[c], d};
+          if (!j->ip) {
+            hit.key = qn[g + c] + j->norm[d] - 2 * dot[c];
+            hit.key = hit.key < 0 ? 0 : hit.key;
+          }
+          vecn_hit_push(heap + (g + c) * k, &fill[g + c], k, hit);
+        }
+      }
+    }
+  }
+  for (size_t i = 0; i < m; i++) {
+    VecNHit *h = heap + i * k;
+    for (size_t e = fill[i]; e > 1; e--) {
+      const VecNHit top = h[0];
+      h[0] = h[e - 1];
+      h[e - 1] = top;
+      vecn_hit_down(h, e - 1, 0);
+    }
+    size_t *idx = j->idx + (lo + i) * k;
+    Float *score = j->score + (lo + i) * k;
+    for (size_t e = 0; e < k; e++) {
+      idx[e] = e < fill[i] ? h[e].index : SIZE_MAX;
+      if (j->ip)
+        score[e] = e < fill[i] ? -h[e].key : -INFINITY;
+      else
+        score[e] = e < fill[i] ? h[e].key : INFINITY;
+    }
+  }
+}
+
+// Runs the search, with every task's scratch allocated up front so that a
+// failure leaves no row half written.
+static
+bool vecn_knn_run(VecNKnnJob *j, size_t nq) {
+  if (nq == 0 || j->k == 0)
+    return true;
+  const size_t len = j->q[0]->len;
+  j->norm = !j->ip && j->n ? malloc(j->n * sizeof(Float)) : NULL;
+  j->heap = malloc(nq * j->k * sizeof(VecNHit));
+  j->fill = malloc(nq * sizeof(size_t));
+  j->qn = malloc(nq * sizeof(Float));
+  const bool ok = (j->norm || j->ip || !j->n) && j->heap && j->fill && j->qn;
+  if (ok) {
+    if (j->norm)
+      sol_parallel_for(j->n, len * sizeof(Float), vecn_norm_task, j);
+    sol_parallel_for(nq, j->n * len * sizeof(Float), vecn_knn_task, j);
+  }
+  free(j->norm);
+  free(j->heap);
+  free(j->fill);
+  free(j->qn);
+  return ok;
+}
+
+/// vecn_knn_l2 ///
+// Description
+//   Finds the k nearest database vectors to each query by Euclidean
+//   distance, with an exhaustive blocked search. Rows of the output are
+//   sorted nearest first, ties going to the lower index; rows with fewer than
+//   k hits are padded with SIZE_MAX and infinity. All vectors must have the
+//   same len.
+// Arguments
+//   idx: indices (size_t[nq * k])
+//   dist: squared distances (Float[nq * k])
+//   k: neighbors per query (size_t)
+//   q: query vectors (VecN**)
+//   nq: query count (size_t)
+//   db: database vectors (VecN**)
+//   n: database count (size_t)
+// Returns
+//   false if allocation fails, leaving idx and dist unspecified (bool)
+//   {idx[i * k + j] = j-th nearest db vector to q[i]}
+
+sol_inline
+bool vecn_knn_l2(size_t *idx, Float *dist, size_t k, const VecN *const *q, size_t nq,
+                 const VecN *const *db, size_t n) {
+  VecNKnnJob j = {idx, dist, k, q, db, n, NULL, NULL, NULL, NULL, false};
+  return vecn_knn_run(&j, nq);
+}
+
+/// vecn_knn_ip ///
+// Description
+//   Finds the k database vectors with the largest inner product with each
+//   query, which is cosine similarity when the vectors are normalized. Output
+//   is laid out as in vecn_knn_l2, best first, padded with -infinity.
+// Arguments
+//   idx: indices (size_t[nq * k])
+//   score: inner products (Float[nq * k])
+//   k: neighbors per query (size_t)
+//   q: query vectors (VecN**)
+//   nq: query count (size_t)
+//   db: database vectors (VecN**)
+//   n: database count (size_t)
+// Returns
+//   false if allocation fails, leaving idx and score unspecified (bool)
+//   {idx[i * k + j] = db vector with the j-th largest dot with q[i]}
+
+sol_inline
+bool vecn_knn_ip(size_t *idx, Float *score, size_t k, const VecN *const *q, size_t nq,
+                 const VecN *const *db, size_t n) {
+  VecNKnnJob j = {idx, score, k, q, db, n, NULL, NULL, NULL, NULL, true};
+  return vecn_knn_run(&j, nq);
+}
@@ -0,0 +1,1394 @@
+    /////////////////////////////////////////////////////////////////
+   // sol_vox.c ////////////////////////////////////////////////////
+  // Description: Adds voxel grids to Sol. ////////////////////////
+ // Author: David Garland (https://github.com/davidgarland/sol) //
+/////////////////////////////////////////////////////////////////
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Local Headers /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include "../sol.h"
+#include "sol_simd.h"
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Standard Headers //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Voxelizer Types ///////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Triangles are worked on in grid units, where voxel (x, y, z) is the box of
+// half size 1/2 around (x + 1/2, y + 1/2, z + 1/2). A triangle overlaps a box
+// unless one of 13 axes separates them (Akenine-Moller): the three box axes,
+// the triangle's normal and the nine crosses of a box axis with an edge. For
+// one row of voxels along x, every axis leaves a range of box centres along
+// the row, so the voxels a triangle touches in a row are a run that falls
+// straight out of the axes without testing any voxel on its own.
+//
+// The y and z box axes pick the rows, the other axes are kept as VoxAxis: an
+// axis with an x component bounds the run at both ends, one without just
+// keeps or drops the whole row.
+
+#define VOX_AXES 11
+
+typedef struct {
+  Float b, c; // y and z components of the axis.
+  Float lo, hi; // Triangle's projection, grown by the box's.
+  Float inv; // 1 / the x component, or 0 for axes without one.
+} VoxAxis;
+
+typedef struct {
+  Float p[3][3]; // Corners in grid units.
+  Float lo[3], hi[3];
+  VoxAxis axis[VOX_AXES];
+  size_t runs; // Axes [0, runs) bound the run; the rest keep or drop rows.
+} VoxTri;
+
+typedef struct {
+  SolVoxels *g;
+  const Vec3p *v;
+  const uint32_t *idx;
+  size_t *start; // Triangles touching slice z are list[start[z] .. start[z + 1]).
+  uint32_t *list;
+  bool surface; // Set the voxels the triangles touch.
+  bool solid; // Set the voxels whose centres are inside.
+} VoxJob;
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Row Kernel ////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// A SimdReg holds the runs of SIMD_LANES rows of a slice at once, each lane
+// with its own y; everything else about the triangle is the same across
+// lanes. The field kernels further down use it for SIMD_LANES samples of a
+// row.
+
+// Writes a triangle's corners in grid units.
+static inline
+void vox_corners(Float p[3][3], const VoxJob *j, size_t i) {
+  const SolVoxels *g = j->g;
+  const Float inv = 1 / g->size;
+  for (size_t k = 0; k < 3; k++) {
+    const Vec3p v = j->v[j->idx[3 * i + k]];
+    p[k][0] = (v.x - g->origin.x) * inv;
+    p[k][1] = (v.y - g->origin.y) * inv;
+    p[k][2] = (v.z - g->origin.z) * inv;
+  }
+}
+
+// Sets up a triangle's corners, bounds and axes.
+static
+void vox_tri(VoxTri *t, const VoxJob *j, size_t i) {
+  vox_corners(t->p, j, i);
+  Float e[3][3], a[VOX_AXES][3];
+  for (size_t d = 0; d < 3; d++) {
+    t->lo[d] = t->p[0][d];
+    t->hi[d] = t->p[0][d];
+    for (size_t k = 1; k < 3; k++) {
+      t->lo[d] = t->p[k][d] < t->lo[d] ? t->p[k][d] : t->lo[d];
+      t->hi[d] = t->p[k][d] > t->hi[d] ? t->p[k][d] : t->hi[d];
+    }
+    for (size_t k = 0; k < 3; k++)
+      e[k][d] = t->p[(k + 1) % 3][d] - t->p[k][d];
+  }
+  a[0][0] = 1;
+  a[0][1] = a[0][2] = 0;
+  a[1][0] = e[0][1] * e[1][2] - e[0][2] * e[1][1];
+  a[1][1] = e[0][2] * e[1][0] - e[0][0] * e[1][2];
+  a[1][2] = e[0][0] * e[1][1] - e[0][1] * e[1][0];
+  for (size_t k = 0; k < 3; k++) {
+    // x, y and z crossed with edge k.
+    a[2 + 3 * k][0] = 0;
+    a[2 + 3 * k][1] = -e[k][2];
+    a[2 + 3 * k][2] = e[k][1];
+    a[3 + 3 * k][0] = e[k][2];
+    a[3 + 3 * k][1] = 0;
+    a[3 + 3 * k][2] = -e[k][0];
+    a[4 + 3 * k][0] = -e[k][1];
+    a[4 + 3 * k][1] = e[k][0];
+    a[4 + 3 * k][2] = 0;
+  }
+  // Runs first, then the rest from the back.
+  size_t runs = 0, rows = VOX_AXES;
+  for (size_t k = 0; k < VOX_AXES; k++) {
+    Float lo = INFINITY, hi = -INFINITY;
+    for (size_t c = 0; c < 3; c++) {
+      const Float q = a[k][0] * t->p[c][0] + a[k][1] * t->p[c][1] + a[k][2] * t->p[c][2];
+      lo = q < lo ? q : lo;
+      hi = q > hi ? q : hi;
+    }
+    Float r = 0;
+    for (size_t d = 0; d < 3; d++)
+      r += a[k][d] < 0 ? -a[k][d] : a[k][d];
+    r /= 2;
+    VoxAxis *x = a[k][0] != 0 ? t->axis + runs++ : t->axis + --rows;
+    x->b = a[k][1];
+    x->c = a[k][2];
+    x->lo = lo - r;
+    x->hi = hi + r;
+    x->inv = a[k][0] != 0 ? 1 / a[k][0] : 0;
+  }
+  t->runs = runs;
+}
+
+// Writes the run of box centres along x that a triangle overlaps in n rows
+// from row y of slice z, as [lo, hi] with lo > hi for none.
+static inline
+void vox_runs(Float *lo, Float *hi, const VoxTri *t, size_t y, size_t z, size_t n) {
+  const Float cz = (Float) z + (Float) 0.5;
+  Float cy[SIMD_LANES];
+  for (size_t k = 0; k < SIMD_LANES; k++)
+    cy[k] = (Float) (y + k) + (Float) 0.5;
+  #if SIMD_LANES > 1
+        const SimdReg zero = simd_set1(0), y4 = simd_load(cy);
+        SimdReg rl = simd_set1(-INFINITY), rh = simd_set1(INFINITY);
+        SimdReg keep = simd_le(zero, zero);
+        for (size_t k = 0; k < VOX_AXES; k++) {
+          const VoxAxis *a = t->axis + k;
+          const SimdReg b = simd_set1(a->b);
+          const SimdReg l = simd_sub(simd_set1(a->lo - a->c * cz), simd_mul(b, y4));
+          const SimdReg h = simd_sub(simd_set1(a->hi - a->c * cz), simd_mul(b, y4));
+          if (k < t->runs) {
+            const SimdReg inv = simd_set1(a->inv);
+            const SimdReg p = simd_mul(l, inv), q = simd_mul(h, inv);
+            // A NaN from an overflowed inverse keeps the old bound.
+            rl = simd_max(simd_min(p, q), rl);
+            rh = simd_min(simd_max(p, q), rh);
+          } else {
+            keep = simd_and(keep, simd_and(simd_le(l, zero), simd_le(zero, h)));
+          }
+        }
+        const unsigned bits = (unsigned) simd_bits(keep);
+        Float l4[SIMD_LANES], h4[SIMD_LANES];
+        simd_store(l4, rl);
+        simd_store(h4, rh);
+        for (size_t k = 0; k < n; k++) {
+          lo[k] = (bits >> k) & 1 ? l4[k] : INFINITY;
+          hi[k] = h4[k];
+        }
+  #else
+        (void) n;
+        Float rl = -INFINITY, rh = INFINITY;
+        for (size_t k = 0; k < VOX_AXES; k++) {
+          const VoxAxis *a = t->axis + k;
+          const Float l = a->lo - a->c * cz - a->b * cy[0];
+          const Float h = a->hi - a->c * cz - a->b * cy[0];
+          if (k < t->runs) {
+            const Float p = l * a->inv, q = h * a->inv;
+            rl = (p < q ? p : q) > rl ? (p < q ? p : q) : rl;
+            rh = (p > q ? p : q) < rh ? (p > q ? p : q) : rh;
+          } else if (!(l <= 0 && 0 <= h)) {
+            rl = INFINITY;
+          }
+        }
+        lo[0] = rl;
+        hi[0] = rh;
+  #endif
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Voxelizer Helpers /////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Clamps the cells [ceil(lo), floor(hi)] to [0, n), false if none are left.
+static inline
+bool vox_range(size_t *a, size_t *b, Float lo, Float hi, size_t n) {
+  lo = flt_ceil(lo);
+  hi = flt_floor(hi);
+  if (!(lo <= hi) || hi < 0 || lo >= (Float) n || n == 0)
+    return false;
+  *a = lo > 0 ? (size_t) lo : 0;
+  *b = hi < (Float) (n - 1) ? (size_t) hi : n - 1;
+  return true;
+}
+
+// Sets bits [a, b] of a row.
+static inline
+void vox_fill(uint64_t *row, size_t a, size_t b) {
+  const size_t wa = a / 64, wb = b / 64;
+  const uint64_t ma = ~(uint64_t) 0 << (a % 64), mb = ~(uint64_t) 0 >> (63 - b % 64);
+  if (wa == wb) {
+    row[wa] |= ma & mb;
+    return;
+  }
+  row[wa] |= ma;
+  for (size_t w = wa + 1; w < wb; w++)
+    row[w] = ~(uint64_t) 0;
+  row[wb] |= mb;
+}
+
+// The yz edge function of ab at (u, w), worked out from the same end of the
+// edge whichever way round it is given so that two triangles sharing an edge
+// get exactly opposite values.
+static inline
+Float vox_edge(const Float a[3], const Float b[3], Float u, Float w) {
+  if (a[1] < b[1] || (a[1] == b[1] && a[2] < b[2]))
+    return (b[1] - a[1]) * (w - a[2]) - (b[2] - a[2]) * (u - a[1]);
+  return -((a[1] - b[1]) * (w - b[2]) - (a[2] - b[2]) * (u - b[1]));
+}
+
+// Whether a counterclockwise triangle owns its edge from a to b when a line
+// runs exactly through it: of the two ways round an edge, exactly one does,
+// so a line through an edge shared by two triangles crosses one of them.
+static inline
+bool vox_owns(const Float a[3], const Float b[3]) {
+  return b[2] > a[2] || (b[2] == a[2] && b[1] > a[1]);
+}
+
+// Toggles the first voxel of row y past each point where the line through
+// the row's centres crosses the triangle, so that a prefix parity over the
+// row is set exactly inside a closed mesh.
+static
+void vox_cross(uint64_t *rows, const SolVoxels *g, const Float p[3][3], size_t z) {
+  const Float area = (p[1][1] - p[0][1]) * (p[2][2] - p[0][2]) - (p[1][2] - p[0][2]) * (p[2][1] - p[0][1]);
+  if (area == 0)
+    return;
+  const Float s = area > 0 ? 1 : -1;
+  const Float cz = (Float) z + (Float) 0.5;
+  const Float lo = p[0][1] < p[1][1] ? (p[0][1] < p[2][1] ? p[0][1] : p[2][1]) : (p[1][1] < p[2][1] ? p[1][1] : p[2][1]);
+  const Float hi = p[0][1] > p[1][1] ? (p[0][1] > p[2][1] ? p[0][1] : p[2][1]) : (p[1][1] > p[2][1] ? p[1][1] : p[2][1]);
+  size_t a, b;
+  if (!vox_range(&a, &b, lo - (Float) 0.5, hi - (Float) 0.5, g->ny))
+    return;
+  for (size_t y = a; y <= b; y++) {
+    const Float cy = (Float) y + (Float) 0.5;
+    Float e[3];
+    bool in = true;
+    for (size_t k = 0; k < 3 && in; k++) {
+      const Float *u = p[(k + 1) % 3], *v = p[(k + 2) % 3]; // Edge opposite corner k.
+      e[k] = s * vox_edge(u, v, cy, cz);
+      in = e[k] > 0 || (e[k] == 0 && (s > 0 ? vox_owns(u, v) : vox_owns(v, u)));
+    }
+    if (!in)
+      continue;
+    const Float x = (e[0] * p[0][0] + e[1] * p[1][0] + e[2] * p[2][0]) / (e[0] + e[1] + e[2]);
+    const Float first = flt_floor(x - (Float) 0.5) + 1;
+    if (!(first < (Float) g->nx))
+      continue;
+    const size_t i = first > 0 ? (size_t) first : 0;
+    rows[y * g->words + i / 64] ^= (uint64_t) 1 << (i % 64);
+  }
+}
+
+// Turns each row's toggles into the parity of all toggles up to each voxel.
+static
+void vox_parity(uint64_t *rows, const SolVoxels *g) {
+  for (size_t y = 0; y < g->ny; y++) {
+    uint64_t *row = rows + y * g->words, carry = 0;
+    for (size_t w = 0; w < g->words; w++) {
+      uint64_t x = row[w];
+      x ^= x << 1;
+      x ^= x << 2;
+      x ^= x << 4;
+      x ^= x << 8;
+      x ^= x << 16;
+      x ^= x << 32;
+      x ^= carry;
+      carry = (uint64_t) 0 - (x >> 63);
+      row[w] = x;
+    }
+    if (g->nx % 64)
+      row[g->words - 1] &= ~(uint64_t) 0 >> (64 - g->nx % 64);
+  }
+}
+
+// Buckets the triangles by the slices their boxes touch, grown by grow
+// slices each way. The first pass counts into start[z + 2], the second fills
+// slice z through start[z + 1], which leaves it where slice z + 1 begins.
+static
+bool vox_bucket(VoxJob *j, size_t n, size_t grow) {
+  const size_t nz = j->g->nz;
+  size_t *start = calloc(nz + 2, sizeof(size_t));
+  uint32_t *list = NULL;
+  if (!start)
+    return false;
+  for (int pass = 0; pass < 2; pass++) {
+    for (size_t i = 0; i < n; i++) {
+      Float p[3][3];
+      size_t a, b;
+      vox_corners(p, j, i);
+      const Float lo = p[0][2] < p[1][2] ? (p[0][2] < p[2][2] ? p[0][2] : p[2][2]) : (p[1][2] < p[2][2] ? p[1][2] : p[2][2]);
+      const Float hi = p[0][2] > p[1][2] ? (p[0][2] > p[2][2] ? p[0][2] : p[2][2]) : (p[1][2] > p[2][2] ? p[1][2] : p[2][2]);
+      if (!vox_range(&a, &b, lo - 1 - (Float) grow, hi + (Float) grow, nz))
+        continue;
+      for (size_t z = a; z <= b; z++) {
+        if (pass)
+          list[start[z + 1]++] = (uint32_t) i;
+        else
+          start[z + 2]++;
+      }
+    }
+    if (pass)
+      break;
+    for (size_t z = 0; z < nz; z++)
+      start[z + 2] += start[z + 1];
+    list = malloc((start[nz + 1] ? start[nz + 1] : 1) * sizeof(uint32_t));
+    if (!list) {
+      free(start);
+      return false;
+    }
+  }
+  j->start = start;
+  j->list = list;
+  return true;
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Voxelizer Tasks ///////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Each slice of the grid is filled by one task from its own triangle list,
+// so tasks never write the same word.
+static
+void vox_slice_task(void *ctx, size_t lo, size_t hi) {
+  const VoxJob *j = ctx;
+  SolVoxels *g = j->g;
+  VoxTri t;
+  Float rl[SIMD_LANES], rh[SIMD_LANES];
+  for (size_t z = lo; z < hi; z++) {
+    uint64_t *rows = g->bits + z * g->ny * g->words;
+    memset(rows, 0, g->ny * g->words * sizeof(uint64_t));
+    if (j->solid) {
+      for (size_t s = j->start[z]; s < j->start[z + 1]; s++) {
+        vox_corners(t.p, j, j->list[s]);
+        vox_cross(rows, g, (const Float (*)[3]) t.p, z);
+      }
+      vox_parity(rows, g);
+    }
+    for (size_t s = j->start[z]; s < j->start[z + 1] && j->surface; s++) {
+      size_t a, b;
+      vox_tri(&t, j, j->list[s]);
+      if (!vox_range(&a, &b, t.lo[1] - 1, t.hi[1], g->ny))
+        continue;
+      for (size_t y = a; y <= b; y += SIMD_LANES) {
+        const size_t n = b - y + 1 < SIMD_LANES ? b - y + 1 : SIMD_LANES;
+        vox_runs(rl, rh, &t, y, z, n);
+        for (size_t k = 0; k < n; k++) {
+          size_t x0, x1;
+          if (vox_range(&x0, &x1, rl[k] - (Float) 0.5, rh[k] - (Float) 0.5, g->nx))
+            vox_fill(rows + (y + k) * g->words, x0, x1);
+        }
+      }
+    }
+  }
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Voxel Functions ///////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+/// sol_voxels_init ///
+// Description
+//   Creates an empty voxel grid.
+// Arguments
+//   origin: lowest corner of the grid (Vec3)
+//   size: voxel edge length (Float)
+//   nx, ny, nz: voxel counts along each axis (size_t)
+// Returns
+//   grid (SolVoxels*), or NULL if allocation fails
+
+sol_inline
+SolVoxels *sol_voxels_init(Vec3 origin, Float size, size_t nx, size_t ny, size_t nz) {
+  SolVoxels *g = malloc(sizeof(SolVoxels));
+  if (!g)
+    return NULL;
+  g->words = (nx + 63) / 64;
+  g->nx = nx;
+  g->ny = ny;
+  g->nz = nz;
+  g->origin = origin;
+  g->size = size;
+  const size_t words = g->words * ny * nz;
+  g->bits = calloc(words ? words : 1, sizeof(uint64_t));
+  if (!g->bits) {
+    free(g);
+    return NULL;
+  }
+  return g;
+}
+
+/// sol_voxels_free ///
+// Description
+//   Frees a voxel grid.
+// Arguments
+//   g: grid (SolVoxels*)
+// Returns
+//   void
+
+sol_inline
+void sol_voxels_free(SolVoxels *g) {
+  if (!g)
+    return;
+  free(g->bits);
+  free(g);
+}
+
+/// sol_voxels_get ///
+// Description
+//   Reads one voxel of a grid.
+// Arguments
+//   g: grid (SolVoxels*)
+//   x, y, z: voxel, inside the grid (size_t)
+// Returns
+//   whether the voxel is set (bool)
+
+sol_inline
+bool sol_voxels_get(const SolVoxels *g, size_t x, size_t y, size_t z) {
+  return (g->bits[(z * g->ny + y) * g->words + x / 64] >> (x % 64)) & 1;
+}
+
+/// sol_voxelize ///
+// Description
+//   Replaces a grid's voxels with those a triangle mesh touches, exactly by
+//   the separating axis test; voxels that only touch a triangle on a face,
+//   edge or corner count. With solid set, voxels whose centres are inside the
+//   mesh are set as well, by the parity of crossings along each row; the mesh
+//   should then be closed, though its triangles may face either way. The grid
+//   is filled a slice along z at a time, in parallel.
+// Arguments
+//   g: grid (SolVoxels*)
+//   v: vertices (Vec3p*)
+//   idx: three vertex indices per triangle (uint32_t*)
+//   n: triangle count, below 2^32 (size_t)
+//   solid: whether to fill the inside (bool)
+// Returns
+//   false if allocation fails, leaving the grid untouched (bool)
+
+sol_inline
+bool sol_voxelize(SolVoxels *g, const Vec3p *v, const uint32_t *idx, size_t n, bool solid) {
+  VoxJob j = {g, v, idx, NULL, NULL, true, solid};
+  if (!vox_bucket(&j, n, 0))
+    return false;
+  sol_parallel_for(g->nz, g->ny * g->words * sizeof(uint64_t) + sizeof(VoxTri), vox_slice_task, &j);
+  free(j.list);
+  free(j.start);
+  return true;
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Field Types ///////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// While a field is built, every sample keeps the nearest site it has found
+// so far, a point on the mesh or one of the points, with INFINITY for none,
+// and the squared distance to it in d. Sweeps along x, y and z, each way,
+// hand a sample's site on to its neighbour whenever the neighbour finds it
+// nearer than its own, which carries every site out across its Voronoi cell
+// in passes over independent rows. A site can be cut off by a nearer one on
+// the way to a sample past it, so samples far from any seed may end up with
+// a slightly long distance; a second round of sweeps mends most of those.
+// Seeded samples are always exact.
+
+#define FIELD_ROUNDS 2
+
+typedef struct {
+  SolField *f;
+  Float *s[3]; // Site of each sample.
+} FieldJob;
+
+typedef struct {
+  FieldJob *j;
+  const VoxJob *v;
+  size_t band;
+  size_t *count; // Band samples per slice, then the first of each slice.
+  Vec3p *p; // Band samples.
+  size_t *cell;
+} FieldBand;
+
+typedef struct {
+  const Vec3p *v;
+  const uint32_t *idx;
+  const size_t *tri;
+  const Vec3p *p;
+  Soa3 q, a, b, c;
+} FieldNear;
+
+typedef struct {
+  FieldJob *j;
+  const Vec3p *p;
+  const size_t *cell;
+  Soa3 near;
+} FieldSeed;
+
+typedef struct {
+  const SolField *f;
+  const Vec3p *p;
+  Float *d;
+  Vec3p *grad;
+} FieldSample;
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Field Kernels /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+static inline
+Float field_centre(const SolField *f, size_t i, size_t axis) {
+  const Float o = axis == 0 ? f->origin.x : (axis == 1 ? f->origin.y : f->origin.z);
+  return o + ((Float) i + (Float) 0.5) * f->size;
+}
+
+// Hands the sites of the row at src on to the row at dst where they are
+// nearer, for a row whose samples are at y = cy and z = cz.
+static inline
+void field_pull(const FieldJob *j, size_t dst, size_t src, Float cy, Float cz) {
+  const SolField *f = j->f;
+  Float *d = f->d + dst, *sx = j->s[0] + dst, *sy = j->s[1] + dst, *sz = j->s[2] + dst;
+  const Float *tx = j->s[0] + src, *ty = j->s[1] + src, *tz = j->s[2] + src;
+  size_t x = 0;
+  #if SIMD_LANES > 1
+        const SimdReg y = simd_set1(cy), z = simd_set1(cz);
+        Float cx[SIMD_LANES];
+        for (; x + SIMD_LANES <= f->nx; x += SIMD_LANES) {
+          for (size_t k = 0; k < SIMD_LANES; k++)
+            cx[k] = field_centre(f, x + k, 0);
+          const SimdReg px = simd_load(tx + x), py = simd_load(ty + x), pz = simd_load(tz + x);
+          const SimdReg ex = simd_sub(simd_load(cx), px), ey = simd_sub(y, py), ez = simd_sub(z, pz);
+          const SimdReg dd = simd_add(simd_add(simd_mul(ex, ex), simd_mul(ey, ey)), simd_mul(ez, ez));
+          const SimdReg old = simd_load(d + x);
+          const SimdReg m = simd_lt(dd, old);
+          simd_store(d + x, simd_sel(m, dd, old));
+          simd_store(sx + x, simd_sel(m, px, simd_load(sx + x)));
+          simd_store(sy + x, simd_sel(m, py, simd_load(sy + x)));
+          simd_store(sz + x, simd_sel(m, pz, simd_load(sz + x)));
+        }
+  #endif
+  for (; x < f->nx; x++) {
+    const Float ex = field_centre(f, x, 0) - tx[x], ey = cy - ty[x], ez = cz - tz[x];
+    const Float dd = ex * ex + ey * ey + ez * ez;
+    if (dd < d[x]) {
+      d[x] = dd;
+      sx[x] = tx[x];
+      sy[x] = ty[x];
+      sz[x] = tz[x];
+    }
+  }
+}
+
+// Trilinear interpolation of the eight samples around a point, c[k] being
+// the one at offset (k & 1, k >> 1 & 1, k >> 2) and t the point's position
+// between them, with the gradient scaled by inv.
+static inline
+void field_lerp(Float *d, Float g[3], const Float c[8], const Float t[3], Float inv) {
+  const Float x0 = c[0] + (c[1] - c[0]) * t[0], x1 = c[2] + (c[3] - c[2]) * t[0];
+  const Float x2 = c[4] + (c[5] - c[4]) * t[0], x3 = c[6] + (c[7] - c[6]) * t[0];
+  const Float y0 = x0 + (x1 - x0) * t[1], y1 = x2 + (x3 - x2) * t[1];
+  *d = y0 + (y1 - y0) * t[2];
+  const Float dx0 = (c[1] - c[0]) + ((c[3] - c[2]) - (c[1] - c[0])) * t[1];
+  const Float dx1 = (c[5] - c[4]) + ((c[7] - c[6]) - (c[5] - c[4])) * t[1];
+  g[0] = (dx0 + (dx1 - dx0) * t[2]) * inv;
+  g[1] = ((x1 - x0) + ((x3 - x2) - (x1 - x0)) * t[2]) * inv;
+  g[2] = (y1 - y0) * inv;
+}
+
+// Finds the eight samples around a point, clamped to the field, and the
+// point's position between them.
+static inline
+void field_corners(Float c[8], Float t[3], const SolField *f, Vec3p p) {
+  const Float u[3] = {
+    (p.x - f->origin.x) / f->size - (Float) 0.5,
+    (p.y - f->origin.y) / f->size - (Float) 0.5,
+    (p.z - f->origin.z) / f->size - (Float) 0.5
+  };
+  const size_t n[3] = {f->nx, f->ny, f->nz};
+  size_t i[3], step[3];
+  for (size_t k = 0; k < 3; k++) {
+    const Float top = (Float) (n[k] - 1);
+    const Float w = u[k] > 0 ? (u[k] < top ? u[k] : top) : 0; // NaN goes to 0.
+    i[k] = (size_t) w;
+    if (i[k] + 1 >= n[k] && i[k] > 0)
+      i[k]--;
+    t[k] = w - (Float) i[k];
+    step[k] = n[k] > 1;
+  }
+  const size_t base = (i[2] * f->ny + i[1]) * f->nx + i[0];
+  const size_t sx = step[0], sy = step[1] * f->nx, sz = step[2] * f->nx * f->ny;
+  for (size_t k = 0; k < 8; k++)
+    c[k] = f->d[base + (k & 1) * sx + (k >> 1 & 1) * sy + (k >> 2) * sz];
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Field Tasks ///////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Clears slices, then marks d = 0 for the samples within band of a
+// triangle's box when building from a mesh.
+static
+void field_band_task(void *ctx, size_t lo, size_t hi) {
+  const FieldBand *b = ctx;
+  const SolField *f = b->j->f;
+  const size_t slice = f->nx * f->ny;
+  for (size_t z = lo; z < hi; z++) {
+    const size_t base = z * slice;
+    for (size_t i = 0; i < slice; i++) {
+      f->d[base + i] = INFINITY;
+      b->j->s[0][base + i] = b->j->s[1][base + i] = b->j->s[2][base + i] = INFINITY;
+    }
+    if (!b->v)
+      continue;
+    const Float band = (Float) b->band + (Float) 0.5;
+    size_t count = 0;
+    for (size_t s = b->v->start[z]; s < b->v->start[z + 1]; s++) {
+      Float p[3][3], tl[3], th[3];
+      size_t r[3][2];
+      vox_corners(p, b->v, b->v->list[s]);
+      for (size_t d = 0; d < 3; d++) {
+        tl[d] = p[0][d] < p[1][d] ? (p[0][d] < p[2][d] ? p[0][d] : p[2][d]) : (p[1][d] < p[2][d] ? p[1][d] : p[2][d]);
+        th[d] = p[0][d] > p[1][d] ? (p[0][d] > p[2][d] ? p[0][d] : p[2][d]) : (p[1][d] > p[2][d] ? p[1][d] : p[2][d]);
+      }
+      const size_t n[3] = {f->nx, f->ny, f->nz};
+      bool in = true;
+      for (size_t d = 0; d < 3 && in; d++)
+        in = vox_range(&r[d][0], &r[d][1], tl[d] - band, th[d] + (Float) b->band - (Float) 0.5, n[d]);
+      if (!in || z < r[2][0] || z > r[2][1])
+        continue;
+      for (size_t y = r[1][0]; y <= r[1][1]; y++)
+        for (size_t x = r[0][0]; x <= r[0][1]; x++)
+          f->d[base + y * f->nx + x] = 0;
+    }
+    for (size_t i = 0; i < slice; i++)
+      count += f->d[base + i] == 0;
+    b->count[z] = count;
+  }
+}
+
+// Lists the marked samples of each slice from where the slice begins.
+static
+void field_gather_task(void *ctx, size_t lo, size_t hi) {
+  const FieldBand *b = ctx;
+  const SolField *f = b->j->f;
+  for (size_t z = lo; z < hi; z++) {
+    size_t at = b->count[z];
+    for (size_t y = 0; y < f->ny; y++) {
+      for (size_t x = 0; x < f->nx; x++) {
+        const size_t i = (z * f->ny + y) * f->nx + x;
+        if (f->d[i] != 0)
+          continue;
+        b->p[at].x = field_centre(f, x, 0);
+        b->p[at].y = field_centre(f, y, 1);
+        b->p[at].z = field_centre(f, z, 2);
+        b->cell[at++] = i;
+      }
+    }
+  }
+}
+
+// Lays out each band sample and the corners of its nearest triangle for the
+// closest point kernel.
+static
+void field_near_task(void *ctx, size_t lo, size_t hi) {
+  const FieldNear *j = ctx;
+  for (size_t i = lo; i < hi; i++) {
+    const Vec3p a = j->v[j->idx[3 * j->tri[i]]];
+    const Vec3p b = j->v[j->idx[3 * j->tri[i] + 1]];
+    const Vec3p c = j->v[j->idx[3 * j->tri[i] + 2]];
+    j->q.x[i] = j->p[i].x;
+    j->q.y[i] = j->p[i].y;
+    j->q.z[i] = j->p[i].z;
+    j->a.x[i] = a.x;
+    j->a.y[i] = a.y;
+    j->a.z[i] = a.z;
+    j->b.x[i] = b.x;
+    j->b.y[i] = b.y;
+    j->b.z[i] = b.z;
+    j->c.x[i] = c.x;
+    j->c.y[i] = c.y;
+    j->c.z[i] = c.z;
+  }
+}
+
+// Seeds the band samples with their closest points.
+static
+void field_seed_task(void *ctx, size_t lo, size_t hi) {
+  const FieldSeed *j = ctx;
+  for (size_t i = lo; i < hi; i++) {
+    const size_t c = j->cell[i];
+    const Float ex = j->p[i].x - j->near.x[i], ey = j->p[i].y - j->near.y[i], ez = j->p[i].z - j->near.z[i];
+    j->j->s[0][c] = j->near.x[i];
+    j->j->s[1][c] = j->near.y[i];
+    j->j->s[2][c] = j->near.z[i];
+    j->j->f->d[c] = ex * ex + ey * ey + ez * ez;
+  }
+}
+
+static
+void field_sweep_x_task(void *ctx, size_t lo, size_t hi) {
+  const FieldJob *j = ctx;
+  const SolField *f = j->f;
+  for (size_t z = lo; z < hi; z++) {
+    const Float cz = field_centre(f, z, 2);
+    for (size_t y = 0; y < f->ny; y++) {
+      const size_t row = (z * f->ny + y) * f->nx;
+      const Float cy = field_centre(f, y, 1);
+      for (size_t step = 0; step < 2; step++) {
+        for (size_t k = 1; k < f->nx; k++) {
+          const size_t x = step ? f->nx - 1 - k : k, from = step ? x + 1 : x - 1;
+          const Float ex = field_centre(f, x, 0) - j->s[0][row + from];
+          const Float ey = cy - j->s[1][row + from], ez = cz - j->s[2][row + from];
+          const Float dd = ex * ex + ey * ey + ez * ez;
+          if (dd < f->d[row + x]) {
+            f->d[row + x] = dd;
+            for (size_t a = 0; a < 3; a++)
+              j->s[a][row + x] = j->s[a][row + from];
+          }
+        }
+      }
+    }
+  }
+}
+
+static
+void field_sweep_y_task(void *ctx, size_t lo, size_t hi) {
+  const FieldJob *j = ctx;
+  const SolField *f = j->f;
+  for (size_t z = lo; z < hi; z++) {
+    const Float cz = field_centre(f, z, 2);
+    for (size_t k = 1; k < f->ny; k++)
+      field_pull(j, (z * f->ny + k) * f->nx, (z * f->ny + k - 1) * f->nx, field_centre(f, k, 1), cz);
+    for (size_t k = f->ny - 1; k-- > 0;)
+      field_pull(j, (z * f->ny + k) * f->nx, (z * f->ny + k + 1) * f->nx, field_centre(f, k, 1), cz);
+  }
+}
+
+static
+void field_sweep_z_task(void *ctx, size_t lo, size_t hi) {
+  const FieldJob *j = ctx;
+  const SolField *f = j->f;
+  for (size_t k = 1; k < f->nz; k++)
+    for (size_t y = lo; y < hi; y++)
+      field_pull(j, (k * f->ny + y) * f->nx, ((k - 1) * f->ny + y) * f->nx, field_centre(f, y, 1), field_centre(f, k, 2));
+  for (size_t k = f->nz - 1; k-- > 0;)
+    for (size_t y = lo; y < hi; y++)
+      field_pull(j, (k * f->ny + y) * f->nx, ((k + 1) * f->ny + y) * f->nx, field_centre(f, y, 1), field_centre(f, k, 2));
+}
+
+// Turns squared distances into distances, negative inside.
+static
+void field_finish_task(void *ctx, size_t lo, size_t hi) {
+  const FieldBand *b = ctx;
+  SolField *f = b->j->f;
+  for (size_t z = lo; z < hi; z++) {
+    for (size_t y = 0; y < f->ny; y++) {
+      const size_t row = (z * f->ny + y) * f->nx;
+      for (size_t x = 0; x < f->nx; x++) {
+        const Float d = flt_sqrt(f->d[row + x]);
+        f->d[row + x] = b->v && sol_voxels_get(b->v->g, x, y, z) ? -d : d;
+      }
+    }
+  }
+}
+
+static
+void field_sample_task(void *ctx, size_t lo, size_t hi) {
+  const FieldSample *j = ctx;
+  const Float inv = 1 / j->f->size;
+  size_t i = lo;
+  #if SIMD_LANES > 1
+        for (; i + SIMD_LANES <= hi; i += SIMD_LANES) {
+          Float c[8][SIMD_LANES], t[3][SIMD_LANES], e[8], u[3];
+          for (size_t k = 0; k < SIMD_LANES; k++) {
+            field_corners(e, u, j->f, j->p[i + k]);
+            for (size_t q = 0; q < 8; q++)
+              c[q][k] = e[q];
+            t[0][k] = u[0];
+            t[1][k] = u[1];
+            t[2][k] = u[2];
+          }
+          SimdReg r[8];
+          for (size_t q = 0; q < 8; q++)
+            r[q] = simd_load(c[q]);
+          const SimdReg tx = simd_load(t[0]), ty = simd_load(t[1]), tz = simd_load(t[2]);
+          const SimdReg a0 = simd_sub(r[1], r[0]), a1 = simd_sub(r[3], r[2]);
+          const SimdReg a2 = simd_sub(r[5], r[4]), a3 = simd_sub(r[7], r[6]);
+          const SimdReg x0 = simd_add(r[0], simd_mul(a0, tx)), x1 = simd_add(r[2], simd_mul(a1, tx));
+          const SimdReg x2 = simd_add(r[4], simd_mul(a2, tx)), x3 = simd_add(r[6], simd_mul(a3, tx));
+          const SimdReg b0 = simd_sub(x1, x0), b1 = simd_sub(x3, x2);
+          const SimdReg y0 = simd_add(x0, simd_mul(b0, ty)), y1 = simd_add(x2, simd_mul(b1, ty));
+          const SimdReg dz = simd_sub(y1, y0);
+          simd_store(j->d + i, simd_add(y0, simd_mul(dz, tz)));
+          if (!j->grad)
+            continue;
+          const SimdReg dx0 = simd_add(a0, simd_mul(simd_sub(a1, a0), ty));
+          const SimdReg dx1 = simd_add(a2, simd_mul(simd_sub(a3, a2), ty));
+          const SimdReg iv = simd_set1(inv);
+          Float g[3][SIMD_LANES];
+          simd_store(g[0], simd_mul(simd_add(dx0, simd_mul(simd_sub(dx1, dx0), tz)), iv));
+          simd_store(g[1], simd_mul(simd_add(b0, simd_mul(simd_sub(b1, b0), tz)), iv));
+          simd_store(g[2], simd_mul(dz, iv));
+          for (size_t k = 0; k < SIMD_LANES; k++) {
+            j->grad[i + k].x = g[0][k];
+            j->grad[i + k].y = g[1][k];
+            j->grad[i + k].z = g[2][k];
+          }
+        }
+  #endif
+  for (; i < hi; i++) {
+    Float c[8], t[3], g[3];
+    field_corners(c, t, j->f, j->p[i]);
+    field_lerp(j->d + i, g, c, t, inv);
+    if (j->grad) {
+      j->grad[i].x = g[0];
+      j->grad[i].y = g[1];
+      j->grad[i].z = g[2];
+    }
+  }
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Field Helpers /////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+static
+void field_sweep(FieldJob *j) {
+  const SolField *f = j->f;
+  const size_t row = f->nx * (sizeof(Float) * 4);
+  for (size_t r = 0; r < FIELD_ROUNDS; r++) {
+    sol_parallel_for(f->nz, row * f->ny, field_sweep_x_task, j);
+    sol_parallel_for(f->nz, row * f->ny, field_sweep_y_task, j);
+    sol_parallel_for(f->ny, row * f->nz, field_sweep_z_task, j);
+  }
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Field Functions ///////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+/// sol_field_init ///
+// Description
+//   Creates a field with every sample set to infinity.
+// Arguments
+//   origin: lowest corner of the grid (Vec3)
+//   size: sample spacing (Float)
+//   nx, ny, nz: sample counts along each axis (size_t)
+// Returns
+//   field (SolField*), or NULL if allocation fails
+
+sol_inline
+SolField *sol_field_init(Vec3 origin, Float size, size_t nx, size_t ny, size_t nz) {
+  SolField *f = malloc(sizeof(SolField));
+  if (!f)
+    return NULL;
+  f->nx = nx;
+  f->ny = ny;
+  f->nz = nz;
+  f->origin = origin;
+  f->size = size;
+  const size_t cells = nx * ny * nz;
+  f->d = malloc((cells ? cells : 1) * sizeof(Float));
+  if (!f->d) {
+    free(f);
+    return NULL;
+  }
+  for (size_t i = 0; i < cells; i++)
+    f->d[i] = INFINITY;
+  return f;
+}
+
+/// sol_field_free ///
+// Description
+//   Frees a field.
+// Arguments
+//   f: field (SolField*)
+// Returns
+//   void
+
+sol_inline
+void sol_field_free(SolField *f) {
+  if (!f)
+    return;
+  free(f->d);
+  free(f);
+}
+
+/// sol_field_mesh ///
+// Description
+//   Replaces a field's samples with their signed distances to a triangle
+//   mesh, negative inside. Samples within band samples of a triangle's box
+//   get their exact distance from the mesh's bounding hierarchy, and the
+//   rest inherit nearest points from them by parallel sweeps, which may
+//   leave them long by a fraction of a sample; a wider band costs more but
+//   leaves less to the sweeps. Inside is decided as in sol_voxelize, so
+//   the mesh should be closed; triangles may face either way.
+// Arguments
+//   f: field (SolField*)
+//   v: vertices (Vec3p*)
+//   idx: three vertex indices per triangle (uint32_t*)
+//   n: triangle count, below 2^32 (size_t)
+//   band: width of the exact band in samples, at least 1 (size_t)
+// Returns
+//   false if allocation fails, leaving the field unspecified (bool)
+
+sol_inline
+bool sol_field_mesh(SolField *f, const Vec3p *v, const uint32_t *idx, size_t n, size_t band) {
+  const size_t cells = f->nx * f->ny * f->nz;
+  band = band ? band : 1;
+  Float *s = malloc((cells ? 3 * cells : 1) * sizeof(Float));
+  SolVoxels *in = sol_voxels_init(f->origin, f->size, f->nx, f->ny, f->nz);
+  size_t *count = malloc((f->nz + 1) * sizeof(size_t));
+  FieldJob j = {f, {s, s + cells, s + 2 * cells}};
+  VoxJob vj = {in, v, idx, NULL, NULL, false, true};
+  FieldBand b = {&j, &vj, band, count, NULL, NULL};
+  bool ok = s && in && count && vox_bucket(&vj, n, band);
+  if (ok) {
+    // Inside, then the band and its samples.
+    sol_parallel_for(f->nz, f->ny * in->words * sizeof(uint64_t), vox_slice_task, &vj);
+    sol_parallel_for(f->nz, f->nx * f->ny * sizeof(Float) * 4, field_band_task, &b);
+    size_t m = 0;
+    for (size_t z = 0; z <= f->nz; z++) {
+      const size_t c = z < f->nz ? count[z] : 0;
+      count[z] = m;
+      m += c;
+    }
+    b.p = malloc((m ? m : 1) * sizeof(Vec3p));
+    b.cell = malloc((m ? m : 1) * sizeof(size_t));
+    size_t *tri = malloc((m ? m : 1) * sizeof(size_t));
+    Float *dist = malloc((m ? m : 1) * sizeof(Float));
+    Float *buf = malloc((m ? 15 * m : 1) * sizeof(Float));
+    SolMesh *mesh = sol_mesh_init(v, idx, n);
+    ok = b.p && b.cell && tri && dist && buf && mesh;
+    if (ok) {
+      sol_parallel_for(f->nz, f->nx * f->ny * sizeof(Float), field_gather_task, &b);
+      sol_mesh_distance_array(dist, tri, mesh, b.p, m);
+      FieldNear near = {
+        v, idx, tri, b.p,
+        {buf, buf + m, buf + 2 * m},
+        {buf + 3 * m, buf + 4 * m, buf + 5 * m},
+        {buf + 6 * m, buf + 7 * m, buf + 8 * m},
+        {buf + 9 * m, buf + 10 * m, buf + 11 * m}
+      };
+      FieldSeed seed = {&j, b.p, b.cell, {buf + 12 * m, buf + 13 * m, buf + 14 * m}};
+      sol_parallel_for(m, sizeof(Float) * 12, field_near_task, &near);
+      vec3_closest_tri_array(seed.near, near.q, near.a, near.b, near.c, m);
+      sol_parallel_for(m, sizeof(Float) * 8, field_seed_task, &seed);
+      field_sweep(&j);
+      sol_parallel_for(f->nz, f->nx * f->ny * sizeof(Float), field_finish_task, &b);
+    }
+    sol_mesh_free(mesh);
+    free(buf);
+    free(dist);
+    free(tri);
+    free(b.cell);
+    free(b.p);
+  }
+  free(vj.list);
+  free(vj.start);
+  free(count);
+  sol_voxels_free(in);
+  free(s);
+  return ok;
+}
+
+/// sol_field_points ///
+// Description
+//   Replaces a field's samples with their unsigned distances to the nearest
+//   of a set of points. Each point seeds the sample nearest to it, or the
+//   nearest sample on the edge of the field for points outside it, and
+//   sweeps carry the points out from there.
+// Arguments
+//   f: field (SolField*)
+//   p: points (Vec3p*)
+//   n: point count (size_t)
+// Returns
+//   false if allocation fails, leaving the field unspecified (bool)
+
+sol_inline
+bool sol_field_points(SolField *f, const Vec3p *p, size_t n) {
+  const size_t cells = f->nx * f->ny * f->nz;
+  Float *s = malloc((cells ? 3 * cells : 1) * sizeof(Float));
+  if (!s)
+    return false;
+  FieldJob j = {f, {s, s + cells, s + 2 * cells}};
+  FieldBand b = {&j, NULL, 0, NULL, NULL, NULL};
+  sol_parallel_for(f->nz, f->nx * f->ny * sizeof(Float) * 4, field_band_task, &b);
+  for (size_t i = 0; i < n && cells; i++) {
+    const Float u[3] = {
+      (p[i].x - f->origin.x) / f->size,
+      (p[i].y - f->origin.y) / f->size,
+      (p[i].z - f->origin.z) / f->size
+    };
+    const size_t dim[3] = {f->nx, f->ny, f->nz};
+    size_t c[3];
+    for (size_t k = 0; k < 3; k++) {
+      const Float top = (Float) (dim[k] - 1);
+      const Float w = u[k] > 0 ? (u[k] < top ? u[k] : top) : 0;
+      c[k] = (size_t) w;
+    }
+    const size_t at = (c[2] * f->ny + c[1]) * f->nx + c[0];
+    const Float ex = field_centre(f, c[0], 0) - p[i].x;
+    const Float ey = field_centre(f, c[1], 1) - p[i].y;
+    const Float ez = field_centre(f, c[2], 2) - p[i].z;
+    const Float dd = ex * ex + ey * ey + ez * ez;
+    if (dd < f->d[at]) {
+      f->d[at] = dd;
+      s[at] = p[i].x;
+      s[at + cells] = p[i].y;
+      s[at + 2 * cells] = p[i].z;
+    }
+  }
+  field_sweep(&j);
+  sol_parallel_for(f->nz, f->nx * f->ny * sizeof(Float), field_finish_task, &b);
+  free(s);
+  return true;
+}
+
+/// sol_field_sample_array ///
+// Description
+//   Samples a field at n points by trilinear interpolation, optionally with
+//   the gradient of the interpolant. Points outside the field are clamped to
+//   its outermost samples.
+// Arguments
+//   d: values (Float*)
+//   grad: gradients, or NULL (Vec3p*)
+//   f: field (SolField*)
+//   p: points (Vec3p*)
+//   n: point count (size_t)
+// Returns
+//   void
+
+sol_inline
+void sol_field_sample_array(Float *d, Vec3p *grad, const SolField *f, const Vec3p *p, size_t n) {
+  FieldSample j = {f, p, d, grad};
+  sol_parallel_for(n, sizeof(Vec3p) * 2 + sizeof(Float) * 9, field_sample_task, &j);
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Filter Types //////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Points are filtered by sorting them on the voxel they fall in. A voxel's
+// coordinates, less those of the lowest voxel any point falls in, are packed
+// into a key with x in the lowest bits and z in the highest, each taking no
+// more bits than the points span, so the sort needs only as many 8 bit
+// passes as the cloud does. Every pass is a stable LSD radix pass over
+// FILTER_CHUNKS chunks at once: each chunk counts its digits, the counts are
+// summed in digit then chunk order, and each chunk scatters its own points.
+// The sorted keys are then cut into chunks on voxel boundaries, and every
+// chunk writes one result per voxel from where the chunks before it end.
+
+#define FILTER_CHUNKS 64
+
+typedef struct {
+  const Vec3p *v;
+  size_t n;
+  Float size, inv;
+  int64_t box[FILTER_CHUNKS][6]; // Lowest then highest voxel of each chunk.
+  int64_t lo[3];
+  unsigned shift[4]; // Where each axis starts in a key, then the key's width.
+  unsigned digit;
+  uint64_t *key, *key_tmp;
+  size_t *order, *order_tmp;
+  size_t *count; // Digit d of chunk c is count[d * FILTER_CHUNKS + c].
+  size_t cut[FILTER_CHUNKS + 1]; // Chunks of the sorted points.
+  size_t at[FILTER_CHUNKS + 1]; // First result of each chunk.
+  Vec3p *mean; // Means, or NULL for indices.
+  size_t *idx;
+  bool nearest;
+} FilterJob;
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Filter Kernels ////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Clamped to 2^62 voxels either way, where a NaN goes too.
+static inline
+int64_t filter_cell(Float x, Float inv) {
+  const Float top = (Float) 4611686018427387904.0, f = x * inv;
+  const int64_t i = (int64_t) (f > -top ? (f < top ? f : top) : -top);
+  return i - ((Float) i > f);
+}
+
+static inline
+uint64_t filter_key(const FilterJob *j, Vec3p p) {
+  const int64_t q[3] = {filter_cell(p.x, j->inv), filter_cell(p.y, j->inv), filter_cell(p.z, j->inv)};
+  uint64_t key = 0;
+  for (size_t d = 0; d < 3; d++)
+    if (j->shift[d] < 64)
+      key |= ((uint64_t) q[d] - (uint64_t) j->lo[d]) << j->shift[d];
+  return key;
+}
+
+// Centre of the voxel with the given key along axis d.
+static inline
+Float filter_centre(const FilterJob *j, uint64_t key, size_t d) {
+  const unsigned bits = j->shift[d + 1] - j->shift[d];
+  const uint64_t mask = bits < 64 ? ((uint64_t) 1 << bits) - 1 : ~(uint64_t) 0;
+  const uint64_t q = j->shift[d] < 64 ? key >> j->shift[d] & mask : 0;
+  return ((Float) (int64_t) (q + (uint64_t) j->lo[d]) + (Float) 0.5) * j->size;
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Filter Tasks //////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+static
+void filter_bounds_task(void *ctx, size_t lo, size_t hi) {
+  FilterJob *j = ctx;
+  for (size_t c = lo; c < hi; c++) {
+    int64_t *b = j->box[c];
+    b[0] = b[1] = b[2] = INT64_MAX;
+    b[3] = b[4] = b[5] = INT64_MIN;
+    for (size_t i = j->n * c / FILTER_CHUNKS; i < j->n * (c + 1) / FILTER_CHUNKS; i++) {
+      const int64_t q[3] = {
+        filter_cell(j->v[i].x, j->inv),
+        filter_cell(j->v[i].y, j->inv),
+        filter_cell(j->v[i].z, j->inv)
+      };
+      for (size_t d = 0; d < 3; d++) {
+        b[d] = q[d] < b[d] ? q[d] : b[d];
+        b[d + 3] = q[d] > b[d + 3] ? q[d] : b[d + 3];
+      }
+    }
+  }
+}
+
+static
+void filter_key_task(void *ctx, size_t lo, size_t hi) {
+  FilterJob *j = ctx;
+  for (size_t i = lo; i < hi; i++) {
+    j->key[i] = filter_key(j, j->v[i]);
+    j->order[i] = i;
+  }
+}
+
+static
+void filter_count_task(void *ctx, size_t lo, size_t hi) {
+  FilterJob *j = ctx;
+  for (size_t c = lo; c < hi; c++) {
+    size_t count[256] = {0};
+    for (size_t i = j->n * c / FILTER_CHUNKS; i < j->n * (c + 1) / FILTER_CHUNKS; i++)
+      count[j->key[i] >> j->digit & 0xFF]++;
+    for (size_t d = 0; d < 256; d++)
+      j->count[d * FILTER_CHUNKS + c] = count[d];
+  }
+}
+
+static
+void filter_scatter_task(void *ctx, size_t lo, size_t hi) {
+  FilterJob *j = ctx;
+  for (size_t c = lo; c < hi; c++) {
+    size_t to[256];
+    for (size_t d = 0; d < 256; d++)
+      to[d] = j->count[d * FILTER_CHUNKS + c];
+    for (size_t i = j->n * c / FILTER_CHUNKS; i < j->n * (c + 1) / FILTER_CHUNKS; i++) {
+      const size_t k = to[j->key[i] >> j->digit & 0xFF]++;
+      j->key_tmp[k] = j->key[i];
+      j->order_tmp[k] = j->order[i];
+    }
+  }
+}
+
+// Counts the voxels of each chunk of sorted points.
+static
+void filter_runs_task(void *ctx, size_t lo, size_t hi) {
+  FilterJob *j = ctx;
+  for (size_t c = lo; c < hi; c++) {
+    size_t runs = 0;
+    for (size_t i = j->cut[c]; i < j->cut[c + 1]; i++)
+      runs += i == j->cut[c] || j->key[i] != j->key[i - 1];
+    j->at[c + 1] = runs;
+  }
+}
+
+// Writes one result per voxel of each chunk of sorted points.
+static
+void filter_emit_task(void *ctx, size_t lo, size_t hi) {
+  const FilterJob *j = ctx;
+  for (size_t c = lo; c < hi; c++) {
+    size_t o = j->at[c];
+    for (size_t a = j->cut[c], b; a < j->cut[c + 1]; a = b, o++) {
+      b = a + 1;
+      while (b < j->cut[c + 1] && j->key[b] == j->key[a])
+        b++;
+      const Vec3p p = j->v[j->order[a]];
+      if (j->mean) {
+        // Summed about the voxel's first point, which keeps far off clouds
+        // from losing their low bits.
+        Float s[3] = {0, 0, 0};
+        for (size_t i = a + 1; i < b; i++) {
+          const Vec3p q = j->v[j->order[i]];
+          s[0] += q.x - p.x;
+          s[1] += q.y - p.y;
+          s[2] += q.z - p.z;
+        }
+        const Float k = (Float) (b - a);
+        j->mean[o].x = p.x + s[0] / k;
+        j->mean[o].y = p.y + s[1] / k;
+        j->mean[o].z = p.z + s[2] / k;
+      } else if (j->nearest) {
+        const Float m[3] = {filter_centre(j, j->key[a], 0), filter_centre(j, j->key[a], 1), filter_centre(j, j->key[a], 2)};
+        size_t best = j->order[a];
+        Float low = INFINITY;
+        for (size_t i = a; i < b; i++) {
+          const Vec3p q = j->v[j->order[i]];
+          const Float d = (q.x - m[0]) * (q.x - m[0]) + (q.y - m[1]) * (q.y - m[1]) + (q.z - m[2]) * (q.z - m[2]);
+          if (d < low) {
+            low = d;
+            best = j->order[i];
+          }
+        }
+        j->idx[o] = best;
+      } else {
+        j->idx[o] = j->order[a];
+      }
+    }
+  }
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Filter Helpers ////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// Sorts the points by voxel and writes one result per voxel, returning how
+// many or SIZE_MAX if allocation fails or the points span too many voxels.
+static
+size_t filter_run(FilterJob *j) {
+  const size_t n = j->n;
+  if (!n)
+    return 0;
+  j->inv = 1 / j->size;
+  sol_parallel_for(FILTER_CHUNKS, n / FILTER_CHUNKS * sizeof(Vec3p) + 1, filter_bounds_task, j);
+  j->shift[0] = 0;
+  for (size_t d = 0; d < 3; d++) {
+    int64_t hi = INT64_MIN;
+    j->lo[d] = INT64_MAX;
+    for (size_t c = 0; c < FILTER_CHUNKS; c++) {
+      j->lo[d] = j->box[c][d] < j->lo[d] ? j->box[c][d] : j->lo[d];
+      hi = j->box[c][d + 3] > hi ? j->box[c][d + 3] : hi;
+    }
+    unsigned bits = 0;
+    for (uint64_t span = (uint64_t) hi - (uint64_t) j->lo[d]; span; span >>= 1)
+      bits++;
+    j->shift[d + 1] = j->shift[d] + bits;
+  }
+  if (j->shift[3] > 64)
+    return SIZE_MAX;
+
+  j->key = malloc(n * sizeof(uint64_t));
+  j->key_tmp = malloc(n * sizeof(uint64_t));
+  j->order = malloc(n * sizeof(size_t));
+  j->order_tmp = malloc(n * sizeof(size_t));
+  j->count = malloc(256 * FILTER_CHUNKS * sizeof(size_t));
+  size_t out = SIZE_MAX;
+  if (j->key && j->key_tmp && j->order && j->order_tmp && j->count) {
+    sol_parallel_for(n, sizeof(Vec3p) + sizeof(uint64_t) + sizeof(size_t), filter_key_task, j);
+    for (j->digit = 0; j->digit < j->shift[3]; j->digit += 8) {
+      sol_parallel_for(FILTER_CHUNKS, n / FILTER_CHUNKS * sizeof(uint64_t) + 1, filter_count_task, j);
+      size_t sum = 0;
+      for (size_t k = 0; k < 256 * FILTER_CHUNKS; k++) {
+        const size_t c = j->count[k];
+        j->count[k] = sum;
+        sum += c;
+      }
+      sol_parallel_for(FILTER_CHUNKS, n / FILTER_CHUNKS * 32 + 1, filter_scatter_task, j);
+      uint64_t *key = j->key;
+      size_t *order = j->order;
+      j->key = j->key_tmp;
+      j->order = j->order_tmp;
+      j->key_tmp = key;
+      j->order_tmp = order;
+    }
+
+    // Chunks start where a voxel does, found by binary search from an even
+    // split so that one crowded voxel does not hold the cuts up.
+    j->cut[0] = 0;
+    for (size_t c = 1; c <= FILTER_CHUNKS; c++) {
+      size_t a = n * c / FILTER_CHUNKS;
+      a = a > j->cut[c - 1] ? a : j->cut[c - 1];
+      if (a > 0 && a < n) {
+        const uint64_t key = j->key[a - 1];
+        size_t b = n;
+        while (a < b) {
+          const size_t m = a + (b - a) / 2;
+          if (j->key[m] == key)
+            a = m + 1;
+          else
+            b = m;
+        }
+      }
+      j->cut[c] = a;
+    }
+    sol_parallel_for(FILTER_CHUNKS, n / FILTER_CHUNKS * sizeof(uint64_t) + 1, filter_runs_task, j);
+    j->at[0] = 0;
+    for (size_t c = 0; c < FILTER_CHUNKS; c++)
+      j->at[c + 1] += j->at[c];
+    sol_parallel_for(FILTER_CHUNKS, n / FILTER_CHUNKS * (sizeof(Vec3p) + 16) + 1, filter_emit_task, j);
+    out = j->at[FILTER_CHUNKS];
+  }
+  free(j->key);
+  free(j->key_tmp);
+  free(j->order);
+  free(j->order_tmp);
+  free(j->count);
+  return out;
+}
+
+  //////////////////////////////////////////////////////////////////////////////
+ // Filter Functions //////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+/// vec3_voxel_mean_array ///
+// Description
+//   Downsamples a point cloud to one point per voxel of a grid of cubes of
+//   the given size aligned to the world origin, the mean of the points in
+//   the voxel. The points are radix sorted by voxel in parallel, so the
+//   scratch memory grows with the point count rather than the volume the
+//   points span. Results are in order of voxel z, then y, then x.
+// Arguments
+//   out: voxel means, written; room for n (Vec3p*)
+//   v: points (Vec3p*)
+//   n: point count (size_t)
+//   size: voxel edge length, positive (Float)
+// Returns
+//   voxel count (size_t), or SIZE_MAX if allocation fails or the points
+//   span more than 2^64 voxels
+
+sol_inline
+size_t vec3_voxel_mean_array(Vec3p *out, const Vec3p *v, size_t n, Float size) {
+  FilterJob j = {.v = v, .n = n, .size = size, .mean = out};
+  return filter_run(&j);
+}
+
+/// vec3_voxel_first_array ///
+// Description
+//   Downsamples a point cloud as vec3_voxel_mean_array does, keeping the
+//   first point of each voxel.
+// Arguments
+//   idx: index of each voxel's first point, written; room for n (size_t*)
+//   v: points (Vec3p*)
+//   n: point count (size_t)
+//   size: voxel edge length, positive (Float)
+// Returns
+//   voxel count (size_t), or SIZE_MAX if allocation fails or the points
+//   span more than 2^64 voxels
+
+sol_inline
+size_t vec3_voxel_first_array(size_t *idx, const Vec3p *v, size_t n, Float size) {
+  FilterJob j = {.v = v, .n = n, .size = size, .idx = idx};
+  return filter_run(&j);
+}
+
+/// vec3_voxel_nearest_array ///
+// Description
+//   Downsamples a point cloud as vec3_voxel_mean_array does, keeping the
+//   point of each voxel nearest its centre, the first of any ties.
+// Arguments
+//   idx: index of each voxel's kept point, written; room for n (size_t*)
+//   v: points (Vec3p*)
+//   n: point count (size_t)
+//   size: voxel edge length, positive (Float)
+// Returns
+//   voxel count (size_t), or SIZE_MAX if allocation fails or the points
+//   span more than 2^64 voxels
+
+sol_inline
+size_t vec3_voxel_nearest_array(size_t *idx, const Vec3p *v, size_t n, Float size) {
+  FilterJob j = {.v = v, .n = n, .size = size, .idx = idx, .nearest = true};
+  return filter_run(&j);
+}
@@ -73,7 +73,101 @@ bench "vec3_mag":
 bench "vec3_rot":
     c = vec3_rot(c, q)
 
+bench "vec3_dot":
+    f = vec3_dot(a, b)
+
+bench "vec3_cross":
+    c = vec3_cross(a, b)
+
+bench "vec3_round":
+    c = vec3_round(c)
+
 echo a
 echo b
 echo c
 echo f
+
+######################
+# Scaling Benchmarks #
+######################
+
+const solScaleLen = 10_000_000 # Elements per array kernel call.
+const solScaleRuns = 10
+
+var sa = newSeq[Vec3p](solScaleLen)
+var sb = newSeq[Vec3p](solScaleLen)
+var so = newSeq[Vec3p](solScaleLen)
+for i in 0 ..< solScaleLen:
+    sa[i] = Vec3p(x: Float(i), y: 1, z: 2)
+    sb[i] = Vec3p(x: 3, y: Float(i), z: 4)
+
+let solCores = sol_get_threads()
+var base: float = 0
+for t in 1 .. int(solCores):
+    sol_set_threads(csize(t))
+    let start = epochTime()
+    for r in 0 ..< solScaleRuns:
+        vec3_add_array(addr so[0], addr sa[0], addr sb[0], csize(solScaleLen))
+    let time = (epochTime() - start) / solScaleRuns
+    if t == 1:
+        base = time
+    echo "[sol] vec3_add_array on " & $t & " thread(s)"
+    echo "-> Average Time:    " & time.formatFloat(format = ffDecimal, precision = solPrecision)
+    echo "-> Speedup:         " & (base / time).formatFloat(format = ffDecimal, precision = 2)
+sol_set_threads(0)
+
+####################
+# Noise Benchmarks #
+####################
+
+const solNoiseLen = 4_000_000 # Sample points per noise call.
+
+var np = newSeq[Vec3p](solNoiseLen)
+var nq = newSeq[Vec2](solNoiseLen)
+var no = newSeq[Float](solNoiseLen)
+for i in 0 ..< solNoiseLen:
+    np[i] = Vec3p(x: Float(i) * 0.001, y: Float(i mod 977) * 0.01, z: 0.5)
+    nq[i] = vec2_init(Float(i) * 0.001, Float(i mod 977) * 0.01)
+
+template noiseBench(name: string, code: stmt) =
+    let start = epochTime()
+    for r in 0 ..< solScaleRuns:
+        code
+    let time = (epochTime() - start) / solScaleRuns
+    echo "[sol] " & name & " over " & $solNoiseLen & " points"
+    echo "-> Samples Per Second: " & (solNoiseLen / time).formatFloat(format = ffDecimal, precision = 0)
+
+noiseBench "noise2_array":
+    noise2_array(addr no[0], addr nq[0], csize(solNoiseLen))
+
+noiseBench "noise3_array":
+    noise3_array(addr no[0], addr np[0], csize(solNoiseLen))
+
+noiseBench "noise3_perlin_array":
+    noise3_perlin_array(addr no[0], addr np[0], csize(solNoiseLen))
+
+noiseBench "noise3_fbm_array (5 octaves)":
+    noise3_fbm_array(addr no[0], addr np[0], csize(solNoiseLen), 5, 2, 0.5)
+
+#####################
+# N-Body Benchmarks #
+#####################
+
+for bodies in [10_000, 100_000, 1_000_000]:
+    var buf = newSeq[Float](bodies * 6)
+    let pos = Soa3(x: addr buf[0], y: addr buf[bodies], z: addr buf[2 * bodies])
+    let acc = Soa3(x: addr buf[3 * bodies], y: addr buf[4 * bodies], z: addr buf[5 * bodies])
+    var seed: uint32 = 1
+    for i in 0 ..< bodies * 3:
+        seed = seed * 1664525'u32 + 1013904223'u32
+        buf[i] = Float(seed shr 8) / 16777216
+    var grav = SolGravity(mass: nil, g: 1, softening: 0.001, theta: 0.5)
+    if bodies <= 10_000:
+        let start = epochTime()
+        vec3_gravity_direct_array(acc, pos, csize(bodies), addr grav)
+        echo "[sol] vec3_gravity_direct_array on " & $bodies & " bodies"
+        echo "-> Time:            " & (epochTime() - start).formatFloat(format = ffDecimal, precision = solPrecision)
+    let start = epochTime()
+    vec3_gravity_tree_array(acc, pos, csize(bodies), addr grav)
+    echo "[sol] vec3_gravity_tree_array (theta 0.5) on " & $bodies & " bodies"
+    echo "-> Time:            " & (epochTime() - start).formatFloat(format = ffDecimal, precision = solPrecision)